@@ -0,0 +1,441 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5CorePCH.h"
+#include "Wm5MappedFile.h"
+#include "Wm5Assert.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+#if defined(WIN32)
+//----------------------------------------------------------------------------
+#include <windows.h>
+//----------------------------------------------------------------------------
+namespace
+{
+    struct FileState
+    {
+        HANDLE File, Mapping;
+    };
+
+    // ReadFile and WriteFile transfer at most 2^32-1 bytes per call.
+    const size_t gsMaxTransfer = 0x40000000;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Open (const std::string& filename, bool writable)
+{
+    assertion(mState == 0, "File %s is already open\n", filename.c_str());
+    if (mState)
+    {
+        return false;
+    }
+
+    DWORD access = (writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ);
+    HANDLE file = CreateFileA(filename.c_str(), access, FILE_SHARE_READ, 0,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, 0);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    FileState* state = new0 FileState;
+    state->File = file;
+    state->Mapping = 0;
+    mState = state;
+    mSize = (int64_t)size.QuadPart;
+    mWritable = writable;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Create (const std::string& filename, int64_t size)
+{
+    assertion(mState == 0, "File %s is already open\n", filename.c_str());
+    if (mState)
+    {
+        return false;
+    }
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ, 0, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, 0);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    // Extending the file fills the new bytes with zeros.
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)size;
+    if (!SetFilePointerEx(file, end, 0, FILE_BEGIN) || !SetEndOfFile(file))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    FileState* state = new0 FileState;
+    state->File = file;
+    state->Mapping = 0;
+    mState = state;
+    mSize = size;
+    mWritable = true;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Close ()
+{
+    if (!mState)
+    {
+        return false;
+    }
+
+    Unmap();
+    FileState* state = (FileState*)mState;
+    BOOL closed = CloseHandle(state->File);
+    delete0(state);
+    mState = 0;
+    mSize = 0;
+    mWritable = false;
+    return closed == TRUE;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Read (int64_t offset, size_t numBytes, void* data) const
+{
+    if (!mState || offset < 0 || offset + (int64_t)numBytes > mSize)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    char* bytes = (char*)data;
+    while (numBytes > 0)
+    {
+        DWORD count = (DWORD)(numBytes < gsMaxTransfer ? numBytes :
+            gsMaxTransfer);
+        OVERLAPPED overlapped;
+        memset(&overlapped, 0, sizeof(OVERLAPPED));
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD numRead = 0;
+        if (!ReadFile(state->File, bytes, count, &numRead, &overlapped)
+        ||  numRead == 0)
+        {
+            return false;
+        }
+        bytes += numRead;
+        offset += numRead;
+        numBytes -= numRead;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Write (int64_t offset, size_t numBytes, const void* data)
+{
+    assertion(mWritable, "The file is not writable\n");
+    if (!mState || !mWritable || offset < 0
+    ||  offset + (int64_t)numBytes > mSize)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    const char* bytes = (const char*)data;
+    while (numBytes > 0)
+    {
+        DWORD count = (DWORD)(numBytes < gsMaxTransfer ? numBytes :
+            gsMaxTransfer);
+        OVERLAPPED overlapped;
+        memset(&overlapped, 0, sizeof(OVERLAPPED));
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD numWritten = 0;
+        if (!WriteFile(state->File, bytes, count, &numWritten, &overlapped)
+        ||  numWritten == 0)
+        {
+            return false;
+        }
+        bytes += numWritten;
+        offset += numWritten;
+        numBytes -= numWritten;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+char* MappedFile::Map ()
+{
+    if (mMapping || !mState || mSize == 0)
+    {
+        return mMapping;
+    }
+    if ((uint64_t)mSize > (uint64_t)(size_t)-1)
+    {
+        return 0;
+    }
+
+    FileState* state = (FileState*)mState;
+    state->Mapping = CreateFileMappingA(state->File, 0,
+        (mWritable ? PAGE_READWRITE : PAGE_READONLY), 0, 0, 0);
+    if (!state->Mapping)
+    {
+        return 0;
+    }
+
+    mMapping = (char*)MapViewOfFile(state->Mapping,
+        (mWritable ? FILE_MAP_WRITE : FILE_MAP_READ), 0, 0, 0);
+    if (!mMapping)
+    {
+        CloseHandle(state->Mapping);
+        state->Mapping = 0;
+    }
+    return mMapping;
+}
+//----------------------------------------------------------------------------
+void MappedFile::Unmap ()
+{
+    if (mMapping)
+    {
+        FileState* state = (FileState*)mState;
+        UnmapViewOfFile(mMapping);
+        CloseHandle(state->Mapping);
+        state->Mapping = 0;
+        mMapping = 0;
+    }
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Flush ()
+{
+    if (!mState)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    if (mMapping && !FlushViewOfFile(mMapping, 0))
+    {
+        return false;
+    }
+    return (!mWritable || FlushFileBuffers(state->File) == TRUE);
+}
+//----------------------------------------------------------------------------
+#elif defined(__LINUX__) || defined(__APPLE__)
+//----------------------------------------------------------------------------
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+//----------------------------------------------------------------------------
+namespace
+{
+    struct FileState
+    {
+        int Descriptor;
+    };
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Open (const std::string& filename, bool writable)
+{
+    assertion(mState == 0, "File %s is already open\n", filename.c_str());
+    if (mState)
+    {
+        return false;
+    }
+
+    int descriptor = open(filename.c_str(), (writable ? O_RDWR : O_RDONLY));
+    if (descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    FileState* state = new0 FileState;
+    state->Descriptor = descriptor;
+    mState = state;
+    mSize = (int64_t)status.st_size;
+    mWritable = writable;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Create (const std::string& filename, int64_t size)
+{
+    assertion(mState == 0, "File %s is already open\n", filename.c_str());
+    if (mState)
+    {
+        return false;
+    }
+
+    int descriptor = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+        0644);
+    if (descriptor < 0)
+    {
+        return false;
+    }
+
+    // Extending the file fills the new bytes with zeros.  On most file
+    // systems the file is sparse until it is written.
+    if (ftruncate(descriptor, (off_t)size) != 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    FileState* state = new0 FileState;
+    state->Descriptor = descriptor;
+    mState = state;
+    mSize = size;
+    mWritable = true;
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Close ()
+{
+    if (!mState)
+    {
+        return false;
+    }
+
+    Unmap();
+    FileState* state = (FileState*)mState;
+    int closed = close(state->Descriptor);
+    delete0(state);
+    mState = 0;
+    mSize = 0;
+    mWritable = false;
+    return closed == 0;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Read (int64_t offset, size_t numBytes, void* data) const
+{
+    if (!mState || offset < 0 || offset + (int64_t)numBytes > mSize)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    char* bytes = (char*)data;
+    while (numBytes > 0)
+    {
+        ssize_t numRead = pread(state->Descriptor, bytes, numBytes,
+            (off_t)offset);
+        if (numRead <= 0)
+        {
+            return false;
+        }
+        bytes += numRead;
+        offset += numRead;
+        numBytes -= (size_t)numRead;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Write (int64_t offset, size_t numBytes, const void* data)
+{
+    assertion(mWritable, "The file is not writable\n");
+    if (!mState || !mWritable || offset < 0
+    ||  offset + (int64_t)numBytes > mSize)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    const char* bytes = (const char*)data;
+    while (numBytes > 0)
+    {
+        ssize_t numWritten = pwrite(state->Descriptor, bytes, numBytes,
+            (off_t)offset);
+        if (numWritten <= 0)
+        {
+            return false;
+        }
+        bytes += numWritten;
+        offset += numWritten;
+        numBytes -= (size_t)numWritten;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+char* MappedFile::Map ()
+{
+    if (mMapping || !mState || mSize == 0)
+    {
+        return mMapping;
+    }
+    if ((uint64_t)mSize > (uint64_t)(size_t)-1)
+    {
+        return 0;
+    }
+
+    FileState* state = (FileState*)mState;
+    void* mapping = mmap(0, (size_t)mSize,
+        (mWritable ? PROT_READ | PROT_WRITE : PROT_READ), MAP_SHARED,
+        state->Descriptor, 0);
+    mMapping = (mapping != MAP_FAILED ? (char*)mapping : 0);
+    return mMapping;
+}
+//----------------------------------------------------------------------------
+void MappedFile::Unmap ()
+{
+    if (mMapping)
+    {
+        munmap(mMapping, (size_t)mSize);
+        mMapping = 0;
+    }
+}
+//----------------------------------------------------------------------------
+bool MappedFile::Flush ()
+{
+    if (!mState)
+    {
+        return false;
+    }
+
+    FileState* state = (FileState*)mState;
+    if (mMapping && msync(mMapping, (size_t)mSize, MS_SYNC) != 0)
+    {
+        return false;
+    }
+    return (!mWritable || fsync(state->Descriptor) == 0);
+}
+//----------------------------------------------------------------------------
+#else
+#error Other platforms not yet implemented.
+#endif
+//----------------------------------------------------------------------------
+MappedFile::MappedFile ()
+    :
+    mState(0),
+    mSize(0),
+    mMapping(0),
+    mWritable(false)
+{
+}
+//----------------------------------------------------------------------------
+MappedFile::~MappedFile ()
+{
+    if (mState)
+    {
+        Close();
+    }
+}
+//----------------------------------------------------------------------------
+MappedFile::operator bool () const
+{
+    return mState != 0;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5MAPPEDFILE_H
+#define WM5MAPPEDFILE_H
+
+#include "Wm5CoreLIB.h"
+
+// Random access to binary files that may be larger than the physical
+// memory or the 2GB range of FileIO.  The class provides positional reads
+// and writes with 64-bit offsets and a memory mapping of the entire file.
+// Unlike FileIO, the bytes are transferred as is; no endianness swapping is
+// performed.  Positional reads of an open file may be called concurrently
+// from several threads.
+
+namespace Wm5
+{
+
+class WM5_CORE_ITEM MappedFile
+{
+public:
+    // Construction and destruction.
+    MappedFile ();
+    ~MappedFile ();
+
+    // Open an existing file.  If 'writable' is false, calling Write is an
+    // error and the mapping is read-only.
+    bool Open (const std::string& filename, bool writable);
+
+    // Create a writable file of the specified size.  An existing file is
+    // replaced.  The contents are zero.
+    bool Create (const std::string& filename, int64_t size);
+
+    bool Close ();
+
+    // Implicit conversion to allow testing for successful file open.
+    operator bool () const;
+
+    // Member access.
+    inline int64_t GetSize () const;
+    inline bool IsWritable () const;
+
+    // The return value is 'true' if and only if all 'numBytes' bytes at
+    // 'offset' were transferred.
+    bool Read (int64_t offset, size_t numBytes, void* data) const;
+    bool Write (int64_t offset, size_t numBytes, const void* data);
+
+    // Map the entire file into the address space.  The function returns
+    // null if the mapping fails, for example when the address space of a
+    // 32-bit process is too small.  Writes through the mapping of a
+    // writable file are stored in the file.  Flush forces them to disk.
+    char* Map ();
+    void Unmap ();
+    bool Flush ();
+    inline char* GetMapping () const;
+
+private:
+    // The platform-specific file handles are hidden behind a void* to
+    // avoid exposing system headers.
+    void* mState;
+    int64_t mSize;
+    char* mMapping;
+    bool mWritable;
+};
+
+#include "Wm5MappedFile.inl"
+
+}
+
+#endif
@@ -0,0 +1,24 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+inline int64_t MappedFile::GetSize () const
+{
+    return mSize;
+}
+//----------------------------------------------------------------------------
+inline bool MappedFile::IsWritable () const
+{
+    return mWritable;
+}
+//----------------------------------------------------------------------------
+inline char* MappedFile::GetMapping () const
+{
+    return mMapping;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,409 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5CorePCH.h"
+#include "Wm5ThreadPool.h"
+#include "Wm5Assert.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+#if defined(WIN32)
+//----------------------------------------------------------------------------
+// Condition variables require Windows Vista or later.
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600
+#endif
+#include <windows.h>
+//----------------------------------------------------------------------------
+namespace
+{
+    struct WorkerInfo
+    {
+        ThreadPool* Pool;
+        int Worker;
+    };
+
+    struct PoolState
+    {
+        CRITICAL_SECTION Mutex;
+        CONDITION_VARIABLE Wake, Done;
+        HANDLE* Threads;
+        WorkerInfo* Info;
+        unsigned int Generation;
+        int Active;
+        bool Quit;
+    };
+
+    DWORD WINAPI PoolEntry (LPVOID parameters)
+    {
+        WorkerInfo* info = (WorkerInfo*)parameters;
+        info->Pool->WorkerLoop(info->Worker);
+        return 0;
+    }
+}
+//----------------------------------------------------------------------------
+ThreadPool::ThreadPool (int numThreads)
+    :
+    mNumThreads(numThreads > 0 ? numThreads : GetNumProcessors()),
+    mTask(0),
+    mUserData(0),
+    mNumItems(0),
+    mGrain(1),
+    mNext(0),
+    mBusy(false)
+{
+    PoolState* state = new0 PoolState;
+    InitializeCriticalSection(&state->Mutex);
+    InitializeConditionVariable(&state->Wake);
+    InitializeConditionVariable(&state->Done);
+    state->Generation = 0;
+    state->Active = 0;
+    state->Quit = false;
+    state->Threads = 0;
+    state->Info = 0;
+    mState = state;
+
+    if (mNumThreads > 1)
+    {
+        state->Threads = new1<HANDLE>(mNumThreads - 1);
+        state->Info = new1<WorkerInfo>(mNumThreads - 1);
+        for (int i = 0; i < mNumThreads - 1; ++i)
+        {
+            state->Info[i].Pool = this;
+            state->Info[i].Worker = i + 1;
+            state->Threads[i] = CreateThread(NULL, 0, PoolEntry,
+                &state->Info[i], 0, NULL);
+            assertion(state->Threads[i] != NULL,
+                "Failed to create pool thread\n");
+        }
+    }
+}
+//----------------------------------------------------------------------------
+ThreadPool::~ThreadPool ()
+{
+    PoolState* state = (PoolState*)mState;
+
+    EnterCriticalSection(&state->Mutex);
+    state->Quit = true;
+    WakeAllConditionVariable(&state->Wake);
+    LeaveCriticalSection(&state->Mutex);
+
+    for (int i = 0; i < mNumThreads - 1; ++i)
+    {
+        WaitForSingleObject(state->Threads[i], INFINITE);
+        CloseHandle(state->Threads[i]);
+    }
+
+    DeleteCriticalSection(&state->Mutex);
+    delete1(state->Threads);
+    delete1(state->Info);
+    delete0(state);
+}
+//----------------------------------------------------------------------------
+void ThreadPool::Execute (int numItems, int grain, Task task, void* userData)
+{
+    if (numItems <= 0)
+    {
+        return;
+    }
+
+    PoolState* state = (PoolState*)mState;
+    EnterCriticalSection(&state->Mutex);
+    if (mNumThreads == 1 || mBusy)
+    {
+        LeaveCriticalSection(&state->Mutex);
+        task(0, numItems, 0, userData);
+        return;
+    }
+
+    mBusy = true;
+    mTask = task;
+    mUserData = userData;
+    mNumItems = numItems;
+    mGrain = (grain > 0 ? grain : (numItems + 4*mNumThreads - 1) /
+        (4*mNumThreads));
+    mNext = 0;
+    state->Active = mNumThreads - 1;
+    ++state->Generation;
+    WakeAllConditionVariable(&state->Wake);
+    LeaveCriticalSection(&state->Mutex);
+
+    RunChunks(0);
+
+    EnterCriticalSection(&state->Mutex);
+    while (state->Active > 0)
+    {
+        SleepConditionVariableCS(&state->Done, &state->Mutex, INFINITE);
+    }
+    mBusy = false;
+    LeaveCriticalSection(&state->Mutex);
+}
+//----------------------------------------------------------------------------
+void ThreadPool::WorkerLoop (int worker)
+{
+    PoolState* state = (PoolState*)mState;
+    unsigned int generation = 0;
+
+    for (;;)
+    {
+        EnterCriticalSection(&state->Mutex);
+        while (!state->Quit && state->Generation == generation)
+        {
+            SleepConditionVariableCS(&state->Wake, &state->Mutex, INFINITE);
+        }
+        if (state->Quit)
+        {
+            LeaveCriticalSection(&state->Mutex);
+            return;
+        }
+        generation = state->Generation;
+        LeaveCriticalSection(&state->Mutex);
+
+        RunChunks(worker);
+
+        EnterCriticalSection(&state->Mutex);
+        if (--state->Active == 0)
+        {
+            WakeConditionVariable(&state->Done);
+        }
+        LeaveCriticalSection(&state->Mutex);
+    }
+}
+//----------------------------------------------------------------------------
+bool ThreadPool::GetChunk (int& begin, int& end)
+{
+    PoolState* state = (PoolState*)mState;
+    EnterCriticalSection(&state->Mutex);
+    begin = mNext;
+    end = (mNumItems - begin > mGrain ? begin + mGrain : mNumItems);
+    mNext = end;
+    LeaveCriticalSection(&state->Mutex);
+    return begin < end;
+}
+//----------------------------------------------------------------------------
+int ThreadPool::GetNumProcessors ()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0 ?
+        (int)info.dwNumberOfProcessors : 1);
+}
+//----------------------------------------------------------------------------
+#elif defined(__LINUX__) || defined(__APPLE__)
+//----------------------------------------------------------------------------
+#include <unistd.h>
+//----------------------------------------------------------------------------
+namespace
+{
+    struct WorkerInfo
+    {
+        ThreadPool* Pool;
+        int Worker;
+    };
+
+    struct PoolState
+    {
+        pthread_mutex_t Mutex;
+        pthread_cond_t Wake, Done;
+        pthread_t* Threads;
+        WorkerInfo* Info;
+        unsigned int Generation;
+        int Active;
+        bool Quit;
+    };
+
+    void* PoolEntry (void* parameters)
+    {
+        WorkerInfo* info = (WorkerInfo*)parameters;
+        info->Pool->WorkerLoop(info->Worker);
+        return 0;
+    }
+}
+//----------------------------------------------------------------------------
+ThreadPool::ThreadPool (int numThreads)
+    :
+    mNumThreads(numThreads > 0 ? numThreads : GetNumProcessors()),
+    mTask(0),
+    mUserData(0),
+    mNumItems(0),
+    mGrain(1),
+    mNext(0),
+    mBusy(false)
+{
+    PoolState* state = new0 PoolState;
+    pthread_mutex_init(&state->Mutex, 0);
+    pthread_cond_init(&state->Wake, 0);
+    pthread_cond_init(&state->Done, 0);
+    state->Generation = 0;
+    state->Active = 0;
+    state->Quit = false;
+    state->Threads = 0;
+    state->Info = 0;
+    mState = state;
+
+    if (mNumThreads > 1)
+    {
+        state->Threads = new1<pthread_t>(mNumThreads - 1);
+        state->Info = new1<WorkerInfo>(mNumThreads - 1);
+        for (int i = 0; i < mNumThreads - 1; ++i)
+        {
+            state->Info[i].Pool = this;
+            state->Info[i].Worker = i + 1;
+            int result = pthread_create(&state->Threads[i], 0, PoolEntry,
+                &state->Info[i]);
+            assertion(result == 0, "Failed to create pool thread\n");
+            WM5_UNUSED(result);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+ThreadPool::~ThreadPool ()
+{
+    PoolState* state = (PoolState*)mState;
+
+    pthread_mutex_lock(&state->Mutex);
+    state->Quit = true;
+    pthread_cond_broadcast(&state->Wake);
+    pthread_mutex_unlock(&state->Mutex);
+
+    for (int i = 0; i < mNumThreads - 1; ++i)
+    {
+        pthread_join(state->Threads[i], 0);
+    }
+
+    pthread_cond_destroy(&state->Done);
+    pthread_cond_destroy(&state->Wake);
+    pthread_mutex_destroy(&state->Mutex);
+    delete1(state->Threads);
+    delete1(state->Info);
+    delete0(state);
+}
+//----------------------------------------------------------------------------
+void ThreadPool::Execute (int numItems, int grain, Task task, void* userData)
+{
+    if (numItems <= 0)
+    {
+        return;
+    }
+
+    PoolState* state = (PoolState*)mState;
+    pthread_mutex_lock(&state->Mutex);
+    if (mNumThreads == 1 || mBusy)
+    {
+        pthread_mutex_unlock(&state->Mutex);
+        task(0, numItems, 0, userData);
+        return;
+    }
+
+    mBusy = true;
+    mTask = task;
+    mUserData = userData;
+    mNumItems = numItems;
+    mGrain = (grain > 0 ? grain : (numItems + 4*mNumThreads - 1) /
+        (4*mNumThreads));
+    mNext = 0;
+    state->Active = mNumThreads - 1;
+    ++state->Generation;
+    pthread_cond_broadcast(&state->Wake);
+    pthread_mutex_unlock(&state->Mutex);
+
+    RunChunks(0);
+
+    pthread_mutex_lock(&state->Mutex);
+    while (state->Active > 0)
+    {
+        pthread_cond_wait(&state->Done, &state->Mutex);
+    }
+    mBusy = false;
+    pthread_mutex_unlock(&state->Mutex);
+}
+//----------------------------------------------------------------------------
+void ThreadPool::WorkerLoop (int worker)
+{
+    PoolState* state = (PoolState*)mState;
+    unsigned int generation = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&state->Mutex);
+        while (!state->Quit && state->Generation == generation)
+        {
+            pthread_cond_wait(&state->Wake, &state->Mutex);
+        }
+        if (state->Quit)
+        {
+            pthread_mutex_unlock(&state->Mutex);
+            return;
+        }
+        generation = state->Generation;
+        pthread_mutex_unlock(&state->Mutex);
+
+        RunChunks(worker);
+
+        pthread_mutex_lock(&state->Mutex);
+        if (--state->Active == 0)
+        {
+            pthread_cond_signal(&state->Done);
+        }
+        pthread_mutex_unlock(&state->Mutex);
+    }
+}
+//----------------------------------------------------------------------------
+bool ThreadPool::GetChunk (int& begin, int& end)
+{
+    PoolState* state = (PoolState*)mState;
+    pthread_mutex_lock(&state->Mutex);
+    begin = mNext;
+    end = (mNumItems - begin > mGrain ? begin + mGrain : mNumItems);
+    mNext = end;
+    pthread_mutex_unlock(&state->Mutex);
+    return begin < end;
+}
+//----------------------------------------------------------------------------
+int ThreadPool::GetNumProcessors ()
+{
+    long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (numProcessors > 0 ? (int)numProcessors : 1);
+}
+//----------------------------------------------------------------------------
+#else
+#error Other platforms not yet implemented.
+#endif
+//----------------------------------------------------------------------------
+int ThreadPool::GetNumThreads () const
+{
+    return mNumThreads;
+}
+//----------------------------------------------------------------------------
+void ThreadPool::ParallelFor (ThreadPool* pool, int numItems, int grain,
+    Task task, void* userData)
+{
+    if (pool)
+    {
+        pool->Execute(numItems, grain, task, userData);
+    }
+    else if (numItems > 0)
+    {
+        task(0, numItems, 0, userData);
+    }
+}
+//----------------------------------------------------------------------------
+int ThreadPool::GetNumWorkers (const ThreadPool* pool)
+{
+    return (pool ? pool->mNumThreads : 1);
+}
+//----------------------------------------------------------------------------
+void ThreadPool::RunChunks (int worker)
+{
+    int begin, end;
+    while (GetChunk(begin, end))
+    {
+        mTask(begin, end, worker, mUserData);
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5THREADPOOL_H
+#define WM5THREADPOOL_H
+
+#include "Wm5CoreLIB.h"
+
+namespace Wm5
+{
+
+// A fixed set of worker threads for data-parallel loops.  The index range
+// [0,numItems) is partitioned into chunks of 'grain' items, and the chunks
+// are handed out to the workers on demand.  The calling thread participates
+// as worker 0, so a pool with N threads creates N-1 system threads.  The
+// worker index passed to the task is in {0,...,GetNumThreads()-1} and may
+// be used to select per-thread scratch storage.
+//
+// Execute blocks until all chunks are processed.  A task must not call
+// Execute on the same pool; if it does, the nested call runs serially on
+// the calling thread.
+
+class WM5_CORE_ITEM ThreadPool
+{
+public:
+    // The task processes the items begin <= i < end.
+    typedef void (*Task)(int begin, int end, int worker, void* userData);
+
+    // Construction and destruction.  A 'numThreads' of zero selects the
+    // number of processors.  A pool with one thread runs all tasks on the
+    // calling thread.
+    ThreadPool (int numThreads = 0);
+    ~ThreadPool ();
+
+    // Member access.
+    int GetNumThreads () const;
+
+    // Execute the task on [0,numItems).  A 'grain' of zero selects chunks
+    // so that each thread receives a few of them.
+    void Execute (int numItems, int grain, Task task, void* userData);
+
+    // Convenience for classes that accept an optional pool.  When 'pool' is
+    // null, the task is called once on [0,numItems) with worker 0.
+    static void ParallelFor (ThreadPool* pool, int numItems, int grain,
+        Task task, void* userData);
+
+    // The number of threads to allocate per-thread storage for when the
+    // pool is optional.
+    static int GetNumWorkers (const ThreadPool* pool);
+
+    // The number of logical processors reported by the system.
+    static int GetNumProcessors ();
+
+public_internal:
+    // The loop executed by the system threads.
+    void WorkerLoop (int worker);
+
+private:
+    // Chunk distribution.  The platform-specific state is hidden behind a
+    // void* to avoid exposing system headers.
+    void RunChunks (int worker);
+    bool GetChunk (int& begin, int& end);
+
+    int mNumThreads;
+    void* mState;
+
+    // The current job.
+    Task mTask;
+    void* mUserData;
+    int mNumItems, mGrain, mNext;
+    bool mBusy;
+};
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "Wm5Endian.h"
 #include "Wm5Environment.h"
 #include "Wm5FileIO.h"
+#include "Wm5MappedFile.h"
 
 // Memory
 #include "Wm5Memory.h"
@@ -40,6 +41,7 @@
 #include "Wm5MutexType.h"
 #include "Wm5ScopedCS.h"
 #include "Wm5Thread.h"
+#include "Wm5ThreadPool.h"
 #include "Wm5ThreadType.h"
 
 // Time
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5GraphicsPCH.h"
 #include "Wm5ImageProcessing.h"
@@ -16,7 +16,9 @@ ImageProcessing::ImageProcessing (int numCols, int numRows, int numTargets)
     :
     mNumCols(numCols),
     mNumRows(numRows),
-    mNumTargets(numTargets)
+    mNumTargets(numTargets),
+    mCpuKernel(0),
+    mCpuUserData(0)
 {
     assertion(mNumCols > 1 && mNumRows > 0, "Invalid bound.\n");
     assertion(mNumTargets > 0, "Invalid number of targets.\n");
@@ -256,6 +258,120 @@ void ImageProcessing::ExecuteStep (Renderer* renderer, bool draw)
     renderer->Disable(mTargets[1]);
 }
 //----------------------------------------------------------------------------
+void ImageProcessing::SetCpuKernel (CpuKernel kernel, void* userData)
+{
+    mCpuKernel = kernel;
+    mCpuUserData = userData;
+}
+//----------------------------------------------------------------------------
+void ImageProcessing::InitializeCpu (ThreadPool* pool)
+{
+    assertion(mMainTexture != 0 && mBoundaryEffect != 0,
+        "The standard pipeline is required.\n");
+
+    CreateCpuBoundary();
+
+    // Copy the image to target 0 and set the boundary conditions.
+    memcpy(mTargets[0]->GetColorTexture(0)->GetData(0),
+        mMainTexture->GetData(0), mNumCols*mNumRows*sizeof(Float4));
+    ThreadPool::ParallelFor(pool, mNumRows, 0, BoundaryTask, this);
+}
+//----------------------------------------------------------------------------
+void ImageProcessing::ExecuteStepCpu (ThreadPool* pool)
+{
+    assertion(mCpuKernel != 0, "The CPU kernel must be set.\n");
+    assertion((int)mBoundaryRowStart.size() == mNumRows + 1,
+        "InitializeCpu must be called first.\n");
+
+    // Take a step using the kernel, and then set the boundary conditions.
+    ThreadPool::ParallelFor(pool, mNumRows, 0, KernelTask, this);
+    ThreadPool::ParallelFor(pool, mNumRows, 0, BoundaryTask, this);
+}
+//----------------------------------------------------------------------------
+void ImageProcessing::CreateCpuBoundary ()
+{
+    // The boundary effects have the mask or offset texture at sampler 0.
+    const PixelShader* pshader = mBoundaryEffect->GetPixelShader(0, 0);
+    bool dirichlet = (pshader->GetSamplerName(0) == "MaskSampler");
+    Texture2D* texture =
+        (Texture2D*)mBoundaryEffectInstance->GetPixelTexture(0, 0);
+    const Float4* data = (const Float4*)texture->GetData(0);
+    const Float4 one(1.0f, 1.0f, 1.0f, 1.0f);
+
+    mBoundaryPixels.clear();
+    mBoundaryRowStart.resize(mNumRows + 1);
+    for (int row = 0; row < mNumRows; ++row)
+    {
+        mBoundaryRowStart[row] = (int)mBoundaryPixels.size();
+        for (int col = 0; col < mNumCols; ++col)
+        {
+            BoundaryPixel pixel;
+            pixel.Target = Index(col, row);
+            const Float4& value = data[pixel.Target];
+            if (dirichlet)
+            {
+                // The state is multiplied by the mask.
+                if (value == one)
+                {
+                    continue;
+                }
+                pixel.Source = pixel.Target;
+                pixel.Scale = value;
+            }
+            else
+            {
+                // The state is copied from the pixel at the offset, which
+                // is in texture coordinates.
+                int dCol = (int)Mathf::Floor(value[0]/mColSpacing + 0.5f);
+                int dRow = (int)Mathf::Floor(value[1]/mRowSpacing + 0.5f);
+                if (dCol == 0 && dRow == 0)
+                {
+                    continue;
+                }
+                pixel.Source = Index(col + dCol, row + dRow);
+                pixel.Scale = one;
+            }
+            mBoundaryPixels.push_back(pixel);
+        }
+    }
+    mBoundaryRowStart[mNumRows] = (int)mBoundaryPixels.size();
+}
+//----------------------------------------------------------------------------
+void ImageProcessing::KernelTask (int begin, int end, int, void* userData)
+{
+    ImageProcessing* ip = (ImageProcessing*)userData;
+    const Float4* source =
+        (const Float4*)ip->mTargets[1]->GetColorTexture(0)->GetData(0);
+    Float4* target = (Float4*)ip->mTargets[0]->GetColorTexture(0)->GetData(0);
+    ip->mCpuKernel(ip, source, target, begin, end, ip->mCpuUserData);
+}
+//----------------------------------------------------------------------------
+void ImageProcessing::BoundaryTask (int begin, int end, int, void* userData)
+{
+    ImageProcessing* ip = (ImageProcessing*)userData;
+    const Float4* source =
+        (const Float4*)ip->mTargets[0]->GetColorTexture(0)->GetData(0);
+    Float4* target = (Float4*)ip->mTargets[1]->GetColorTexture(0)->GetData(0);
+
+    // Copy the rows, and then overwrite their boundary pixels.  The source
+    // pixels may be in other rows, but those are not modified here.
+    memcpy(target + begin*ip->mNumCols, source + begin*ip->mNumCols,
+        (end - begin)*ip->mNumCols*sizeof(Float4));
+
+    const std::vector<BoundaryPixel>& pixel = ip->mBoundaryPixels;
+    const int iMax = ip->mBoundaryRowStart[end];
+    for (int i = ip->mBoundaryRowStart[begin]; i < iMax; ++i)
+    {
+        const Float4& scale = pixel[i].Scale;
+        const Float4& state = source[pixel[i].Source];
+        Float4& result = target[pixel[i].Target];
+        result[0] = scale[0]*state[0];
+        result[1] = scale[1]*state[1];
+        result[2] = scale[2]*state[2];
+        result[3] = scale[3]*state[3];
+    }
+}
+//----------------------------------------------------------------------------
 void ImageProcessing::CreateVertexShader ()
 {
     // void v_ScreenShader
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5IMAGEPROCESSING_H
 #define WM5IMAGEPROCESSING_H
@@ -15,6 +15,7 @@
 #include "Wm5Renderer.h"
 #include "Wm5RenderTarget.h"
 #include "Wm5TriMesh.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -55,6 +56,29 @@ public:
     void Initialize (Renderer* renderer, bool openglHack = false);
     void ExecuteStep (Renderer* renderer, bool draw);
 
+    // Execution of the standard image processing pipeline on the CPU, for
+    // hosts without a GPU.  No renderer is required.  The images live in
+    // the system memory of the color textures of the render targets.  A
+    // step applies the kernel to target 1 and writes target 0, and then it
+    // applies the boundary effect to target 0 and writes target 1, just as
+    // ExecuteStep does.  After InitializeCpu or ExecuteStepCpu, the state
+    // is GetTarget(1)->GetColorTexture(0)->GetData(0).
+    //
+    // The kernel replaces the main pixel shader.  It must compute the rows
+    // rowMin <= row < rowMax of 'target' from 'source'; the boundary pixels
+    // may have any values, because the boundary effect overwrites them.
+    // When 'pool' is not null, the kernel is called concurrently for
+    // disjoint row ranges.  The boundary effect is evaluated from the mask
+    // texture of the Dirichlet effect or the offset texture of the Neumann
+    // effect.
+    typedef void (*CpuKernel)(const ImageProcessing* ip,
+        const Float4* source, Float4* target, int rowMin, int rowMax,
+        void* userData);
+
+    void SetCpuKernel (CpuKernel kernel, void* userData);
+    void InitializeCpu (ThreadPool* pool = 0);
+    void ExecuteStepCpu (ThreadPool* pool = 0);
+
 protected:
     void CreateVertexShader ();
 
@@ -78,6 +102,26 @@ protected:
     VisualEffectPtr mDrawInput;
     VisualEffectInstancePtr mDrawInputInstance;
 
+    // Support for the CPU pipeline.  The boundary effect sets pixel Target
+    // to the componentwise product of Scale and the state at pixel Source.
+    // The pixels of row r are mBoundaryPixels[mBoundaryRowStart[r]] through
+    // mBoundaryPixels[mBoundaryRowStart[r+1]-1].
+    class BoundaryPixel
+    {
+    public:
+        int Target, Source;
+        Float4 Scale;
+    };
+
+    void CreateCpuBoundary ();
+    static void KernelTask (int begin, int end, int, void* userData);
+    static void BoundaryTask (int begin, int end, int, void* userData);
+
+    CpuKernel mCpuKernel;
+    void* mCpuUserData;
+    std::vector<BoundaryPixel> mBoundaryPixels;
+    std::vector<int> mBoundaryRowStart;
+
     static int msDx9VRegisters[1];
     static int msOglVRegisters[1];
     static int* msVRegisters[Shader::MAX_PROFILES];
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5GraphicsPCH.h"
 #include "Wm5ImageProcessing2.h"
@@ -281,6 +281,52 @@ void ImageProcessing2::CreateDrawEffect (VisualEffect*& effect,
     CreateEffect(pshader, effect, instance);
 }
 //----------------------------------------------------------------------------
+void ImageProcessing2::CpuGaussianBlur (const ImageProcessing* ip,
+    const Float4* source, Float4* target, int rowMin, int rowMax,
+    void* userData)
+{
+    const float* weight = (const float*)userData;
+    const float wx = weight[0], wy = weight[1], w = weight[2];
+    const int numCols = ip->GetNumCols();
+    const int numRowsM1 = ip->GetNumRows() - 1;
+    const int iMax = 4*(numCols - 1);
+
+    for (int row = rowMin; row < rowMax; ++row)
+    {
+        const Float4* srcZZ = source + numCols*row;
+        Float4* trg = target + numCols*row;
+        if (row == 0 || row == numRowsM1)
+        {
+            // The boundary effect overwrites these pixels.
+            memcpy(trg, srcZZ, numCols*sizeof(Float4));
+            continue;
+        }
+
+        // The channels of a pixel are computed before any is stored, so
+        // the compiler may process them as one SIMD vector.
+        const float* c = (const float*)srcZZ;
+        const float* m = (const float*)(srcZZ - numCols);
+        const float* p = (const float*)(srcZZ + numCols);
+        float* t = (float*)trg;
+        for (int i = 4; i < iMax; i += 4)
+        {
+            float r0 = wx*(c[i+4] + c[i-4]) + wy*(p[i] + m[i]) + w*c[i];
+            float r1 = wx*(c[i+5] + c[i-3]) + wy*(p[i+1] + m[i+1]) +
+                w*c[i+1];
+            float r2 = wx*(c[i+6] + c[i-2]) + wy*(p[i+2] + m[i+2]) +
+                w*c[i+2];
+            float r3 = wx*(c[i+7] + c[i-1]) + wy*(p[i+3] + m[i+3]) +
+                w*c[i+3];
+            t[i] = r0;
+            t[i+1] = r1;
+            t[i+2] = r2;
+            t[i+3] = r3;
+        }
+        trg[0] = srcZZ[0];
+        trg[numCols-1] = srcZZ[numCols-1];
+    }
+}
+//----------------------------------------------------------------------------
 int ImageProcessing2::msAllDirichletPTextureUnits[2] = { 0, 1 };
 int* ImageProcessing2::msDirichletPTextureUnits[Shader::MAX_PROFILES] =
 {
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5IMAGEPROCESSING2_H
 #define WM5IMAGEPROCESSING2_H
@@ -54,6 +54,14 @@ public:
     void CreateDrawEffect (VisualEffect*& effect,
         VisualEffectInstance*& instance);
 
+    // The CPU kernel (see SetCpuKernel) for the explicit step of the heat
+    // equation of the GpuGaussianBlur2 sample.  'userData' points to the
+    // weights (wx,wy,w) of its Weight constant.  The result is
+    // wx*(S(x+1,y)+S(x-1,y)) + wy*(S(x,y+1)+S(x,y-1)) + w*S(x,y).
+    static void CpuGaussianBlur (const ImageProcessing* ip,
+        const Float4* source, Float4* target, int rowMin, int rowMax,
+        void* userData);
+
 private:
     void CreateVertexShader ();
 
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5GraphicsPCH.h"
 #include "Wm5ImageProcessing3.h"
@@ -489,6 +489,77 @@ void ImageProcessing3::CreateDrawEffect (VisualEffect*& effect,
     instance->SetPixelTexture(0, "MaskSampler", maskTexture);
 }
 //----------------------------------------------------------------------------
+void ImageProcessing3::CpuGaussianBlur (const ImageProcessing* ip,
+    const Float4* source, Float4* target, int rowMin, int rowMax,
+    void* userData)
+{
+    const ImageProcessing3* ip3 = (const ImageProcessing3*)ip;
+    const float* weight = (const float*)userData;
+    const float wx = weight[0], wy = weight[1], wz = weight[2];
+    const float w = weight[3];
+    const int numCols = ip3->GetNumCols();
+    const int bound0 = ip3->mBound0, bound1 = ip3->mBound1;
+    const int iMax = 4*(bound0 - 1);
+
+    for (int row = rowMin; row < rowMax; ++row)
+    {
+        // The row holds the voxels (x,y,z) for 0 <= x < bound0 of the
+        // slices z in a row of tiles.
+        const Float4* srcRow = source + numCols*row;
+        Float4* trgRow = target + numCols*row;
+        const int y = row % bound1;
+        if (y == 0 || y == ip3->mBound1M1)
+        {
+            // The boundary effect overwrites these voxels.
+            memcpy(trgRow, srcRow, numCols*sizeof(Float4));
+            continue;
+        }
+
+        const int zMin = (row/bound1)*ip3->mFactor0;
+        for (int tile = 0; tile < ip3->mFactor0; ++tile)
+        {
+            const Float4* srcZZZ = srcRow + tile*bound0;
+            Float4* trg = trgRow + tile*bound0;
+            const int z = zMin + tile;
+            if (z == 0 || z == ip3->mBound2M1)
+            {
+                memcpy(trg, srcZZZ, bound0*sizeof(Float4));
+                continue;
+            }
+
+            int u, v;
+            ip3->Map3Dto2D(0, y, z + 1, u, v);
+            const float* zp = (const float*)(source + u + numCols*v);
+            ip3->Map3Dto2D(0, y, z - 1, u, v);
+            const float* zm = (const float*)(source + u + numCols*v);
+
+            // The channels of a voxel are computed before any is stored, so
+            // the compiler may process them as one SIMD vector.
+            const float* c = (const float*)srcZZZ;
+            const float* ym = (const float*)(srcZZZ - numCols);
+            const float* yp = (const float*)(srcZZZ + numCols);
+            float* t = (float*)trg;
+            for (int i = 4; i < iMax; i += 4)
+            {
+                float r0 = wx*(c[i+4] + c[i-4]) + wy*(yp[i] + ym[i]) +
+                    wz*(zp[i] + zm[i]) + w*c[i];
+                float r1 = wx*(c[i+5] + c[i-3]) + wy*(yp[i+1] + ym[i+1]) +
+                    wz*(zp[i+1] + zm[i+1]) + w*c[i+1];
+                float r2 = wx*(c[i+6] + c[i-2]) + wy*(yp[i+2] + ym[i+2]) +
+                    wz*(zp[i+2] + zm[i+2]) + w*c[i+2];
+                float r3 = wx*(c[i+7] + c[i-1]) + wy*(yp[i+3] + ym[i+3]) +
+                    wz*(zp[i+3] + zm[i+3]) + w*c[i+3];
+                t[i] = r0;
+                t[i+1] = r1;
+                t[i+2] = r2;
+                t[i+3] = r3;
+            }
+            trg[0] = srcZZZ[0];
+            trg[bound0-1] = srcZZZ[bound0-1];
+        }
+    }
+}
+//----------------------------------------------------------------------------
 int ImageProcessing3::msAllDirichletPTextureUnits[2] = { 0, 1 };
 int* ImageProcessing3::msDirichletPTextureUnits[Shader::MAX_PROFILES] =
 {
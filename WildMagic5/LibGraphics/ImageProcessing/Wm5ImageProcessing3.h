@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5IMAGEPROCESSING3_H
 #define WM5IMAGEPROCESSING3_H
@@ -90,6 +90,16 @@ public:
     void CreateDrawEffect (VisualEffect*& effect,
         VisualEffectInstance*& instance, const Float4& boundaryColor);
 
+    // The CPU kernel (see SetCpuKernel) for the explicit step of the heat
+    // equation of the GpuGaussianBlur3 sample.  'userData' points to the
+    // weights (wx,wy,wz,w) of its Weight constant.  The result is
+    // wx*(S(x+1,y,z)+S(x-1,y,z)) + wy*(S(x,y+1,z)+S(x,y-1,z)) +
+    // wz*(S(x,y,z+1)+S(x,y,z-1)) + w*S(x,y,z).  The z-neighbors are found
+    // from the tiling, so no offset texture is needed.
+    static void CpuGaussianBlur (const ImageProcessing* ip,
+        const Float4* source, Float4* target, int rowMin, int rowMax,
+        void* userData);
+
 private:
     int mBound0, mBound1, mBound2, mBound0M1, mBound1M1, mBound2M1;
     int mFactor0, mFactor1;
@@ -4,10 +4,12 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2010/04/30)
+// File Version: 5.0.4 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5Binary2D.h"
+#include "Wm5ComponentLabeler.h"
+#include "Wm5DistanceTransform.h"
 using namespace Wm5;
 
 //----------------------------------------------------------------------------
@@ -152,162 +154,21 @@ void Binary2D::ExtractBoundary (int x0, int y0, ImageInt2D& image,
 //----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
-// Connected component labeling.  The algorithm is simply a nonrecursive
-// depth-first search of the graph.
+// Connected component labeling.  The runs of 1-valued pixels are joined
+// with union-find by ComponentLabeler.
 //----------------------------------------------------------------------------
 void Binary2D::GetComponents8 (ImageInt2D& image, bool storeZeros,
-    std::vector<IndexArray>& components)
+    std::vector<IndexArray>& components, ThreadPool* pool)
 {
-    // Incremental 1D offsets for 8-connected neighbors.  Store +1 and -1
-    // first to be cache friendly during the depth-first search.
-    const int bound0 = image.GetBound(0);
-    const int delta[8] =
-    {
-        +1,
-        -1,
-        -1 - bound0,
-           - bound0,
-        +1 - bound0,
-        -1 + bound0,
-           + bound0,
-        +1 + bound0
-    };
-
-    GetComponents(8, delta, storeZeros, image, components);
+    ComponentLabeler::Execute(image.GetBound(0), image.GetBound(1), 1,
+        (int*)image.GetData(), 1, -1, storeZeros, components, pool);
 }
 //----------------------------------------------------------------------------
 void Binary2D::GetComponents4 (ImageInt2D& image, bool storeZeros,
-    std::vector<IndexArray>& components)
+    std::vector<IndexArray>& components, ThreadPool* pool)
 {
-    // Incremental 1D offsets for 8-connected neighbors.  Store +1 and -1
-    // first to be cache friendly during the depth-first search.
-    const int bound0 = image.GetBound(0);
-    const int delta[4] =
-    {
-        +1,
-        -1,
-        -bound0,
-        bound0
-    };
-
-    GetComponents(4, delta, storeZeros, image, components);
-}
-//----------------------------------------------------------------------------
-void Binary2D::GetComponents (const int numNeighbors, const int delta[],
-    bool storeZeros, ImageInt2D& image, std::vector<IndexArray>& components)
-{
-    const int numPixels = image.GetQuantity();
-    int* numElements = new1<int>(numPixels);
-    int i, numComponents = 0, label = 2;
-    int* vstack = new1<int>(numPixels);
-    for (i = 0; i < numPixels; ++i)
-    {
-        if (image[i] == 1)
-        {
-            int top = -1;
-            vstack[++top] = i;
-
-            int& count = numElements[numComponents + 1];
-            count = 0;
-            while (top >= 0)
-            {
-                int v = vstack[top];
-                image[v] = -1;
-                int j;
-                for (j = 0; j < numNeighbors; ++j)
-                {
-                    int adj = v + delta[j];
-                    if (image[adj] == 1)
-                    {
-                        vstack[++top] = adj;
-                        break;
-                    }
-                }
-                if (j == numNeighbors)
-                {
-                    image[v] = label;
-                    ++count;
-                    --top;
-                }
-            }
-
-            ++numComponents;
-            ++label;
-        }
-    }
-    delete1(vstack);
-
-    if (storeZeros)
-    {
-        if (numComponents > 0)
-        {
-            int numZeros = numPixels;
-            components.resize(numComponents + 1);
-            for (i = 1; i <= numComponents; ++i)
-            {
-                int count = numElements[i];
-                components[i].resize(count);
-                numZeros -= count;
-                numElements[i] = 0;
-            }
-            components[0].resize(numZeros);
-            numZeros = 0;
-            int* zeros = &components[0][0];
-
-            for (i = 0; i < numPixels; ++i)
-            {
-                int value = image[i];
-                if (value != 0)
-                {
-                    // Labels started at 2 to support the depth-first search,
-                    // so they need to be decremented for the correct labels.
-                    image[i] = --value;
-                    components[value][numElements[value]] = i;
-                    ++numElements[value];
-                }
-                else
-                {
-                    zeros[numZeros++] = i;
-                }
-            }
-        }
-        else
-        {
-            components.resize(1);
-            components[0].resize(numPixels);
-            int* zeros = &components[0][0];
-            for (i = 0; i < numPixels; ++i)
-            {
-                zeros[i] = i;
-            }
-        }
-    }
-    else
-    {
-        if (numComponents > 0)
-        {
-            components.resize(numComponents + 1);
-            for (i = 1; i <= numComponents; ++i)
-            {
-                components[i].resize(numElements[i]);
-                numElements[i] = 0;
-            }
-
-            for (i = 0; i < numPixels; ++i)
-            {
-                int value = image[i];
-                if (value != 0)
-                {
-                    // Labels started at 2 to support the depth-first search,
-                    // so they need to be decremented for the correct labels.
-                    image[i] = --value;
-                    components[value][numElements[value]] = i;
-                    ++numElements[value];
-                }
-            }
-        }
-    }
-    delete1(numElements);
+    ComponentLabeler::Execute(image.GetBound(0), image.GetBound(1), 1,
+        (int*)image.GetData(), 0, -1, storeZeros, components, pool);
 }
 //----------------------------------------------------------------------------
 
@@ -358,278 +219,34 @@ void Binary2D::GetL1Distance (ImageInt2D& image, int& maxDistance)
 //----------------------------------------------------------------------------
 // L2 Distance Transform (Euclidean Distance Transform)
 //
-// This program calculates the Euclidean distance transform of a binary
-// input image.  The adaptive algorithm is guaranteed to give exact
-// distances for all distances < 100.  Algorithm sent to me by John Gauch.
-//
-// From John Gauch at University of Kansas:
-// The basic idea is similar to a EDT described recently in PAMI by Laymarie
-// from McGill.  By keeping the dx and dy offset to the nearest edge (feature)
-// point in the image, we can search to see which dx dy is closest to a given
-// point by examining a set of neighbors.  The Laymarie method (and Borgfors)
-// look at a fixed 3x3 or 5x5 neighborhood and call it a day.  What we did was
-// calculate (painfully) what neighborhoods you need to look at to guarentee
-// that the exact distance is obtained.  Thus, you will see in the code, that
-// we L2Check the current distance and depending on what we have so far, we
-// extend the search region.  Since our algorithm for L2Checking the exactness
-// of each neighborhood is on the order N^4, we have only gone to N=100.  In
-// theory, you could make this large enough to get all distances exact.  We
-// have implemented the algorithm to get all distances < 100 to be exact. 
+// The squared distances are computed exactly by the separable algorithm of
+// DistanceTransform, first along the rows and then along the columns.
 //----------------------------------------------------------------------------
 void Binary2D::GetL2Distance (const ImageInt2D& image, double& maxDistance,
-    ImageDouble2D& transform)
+    ImageDouble2D& transform, ThreadPool* pool)
 {
-    const int bound0 = image.GetBound(0);
-    const int bound1 = image.GetBound(1);
-    const int bound0m1 = bound0 - 1;
-    const int bound1m1 = bound1 - 1;
-    int x, y, distance;
-
-    // Create and initialize intermediate images.
-    ImageInt2D xNear(bound0, bound1);
-    ImageInt2D yNear(bound0, bound1);
-    ImageInt2D dist(bound0, bound1);
-    for (y = 0; y < bound1; ++y)
-    {
-        for (x = 0; x < bound0; ++x)
-        {
-            if (image(x, y) != 0)
-            {
-                xNear(x, y) = 0;
-                yNear(x, y) = 0;
-                dist(x, y) = INT_MAX;
-            }
-            else
-            {
-                xNear(x, y) = x;
-                yNear(x, y) = y;
-                dist(x, y) = 0;
-            }
-        }
-    }
-
-    const int K1 = 1;
-    const int K2 = 169;   // 13^2
-    const int K3 = 961;   // 31^2
-    const int K4 = 2401;  // 49^2
-    const int K5 = 5184;  // 72^2
-
-    // Pass in the ++ direction.
-    for (y = 0; y < bound1; ++y)
-    {
-        for (x = 0; x < bound0; ++x)
-        {
-            distance = dist(x, y);
-            if (distance > K1)
-            { 
-                L2Check(x, y, -1,  0, xNear, yNear, dist); 
-                L2Check(x, y, -1, -1, xNear, yNear, dist); 
-                L2Check(x, y,  0, -1, xNear, yNear, dist); 
-            }
-            if (distance > K2)
-            { 
-                L2Check(x, y, -2, -1, xNear, yNear, dist); 
-                L2Check(x, y, -1, -2, xNear, yNear, dist); 
-            }
-            if (distance > K3)
-            { 
-                L2Check(x, y, -3, -1, xNear, yNear, dist); 
-                L2Check(x, y, -3, -2, xNear, yNear, dist); 
-                L2Check(x, y, -2, -3, xNear, yNear, dist); 
-                L2Check(x, y, -1, -3, xNear, yNear, dist); 
-            }
-            if (distance > K4)
-            { 
-                L2Check(x, y, -4, -1, xNear, yNear, dist); 
-                L2Check(x, y, -4, -3, xNear, yNear, dist); 
-                L2Check(x, y, -3, -4, xNear, yNear, dist); 
-                L2Check(x, y, -1, -4, xNear, yNear, dist); 
-            }
-            if (distance > K5)
-            { 
-                L2Check(x, y, -5, -1, xNear, yNear, dist); 
-                L2Check(x, y, -5, -2, xNear, yNear, dist); 
-                L2Check(x, y, -5, -3, xNear, yNear, dist); 
-                L2Check(x, y, -5, -4, xNear, yNear, dist);
-                L2Check(x, y, -4, -5, xNear, yNear, dist); 
-                L2Check(x, y, -2, -5, xNear, yNear, dist); 
-                L2Check(x, y, -3, -5, xNear, yNear, dist); 
-                L2Check(x, y, -1, -5, xNear, yNear, dist); 
-            }
-        }
-    }
-
-    // Pass in -- direction.
-    for (y = bound1m1; y >= 0; --y)
-    {
-        for (x = bound0m1; x >= 0; --x)
-        {
-            distance = dist(x, y);
-            if (distance > K1)
-            { 
-                L2Check(x, y, 1, 0, xNear, yNear, dist); 
-                L2Check(x, y, 1, 1, xNear, yNear, dist); 
-                L2Check(x, y, 0, 1, xNear, yNear, dist); 
-            }
-            if (distance > K2)
-            { 
-                L2Check(x, y, 2, 1, xNear, yNear, dist); 
-                L2Check(x, y, 1, 2, xNear, yNear, dist); 
-            }
-            if (distance > K3)
-            { 
-                L2Check(x, y, 3, 1, xNear, yNear, dist); 
-                L2Check(x, y, 3, 2, xNear, yNear, dist); 
-                L2Check(x, y, 2, 3, xNear, yNear, dist); 
-                L2Check(x, y, 1, 3, xNear, yNear, dist); 
-            }
-            if (distance > K4)
-            { 
-                L2Check(x, y, 4, 1, xNear, yNear, dist); 
-                L2Check(x, y, 4, 3, xNear, yNear, dist); 
-                L2Check(x, y, 3, 4, xNear, yNear, dist); 
-                L2Check(x, y, 1, 4, xNear, yNear, dist); 
-            }
-            if (distance > K5)
-            { 
-                L2Check(x, y, 5, 1, xNear, yNear, dist); 
-                L2Check(x, y, 5, 2, xNear, yNear, dist); 
-                L2Check(x, y, 5, 3, xNear, yNear, dist); 
-                L2Check(x, y, 5, 4, xNear, yNear, dist);
-                L2Check(x, y, 4, 5, xNear, yNear, dist); 
-                L2Check(x, y, 2, 5, xNear, yNear, dist); 
-                L2Check(x, y, 3, 5, xNear, yNear, dist); 
-                L2Check(x, y, 1, 5, xNear, yNear, dist); 
-            }
-        }
-    }
-
-    // Pass in the +- direction.
-    for (y = bound1m1; y >= 0; --y)
-    {
-        for (x = 0; x < bound0; ++x)
-        {
-            distance = dist(x, y);
-            if (distance > K1)
-            { 
-                L2Check(x, y, -1, 0, xNear, yNear, dist); 
-                L2Check(x, y, -1, 1, xNear, yNear, dist); 
-                L2Check(x, y,  0, 1, xNear, yNear, dist); 
-            }
-            if (distance > K2)
-            { 
-                L2Check(x, y, -2, 1, xNear, yNear, dist); 
-                L2Check(x, y, -1, 2, xNear, yNear, dist); 
-            }
-            if (distance > K3)
-            { 
-                L2Check(x, y, -3, 1, xNear, yNear, dist); 
-                L2Check(x, y, -3, 2, xNear, yNear, dist); 
-                L2Check(x, y, -2, 3, xNear, yNear, dist); 
-                L2Check(x, y, -1, 3, xNear, yNear, dist); 
-            }
-            if (distance > K4)
-            { 
-                L2Check(x, y, -4, 1, xNear, yNear, dist); 
-                L2Check(x, y, -4, 3, xNear, yNear, dist); 
-                L2Check(x, y, -3, 4, xNear, yNear, dist); 
-                L2Check(x, y, -1, 4, xNear, yNear, dist); 
-            }
-            if (distance > K5)
-            { 
-                L2Check(x, y, -5, 1, xNear, yNear, dist); 
-                L2Check(x, y, -5, 2, xNear, yNear, dist); 
-                L2Check(x, y, -5, 3, xNear, yNear, dist); 
-                L2Check(x, y, -5, 4, xNear, yNear, dist);
-                L2Check(x, y, -4, 5, xNear, yNear, dist); 
-                L2Check(x, y, -2, 5, xNear, yNear, dist); 
-                L2Check(x, y, -3, 5, xNear, yNear, dist); 
-                L2Check(x, y, -1, 5, xNear, yNear, dist); 
-            }
-        }
-    }
-
-    // Pass in the -+ direction.
-    for (y = 0; y < bound1; ++y)
-    {
-        for (x = bound0m1; x >= 0; --x)
-        {
-            distance = dist(x, y);
-            if (distance > K1)
-            { 
-                L2Check(x, y, 1,  0, xNear, yNear, dist); 
-                L2Check(x, y, 1, -1, xNear, yNear, dist); 
-                L2Check(x, y, 0, -1, xNear, yNear, dist); 
-            }
-            if (distance > K2)
-            { 
-                L2Check(x, y, 2, -1, xNear, yNear, dist); 
-                L2Check(x, y, 1, -2, xNear, yNear, dist); 
-            }
-            if (distance > K3)
-            { 
-                L2Check(x, y, 3, -1, xNear, yNear, dist); 
-                L2Check(x, y, 3, -2, xNear, yNear, dist); 
-                L2Check(x, y, 2, -3, xNear, yNear, dist); 
-                L2Check(x, y, 1, -3, xNear, yNear, dist); 
-            }
-            if (distance > K4)
-            { 
-                L2Check(x, y, 4, -1, xNear, yNear, dist); 
-                L2Check(x, y, 4, -3, xNear, yNear, dist); 
-                L2Check(x, y, 3, -4, xNear, yNear, dist); 
-                L2Check(x, y, 1, -4, xNear, yNear, dist); 
-            }
-            if (distance > K5)
-            { 
-                L2Check(x, y, 5, -1, xNear, yNear, dist); 
-                L2Check(x, y, 5, -2, xNear, yNear, dist); 
-                L2Check(x, y, 5, -3, xNear, yNear, dist); 
-                L2Check(x, y, 5, -4, xNear, yNear, dist);
-                L2Check(x, y, 4, -5, xNear, yNear, dist); 
-                L2Check(x, y, 2, -5, xNear, yNear, dist); 
-                L2Check(x, y, 3, -5, xNear, yNear, dist); 
-                L2Check(x, y, 1, -5, xNear, yNear, dist); 
-            }
-        }
-    }
+    const int numPixels = image.GetQuantity();
+    ImageInt2D sqrDistance(image.GetBound(0), image.GetBound(1));
+    GetSqrL2Distance(image, sqrDistance, 0, pool);
 
     maxDistance = 0.0;
-    for (y = 0; y < bound1; ++y)
+    for (int i = 0; i < numPixels; ++i)
     {
-        for (x = 0; x < bound0; ++x)
+        double distance = sqrt((double)sqrDistance[i]);
+        if (distance > maxDistance)
         {
-            double distance = sqrt((double)dist(x, y));
-            if (distance > maxDistance)
-            {
-                maxDistance = distance;
-            }
-            transform(x, y) = distance;
+            maxDistance = distance;
         }
+        transform[i] = distance;
     }
 }
 //----------------------------------------------------------------------------
-void Binary2D::L2Check (int x, int y, int dx, int dy, ImageInt2D& xNear,
-    ImageInt2D& yNear, ImageInt2D& dist)
+void Binary2D::GetSqrL2Distance (const ImageInt2D& image,
+    ImageInt2D& sqrDistance, ImageInt2D* nearest, ThreadPool* pool)
 {
-    const int bound0 = dist.GetBound(0);
-    const int bound1 = dist.GetBound(1);
-    int xp = x + dx, yp = y + dy;
-    if (0 <= xp && xp < bound0 && 0 <= yp && yp < bound1)
-    {
-        if (dist(xp, yp) < dist(x, y))
-        {
-            int dx0 = xNear(xp, yp) - x;
-            int dy0 = yNear(xp, yp) - y;
-            int newDist = dx0*dx0 + dy0*dy0;
-            if (newDist < dist(x, y))
-            {
-                xNear(x, y) = xNear(xp, yp);
-                yNear(x, y) = yNear(xp, yp);
-                dist(x, y) = newDist;
-            }
-        }
-    }
+    DistanceTransform::Execute(image.GetBound(0), image.GetBound(1), 1,
+        (const int*)image.GetData(), (int*)sqrDistance.GetData(),
+        (nearest ? (int*)nearest->GetData() : 0), pool);
 }
 //----------------------------------------------------------------------------
 
@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.3 (2010/10/01)
+// File Version: 5.0.5 (2026/10/19)
 
 #ifndef WM5BINARY2D_H
 #define WM5BINARY2D_H
 
 #include "Wm5ImagicsLIB.h"
 #include "Wm5Images.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -31,6 +32,11 @@ public:
     // corresponds to coordinates (x,y) = (i % b0, i / b0).
     typedef std::vector<int> IndexArray;
 
+    // The component labeling joins runs of foreground pixels by union-find
+    // (see ComponentLabeler).  The labels are numbered in the order of the
+    // first pixel of each component.  If 'pool' is not null, the rows are
+    // labeled concurrently in tiles; the caller retains ownership.
+
     // Extract boundaries from 1-valued blobs.  The blob interiors are
     // 4-connected and the blob boundaries are 8-connected.  The output is
     // an array of boundaries, each boundary containing a list of pixels
@@ -47,7 +53,7 @@ public:
     // construction of components[0] is time consuming.  The array
     // components[i], i >= 1, contains the indices for the i-th component.
     static void GetComponents8 (ImageInt2D& image, bool storeZeros,
-        std::vector<IndexArray>& components);
+        std::vector<IndexArray>& components, ThreadPool* pool = 0);
 
     // Compute the 4-connected components of a binary image.  The input
     // image is modified to avoid the cost of making a copy.  On output,
@@ -57,7 +63,7 @@ public:
     // construction of components[0] is time consuming.  The array
     // components[i], i >= 1, contains the indices for the i-th component.
     static void GetComponents4 (ImageInt2D& image, bool storeZeros,
-        std::vector<IndexArray>& components);
+        std::vector<IndexArray>& components, ThreadPool* pool = 0);
 
     // Compute the L1 distance transform.  Given a pixel (x,y), the neighbors
     // (x+1,y), (x-1,y), (x,y+1), and (x,y-1) are 1 unit of distance from
@@ -67,12 +73,22 @@ public:
     static void GetL1Distance (ImageInt2D& image, int& maxDistance);
 
     // Compute the L2 distance transform (Euclidean distance transform).  The
-    // distances are exact as long as they are smaller than 100 (see the
-    // comments in the source code).  The 'transform' should be the same
-    // dimensions as 'image' and its values are all set in this function, so
-    // it does not matter what they are on input.
+    // value at a pixel is the distance to the nearest 0-valued pixel, and
+    // the distances are exact (see DistanceTransform).  The 'transform'
+    // should be the same dimensions as 'image' and its values are all set
+    // in this function, so it does not matter what they are on input.  If
+    // 'pool' is not null, the rows and columns are processed concurrently;
+    // the caller retains ownership.
     static void GetL2Distance (const ImageInt2D& image, double& maxDistance,
-        ImageDouble2D& transform);
+        ImageDouble2D& transform, ThreadPool* pool = 0);
+
+    // Compute the squared L2 distance transform.  The 'sqrDistance' image
+    // should be the same dimensions as 'image'.  If 'nearest' is not null,
+    // it must also have those dimensions, and on output its value at a
+    // pixel is the index of a nearest 0-valued pixel.
+    static void GetSqrL2Distance (const ImageInt2D& image,
+        ImageInt2D& sqrDistance, ImageInt2D* nearest = 0,
+        ThreadPool* pool = 0);
 
     // Compute a skeleton of the image.  Pixels are trimmed from outside to
     // inside using L1 distance.  Connectivity and cycles of the original
@@ -86,15 +102,6 @@ protected:
     static void ExtractBoundary (int x0, int y0, ImageInt2D& image,
         IndexArray& boundary);
 
-    // The heart of the component labeling.
-    static void GetComponents (const int numNeighbors, const int delta[],
-        bool storeZeros, ImageInt2D& image,
-        std::vector<IndexArray>& components);
-
-    // Helper for computing the L2 distance transform.
-    static void L2Check (int x, int y, int dx, int dy, ImageInt2D& xNear,
-        ImageInt2D& yNear, ImageInt2D& dist);
-
     // Helpers for skeletonization.
     typedef bool (*InteriorFunction)(ImageInt2D&,int,int);
     static bool Interior4 (ImageInt2D& image, int x, int y);
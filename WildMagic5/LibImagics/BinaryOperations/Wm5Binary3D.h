@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.3 (2010/10/01)
+// File Version: 5.0.5 (2026/10/19)
 
 #ifndef WM5BINARY3D_H
 #define WM5BINARY3D_H
 
 #include "Wm5ImagicsLIB.h"
 #include "Wm5Images.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -29,6 +30,11 @@ public:
     //   (x,y,z) = (i % b0, (i / b0) % b1, (i / b0) / b1)
     typedef std::vector<int> IndexArray;
 
+    // The component labeling joins runs of foreground voxels by union-find
+    // (see ComponentLabeler).  The labels are numbered in the order of the
+    // first voxel of each component.  If 'pool' is not null, the slices
+    // are labeled concurrently in tiles; the caller retains ownership.
+
     // Compute the 26-connected components of a binary image.  The input
     // image is modified to avoid the cost of making a copy.  On output,
     // the image values are the labels for the components.  If storeZeros is
@@ -37,7 +43,7 @@ public:
     // construction of components[0] is time consuming.  The array
     // components[i], i >= 1, contains the indices for the i-th component.
     static void GetComponents26 (ImageInt3D& image, bool storeZeros,
-        std::vector<IndexArray>& components);
+        std::vector<IndexArray>& components, ThreadPool* pool = 0);
 
     // Compute the 18-connected components of a binary image.  The input
     // image is modified to avoid the cost of making a copy.  On output,
@@ -47,7 +53,7 @@ public:
     // construction of components[0] is time consuming.  The array
     // components[i], i >= 1, contains the indices for the i-th component.
     static void GetComponents18 (ImageInt3D& image, bool storeZeros,
-        std::vector<IndexArray>& components);
+        std::vector<IndexArray>& components, ThreadPool* pool = 0);
 
     // Compute the 6-connected components of a binary image.  The input
     // image is modified to avoid the cost of making a copy.  On output,
@@ -57,13 +63,25 @@ public:
     // construction of components[0] is time consuming.  The array
     // components[i], i >= 1, contains the indices for the i-th component.
     static void GetComponents6 (ImageInt3D& image, bool storeZeros,
-        std::vector<IndexArray>& components);
+        std::vector<IndexArray>& components, ThreadPool* pool = 0);
+
+    // Compute the L2 distance transform (Euclidean distance transform).  The
+    // value at a voxel is the distance to the nearest 0-valued voxel, and
+    // the distances are exact (see DistanceTransform).  The 'transform'
+    // should be the same dimensions as 'image' and its values are all set
+    // in this function, so it does not matter what they are on input.  If
+    // 'pool' is not null, the rows and lines of each pass are processed
+    // concurrently; the caller retains ownership.
+    static void GetL2Distance (const ImageInt3D& image, double& maxDistance,
+        ImageDouble3D& transform, ThreadPool* pool = 0);
 
-private:
-    // The heart of the component labeling.
-    static void GetComponents (const int numNeighbors, const int delta[],
-        bool storeZeros, ImageInt3D& image,
-        std::vector<IndexArray>& components);
+    // Compute the squared L2 distance transform.  The 'sqrDistance' image
+    // should be the same dimensions as 'image'.  If 'nearest' is not null,
+    // it must also have those dimensions, and on output its value at a
+    // voxel is the index of a nearest 0-valued voxel.
+    static void GetSqrL2Distance (const ImageInt3D& image,
+        ImageInt3D& sqrDistance, ImageInt3D* nearest = 0,
+        ThreadPool* pool = 0);
 };
 
 }
@@ -0,0 +1,354 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5ImagicsPCH.h"
+#include "Wm5ComponentLabeler.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+//----------------------------------------------------------------------------
+void ComponentLabeler::Execute (int bound0, int bound1, int bound2,
+    int* data, int reach, int diagonalReach, bool storeZeros,
+    std::vector<std::vector<int> >& components, ThreadPool* pool)
+{
+    components.clear();
+
+    const int numRows = bound1*bound2;
+    const int numVoxels = bound0*numRows;
+    if (numVoxels <= 0)
+    {
+        return;
+    }
+
+    // A few tiles per worker balance the load when the foreground is not
+    // uniformly distributed.
+    int numTiles = (pool ? 4*ThreadPool::GetNumWorkers(pool) : 1);
+    if (numTiles > numRows)
+    {
+        numTiles = numRows;
+    }
+    Tile* tiles = new1<Tile>(numTiles);
+    int t;
+    for (t = 0; t < numTiles; ++t)
+    {
+        tiles[t].RowBegin = (int)(((long long)numRows*t)/numTiles);
+        tiles[t].RowEnd = (int)(((long long)numRows*(t + 1))/numTiles);
+    }
+
+    Context context;
+    context.Bound0 = bound0;
+    context.Bound1 = bound1;
+    context.Reach = reach;
+    context.DiagonalReach = diagonalReach;
+    context.Data = data;
+    context.Tiles = tiles;
+    context.Components = &components;
+    context.StoreZeros = storeZeros;
+
+    // First pass:  find and join the runs within each tile.
+    ThreadPool::ParallelFor(pool, numTiles, 1, ScanTask, &context);
+
+    int numRuns = 0, numForeground = 0;
+    for (t = 0; t < numTiles; ++t)
+    {
+        tiles[t].RunOffset = numRuns;
+        tiles[t].ZeroOffset = tiles[t].RowBegin*bound0 - numForeground;
+        numRuns += (int)tiles[t].Start.size();
+        numForeground += tiles[t].NumForeground;
+    }
+
+    context.Start = new1<int>(numRuns + 1);
+    context.Last = new1<int>(numRuns + 1);
+    context.Parent = new1<int>(numRuns + 1);
+    context.Position = new1<int>(numRuns + 1);
+    context.RowFirst = new1<int>(numRows + 1);
+    context.RowFirst[numRows] = numRuns;
+    ThreadPool::ParallelFor(pool, numTiles, 1, GatherTask, &context);
+
+    // Join the runs across the tile borders.  Only the first bound1+1 rows
+    // of a tile have neighbors in previous tiles.
+    for (t = 1; t < numTiles; ++t)
+    {
+        const Tile& tile = tiles[t];
+        int rMax = tile.RowBegin + bound1 + 1;
+        if (rMax > tile.RowEnd)
+        {
+            rMax = tile.RowEnd;
+        }
+        for (int r = tile.RowBegin; r < rMax; ++r)
+        {
+            JoinPrevious(context, context.Start, context.Last,
+                context.RowFirst, 0, r, 0, context.Parent);
+        }
+    }
+
+    // Every run is linked to a run of smaller index, so the labels are
+    // assigned in one pass in the order of the roots.  The parents are
+    // replaced by the negated labels.
+    int* parent = context.Parent;
+    int numComponents = 0;
+    int r;
+    for (r = 0; r < numRuns; ++r)
+    {
+        if (parent[r] == r)
+        {
+            parent[r] = -(++numComponents);
+        }
+        else
+        {
+            parent[r] = parent[parent[r]];
+        }
+    }
+
+    if (numComponents > 0 || storeZeros)
+    {
+        components.resize(numComponents + 1);
+        std::vector<int> numElements(numComponents + 1, 0);
+        for (r = 0; r < numRuns; ++r)
+        {
+            int& count = numElements[-parent[r]];
+            context.Position[r] = count;
+            count += context.Last[r] - context.Start[r] + 1;
+        }
+        for (int i = 1; i <= numComponents; ++i)
+        {
+            components[i].resize(numElements[i]);
+        }
+        if (storeZeros)
+        {
+            components[0].resize(numVoxels - numForeground);
+        }
+
+        // Second pass:  write the labels and the indices.
+        ThreadPool::ParallelFor(pool, numTiles, 1, WriteTask, &context);
+    }
+
+    delete1(context.RowFirst);
+    delete1(context.Position);
+    delete1(context.Parent);
+    delete1(context.Last);
+    delete1(context.Start);
+    delete1(tiles);
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::ScanTask (int begin, int end, int, void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    const int bound0 = context.Bound0;
+    for (int t = begin; t < end; ++t)
+    {
+        Tile& tile = context.Tiles[t];
+        tile.NumForeground = 0;
+        tile.RowFirst.push_back(0);
+        for (int r = tile.RowBegin; r < tile.RowEnd; ++r)
+        {
+            // Split the row into runs.
+            const int* row = context.Data + r*bound0;
+            int x = 0;
+            while (x < bound0)
+            {
+                if (row[x] != 0)
+                {
+                    int x0 = x++;
+                    while (x < bound0 && row[x] != 0)
+                    {
+                        ++x;
+                    }
+                    tile.Parent.push_back((int)tile.Start.size());
+                    tile.Start.push_back(x0);
+                    tile.Last.push_back(x - 1);
+                    tile.NumForeground += x - x0;
+                }
+                else
+                {
+                    ++x;
+                }
+            }
+            tile.RowFirst.push_back((int)tile.Start.size());
+
+            // Join the runs with those of the previous rows in the tile.
+            if (tile.Start.size() > 0)
+            {
+                JoinPrevious(context, &tile.Start[0], &tile.Last[0],
+                    &tile.RowFirst[0], tile.RowBegin, r, tile.RowBegin,
+                    &tile.Parent[0]);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::GatherTask (int begin, int end, int, void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    for (int t = begin; t < end; ++t)
+    {
+        Tile& tile = context.Tiles[t];
+        const int offset = tile.RunOffset;
+        const int numRuns = (int)tile.Start.size();
+        int i;
+        for (i = 0; i < numRuns; ++i)
+        {
+            context.Start[offset + i] = tile.Start[i];
+            context.Last[offset + i] = tile.Last[i];
+            context.Parent[offset + i] = offset + tile.Parent[i];
+        }
+        const int numRows = tile.RowEnd - tile.RowBegin;
+        for (i = 0; i < numRows; ++i)
+        {
+            context.RowFirst[tile.RowBegin + i] = offset + tile.RowFirst[i];
+        }
+
+        // The local runs are no longer needed.
+        std::vector<int>().swap(tile.Start);
+        std::vector<int>().swap(tile.Last);
+        std::vector<int>().swap(tile.Parent);
+        std::vector<int>().swap(tile.RowFirst);
+    }
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::WriteTask (int begin, int end, int, void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    std::vector<std::vector<int> >& components = *context.Components;
+    const int bound0 = context.Bound0;
+    for (int t = begin; t < end; ++t)
+    {
+        const Tile& tile = context.Tiles[t];
+        int* zeros = 0;
+        if (context.StoreZeros && components[0].size() > 0)
+        {
+            zeros = &components[0][0] + tile.ZeroOffset;
+        }
+
+        for (int r = tile.RowBegin; r < tile.RowEnd; ++r)
+        {
+            const int rowIndex = r*bound0;
+            int* row = context.Data + rowIndex;
+            int x = 0;
+            for (int k = context.RowFirst[r]; k < context.RowFirst[r+1]; ++k)
+            {
+                const int x0 = context.Start[k], x1 = context.Last[k];
+                if (zeros)
+                {
+                    for (/**/; x < x0; ++x)
+                    {
+                        *zeros++ = rowIndex + x;
+                    }
+                }
+
+                const int label = -context.Parent[k];
+                int* indices = &components[label][context.Position[k]];
+                for (x = x0; x <= x1; ++x)
+                {
+                    row[x] = label;
+                    *indices++ = rowIndex + x;
+                }
+            }
+            if (zeros)
+            {
+                for (/**/; x < bound0; ++x)
+                {
+                    *zeros++ = rowIndex + x;
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::JoinRows (const int* start, const int* last, int a0,
+    int a1, int b0, int b1, int reach, int* parent)
+{
+    // The runs of both rows are sorted and disjoint, so the first run of
+    // row b that can overlap a run of row a does not decrease.
+    int j = b0;
+    for (int i = a0; i < a1; ++i)
+    {
+        while (j < b1 && last[j] + reach < start[i])
+        {
+            ++j;
+        }
+        for (int k = j; k < b1 && start[k] <= last[i] + reach; ++k)
+        {
+            Union(parent, i, k);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::JoinPrevious (const Context& context,
+    const int* start, const int* last, const int* rowFirst, int rowOrigin,
+    int r, int rowMin, int* parent)
+{
+    const int bound1 = context.Bound1;
+    const int y = r % bound1;
+    const int a0 = rowFirst[r - rowOrigin], a1 = rowFirst[r - rowOrigin + 1];
+    if (a0 == a1)
+    {
+        return;
+    }
+
+    int neighbor[4], reach[4], numNeighbors = 0;
+    if (y > 0)
+    {
+        neighbor[numNeighbors] = r - 1;
+        reach[numNeighbors++] = context.Reach;
+    }
+    if (r >= bound1)
+    {
+        neighbor[numNeighbors] = r - bound1;
+        reach[numNeighbors++] = context.Reach;
+        if (context.DiagonalReach >= 0)
+        {
+            if (y > 0)
+            {
+                neighbor[numNeighbors] = r - bound1 - 1;
+                reach[numNeighbors++] = context.DiagonalReach;
+            }
+            if (y < bound1 - 1)
+            {
+                neighbor[numNeighbors] = r - bound1 + 1;
+                reach[numNeighbors++] = context.DiagonalReach;
+            }
+        }
+    }
+
+    for (int n = 0; n < numNeighbors; ++n)
+    {
+        const int q = neighbor[n];
+        if (q >= rowMin)
+        {
+            JoinRows(start, last, a0, a1, rowFirst[q - rowOrigin],
+                rowFirst[q - rowOrigin + 1], reach[n], parent);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int ComponentLabeler::Find (int* parent, int i)
+{
+    // Path halving.
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+//----------------------------------------------------------------------------
+void ComponentLabeler::Union (int* parent, int i0, int i1)
+{
+    i0 = Find(parent, i0);
+    i1 = Find(parent, i1);
+    if (i0 < i1)
+    {
+        parent[i1] = i0;
+    }
+    else if (i1 < i0)
+    {
+        parent[i0] = i1;
+    }
+}
+//----------------------------------------------------------------------------
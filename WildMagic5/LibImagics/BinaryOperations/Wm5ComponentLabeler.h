@@ -0,0 +1,106 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5COMPONENTLABELER_H
+#define WM5COMPONENTLABELER_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5ThreadPool.h"
+
+namespace Wm5
+{
+
+class WM5_IMAGICS_ITEM ComponentLabeler
+{
+public:
+    // Connected component labeling of binary images, the implementation of
+    // Binary2D::GetComponents* and Binary3D::GetComponents*.  The image has
+    // bound0 columns, bound1 rows and bound2 slices, with voxel (x,y,z)
+    // stored at index x+bound0*(y+bound1*z); a 2D image has bound2 = 1.
+    // Non-zero voxels are foreground.
+    //
+    // The connectivity is given by the neighbors of (x,y,z) that precede
+    // it in the previous row and slice.  The voxels (x+dx,y-1,z) and
+    // (x+dx,y,z-1) are neighbors for |dx| <= reach.  The voxels
+    // (x+dx,y-1,z-1) and (x+dx,y+1,z-1) are neighbors for
+    // |dx| <= diagonalReach; a diagonalReach of -1 excludes them.
+    //   4-connected (2D):  reach = 0, diagonalReach = -1
+    //   8-connected (2D):  reach = 1, diagonalReach = -1
+    //   6-connected (3D):  reach = 0, diagonalReach = -1
+    //   18-connected (3D): reach = 1, diagonalReach = 0
+    //   26-connected (3D): reach = 1, diagonalReach = 1
+    //
+    // The rows are partitioned into tiles of consecutive rows.  The first
+    // pass splits the rows of each tile into runs of foreground voxels and
+    // joins the overlapping runs of neighboring rows in a union-find
+    // forest, always linking to the root of smaller index.  The tiles are
+    // then joined across their borders, and the root of each component is
+    // its first run in the image.  The second pass writes the labels.  If
+    // 'pool' is not null, the tiles are processed concurrently.
+    //
+    // On output, the image values are the labels 1, 2, ... of the
+    // components, numbered in the order of their first voxel, and
+    // components[i], i >= 1, contains the indices of the i-th component in
+    // increasing order.  If storeZeros is true, components[0] contains the
+    // indices of the background voxels; otherwise, it is empty.
+    static void Execute (int bound0, int bound1, int bound2, int* data,
+        int reach, int diagonalReach, bool storeZeros,
+        std::vector<std::vector<int> >& components, ThreadPool* pool = 0);
+
+private:
+    // The runs of a tile during the first pass, with local indices.
+    class Tile
+    {
+    public:
+        int RowBegin, RowEnd;
+        std::vector<int> Start, Last, Parent, RowFirst;
+        int NumForeground, RunOffset, ZeroOffset;
+    };
+
+    class Context
+    {
+    public:
+        int Bound0, Bound1, Reach, DiagonalReach;
+        int* Data;
+        Tile* Tiles;
+        std::vector<std::vector<int> >* Components;
+        bool StoreZeros;
+
+        // The runs of all tiles, with global indices.  After the
+        // components are found, Parent[r] is the negated label of run r
+        // and Position[r] is the offset of its voxels in the index array
+        // of the component.
+        int* Start;
+        int* Last;
+        int* Parent;
+        int* Position;
+        int* RowFirst;
+    };
+
+    static void ScanTask (int begin, int end, int worker, void* userData);
+    static void GatherTask (int begin, int end, int worker, void* userData);
+    static void WriteTask (int begin, int end, int worker, void* userData);
+
+    // Join the runs of row a, [a0,a1), with the overlapping runs of row b,
+    // [b0,b1).
+    static void JoinRows (const int* start, const int* last, int a0,
+        int a1, int b0, int b1, int reach, int* parent);
+
+    // Join the runs of row r with the runs of its neighboring rows whose
+    // indices are in [rowMin,r).
+    static void JoinPrevious (const Context& context, const int* start,
+        const int* last, const int* rowFirst, int rowOrigin, int r,
+        int rowMin, int* parent);
+
+    static int Find (int* parent, int i);
+    static void Union (int* parent, int i0, int i1);
+};
+
+}
+
+#endif
@@ -0,0 +1,304 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5ImagicsPCH.h"
+#include "Wm5DistanceTransform.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+//----------------------------------------------------------------------------
+void DistanceTransform::Execute (int bound0, int bound1, int bound2,
+    const int* data, int* sqrDistances, int* nearest, ThreadPool* pool)
+{
+    const int numRows = bound1*bound2;
+    if (bound0 <= 0 || numRows <= 0)
+    {
+        return;
+    }
+
+    int maxBound = bound0;
+    if (bound1 > maxBound)
+    {
+        maxBound = bound1;
+    }
+    if (bound2 > maxBound)
+    {
+        maxBound = bound2;
+    }
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+
+    Context context;
+    context.Bound0 = bound0;
+    context.Bound1 = bound1;
+    context.Bound2 = bound2;
+    context.Axis = 0;
+    context.Data = data;
+    context.SqrDistances = sqrDistances;
+    context.Nearest = nearest;
+    context.ScratchSize = (2*BLOCK_SIZE + 5)*maxBound;
+    context.Scratch = new1<int>(numWorkers*context.ScratchSize);
+
+    // Distances to the nearest feature in the same row.
+    ThreadPool::ParallelFor(pool, numRows, 0, RowTask, &context);
+
+    // Distances to the nearest feature in the same slice.
+    const int numBlocks0 = (bound0 + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    if (bound1 > 1)
+    {
+        context.Axis = 1;
+        ThreadPool::ParallelFor(pool, numBlocks0*bound2, 0, LineTask,
+            &context);
+    }
+
+    // Distances to the nearest feature in the image.
+    const int numBlocks01 = (bound0*bound1 + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    if (bound2 > 1)
+    {
+        context.Axis = 2;
+        ThreadPool::ParallelFor(pool, numBlocks01, 0, LineTask, &context);
+    }
+
+    delete1(context.Scratch);
+}
+//----------------------------------------------------------------------------
+void DistanceTransform::RowTask (int begin, int end, int, void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    const int bound0 = context.Bound0;
+    for (int r = begin; r < end; ++r)
+    {
+        const int rowIndex = r*bound0;
+        const int* row = context.Data + rowIndex;
+        int* sqrDistance = context.SqrDistances + rowIndex;
+
+        // The forward scan stores the nearest feature on the left, -1 if
+        // there is none.  The backward scan replaces it by the nearest
+        // feature on the right when that one is closer.
+        int x, feature = -1;
+        for (x = 0; x < bound0; ++x)
+        {
+            if (row[x] == 0)
+            {
+                feature = x;
+            }
+            sqrDistance[x] = feature;
+        }
+
+        feature = -1;
+        for (x = bound0 - 1; x >= 0; --x)
+        {
+            if (row[x] == 0)
+            {
+                feature = x;
+            }
+            int left = sqrDistance[x];
+            if (feature >= 0 && (left < 0 || feature - x < x - left))
+            {
+                left = feature;
+            }
+
+            if (left >= 0)
+            {
+                sqrDistance[x] = (x - left)*(x - left);
+                if (context.Nearest)
+                {
+                    context.Nearest[rowIndex + x] = rowIndex + left;
+                }
+            }
+            else
+            {
+                sqrDistance[x] = INT_MAX;
+                if (context.Nearest)
+                {
+                    context.Nearest[rowIndex + x] = -1;
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void DistanceTransform::LineTask (int begin, int end, int worker,
+    void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    const int bound0 = context.Bound0;
+    const int bound1 = context.Bound1;
+    int n, stride, numLines;
+    if (context.Axis == 1)
+    {
+        n = bound1;
+        stride = bound0;
+        numLines = bound0;
+    }
+    else
+    {
+        n = context.Bound2;
+        stride = bound0*bound1;
+        numLines = stride;
+    }
+    const int numBlocks = (numLines + BLOCK_SIZE - 1)/BLOCK_SIZE;
+
+    int* f = context.Scratch + worker*context.ScratchSize;
+    int* feature = f + BLOCK_SIZE*n;
+    int* envelope = feature + BLOCK_SIZE*n;
+    int* site = envelope + n;
+    int* vertex = site + n;
+    int* start = vertex + n;
+    int* temp = start + n;
+
+    for (int item = begin; item < end; ++item)
+    {
+        // The lines of axis 1 are indexed by (x,z), those of axis 2 by
+        // (x,y).  An item is a block of consecutive lines; their voxels
+        // at the same position along the lines are adjacent in memory.
+        int block = item % numBlocks;
+        int line0 = block*BLOCK_SIZE;
+        int numBlockLines = numLines - line0;
+        if (numBlockLines > BLOCK_SIZE)
+        {
+            numBlockLines = BLOCK_SIZE;
+        }
+        int base = line0;
+        if (context.Axis == 1)
+        {
+            base += bound0*bound1*(item / numBlocks);
+        }
+
+        int* sqrDistance = context.SqrDistances + base;
+        int* nearest = (context.Nearest ? context.Nearest + base : 0);
+        int u, i, j;
+        for (u = 0, i = 0; u < n; ++u, i += stride)
+        {
+            for (j = 0; j < numBlockLines; ++j)
+            {
+                f[j*n + u] = sqrDistance[i + j];
+            }
+        }
+        if (nearest)
+        {
+            for (u = 0, i = 0; u < n; ++u, i += stride)
+            {
+                for (j = 0; j < numBlockLines; ++j)
+                {
+                    feature[j*n + u] = nearest[i + j];
+                }
+            }
+        }
+
+        for (j = 0; j < numBlockLines; ++j)
+        {
+            int* lineF = f + j*n;
+            LowerEnvelope(n, lineF, envelope, site, vertex, start);
+            memcpy(lineF, envelope, n*sizeof(int));
+            if (nearest)
+            {
+                int* lineFeature = feature + j*n;
+                for (u = 0; u < n; ++u)
+                {
+                    temp[u] = (site[u] >= 0 ? lineFeature[site[u]] : -1);
+                }
+                memcpy(lineFeature, temp, n*sizeof(int));
+            }
+        }
+
+        for (u = 0, i = 0; u < n; ++u, i += stride)
+        {
+            for (j = 0; j < numBlockLines; ++j)
+            {
+                sqrDistance[i + j] = f[j*n + u];
+            }
+        }
+        if (nearest)
+        {
+            for (u = 0, i = 0; u < n; ++u, i += stride)
+            {
+                for (j = 0; j < numBlockLines; ++j)
+                {
+                    nearest[i + j] = feature[j*n + u];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void DistanceTransform::LowerEnvelope (int n, const int* f, int* envelope,
+    int* site, int* vertex, int* start)
+{
+    // The parabola of vertex[k] is the lowest one on the interval
+    // [start[k],start[k+1]).  Parabola i is not above parabola q > i at u
+    // exactly when u <= (q^2 - i^2 + f[q] - f[i])/(2*(q - i)), so the
+    // separating abscissa is the floor of that quotient.
+    int k = -1;
+    int q, u;
+    for (q = 0; q < n; ++q)
+    {
+        if (f[q] == INT_MAX)
+        {
+            continue;
+        }
+
+        long long separator = 0;
+        while (k >= 0)
+        {
+            const int i = vertex[k];
+            const long long numer = (long long)q*q - (long long)i*i +
+                (long long)f[q] - (long long)f[i];
+            const long long denom = 2*(long long)(q - i);
+            separator = numer/denom;
+            if (numer < 0 && separator*denom != numer)
+            {
+                --separator;
+            }
+
+            if (separator >= start[k])
+            {
+                break;
+            }
+
+            // Parabola q is below parabola i on all of its interval.
+            --k;
+        }
+
+        if (k < 0)
+        {
+            vertex[0] = q;
+            start[0] = 0;
+            k = 0;
+        }
+        else if (separator < n - 1)
+        {
+            ++k;
+            vertex[k] = q;
+            start[k] = (int)separator + 1;
+        }
+    }
+
+    if (k < 0)
+    {
+        for (u = 0; u < n; ++u)
+        {
+            envelope[u] = INT_MAX;
+            site[u] = -1;
+        }
+        return;
+    }
+
+    const int numVertices = k + 1;
+    k = 0;
+    for (u = 0; u < n; ++u)
+    {
+        while (k + 1 < numVertices && start[k + 1] <= u)
+        {
+            ++k;
+        }
+        const int i = vertex[k];
+        envelope[u] = (u - i)*(u - i) + f[i];
+        site[u] = i;
+    }
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5DISTANCETRANSFORM_H
+#define WM5DISTANCETRANSFORM_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5ThreadPool.h"
+
+namespace Wm5
+{
+
+class WM5_IMAGICS_ITEM DistanceTransform
+{
+public:
+    // Exact Euclidean distance transform of binary images, the
+    // implementation of Binary2D::GetSqrL2Distance and
+    // Binary3D::GetSqrL2Distance.  The image has bound0 columns, bound1 rows
+    // and bound2 slices, with voxel (x,y,z) stored at index
+    // x+bound0*(y+bound1*z); a 2D image has bound2 = 1.  The zero-valued
+    // voxels are the features.
+    //
+    // On output, sqrDistances[i] is the squared distance from voxel i to
+    // the nearest feature, which is zero for the features themselves.  If
+    // 'nearest' is not null, nearest[i] is the index of a feature at that
+    // distance.  If the image has no features, the squared distances are
+    // INT_MAX and the nearest indices are -1.  The squared distances must
+    // be representable as int, which is the case when the sum of the
+    // squared bounds is smaller than 2^31.
+    //
+    // The transform is separable (Felzenszwalb and Huttenlocher, "Distance
+    // Transforms of Sampled Functions").  The first pass computes the
+    // distance to the nearest feature within each row.  Each following
+    // pass replaces the values along the lines of the next axis by the
+    // lower envelope of the parabolas (u-i)^2+f(i).  Each pass is linear in
+    // the number of voxels.  The lines of the second and third passes are
+    // processed in blocks of BLOCK_SIZE adjacent lines, which are copied
+    // to contiguous storage so that the strided accesses read and write
+    // whole cache lines.  If 'pool' is not null, the rows and blocks of
+    // each pass are processed concurrently; the result does not depend on
+    // the number of threads.
+    static void Execute (int bound0, int bound1, int bound2,
+        const int* data, int* sqrDistances, int* nearest = 0,
+        ThreadPool* pool = 0);
+
+    enum
+    {
+        BLOCK_SIZE = 16
+    };
+
+private:
+    class Context
+    {
+    public:
+        int Bound0, Bound1, Bound2, Axis;
+        const int* Data;
+        int* SqrDistances;
+        int* Nearest;
+
+        // Per-worker storage for one line, ScratchSize integers each.
+        int* Scratch;
+        int ScratchSize;
+    };
+
+    static void RowTask (int begin, int end, int worker, void* userData);
+    static void LineTask (int begin, int end, int worker, void* userData);
+
+    // Compute the lower envelope of the parabolas (u-i)^2+f[i] for
+    // 0 <= u < n, skipping the i with f[i] = INT_MAX.  On output,
+    // envelope[u] is the minimum and site[u] the i of a parabola that
+    // attains it, or INT_MAX and -1 when all f[i] are INT_MAX.  The arrays
+    // 'vertex' and 'start' are storage for n integers.
+    static void LowerEnvelope (int n, const int* f, int* envelope,
+        int* site, int* vertex, int* start);
+};
+
+}
+
+#endif
@@ -4,11 +4,12 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5ExtractSurfaceCubes.h"
 #include "Wm5Assert.h"
+#include "Wm5Memory.h"
 using namespace Wm5;
 
 typedef std::map<Vector3f,int> VMap;
@@ -16,6 +17,28 @@ typedef VMap::iterator VMapIterator;
 typedef std::map<TriangleKey,int> TMap;
 typedef TMap::iterator TMapIterator;
 
+const int ExtractSurfaceCubes::msCacheSlot[18][4] =
+{
+    { 2, 0, 0, 0 },  // EI_XMIN_YMIN
+    { 2, 0, 1, 0 },  // EI_XMIN_YMAX
+    { 2, 1, 0, 0 },  // EI_XMAX_YMIN
+    { 2, 1, 1, 0 },  // EI_XMAX_YMAX
+    { 0, 0, 0, 1 },  // EI_XMIN_ZMIN
+    { 1, 0, 0, 1 },  // EI_XMIN_ZMAX
+    { 0, 1, 0, 1 },  // EI_XMAX_ZMIN
+    { 1, 1, 0, 1 },  // EI_XMAX_ZMAX
+    { 0, 0, 0, 0 },  // EI_YMIN_ZMIN
+    { 1, 0, 0, 0 },  // EI_YMIN_ZMAX
+    { 0, 0, 1, 0 },  // EI_YMAX_ZMIN
+    { 1, 0, 1, 0 },  // EI_YMAX_ZMAX
+    { 2, 0, 0, 1 },  // FI_XMIN
+    { 2, 1, 0, 1 },  // FI_XMAX
+    { 2, 0, 0, 2 },  // FI_YMIN
+    { 2, 0, 1, 2 },  // FI_YMAX
+    { 0, 0, 0, 2 },  // FI_ZMIN
+    { 1, 0, 0, 2 }   // FI_ZMAX
+};
+
 //----------------------------------------------------------------------------
 ExtractSurfaceCubes::ExtractSurfaceCubes(int xBound, int yBound,
     int zBound, int* data)
@@ -36,22 +59,23 @@ void ExtractSurfaceCubes::ExtractContour (float level,
 
     for (int z = 0; z < mZBound-1; ++z)
     {
+        const int* slice = mData + z*mXYBound;
         for (int y = 0; y < mYBound-1; ++y)
         {
             for (int x = 0; x < mXBound-1; ++x)
             {
                 // Get vertices on edges of box (if any).
                 VETable table;
-                int type = GetVertices(level, x, y, z, table);
+                int type = GetVertices(level, slice, x, y, z, table);
                 if (type != 0)
                 {
                     // Get edges on faces of box.
-                    GetXMinEdges(x, y, z, type, table);
-                    GetXMaxEdges(x, y, z, type, table);
-                    GetYMinEdges(x, y, z, type, table);
-                    GetYMaxEdges(x, y, z, type, table);
-                    GetZMinEdges(x, y, z, type, table);
-                    GetZMaxEdges(x, y, z, type, table);
+                    GetXMinEdges(slice, x, y, type, table);
+                    GetXMaxEdges(slice, x, y, type, table);
+                    GetYMinEdges(slice, x, y, type, table);
+                    GetYMaxEdges(slice, x, y, type, table);
+                    GetZMinEdges(slice, x, y, type, table);
+                    GetZMaxEdges(slice, x, y, type, table);
 
                     // Ear-clip the wireframe mesh.
                     table.RemoveTriangles(vertices, triangles);
@@ -61,6 +85,32 @@ void ExtractSurfaceCubes::ExtractContour (float level,
     }
 }
 //----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ExtractContourIndexed (float level,
+    std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles,
+    ThreadPool* pool)
+{
+    assertion(mData != 0, "The image data is required\n");
+    ExtractSlabs(level, 0, 0, vertices, triangles, pool);
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ExtractContourIndexed (float level,
+    SliceReader reader, void* userData, std::vector<Vector3f>& vertices,
+    std::vector<TriangleKey>& triangles, ThreadPool* pool)
+{
+    assertion(reader != 0, "The slice reader is required\n");
+    ExtractSlabs(level, reader, userData, vertices, triangles, pool);
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ExtractContourIndexed (float level,
+    const TiledImageInt3D& image, std::vector<Vector3f>& vertices,
+    std::vector<TriangleKey>& triangles, ThreadPool* pool)
+{
+    assertion(image.GetBound(0) == mXBound && image.GetBound(1) == mYBound
+        && image.GetBound(2) == mZBound, "Mismatched image bounds\n");
+    ExtractSlabs(level, ReadTiledSlices, (void*)&image, vertices, triangles,
+        pool);
+}
+//----------------------------------------------------------------------------
 void ExtractSurfaceCubes::MakeUnique (std::vector<Vector3f>& vertices,
     std::vector<TriangleKey>& triangles)
 {
@@ -222,13 +272,13 @@ void ExtractSurfaceCubes::ComputeNormals (
     }
 }
 //----------------------------------------------------------------------------
-int ExtractSurfaceCubes::GetVertices (float level, int x, int y, int z,
-    VETable& table)
+int ExtractSurfaceCubes::GetVertices (float level, const int* slice, int x,
+    int y, int z, VETable& table) const
 {
     int type = 0;
 
     // get image values at corners of voxel
-    int i000 = x + mXBound*(y + mYBound*z);
+    int i000 = x + mXBound*y;
     int i100 = i000 + 1;
     int i010 = i000 + mXBound;
     int i110 = i010 + 1;
@@ -236,14 +286,14 @@ int ExtractSurfaceCubes::GetVertices (float level, int x, int y, int z,
     int i101 = i001 + 1;
     int i011 = i001 + mXBound;
     int i111 = i011 + 1;
-    float f000 = (float)mData[i000];
-    float f100 = (float)mData[i100];
-    float f010 = (float)mData[i010];
-    float f110 = (float)mData[i110];
-    float f001 = (float)mData[i001];
-    float f101 = (float)mData[i101];
-    float f011 = (float)mData[i011];
-    float f111 = (float)mData[i111];
+    float f000 = (float)slice[i000];
+    float f100 = (float)slice[i100];
+    float f010 = (float)slice[i010];
+    float f110 = (float)slice[i110];
+    float f001 = (float)slice[i001];
+    float f101 = (float)slice[i101];
+    float f011 = (float)slice[i011];
+    float f111 = (float)slice[i111];
 
     float x0 = (float)x, y0 = (float)y, z0 = (float)z;
     float x1 = x0 + 1.0f, y1 = y0 + 1.0f, z1 = z0 + 1.0f;
@@ -371,8 +421,8 @@ int ExtractSurfaceCubes::GetVertices (float level, int x, int y, int z,
     return type;
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetXMinEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetXMinEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMIN_YMIN)
@@ -404,14 +454,14 @@ void ExtractSurfaceCubes::GetXMinEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = x + mXBound*(y + mYBound*z);
-        int f00 = mData[i];  // F(x,y,z)
+        int i = x + mXBound*y;
+        int f00 = slice[i];  // F(x,y,z)
         i += mXBound;
-        int f10 = mData[i];  // F(x,y+1,z)
+        int f10 = slice[i];  // F(x,y+1,z)
         i += mXYBound;
-        int f11 = mData[i];  // F(x,y+1,z+1)
+        int f11 = slice[i];  // F(x,y+1,z+1)
         i -= mXBound;
-        int f01 = mData[i];  // F(x,y,z+1)
+        int f01 = slice[i];  // F(x,y,z+1)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -446,8 +496,8 @@ void ExtractSurfaceCubes::GetXMinEdges (int x, int y, int z, int type,
     }
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetXMaxEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetXMaxEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMAX_YMIN)
@@ -479,14 +529,14 @@ void ExtractSurfaceCubes::GetXMaxEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = (x+1) + mXBound*(y + mYBound*z);
-        int f00 = mData[i];  // F(x,y,z)
+        int i = (x+1) + mXBound*y;
+        int f00 = slice[i];  // F(x,y,z)
         i += mXBound;
-        int f10 = mData[i];  // F(x,y+1,z)
+        int f10 = slice[i];  // F(x,y+1,z)
         i += mXYBound;
-        int f11 = mData[i];  // F(x,y+1,z+1)
+        int f11 = slice[i];  // F(x,y+1,z+1)
         i -= mXBound;
-        int f01 = mData[i];  // F(x,y,z+1)
+        int f01 = slice[i];  // F(x,y,z+1)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -521,8 +571,8 @@ void ExtractSurfaceCubes::GetXMaxEdges (int x, int y, int z, int type,
     }
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetYMinEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetYMinEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMIN_YMIN)
@@ -554,14 +604,14 @@ void ExtractSurfaceCubes::GetYMinEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = x + mXBound*(y + mYBound*z);
-        int f00 = mData[i];  // F(x,y,z)
+        int i = x + mXBound*y;
+        int f00 = slice[i];  // F(x,y,z)
         i++;
-        int f10 = mData[i];  // F(x+1,y,z)
+        int f10 = slice[i];  // F(x+1,y,z)
         i += mXYBound;
-        int f11 = mData[i];  // F(x+1,y,z+1)
+        int f11 = slice[i];  // F(x+1,y,z+1)
         i--;
-        int f01 = mData[i];  // F(x,y,z+1)
+        int f01 = slice[i];  // F(x,y,z+1)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -596,8 +646,8 @@ void ExtractSurfaceCubes::GetYMinEdges (int x, int y, int z, int type,
     }
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetYMaxEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetYMaxEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMIN_YMAX)
@@ -629,14 +679,14 @@ void ExtractSurfaceCubes::GetYMaxEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = x + mXBound*((y+1) + mYBound*z);
-        int f00 = mData[i];  // F(x,y,z)
+        int i = x + mXBound*(y+1);
+        int f00 = slice[i];  // F(x,y,z)
         i++;
-        int f10 = mData[i];  // F(x+1,y,z)
+        int f10 = slice[i];  // F(x+1,y,z)
         i += mXYBound;
-        int f11 = mData[i];  // F(x+1,y,z+1)
+        int f11 = slice[i];  // F(x+1,y,z+1)
         i--;
-        int f01 = mData[i];  // F(x,y,z+1)
+        int f01 = slice[i];  // F(x,y,z+1)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -671,8 +721,8 @@ void ExtractSurfaceCubes::GetYMaxEdges (int x, int y, int z, int type,
     }
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetZMinEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetZMinEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMIN_ZMIN)
@@ -704,14 +754,14 @@ void ExtractSurfaceCubes::GetZMinEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = x + mXBound*(y + mYBound*z);
-        int f00 = mData[i];  // F(x,y,z)
+        int i = x + mXBound*y;
+        int f00 = slice[i];  // F(x,y,z)
         i++;
-        int f10 = mData[i];  // F(x+1,y,z)
+        int f10 = slice[i];  // F(x+1,y,z)
         i += mXBound;
-        int f11 = mData[i];  // F(x+1,y+1,z)
+        int f11 = slice[i];  // F(x+1,y+1,z)
         i--;
-        int f01 = mData[i];  // F(x,y+1,z)
+        int f01 = slice[i];  // F(x,y+1,z)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -746,8 +796,8 @@ void ExtractSurfaceCubes::GetZMinEdges (int x, int y, int z, int type,
     }
 }
 //----------------------------------------------------------------------------
-void ExtractSurfaceCubes::GetZMaxEdges (int x, int y, int z, int type,
-    VETable& table)
+void ExtractSurfaceCubes::GetZMaxEdges (const int* slice, int x, int y,
+    int type, VETable& table) const
 {
     int faceType = 0;
     if (type & EB_XMIN_ZMAX)
@@ -779,14 +829,14 @@ void ExtractSurfaceCubes::GetZMaxEdges (int x, int y, int z, int type,
     case 15:
     {
         // Four vertices, one per edge, need to disambiguate.
-        int i = x + mXBound*(y + mYBound*(z+1));
-        int f00 = mData[i];  // F(x,y,z)
+        int i = x + mXBound*y + mXYBound;
+        int f00 = slice[i];  // F(x,y,z)
         i++;
-        int f10 = mData[i];  // F(x+1,y,z)
+        int f10 = slice[i];  // F(x+1,y,z)
         i += mXBound;
-        int f11 = mData[i];  // F(x+1,y+1,z)
+        int f11 = slice[i];  // F(x+1,y+1,z)
         i--;
-        int f01 = mData[i];  // F(x,y+1,z)
+        int f01 = slice[i];  // F(x,y+1,z)
         int det = f00*f11 - f01*f10;
 
         if (det > 0)
@@ -883,6 +933,270 @@ Vector3f ExtractSurfaceCubes::GetGradient (Vector3f P)
     return grad;
 }
 //----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ExtractSlabs (float level, SliceReader reader,
+    void* userData, std::vector<Vector3f>& vertices,
+    std::vector<TriangleKey>& triangles, ThreadPool* pool)
+{
+    vertices.clear();
+    triangles.clear();
+
+    const int numLayers = mZBound - 1;
+    if (mXBound < 2 || mYBound < 2 || numLayers < 1)
+    {
+        return;
+    }
+
+    // The slabs are processed in batches.  An image in memory is processed
+    // in one batch.  A streamed image is processed in batches of one slab
+    // per worker, so that only those slabs are resident.
+    const int numSlabs = (numLayers + SLAB_SIZE - 1)/SLAB_SIZE;
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+    int batchSize = (reader ? numWorkers : numSlabs);
+    if (batchSize > numSlabs)
+    {
+        batchSize = numSlabs;
+    }
+
+    const int slabSize = (SLAB_SIZE + 1)*mXYBound;
+    int* buffer = (reader ? new1<int>(batchSize*slabSize) : 0);
+    int* caches = new1<int>(9*mXYBound*numWorkers);
+    Slab* slabs = new1<Slab>(batchSize);
+
+    SlabTaskData data;
+    data.Object = this;
+    data.Level = level;
+    data.Slabs = slabs;
+    data.Caches = caches;
+
+    // The triangles of the previous slab that reference vertices of the
+    // next one, and the plane keys of those vertices.
+    std::vector<TriangleKey> pending;
+    std::vector<int> pendingKeys;
+
+    for (int first = 0; first < numSlabs; first += batchSize)
+    {
+        int numBatch = numSlabs - first;
+        if (numBatch > batchSize)
+        {
+            numBatch = batchSize;
+        }
+
+        for (int j = 0; j < numBatch; ++j)
+        {
+            Slab& slab = slabs[j];
+            slab.ZMin = (first + j)*SLAB_SIZE;
+            slab.ZMax = slab.ZMin + SLAB_SIZE;
+            if (slab.ZMax > numLayers)
+            {
+                slab.ZMax = numLayers;
+            }
+
+            if (reader)
+            {
+                int* slices = buffer + j*slabSize;
+                reader(slab.ZMin, slab.ZMax - slab.ZMin + 1, slices,
+                    userData);
+                slab.Data = slices;
+            }
+            else
+            {
+                slab.Data = mData + slab.ZMin*mXYBound;
+            }
+        }
+
+        ThreadPool::ParallelFor(pool, numBatch, 1, SlabTask, &data);
+
+        for (int j = 0; j < numBatch; ++j)
+        {
+            AppendSlab(slabs[j], pendingKeys, pending, vertices, triangles);
+        }
+    }
+    assertion(pending.size() == 0, "Unresolved slab vertices\n");
+
+    delete1(slabs);
+    delete1(caches);
+    delete1(buffer);
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ExtractSlab (float level, Slab& slab,
+    int* caches) const
+{
+    // caches[0] and caches[1] are the planes z and z+1 of the current
+    // layer, caches[2] is the layer.
+    const int numSlots = 3*mXYBound;
+    int* cache[3] = { caches, caches + numSlots, caches + 2*numSlots };
+    memset(cache[0], 0xFF, numSlots*sizeof(int));
+
+    const bool lastSlab = (slab.ZMax == mZBound - 1);
+    for (int z = slab.ZMin; z < slab.ZMax; ++z)
+    {
+        if (z > slab.ZMin)
+        {
+            int* save = cache[0];
+            cache[0] = cache[1];
+            cache[1] = save;
+        }
+        memset(cache[1], 0xFF, numSlots*sizeof(int));
+        memset(cache[2], 0xFF, numSlots*sizeof(int));
+
+        // The vertices on the bottom plane of a slab are shared with the
+        // previous slab, those on the top plane belong to the next slab.
+        const bool bottomShared = (z == slab.ZMin && z > 0);
+        const bool topExternal = (z + 1 == slab.ZMax && !lastSlab);
+
+        const int* slice = slab.Data + (z - slab.ZMin)*mXYBound;
+        for (int y = 0; y < mYBound-1; ++y)
+        {
+            for (int x = 0; x < mXBound-1; ++x)
+            {
+                VETable table;
+                int type = GetVertices(level, slice, x, y, z, table);
+                if (type != 0)
+                {
+                    GetXMinEdges(slice, x, y, type, table);
+                    GetXMaxEdges(slice, x, y, type, table);
+                    GetYMinEdges(slice, x, y, type, table);
+                    GetYMaxEdges(slice, x, y, type, table);
+                    GetZMinEdges(slice, x, y, type, table);
+                    GetZMaxEdges(slice, x, y, type, table);
+
+                    // Ear-clip the wireframe mesh and map the table
+                    // indices to slab vertices.
+                    int base = 3*(x + mXBound*y);
+                    TriangleKey tri;
+                    while (table.Remove(tri))
+                    {
+                        int v0 = GetSlabVertex(table, tri.V[0], base, cache,
+                            bottomShared, topExternal, slab);
+                        int v1 = GetSlabVertex(table, tri.V[1], base, cache,
+                            bottomShared, topExternal, slab);
+                        int v2 = GetSlabVertex(table, tri.V[2], base, cache,
+                            bottomShared, topExternal, slab);
+                        slab.Triangles.push_back(TriangleKey(v0, v1, v2));
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(slab.Shared.begin(), slab.Shared.end());
+}
+//----------------------------------------------------------------------------
+int ExtractSurfaceCubes::GetSlabVertex (const VETable& table, int i,
+    int base, int* const* caches, bool bottomShared, bool topExternal,
+    Slab& slab) const
+{
+    const int* slot = msCacheSlot[i];
+    int key = base + 3*(slot[1] + mXBound*slot[2]) + slot[3];
+    int& index = caches[slot[0]][key];
+    if (index == -1)
+    {
+        if (slot[0] == 1 && topExternal)
+        {
+            index = -2 - (int)slab.External.size();
+            slab.External.push_back(key);
+        }
+        else
+        {
+            index = (int)slab.Vertices.size();
+            slab.Vertices.push_back(Vector3f(table.GetX(i), table.GetY(i),
+                table.GetZ(i)));
+
+            if (slot[0] == 0 && bottomShared)
+            {
+                slab.Shared.push_back(std::make_pair(key, index));
+            }
+        }
+    }
+    return index;
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::AppendSlab (Slab& slab,
+    std::vector<int>& pendingKeys, std::vector<TriangleKey>& pending,
+    std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles)
+    const
+{
+    const int offset = (int)vertices.size();
+    vertices.insert(vertices.end(), slab.Vertices.begin(),
+        slab.Vertices.end());
+
+    // Resolve the references of the previous slab to the bottom plane of
+    // this slab.
+    const int numPending = (int)pending.size();
+    int i, j;
+    for (i = 0; i < numPending; ++i)
+    {
+        TriangleKey& tri = pending[i];
+        for (j = 0; j < 3; ++j)
+        {
+            if (tri.V[j] < 0)
+            {
+                int key = pendingKeys[-2 - tri.V[j]];
+                std::vector<std::pair<int,int> >::iterator iter =
+                    std::lower_bound(slab.Shared.begin(), slab.Shared.end(),
+                    std::make_pair(key, -1));
+                assertion(iter != slab.Shared.end() && iter->first == key,
+                    "Unexpected condition\n");
+                tri.V[j] = offset + iter->second;
+            }
+        }
+        triangles.push_back(TriangleKey(tri.V[0], tri.V[1], tri.V[2]));
+    }
+    pending.clear();
+
+    const int numTriangles = (int)slab.Triangles.size();
+    for (i = 0; i < numTriangles; ++i)
+    {
+        TriangleKey tri = slab.Triangles[i];
+        bool external = false;
+        for (j = 0; j < 3; ++j)
+        {
+            if (tri.V[j] >= 0)
+            {
+                tri.V[j] += offset;
+            }
+            else
+            {
+                external = true;
+            }
+        }
+
+        if (external)
+        {
+            pending.push_back(tri);
+        }
+        else
+        {
+            triangles.push_back(tri);
+        }
+    }
+    pendingKeys.swap(slab.External);
+
+    slab.Vertices.clear();
+    slab.Triangles.clear();
+    slab.External.clear();
+    slab.Shared.clear();
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::SlabTask (int begin, int end, int worker,
+    void* userData)
+{
+    SlabTaskData& data = *(SlabTaskData*)userData;
+    const ExtractSurfaceCubes* object = data.Object;
+    int* caches = data.Caches + 9*object->mXYBound*worker;
+    for (int s = begin; s < end; ++s)
+    {
+        object->ExtractSlab(data.Level, data.Slabs[s], caches);
+    }
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceCubes::ReadTiledSlices (int zMin, int numSlices,
+    int* slices, void* userData)
+{
+    const TiledImageInt3D* image = (const TiledImageInt3D*)userData;
+    image->GetSlices(zMin, numSlices, (Eint*)slices);
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // ExtractSurfaceCubes::VETable
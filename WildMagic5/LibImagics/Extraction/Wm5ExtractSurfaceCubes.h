@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5EXTRACTSURFACECUBES_H
 #define WM5EXTRACTSURFACECUBES_H
@@ -12,6 +12,8 @@
 #include "Wm5ImagicsLIB.h"
 #include "Wm5Vector3.h"
 #include "Wm5TriangleKey.h"
+#include "Wm5ThreadPool.h"
+#include "Wm5Images.h"
 
 namespace Wm5
 {
@@ -22,7 +24,8 @@ public:
     // The input is a 3D image with lexicographically ordered voxels in
     // (x,y,z) stored in a linear array.  Voxel (x,y,z) is stored in the
     // array at location x+xbound*(y+ybound*z).  The caller is responsible
-    // for deleting data if it was dynamically allocated.
+    // for deleting data if it was dynamically allocated.  The data may be
+    // null when only the streaming ExtractContourIndexed is used.
     ExtractSurfaceCubes (int xBound, int yBound, int zBound, int* data);
 
     // The level value *must* not be exactly an integer.  This simplifies the
@@ -30,6 +33,45 @@ public:
     void ExtractContour (float level, std::vector<Vector3f>& vertices,
         std::vector<TriangleKey>& triangles);
 
+    // Extraction with unique vertices, without the MakeUnique pass.  The
+    // cubes are processed in slabs of SLAB_SIZE layers along z.  Within a
+    // slab, the vertices on cube edges and faces are shared through two
+    // rolling caches for the planes z and z+1 of the current layer and one
+    // cache for the layer itself, so each vertex is created once.  The
+    // vertices on the plane between two slabs are created by the upper
+    // slab and referenced by the lower one.  If 'pool' is not null, the
+    // slabs are processed concurrently; the caller retains ownership.  The
+    // output is the mesh of ExtractContour followed by MakeUnique, except
+    // for the order of the vertices and triangles, and it does not depend
+    // on the number of threads.
+    void ExtractContourIndexed (float level, std::vector<Vector3f>& vertices,
+        std::vector<TriangleKey>& triangles, ThreadPool* pool = 0);
+
+    // Streaming extraction for images that are not resident in memory.
+    // The reader copies 'numSlices' consecutive slices, starting with slice
+    // 'zMin', to 'slices'; each slice has xBound*yBound values.  Only the
+    // slabs being processed are resident, GetNumWorkers(pool) of them at a
+    // time, each of SLAB_SIZE+1 slices.  The reader is always called on
+    // the calling thread, in increasing z order.
+    typedef void (*SliceReader)(int zMin, int numSlices, int* slices,
+        void* userData);
+
+    void ExtractContourIndexed (float level, SliceReader reader,
+        void* userData, std::vector<Vector3f>& vertices,
+        std::vector<TriangleKey>& triangles, ThreadPool* pool = 0);
+
+    // Streaming extraction of an image in the tiled layout, whose bounds
+    // must be those passed to the constructor.  The slices of each slab
+    // are copied brick by brick with TTiledImage3D::GetSlices.
+    void ExtractContourIndexed (float level, const TiledImageInt3D& image,
+        std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles,
+        ThreadPool* pool = 0);
+
+    enum
+    {
+        SLAB_SIZE = 16
+    };
+
     // The extraction has duplicate vertices on edges shared by voxels.  This
     // function will eliminate the duplication.
     void MakeUnique (std::vector<Vector3f>& vertices,
@@ -110,9 +152,11 @@ protected:
         void RemoveTriangles (std::vector<Vector3f>& vertices,
             std::vector<TriangleKey>& triangles);
 
+        // Ear-clip one triangle; its indices are the table indices.
+        bool Remove (TriangleKey& key);
+
     protected:
         void RemoveVertex (int i);
-        bool Remove (TriangleKey& key);
 
         class Vertex
         {
@@ -128,17 +172,80 @@ protected:
         Vertex mVertex[18];
     };
 
-    int GetVertices (float level, int x, int y, int z, VETable& table);
-
-    void GetXMinEdges (int x, int y, int z, int type, VETable& table);
-    void GetXMaxEdges (int x, int y, int z, int type, VETable& table);
-    void GetYMinEdges (int x, int y, int z, int type, VETable& table);
-    void GetYMaxEdges (int x, int y, int z, int type, VETable& table);
-    void GetZMinEdges (int x, int y, int z, int type, VETable& table);
-    void GetZMaxEdges (int x, int y, int z, int type, VETable& table);
+    // The cube functions read the image values from 'slice', which points
+    // to the slice z of the cube; slice z+1 follows it.
+    int GetVertices (float level, const int* slice, int x, int y, int z,
+        VETable& table) const;
+
+    void GetXMinEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
+    void GetXMaxEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
+    void GetYMinEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
+    void GetYMaxEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
+    void GetZMinEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
+    void GetZMaxEdges (const int* slice, int x, int y, int type,
+        VETable& table) const;
 
     Vector3f GetGradient (Vector3f P);
 
+    // Support for ExtractContourIndexed.  A slab holds the cube layers
+    // ZMin <= z < ZMax with Data pointing to slice ZMin.  Its triangles
+    // index its own vertices, except that index -2-k refers to the vertex
+    // with plane key External[k] on the bottom plane of the next slab.  The
+    // vertices on the bottom plane of the slab are listed in Shared as
+    // (plane key, index) pairs sorted by key.  The plane key of a vertex on
+    // plane z is 3*(x+xbound*y)+kind for the x-edge, the y-edge and the
+    // z-face center (kind 0, 1, 2) at (x,y).
+    class Slab
+    {
+    public:
+        const int* Data;
+        int ZMin, ZMax;
+        std::vector<Vector3f> Vertices;
+        std::vector<TriangleKey> Triangles;
+        std::vector<int> External;
+        std::vector<std::pair<int,int> > Shared;
+    };
+
+    void ExtractSlabs (float level, SliceReader reader, void* userData,
+        std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles,
+        ThreadPool* pool);
+
+    void ExtractSlab (float level, Slab& slab, int* caches) const;
+
+    int GetSlabVertex (const VETable& table, int i, int base,
+        int* const* caches, bool bottomShared, bool topExternal,
+        Slab& slab) const;
+
+    void AppendSlab (Slab& slab, std::vector<int>& pendingKeys,
+        std::vector<TriangleKey>& pending, std::vector<Vector3f>& vertices,
+        std::vector<TriangleKey>& triangles) const;
+
+    class SlabTaskData
+    {
+    public:
+        const ExtractSurfaceCubes* Object;
+        float Level;
+        Slab* Slabs;
+        int* Caches;
+    };
+
+    static void SlabTask (int begin, int end, int worker, void* userData);
+
+    // The SliceReader for a TiledImageInt3D passed as 'userData'.
+    static void ReadTiledSlices (int zMin, int numSlices, int* slices,
+        void* userData);
+
+    // The cache of a table vertex: {cache, dx, dy, kind}.  Cache 0 and 1
+    // are the planes z and z+1 with the plane keys above.  Cache 2 is the
+    // layer, with kind 0 for the z-edge at (x,y) and kinds 1 and 2 for the
+    // x-face and y-face centers at (x,y).
+    static const int msCacheSlot[18][4];
+
     int mXBound, mYBound, mZBound, mXYBound;
     int* mData;
 };
@@ -4,11 +4,12 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5ExtractSurfaceTetra.h"
 #include "Wm5Assert.h"
+#include "Wm5Memory.h"
 using namespace Wm5;
 
 typedef std::map<Vector3f,int> VMap;
@@ -16,6 +17,126 @@ typedef VMap::iterator VMapIterator;
 typedef std::map<TriangleKey,int> TMap;
 typedef TMap::iterator TMapIterator;
 
+const int ExtractSurfaceTetra::msCorner[8][3] =
+{
+    { 0, 0, 0 },
+    { 1, 0, 0 },
+    { 1, 1, 0 },
+    { 0, 1, 0 },
+    { 0, 0, 1 },
+    { 1, 0, 1 },
+    { 1, 1, 1 },
+    { 0, 1, 1 }
+};
+
+const int ExtractSurfaceTetra::msTetrahedron[2][5][4] =
+{
+    {
+        { 0, 1, 3, 4 },
+        { 2, 3, 1, 6 },
+        { 5, 4, 6, 1 },
+        { 7, 6, 4, 3 },
+        { 6, 3, 1, 4 }
+    },
+    {
+        { 1, 2, 0, 5 },
+        { 3, 0, 2, 7 },
+        { 4, 7, 5, 0 },
+        { 6, 5, 7, 2 },
+        { 0, 7, 5, 2 }
+    }
+};
+
+const int ExtractSurfaceTetra::msEdge[6][2] =
+{
+    { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 }
+};
+
+const int ExtractSurfaceTetra::msTriangles[81][13] =
+{
+    { 0 },                              // ----
+    { 0 },                              // 0---
+    { 1,  4, 5, 6 },                    // +---
+    { 0 },                              // -0--
+    { 0 },                              // 00--
+    { 1,  5, 6, 1 },                    // +0--
+    { 1,  4, 7, 8 },                    // -+--
+    { 1,  7, 8, 0 },                    // 0+--
+    { 2,  5, 7, 6,  7, 8, 6 },          // ++--
+    { 0 },                              // --0-
+    { 0 },                              // 0-0-
+    { 1,  4, 6, 2 },                    // +-0-
+    { 0 },                              // -00-
+    { 1,  0, 1, 2 },                    // 000-
+    { 1,  6, 1, 2 },                    // +00-
+    { 1,  4, 8, 2 },                    // -+0-
+    { 1,  8, 0, 2 },                    // 0+0-
+    { 1,  6, 8, 2 },                    // ++0-
+    { 1,  5, 7, 9 },                    // --+-
+    { 1,  7, 9, 0 },                    // 0-+-
+    { 2,  4, 7, 6,  7, 9, 6 },          // +-+-
+    { 1,  5, 9, 1 },                    // -0+-
+    { 1,  9, 0, 1 },                    // 00+-
+    { 1,  6, 9, 1 },                    // +0+-
+    { 2,  4, 5, 8,  5, 9, 8 },          // -++-
+    { 1,  9, 8, 0 },                    // 0++-
+    { 1,  6, 8, 9 },                    // +++-
+    { 0 },                              // ---0
+    { 0 },                              // 0--0
+    { 1,  4, 5, 3 },                    // +--0
+    { 0 },                              // -0-0
+    { 1,  0, 1, 3 },                    // 00-0
+    { 1,  5, 1, 3 },                    // +0-0
+    { 1,  4, 7, 3 },                    // -+-0
+    { 1,  7, 0, 3 },                    // 0+-0
+    { 1,  5, 7, 3 },                    // ++-0
+    { 0 },                              // --00
+    { 1,  0, 2, 3 },                    // 0-00
+    { 1,  4, 2, 3 },                    // +-00
+    { 1,  1, 2, 3 },                    // -000
+    { 4,  0, 1, 2,  0, 1, 3,  0, 2, 3,  1, 2, 3 },  // 0000
+    { 1,  1, 2, 3 },                    // +000
+    { 1,  4, 2, 3 },                    // -+00
+    { 1,  0, 2, 3 },                    // 0+00
+    { 0 },                              // ++00
+    { 1,  5, 7, 3 },                    // --+0
+    { 1,  7, 0, 3 },                    // 0-+0
+    { 1,  4, 7, 3 },                    // +-+0
+    { 1,  5, 1, 3 },                    // -0+0
+    { 1,  0, 1, 3 },                    // 00+0
+    { 0 },                              // +0+0
+    { 1,  4, 5, 3 },                    // -++0
+    { 0 },                              // 0++0
+    { 0 },                              // +++0
+    { 1,  6, 8, 9 },                    // ---+
+    { 1,  9, 8, 0 },                    // 0--+
+    { 2,  4, 5, 8,  5, 9, 8 },          // +--+
+    { 1,  6, 9, 1 },                    // -0-+
+    { 1,  9, 0, 1 },                    // 00-+
+    { 1,  5, 9, 1 },                    // +0-+
+    { 2,  4, 7, 6,  7, 9, 6 },          // -+-+
+    { 1,  7, 9, 0 },                    // 0+-+
+    { 1,  5, 7, 9 },                    // ++-+
+    { 1,  6, 8, 2 },                    // --0+
+    { 1,  8, 0, 2 },                    // 0-0+
+    { 1,  4, 8, 2 },                    // +-0+
+    { 1,  6, 1, 2 },                    // -00+
+    { 1,  0, 1, 2 },                    // 000+
+    { 0 },                              // +00+
+    { 1,  4, 6, 2 },                    // -+0+
+    { 0 },                              // 0+0+
+    { 0 },                              // ++0+
+    { 2,  5, 7, 6,  7, 8, 6 },          // --++
+    { 1,  7, 8, 0 },                    // 0-++
+    { 1,  4, 7, 8 },                    // +-++
+    { 1,  5, 6, 1 },                    // -0++
+    { 0 },                              // 00++
+    { 0 },                              // +0++
+    { 1,  4, 5, 6 },                    // -+++
+    { 0 },                              // 0+++
+    { 0 }                               // ++++
+};
+
 //----------------------------------------------------------------------------
 ExtractSurfaceTetra::ExtractSurfaceTetra (int xBound, int yBound,
     int zBound, int* data)
@@ -444,6 +565,55 @@ void ExtractSurfaceTetra::ExtractContour (int level,
     }
 }
 //----------------------------------------------------------------------------
+void ExtractSurfaceTetra::ExtractContourIndexed (int level,
+    std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles,
+    ThreadPool* pool)
+{
+    vertices.clear();
+    triangles.clear();
+
+    const int numLayers = mZBound - 1;
+    if (mXBound < 2 || mYBound < 2 || numLayers < 1)
+    {
+        return;
+    }
+
+    const int numSlabs = (numLayers + SLAB_SIZE - 1)/SLAB_SIZE;
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+    int* caches = new1<int>(11*mXYBound*numWorkers);
+    Slab* slabs = new1<Slab>(numSlabs);
+    int s;
+    for (s = 0; s < numSlabs; ++s)
+    {
+        slabs[s].ZMin = s*SLAB_SIZE;
+        slabs[s].ZMax = slabs[s].ZMin + SLAB_SIZE;
+        if (slabs[s].ZMax > numLayers)
+        {
+            slabs[s].ZMax = numLayers;
+        }
+    }
+
+    SlabTaskData data;
+    data.Object = this;
+    data.Level = level;
+    data.Slabs = slabs;
+    data.Caches = caches;
+    ThreadPool::ParallelFor(pool, numSlabs, 1, SlabTask, &data);
+
+    // The triangles of the previous slab that reference vertices of the
+    // next one, and the plane keys of those vertices.
+    std::vector<TriangleKey> pending;
+    std::vector<int> pendingKeys;
+    for (s = 0; s < numSlabs; ++s)
+    {
+        AppendSlab(slabs[s], pendingKeys, pending, vertices, triangles);
+    }
+    assertion(pending.size() == 0, "Unresolved slab vertices\n");
+
+    delete1(slabs);
+    delete1(caches);
+}
+//----------------------------------------------------------------------------
 void ExtractSurfaceTetra::MakeUnique (std::vector<Vector3f>& vertices,
     std::vector<TriangleKey>& triangles)
 {
@@ -1270,6 +1440,346 @@ void ExtractSurfaceTetra::ProcessTetrahedron (VtxMap& vertexMap,
     }
 }
 //----------------------------------------------------------------------------
+void ExtractSurfaceTetra::ExtractSlab (int level, Slab& slab, int* caches)
+    const
+{
+    const int numPlaneSlots = 4*mXYBound;
+    const int numLayerSlots = 3*mXYBound;
+    SlabContext context;
+    context.S = &slab;
+    context.Cache[0] = caches;
+    context.Cache[1] = caches + numPlaneSlots;
+    context.Cache[2] = caches + 2*numPlaneSlots;
+    memset(context.Cache[0], 0xFF, numPlaneSlots*sizeof(int));
+
+    const bool lastSlab = (slab.ZMax == mZBound - 1);
+    for (int z = slab.ZMin; z < slab.ZMax; ++z)
+    {
+        if (z > slab.ZMin)
+        {
+            int* save = context.Cache[0];
+            context.Cache[0] = context.Cache[1];
+            context.Cache[1] = save;
+        }
+        memset(context.Cache[1], 0xFF, numPlaneSlots*sizeof(int));
+        memset(context.Cache[2], 0xFF, numLayerSlots*sizeof(int));
+
+        // The vertices on the bottom plane of a slab are shared with the
+        // previous slab, those on the top plane belong to the next slab.
+        context.Z = z;
+        context.BottomShared = (z == slab.ZMin && z > 0);
+        context.TopExternal = (z + 1 == slab.ZMax && !lastSlab);
+
+        for (int y = 0; y < mYBound-1; ++y)
+        {
+            for (int x = 0; x < mXBound-1; ++x)
+            {
+                int i000 = x + mXBound*(y + mYBound*z);
+                int f[8];
+                f[0] = mData[i000] - level;
+                f[1] = mData[i000 + 1] - level;
+                f[2] = mData[i000 + mXBound + 1] - level;
+                f[3] = mData[i000 + mXBound] - level;
+                f[4] = mData[i000 + mXYBound] - level;
+                f[5] = mData[i000 + mXYBound + 1] - level;
+                f[6] = mData[i000 + mXYBound + mXBound + 1] - level;
+                f[7] = mData[i000 + mXYBound + mXBound] - level;
+
+                int numPositive = 0, numNegative = 0, c;
+                for (c = 0; c < 8; ++c)
+                {
+                    if (f[c] > 0)
+                    {
+                        ++numPositive;
+                    }
+                    else if (f[c] < 0)
+                    {
+                        ++numNegative;
+                    }
+                }
+                if (numPositive == 8 || numNegative == 8)
+                {
+                    continue;
+                }
+                context.NumInterior = 0;
+
+                // A voxel with a zero value is a vertex even when it is not
+                // used by a triangle.
+                Vector3f position;
+                for (c = 0; c < 8; ++c)
+                {
+                    if (f[c] == 0)
+                    {
+                        AddSlabVertex(context, x, y, c, 0, -1, 0, position);
+                    }
+                }
+
+                const int parity = ((x & 1) ^ (y & 1) ^ (z & 1));
+                for (int t = 0; t < 5; ++t)
+                {
+                    ProcessSlabTetrahedron(context, x, y,
+                        msTetrahedron[parity][t], f);
+                }
+            }
+        }
+    }
+
+    std::sort(slab.Shared.begin(), slab.Shared.end());
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceTetra::ProcessSlabTetrahedron (SlabContext& context,
+    int x, int y, const int* corners, const int* f) const
+{
+    int pattern = 0;
+    int i;
+    for (i = 3; i >= 0; --i)
+    {
+        int value = f[corners[i]];
+        pattern = 3*pattern + (value > 0 ? 2 : (value == 0 ? 1 : 0));
+    }
+
+    const int* entry = msTriangles[pattern];
+    for (int t = 0; t < entry[0]; ++t)
+    {
+        const int* code = entry + 1 + 3*t;
+        if (code[0] < 4 && code[1] < 4 && code[2] < 4
+        &&  IsDuplicateFace(context, x, y, corners[code[0]],
+                corners[code[1]], corners[code[2]]))
+        {
+            continue;
+        }
+
+        int v[3];
+        Vector3f pos[3];
+        for (i = 0; i < 3; ++i)
+        {
+            if (code[i] < 4)
+            {
+                int c = corners[code[i]];
+                v[i] = AddSlabVertex(context, x, y, c, f[c], -1, 0, pos[i]);
+            }
+            else
+            {
+                const int* edge = msEdge[code[i] - 4];
+                int c0 = corners[edge[0]], c1 = corners[edge[1]];
+                v[i] = AddSlabVertex(context, x, y, c0, f[c0], c1, f[c1],
+                    pos[i]);
+            }
+        }
+
+        AddSlabTriangle(context, v[0], v[1], v[2], pos[0], pos[1], pos[2]);
+    }
+}
+//----------------------------------------------------------------------------
+int ExtractSurfaceTetra::AddSlabVertex (SlabContext& context, int x, int y,
+    int c0, int f0, int c1, int f1, Vector3f& position) const
+{
+    const int* offset0 = msCorner[c0];
+    int x0 = x + offset0[0];
+    int y0 = y + offset0[1];
+    int z0 = context.Z + offset0[2];
+
+    int cache, key;
+    if (c1 < 0)
+    {
+        // The voxel itself.
+        position = Vector3f((float)x0, (float)y0, (float)z0);
+        cache = offset0[2];
+        key = 4*(x0 + mXBound*y0);
+    }
+    else
+    {
+        // The root on the edge, computed as in ProcessTetrahedron.
+        const int* offset1 = msCorner[c1];
+        int x1 = x + offset1[0];
+        int y1 = y + offset1[1];
+        int z1 = context.Z + offset1[2];
+        int denom = f0 - f1;
+        int xNumer = f0*x1 - f1*x0;
+        int yNumer = f0*y1 - f1*y0;
+        int zNumer = f0*z1 - f1*z0;
+        if (denom < 0)
+        {
+            denom = -denom;
+            xNumer = -xNumer;
+            yNumer = -yNumer;
+            zNumer = -zNumer;
+        }
+        position = Vector3f(float(xNumer)/float(denom),
+            float(yNumer)/float(denom), float(zNumer)/float(denom));
+
+        int xMin = (x0 < x1 ? x0 : x1);
+        int yMin = (y0 < y1 ? y0 : y1);
+        if (offset0[2] == offset1[2])
+        {
+            // x-edge, y-edge or z-face diagonal in a plane.
+            cache = offset0[2];
+            key = 4*(xMin + mXBound*yMin) + (x0 != x1 ? 1 : 0) +
+                (y0 != y1 ? 2 : 0);
+        }
+        else
+        {
+            // z-edge, x-face diagonal or y-face diagonal in the layer.
+            cache = 2;
+            key = 3*(xMin + mXBound*yMin) + (x0 != x1 ? 2 : 0) +
+                (y0 != y1 ? 1 : 0);
+        }
+    }
+
+    Slab& slab = *context.S;
+    int& index = context.Cache[cache][key];
+    if (index == -1)
+    {
+        if (cache == 1 && context.TopExternal)
+        {
+            index = -2 - (int)slab.External.size();
+            slab.External.push_back(key);
+        }
+        else
+        {
+            index = (int)slab.Vertices.size();
+            slab.Vertices.push_back(position);
+            if (cache == 0 && context.BottomShared)
+            {
+                slab.Shared.push_back(std::make_pair(key, index));
+            }
+        }
+    }
+    return index;
+}
+//----------------------------------------------------------------------------
+bool ExtractSurfaceTetra::IsDuplicateFace (SlabContext& context, int x,
+    int y, int c0, int c1, int c2) const
+{
+    // A face on a side of the cube.  The cube across a lower side comes
+    // first and has produced the face, because the three voxels are zero.
+    const int origin[3] = { x, y, context.Z };
+    for (int d = 0; d < 3; ++d)
+    {
+        int side = msCorner[c0][d];
+        if (msCorner[c1][d] == side && msCorner[c2][d] == side)
+        {
+            return side == 0 && origin[d] > 0;
+        }
+    }
+
+    // A face inside the cube, shared by the central tetrahedron and a
+    // corner tetrahedron.
+    int mask = (1 << c0) | (1 << c1) | (1 << c2);
+    for (int i = 0; i < context.NumInterior; ++i)
+    {
+        if (context.Interior[i] == mask)
+        {
+            return true;
+        }
+    }
+    context.Interior[context.NumInterior++] = mask;
+    return false;
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceTetra::AddSlabTriangle (SlabContext& context, int v0,
+    int v1, int v2, const Vector3f& pos0, const Vector3f& pos1,
+    const Vector3f& pos2) const
+{
+    // Choose triangle orientation based on gradient direction, as in
+    // AddTriangle.
+    Vector3f edge0 = pos1 - pos0;
+    Vector3f edge1 = pos2 - pos0;
+    Vector3f normal = edge0.Cross(edge1);
+    Vector3f centroid = (pos0 + pos1 + pos2)/3.0f;
+    Vector3f grad = GetGradient(centroid);
+    TriangleKey tri;
+    if (grad.Dot(normal) <= 0.0f)
+    {
+        tri = TriangleKey(v0, v1, v2);
+    }
+    else
+    {
+        tri = TriangleKey(v0, v2, v1);
+    }
+
+    context.S->Triangles.push_back(tri);
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceTetra::AppendSlab (Slab& slab,
+    std::vector<int>& pendingKeys, std::vector<TriangleKey>& pending,
+    std::vector<Vector3f>& vertices, std::vector<TriangleKey>& triangles)
+    const
+{
+    const int offset = (int)vertices.size();
+    vertices.insert(vertices.end(), slab.Vertices.begin(),
+        slab.Vertices.end());
+
+    // Resolve the references of the previous slab to the bottom plane of
+    // this slab.
+    const int numPending = (int)pending.size();
+    int i, j;
+    for (i = 0; i < numPending; ++i)
+    {
+        TriangleKey& tri = pending[i];
+        for (j = 0; j < 3; ++j)
+        {
+            if (tri.V[j] < 0)
+            {
+                int key = pendingKeys[-2 - tri.V[j]];
+                std::vector<std::pair<int,int> >::iterator iter =
+                    std::lower_bound(slab.Shared.begin(), slab.Shared.end(),
+                    std::make_pair(key, -1));
+                assertion(iter != slab.Shared.end() && iter->first == key,
+                    "Unexpected condition\n");
+                tri.V[j] = offset + iter->second;
+            }
+        }
+        triangles.push_back(TriangleKey(tri.V[0], tri.V[1], tri.V[2]));
+    }
+    pending.clear();
+
+    const int numTriangles = (int)slab.Triangles.size();
+    for (i = 0; i < numTriangles; ++i)
+    {
+        TriangleKey tri = slab.Triangles[i];
+        bool external = false;
+        for (int k = 0; k < 3; ++k)
+        {
+            if (tri.V[k] >= 0)
+            {
+                tri.V[k] += offset;
+            }
+            else
+            {
+                external = true;
+            }
+        }
+
+        if (external)
+        {
+            pending.push_back(tri);
+        }
+        else
+        {
+            triangles.push_back(tri);
+        }
+    }
+    pendingKeys.swap(slab.External);
+
+    slab.Vertices.clear();
+    slab.Triangles.clear();
+    slab.External.clear();
+    slab.Shared.clear();
+}
+//----------------------------------------------------------------------------
+void ExtractSurfaceTetra::SlabTask (int begin, int end, int worker,
+    void* userData)
+{
+    SlabTaskData& data = *(SlabTaskData*)userData;
+    const ExtractSurfaceTetra* object = data.Object;
+    int* caches = data.Caches + 11*object->mXYBound*worker;
+    for (int s = begin; s < end; ++s)
+    {
+        object->ExtractSlab(data.Level, data.Slabs[s], caches);
+    }
+}
+//----------------------------------------------------------------------------
 ExtractSurfaceTetra::Vertex::Vertex (int xNumer, int xDenom, int yNumer,
     int yDenom, int zNumer, int zDenom)
 {
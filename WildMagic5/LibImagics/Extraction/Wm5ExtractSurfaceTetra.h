@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5EXTRACTSURFACETETRA_H
 #define WM5EXTRACTSURFACETETRA_H
@@ -13,6 +13,7 @@
 #include "Wm5Vector3.h"
 #include "Wm5EdgeKey.h"
 #include "Wm5TriangleKey.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -34,6 +35,26 @@ public:
     void ExtractContour (int level, std::vector<Vector3f>& vertices,
         std::vector<TriangleKey>& triangles);
 
+    // Extraction with integer vertex keys.  Every vertex is a voxel or lies
+    // on an edge of the tetrahedral decomposition, so it is identified by
+    // the voxel and the edge direction rather than by rational coordinates.
+    // The cubes are processed in slabs of SLAB_SIZE layers along z.  A
+    // slab indexes its vertices through flat tables for the planes z and
+    // z+1 and for the layer between them.  The vertices on the plane
+    // between two slabs belong to the upper slab and are resolved when the
+    // slabs are concatenated.  If 'pool' is not null, the slabs are
+    // processed concurrently; the caller retains ownership.  The output has
+    // the vertices and the oriented triangles of ExtractContour, in a
+    // different order, and it does not depend on the number of threads.
+    // Unlike ExtractContour, the image is not modified.
+    void ExtractContourIndexed (int level, std::vector<Vector3f>& vertices,
+        std::vector<TriangleKey>& triangles, ThreadPool* pool = 0);
+
+    enum
+    {
+        SLAB_SIZE = 16
+    };
+
     // The extraction has duplicate vertices on edges shared by voxels.  This
     // function will eliminate the duplication.
     void MakeUnique (std::vector<Vector3f>& vertices,
@@ -102,6 +123,87 @@ protected:
         int z1, int f1, int x2, int y2, int z2, int f2, int x3, int y3,
         int z3, int f3);
 
+    // Support for ExtractContourIndexed.  A slab holds the cube layers
+    // ZMin <= z < ZMax.  Its triangles index its own vertices, except that
+    // index -2-k refers to the vertex with plane key External[k] on the
+    // bottom plane of the next slab.  The vertices on the bottom plane of
+    // the slab are listed in Shared as (plane key, index) pairs sorted by
+    // key.
+    class Slab
+    {
+    public:
+        int ZMin, ZMax;
+        std::vector<Vector3f> Vertices;
+        std::vector<TriangleKey> Triangles;
+        std::vector<int> External;
+        std::vector<std::pair<int,int> > Shared;
+    };
+
+    // The state of a slab at layer Z.  Cache[0] and Cache[1] are the
+    // planes z and z+1 with four slots per voxel (x,y): the voxel, the
+    // x-edge, the y-edge and the z-face diagonal, so the plane key is
+    // 4*(x+xbound*y)+kind.  Cache[2] is the layer with three slots per
+    // voxel: the z-edge, the x-face diagonal and the y-face diagonal.
+    //
+    // Only the triangles with all vertices at voxels can be produced by two
+    // tetrahedra, which share the triangle as a face.  A face on a side of
+    // the cube is kept by the first of the two cubes in z-y-x order, so the
+    // cube drops it when it lies on a lower side that is not on the image
+    // boundary.  A face inside the cube is kept by the first tetrahedron;
+    // Interior lists the corner bit masks of the NumInterior faces that the
+    // current cube has produced.
+    class SlabContext
+    {
+    public:
+        Slab* S;
+        int* Cache[3];
+        int Z;
+        bool BottomShared, TopExternal;
+        int Interior[4], NumInterior;
+    };
+
+    void ExtractSlab (int level, Slab& slab, int* caches) const;
+
+    void ProcessSlabTetrahedron (SlabContext& context, int x, int y,
+        const int* corners, const int* f) const;
+
+    int AddSlabVertex (SlabContext& context, int x, int y, int c0, int f0,
+        int c1, int f1, Vector3f& position) const;
+
+    bool IsDuplicateFace (SlabContext& context, int x, int y, int c0,
+        int c1, int c2) const;
+
+    void AddSlabTriangle (SlabContext& context, int v0, int v1, int v2,
+        const Vector3f& pos0, const Vector3f& pos1, const Vector3f& pos2)
+        const;
+
+    void AppendSlab (Slab& slab, std::vector<int>& pendingKeys,
+        std::vector<TriangleKey>& pending, std::vector<Vector3f>& vertices,
+        std::vector<TriangleKey>& triangles) const;
+
+    class SlabTaskData
+    {
+    public:
+        const ExtractSurfaceTetra* Object;
+        int Level;
+        Slab* Slabs;
+        int* Caches;
+    };
+
+    static void SlabTask (int begin, int end, int worker, void* userData);
+
+    // The cube corners in the numbering of the tetrahedron comments, the
+    // tetrahedra of the cubes with even and odd parity x+y+z, and the
+    // triangles of a tetrahedron indexed by the signs of its function
+    // values (0 for negative, 1 for zero, 2 for positive, base 3 with
+    // corner 0 as the lowest digit).  A triangle entry is 0 to 3 for a
+    // corner and 4 to 9 for the edges 01, 02, 03, 12, 13, 23; the vertex
+    // order is the one used by ProcessTetrahedron.
+    static const int msCorner[8][3];
+    static const int msTetrahedron[2][5][4];
+    static const int msEdge[6][2];
+    static const int msTriangles[81][13];
+
     // Function and gradient evaluated using trilinear interpolation.
     float GetFunction (const Vector3f& P) const;
     Vector3f GetGradient (const Vector3f& P) const;
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5CurvatureFlow2.h"
@@ -18,6 +18,7 @@ CurvatureFlow2::CurvatureFlow2 (int xBound, int yBound, float xSpacing,
     PdeFilter2(xBound, yBound, xSpacing, ySpacing, data, mask, borderValue,
         scaleType)
 {
+    mConcurrentRows = true;
 }
 //----------------------------------------------------------------------------
 CurvatureFlow2::~CurvatureFlow2 ()
@@ -26,18 +27,47 @@ CurvatureFlow2::~CurvatureFlow2 ()
 //----------------------------------------------------------------------------
 void CurvatureFlow2::OnUpdate (int x, int y)
 {
-    LookUp9(x, y);
+    OnUpdateRow(x, x, y);
+}
+//----------------------------------------------------------------------------
+void CurvatureFlow2::OnUpdateRow (int xMin, int xMax, int y)
+{
+    // In the row name srcY and the value name uXY, the x and y offsets are
+    // in {m,z,p}, referring to subtract 1 (m), no change (z), or add 1 (p).
+    const float* srcM = mSrc[y-1];
+    const float* srcZ = mSrc[y];
+    const float* srcP = mSrc[y+1];
+    const bool* mask = (mMask ? mMask[y] : 0);
+    float* dst = mDst[y];
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
+
+        float umm = srcM[x-1];
+        float uzm = srcM[x];
+        float upm = srcM[x+1];
+        float umz = srcZ[x-1];
+        float uzz = srcZ[x];
+        float upz = srcZ[x+1];
+        float ump = srcP[x-1];
+        float uzp = srcP[x];
+        float upp = srcP[x+1];
 
-    float ux = mHalfInvDx*(mUpz - mUmz);
-    float uy = mHalfInvDy*(mUzp - mUzm);
-    float uxx = mInvDxDx*(mUpz - 2.0f*mUzz + mUmz);
-    float uxy = mFourthInvDxDy*(mUmm + mUpp - mUmp - mUpm);
-    float uyy = mInvDyDy*(mUzp - 2.0f*mUzz + mUzm);
+        float ux = mHalfInvDx*(upz - umz);
+        float uy = mHalfInvDy*(uzp - uzm);
+        float uxx = mInvDxDx*(upz - 2.0f*uzz + umz);
+        float uxy = mFourthInvDxDy*(umm + upp - ump - upm);
+        float uyy = mInvDyDy*(uzp - 2.0f*uzz + uzm);
 
-    float sqrUx = ux*ux;
-    float sqrUy = uy*uy;
-    float sqrLength = sqrUx + sqrUy + 1e-08f;  // prevent zero division
-    mDst[y][x] = mUzz + mTimeStep*(uxx*sqrUy + uyy*sqrUx -
-        0.5f*uxy*ux*uy)/sqrLength;
+        float sqrUx = ux*ux;
+        float sqrUy = uy*uy;
+        float sqrLength = sqrUx + sqrUy + 1e-08f;  // prevent zero division
+        dst[x] = uzz + mTimeStep*(uxx*sqrUy + uyy*sqrUx -
+            0.5f*uxy*ux*uy)/sqrLength;
+    }
 }
 //----------------------------------------------------------------------------
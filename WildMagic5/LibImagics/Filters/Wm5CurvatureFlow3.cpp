@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5CurvatureFlow3.h"
@@ -18,6 +18,7 @@ CurvatureFlow3::CurvatureFlow3 (int xBound, int yBound, int zBound,
     PdeFilter3(xBound,yBound,zBound,xSpacing,ySpacing,zSpacing,data,
         mask,borderValue,scaleType)
 {
+    mConcurrentRows = true;
 }
 //----------------------------------------------------------------------------
 CurvatureFlow3::~CurvatureFlow3 ()
@@ -26,25 +27,71 @@ CurvatureFlow3::~CurvatureFlow3 ()
 //----------------------------------------------------------------------------
 void CurvatureFlow3::OnUpdate (int x, int y, int z)
 {
-    LookUp27(x, y, z);
+    OnUpdateRow(x, x, y, z);
+}
+//----------------------------------------------------------------------------
+void CurvatureFlow3::OnUpdateRow (int xMin, int xMax, int y, int z)
+{
+    // In the row name srcYZ and the value name uXYZ, the x, y and z offsets
+    // are in {m,z,p}, referring to subtract 1 (m), no change (z), or add 1
+    // (p).
+    const float* srcMM = mSrc[z-1][y-1];
+    const float* srcZM = mSrc[z-1][y];
+    const float* srcPM = mSrc[z-1][y+1];
+    const float* srcMZ = mSrc[z][y-1];
+    const float* srcZZ = mSrc[z][y];
+    const float* srcPZ = mSrc[z][y+1];
+    const float* srcMP = mSrc[z+1][y-1];
+    const float* srcZP = mSrc[z+1][y];
+    const float* srcPP = mSrc[z+1][y+1];
+    const bool* mask = (mMask ? mMask[z][y] : 0);
+    float* dst = mDst[z][y];
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
+
+        float uzmm = srcMM[x];
+        float umzm = srcZM[x-1];
+        float uzzm = srcZM[x];
+        float upzm = srcZM[x+1];
+        float uzpm = srcPM[x];
+        float ummz = srcMZ[x-1];
+        float uzmz = srcMZ[x];
+        float upmz = srcMZ[x+1];
+        float umzz = srcZZ[x-1];
+        float uzzz = srcZZ[x];
+        float upzz = srcZZ[x+1];
+        float umpz = srcPZ[x-1];
+        float uzpz = srcPZ[x];
+        float uppz = srcPZ[x+1];
+        float uzmp = srcMP[x];
+        float umzp = srcZP[x-1];
+        float uzzp = srcZP[x];
+        float upzp = srcZP[x+1];
+        float uzpp = srcPP[x];
 
-    float ux = mHalfInvDx*(mUpzz - mUmzz);
-    float uy = mHalfInvDy*(mUzpz - mUzmz);
-    float uz = mHalfInvDz*(mUzzp - mUzzm);
-    float uxx = mInvDxDx*(mUpzz - 2.0f*mUzzz + mUmzz);
-    float uxy = mFourthInvDxDy*(mUmmz + mUppz - mUpmz - mUmpz);
-    float uxz = mFourthInvDxDz*(mUmzm + mUpzp - mUpzm - mUmzp);
-    float uyy = mInvDyDy*(mUzpz - 2.0f*mUzzz + mUzmz);
-    float uyz = mFourthInvDyDz*(mUzmm+ mUzpp - mUzpm  - mUzmp);
-    float uzz = mInvDzDz*(mUzzp - 2.0f*mUzzz + mUzzm);
+        float ux = mHalfInvDx*(upzz - umzz);
+        float uy = mHalfInvDy*(uzpz - uzmz);
+        float uz = mHalfInvDz*(uzzp - uzzm);
+        float uxx = mInvDxDx*(upzz - 2.0f*uzzz + umzz);
+        float uxy = mFourthInvDxDy*(ummz + uppz - upmz - umpz);
+        float uxz = mFourthInvDxDz*(umzm + upzp - upzm - umzp);
+        float uyy = mInvDyDy*(uzpz - 2.0f*uzzz + uzmz);
+        float uyz = mFourthInvDyDz*(uzmm+ uzpp - uzpm  - uzmp);
+        float uzz = mInvDzDz*(uzzp - 2.0f*uzzz + uzzm);
 
-    float gradMagSqr = ux*ux + uy*uy + uz*uz;
-    float numer0 = uy*(uxx*uy - uxy*ux) + ux*(uyy*ux - uxy*uy);
-    float numer1 = uz*(uxx*uz - uxz*ux) + ux*(uzz*ux - uxz*uz);
-    float numer2 = uz*(uyy*uz - uyz*uy) + uy*(uzz*uy - uyz*uz);
-    float denom = gradMagSqr + 1e-08f;  // prevent zero division
-    float curvatureLength = (numer0 + numer1 + numer2)/denom;
+        float gradMagSqr = ux*ux + uy*uy + uz*uz;
+        float numer0 = uy*(uxx*uy - uxy*ux) + ux*(uyy*ux - uxy*uy);
+        float numer1 = uz*(uxx*uz - uxz*ux) + ux*(uzz*ux - uxz*uz);
+        float numer2 = uz*(uyy*uz - uyz*uy) + uy*(uzz*uy - uyz*uz);
+        float denom = gradMagSqr + 1e-08f;  // prevent zero division
+        float curvatureLength = (numer0 + numer1 + numer2)/denom;
 
-    mDst[z][y][x] = mUzzz + mTimeStep*curvatureLength;
+        dst[x] = uzzz + mTimeStep*curvatureLength;
+    }
 }
 //----------------------------------------------------------------------------
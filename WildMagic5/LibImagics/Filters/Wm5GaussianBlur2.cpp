@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5GaussianBlur2.h"
@@ -19,6 +19,7 @@ GaussianBlur2::GaussianBlur2 (int xBound, int yBound, float xSpacing,
         scaleType)
 {
     mMaximumTimeStep = 0.5f/(mInvDxDx + mInvDyDy);
+    mConcurrentRows = true;
 }
 //----------------------------------------------------------------------------
 GaussianBlur2::~GaussianBlur2 ()
@@ -32,11 +33,35 @@ float GaussianBlur2::GetMaximumTimeStep () const
 //----------------------------------------------------------------------------
 void GaussianBlur2::OnUpdate (int x, int y)
 {
-    LookUp5(x, y);
+    OnUpdateRow(x, x, y);
+}
+//----------------------------------------------------------------------------
+void GaussianBlur2::OnUpdateRow (int xMin, int xMax, int y)
+{
+    const float* srcM = mSrc[y-1];
+    const float* srcZ = mSrc[y];
+    const float* srcP = mSrc[y+1];
+    const bool* mask = (mMask ? mMask[y] : 0);
+    float* dst = mDst[y];
+
+    // Copies of the members, so that the compiler need not reload them
+    // after each store to dst.
+    const float invDxDx = mInvDxDx;
+    const float invDyDy = mInvDyDy;
+    const float timeStep = mTimeStep;
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
 
-    float uxx = mInvDxDx*(mUpz - 2.0f*mUzz + mUmz);
-    float uyy = mInvDyDy*(mUzp - 2.0f*mUzz + mUzm);
+        float uzz = srcZ[x];
+        float uxx = invDxDx*(srcZ[x+1] - 2.0f*uzz + srcZ[x-1]);
+        float uyy = invDyDy*(srcP[x] - 2.0f*uzz + srcM[x]);
 
-    mDst[y][x] = mUzz + mTimeStep*(uxx + uyy);
+        dst[x] = uzz + timeStep*(uxx + uyy);
+    }
 }
 //----------------------------------------------------------------------------
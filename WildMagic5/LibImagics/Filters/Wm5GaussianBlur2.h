@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5GAUSSIANBLUR2_H
 #define WM5GAUSSIANBLUR2_H
@@ -28,6 +28,7 @@ public:
 
 protected:
     virtual void OnUpdate (int x, int y);
+    virtual void OnUpdateRow (int xMin, int xMax, int y);
 
     float mMaximumTimeStep;
 };
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5GaussianBlur3.h"
@@ -19,6 +19,7 @@ GaussianBlur3::GaussianBlur3 (int xBound, int yBound, int zBound,
         mask, borderValue, scaleType)
 {
     mMaximumTimeStep = 0.5f/(mInvDxDx + mInvDyDy + mInvDzDz);
+    mConcurrentRows = true;
 }
 //----------------------------------------------------------------------------
 GaussianBlur3::~GaussianBlur3 ()
@@ -32,12 +33,41 @@ float GaussianBlur3::GetMaximumTimeStep () const
 //----------------------------------------------------------------------------
 void GaussianBlur3::OnUpdate (int x, int y, int z)
 {
-    LookUp7(x, y, z);
+    OnUpdateRow(x, x, y, z);
+}
+//----------------------------------------------------------------------------
+void GaussianBlur3::OnUpdateRow (int xMin, int xMax, int y, int z)
+{
+    // In the row name srcYZ, the y and z offsets are in {m,z,p}, referring
+    // to subtract 1 (m), no change (z), or add 1 (p).
+    const float* srcZM = mSrc[z-1][y];
+    const float* srcMZ = mSrc[z][y-1];
+    const float* srcZZ = mSrc[z][y];
+    const float* srcPZ = mSrc[z][y+1];
+    const float* srcZP = mSrc[z+1][y];
+    const bool* mask = (mMask ? mMask[z][y] : 0);
+    float* dst = mDst[z][y];
+
+    // Copies of the members, so that the compiler need not reload them
+    // after each store to dst.
+    const float invDxDx = mInvDxDx;
+    const float invDyDy = mInvDyDy;
+    const float invDzDz = mInvDzDz;
+    const float timeStep = mTimeStep;
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
 
-    float uxx = mInvDxDx*(mUpzz - 2.0f*mUzzz + mUmzz);
-    float uyy = mInvDyDy*(mUzpz - 2.0f*mUzzz + mUzmz);
-    float uzz = mInvDzDz*(mUzzp - 2.0f*mUzzz + mUzzm);
+        float uzzz = srcZZ[x];
+        float uxx = invDxDx*(srcZZ[x+1] - 2.0f*uzzz + srcZZ[x-1]);
+        float uyy = invDyDy*(srcPZ[x] - 2.0f*uzzz + srcMZ[x]);
+        float uzz = invDzDz*(srcZP[x] - 2.0f*uzzz + srcZM[x]);
 
-    mDst[z][y][x] = mUzzz + mTimeStep*(uxx + uyy + uzz);
+        dst[x] = uzzz + timeStep*(uxx + uyy + uzz);
+    }
 }
 //----------------------------------------------------------------------------
@@ -0,0 +1,412 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5ImagicsPCH.h"
+#include "Wm5GaussianFilter.h"
+#include "Wm5Memory.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+GaussianFilter<Real>::GaussianFilter (Real sigma, Method method,
+    int numBoxes)
+    :
+    mSigma(sigma),
+    mMethod(method),
+    mNumBoxes(numBoxes),
+    mRadius(0),
+    mInner((Real)1),
+    mOuter((Real)0)
+{
+    assertion(sigma > (Real)0, "The standard deviation must be positive\n");
+
+    const double s = (double)sigma;
+    if (mMethod == GF_RECURSIVE)
+    {
+        assertion(s >= 0.5, "GF_RECURSIVE requires sigma >= 0.5\n");
+
+        // The coefficients of Young and van Vliet, normalized so that the
+        // gain at zero frequency is 1.  Their q(sigma) fits the shape of the
+        // Gaussian, not its variance; the slowly decaying tails of the
+        // recursive filter make its variance about 20 percent larger.
+        double q;
+        if (s >= 2.5)
+        {
+            q = 0.98711*s - 0.96330;
+        }
+        else
+        {
+            q = 3.97156 - 4.14554*sqrt(1.0 - 0.26891*s);
+        }
+        double q2 = q*q, q3 = q2*q;
+        double b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3;
+        double a[3];
+        a[0] = (2.44413*q + 2.85619*q2 + 1.26661*q3)/b0;
+        a[1] = -(1.4281*q2 + 1.26661*q3)/b0;
+        a[2] = 0.422205*q3/b0;
+        double b = 1.0 - (a[0] + a[1] + a[2]);
+        mB = (Real)b;
+        mA[0] = (Real)a[0];
+        mA[1] = (Real)a[1];
+        mA[2] = (Real)a[2];
+
+        // The initial state of the anticausal pass.  Beyond the end of a
+        // line the input equals the last value, so the deviations of the
+        // causal and anticausal values from it satisfy the recurrences with
+        // zero input and decay to zero.  Column j of the matrix is the
+        // anticausal state that results from a unit deviation of the j-th
+        // last causal value, found by running the recurrences until the
+        // deviations are negligible.
+        for (int j = 0; j < 3; ++j)
+        {
+            std::vector<double> w(3, 0.0);
+            w[2 - j] = 1.0;
+            const int maxLength = 1 << 24;
+            for (int k = 3; k < maxLength; ++k)
+            {
+                w.push_back(a[0]*w[k-1] + a[1]*w[k-2] + a[2]*w[k-3]);
+                if (fabs(w[k]) + fabs(w[k-1]) + fabs(w[k-2]) < 1e-20)
+                {
+                    break;
+                }
+            }
+
+            // w[2] is the last causal value of the line, w[3] the first
+            // value beyond the end.
+            const int numW = (int)w.size();
+            std::vector<double> y(numW + 3, 0.0);
+            for (int k = numW - 1; k >= 3; --k)
+            {
+                y[k] = b*w[k] + a[0]*y[k+1] + a[1]*y[k+2] + a[2]*y[k+3];
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+                mBoundary[i][j] = (Real)y[3 + i];
+            }
+        }
+    }
+    else
+    {
+        assertion(numBoxes > 0, "The number of boxes must be positive\n");
+        for (int i = 0; i < 3; ++i)
+        {
+            mA[i] = (Real)0;
+            for (int j = 0; j < 3; ++j)
+            {
+                mBoundary[i][j] = (Real)0;
+            }
+        }
+        mB = (Real)1;
+
+        // The box of radius r has variance r*(r+1)/3.  The radius is the
+        // largest one whose variance does not exceed that of one box of the
+        // cascade, and the end weight alpha makes up the difference.
+        double variance = s*s/(double)numBoxes;
+        mRadius = (int)floor(0.5*(sqrt(12.0*variance + 1.0) - 1.0));
+        double r = (double)mRadius;
+        double alpha = (2.0*r + 1.0)*(variance - r*(r + 1.0)/3.0)/
+            (2.0*((r + 1.0)*(r + 1.0) - variance));
+        if (alpha < 0.0)
+        {
+            alpha = 0.0;
+        }
+        double inner = 1.0/(2.0*alpha + 2.0*r + 1.0);
+        mInner = (Real)inner;
+        mOuter = (Real)(alpha*inner);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void GaussianFilter<Real>::Execute (int bound0, int bound1, int bound2,
+    Real* data, ThreadPool* pool) const
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        ExecuteAxis(axis, bound0, bound1, bound2, data, pool);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void GaussianFilter<Real>::ExecuteAxis (int axis, int bound0, int bound1,
+    int bound2, Real* data, ThreadPool* pool) const
+{
+    assertion(0 <= axis && axis < 3, "Invalid axis\n");
+    const int bounds[3] = { bound0, bound1, bound2 };
+    const int n = bounds[axis];
+    if (n <= 1 || bound0 <= 0 || bound1 <= 0 || bound2 <= 0)
+    {
+        // Lines of one sample are unchanged by the constant extension.
+        return;
+    }
+
+    Context context;
+    context.Filter = this;
+    context.Bound0 = bound0;
+    context.Bound1 = bound1;
+    context.Bound2 = bound2;
+    context.Axis = axis;
+    context.Data = data;
+    if (mMethod == GF_RECURSIVE)
+    {
+        context.Padding = 3;
+        context.ScratchSize = (n + 6)*BLOCK_SIZE;
+    }
+    else
+    {
+        context.Padding = mNumBoxes*(mRadius + 1);
+        context.ScratchSize = 2*(n + 2*context.Padding)*BLOCK_SIZE;
+    }
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+    context.Scratch = new1<Real>(numWorkers*context.ScratchSize);
+
+    int numItems;
+    if (axis == 0)
+    {
+        numItems = (bound1*bound2 + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    }
+    else if (axis == 1)
+    {
+        numItems = bound2*((bound0 + BLOCK_SIZE - 1)/BLOCK_SIZE);
+    }
+    else
+    {
+        numItems = (bound0*bound1 + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    }
+    ThreadPool::ParallelFor(pool, numItems, 0, LineTask, &context);
+
+    delete1(context.Scratch);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void GaussianFilter<Real>::LineTask (int begin, int end, int worker,
+    void* userData)
+{
+    const Context& context = *(const Context*)userData;
+    const GaussianFilter& filter = *context.Filter;
+    const int bound0 = context.Bound0;
+    const int bound1 = context.Bound1;
+
+    // The lines of axis 0 are the rows, indexed by (y,z); their samples
+    // are adjacent.  The lines of axis 1 are indexed by (x,z) and those of
+    // axis 2 by (x,y); the samples of adjacent lines at the same position
+    // are adjacent.
+    int n, stride, lineStride, numLines;
+    if (context.Axis == 0)
+    {
+        n = bound0;
+        stride = 1;
+        lineStride = bound0;
+        numLines = bound1*context.Bound2;
+    }
+    else if (context.Axis == 1)
+    {
+        n = bound1;
+        stride = bound0;
+        lineStride = 1;
+        numLines = bound0;
+    }
+    else
+    {
+        n = context.Bound2;
+        stride = bound0*bound1;
+        lineStride = 1;
+        numLines = stride;
+    }
+    const int numBlocks = (numLines + BLOCK_SIZE - 1)/BLOCK_SIZE;
+
+    Real* block = context.Scratch + worker*context.ScratchSize;
+    Real* temp = block + (n + 2*context.Padding)*BLOCK_SIZE;
+    Real* first = block + context.Padding*BLOCK_SIZE;
+
+    for (int item = begin; item < end; ++item)
+    {
+        int line0 = (item % numBlocks)*BLOCK_SIZE;
+        int numBlockLines = numLines - line0;
+        if (numBlockLines > BLOCK_SIZE)
+        {
+            numBlockLines = BLOCK_SIZE;
+        }
+        Real* lines = context.Data + line0*lineStride;
+        if (context.Axis == 1)
+        {
+            lines += bound0*bound1*(item / numBlocks);
+        }
+
+        // Interleave the lines.  The unused lanes of a partial block
+        // repeat the first line so that all lanes hold valid numbers.
+        int u, i, j;
+        Real* row = first;
+        for (u = 0, i = 0; u < n; ++u, i += stride, row += BLOCK_SIZE)
+        {
+            for (j = 0; j < numBlockLines; ++j)
+            {
+                row[j] = lines[i + j*lineStride];
+            }
+            for (/**/; j < BLOCK_SIZE; ++j)
+            {
+                row[j] = row[0];
+            }
+        }
+
+        const Real* result;
+        if (filter.mMethod == GF_RECURSIVE)
+        {
+            result = filter.Recursive(n, block);
+        }
+        else
+        {
+            result = filter.Box(n, block, temp);
+        }
+
+        for (u = 0, i = 0; u < n; ++u, i += stride, result += BLOCK_SIZE)
+        {
+            for (j = 0; j < numBlockLines; ++j)
+            {
+                lines[i + j*lineStride] = result[j];
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real* GaussianFilter<Real>::Recursive (int n, Real* block) const
+{
+    const int bs = BLOCK_SIZE;
+    const Real b = mB, a0 = mA[0], a1 = mA[1], a2 = mA[2];
+    Real* first = block + 3*bs;
+    Real* last = first + (n - 1)*bs;
+    Real* beyond = last + bs;
+    int j;
+
+    // The input beyond the start of a line equals the first sample, which
+    // is then also the causal value there.  The last sample is saved in
+    // the rows beyond the end, which the causal pass does not use.
+    for (j = 0; j < bs; ++j)
+    {
+        block[j] = first[j];
+        block[bs + j] = first[j];
+        block[2*bs + j] = first[j];
+        beyond[j] = last[j];
+    }
+
+    // The causal pass, in place.
+    Real* w = first;
+    for (int u = 0; u < n; ++u, w += bs)
+    {
+        for (j = 0; j < bs; ++j)
+        {
+            w[j] = b*w[j] + a0*w[j-bs] + a1*w[j-2*bs] + a2*w[j-3*bs];
+        }
+    }
+
+    // The anticausal values beyond the end.
+    for (j = 0; j < bs; ++j)
+    {
+        Real value = beyond[j];
+        Real d0 = last[j] - value;
+        Real d1 = last[j-bs] - value;
+        Real d2 = last[j-2*bs] - value;
+        for (int i = 2; i >= 0; --i)
+        {
+            beyond[i*bs + j] = value + mBoundary[i][0]*d0 +
+                mBoundary[i][1]*d1 + mBoundary[i][2]*d2;
+        }
+    }
+
+    // The anticausal pass, in place.
+    w = last;
+    for (int u = n - 1; u >= 0; --u, w -= bs)
+    {
+        for (j = 0; j < bs; ++j)
+        {
+            w[j] = b*w[j] + a0*w[j+bs] + a1*w[j+2*bs] + a2*w[j+3*bs];
+        }
+    }
+
+    return first;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real* GaussianFilter<Real>::Box (int n, Real* block, Real* temp) const
+{
+    const int bs = BLOCK_SIZE;
+    const int r1 = mRadius + 1;
+    const int padding = mNumBoxes*r1;
+    const int numRows = n + 2*padding;
+    const Real inner = mInner, outer = mOuter;
+    int u, j;
+
+    // Extend the lines by their end values.
+    Real* first = block + padding*bs;
+    Real* last = first + (n - 1)*bs;
+    for (u = 1; u <= padding; ++u)
+    {
+        memcpy(first - u*bs, first, bs*sizeof(Real));
+        memcpy(last + u*bs, last, bs*sizeof(Real));
+    }
+
+    // Each box shortens the extended range by r1 rows at both ends.  After
+    // the last box, the range is that of the lines.  The sums of the inner
+    // samples are updated incrementally.
+    Real* source = block;
+    Real* target = temp;
+    for (int box = 0; box < mNumBoxes; ++box)
+    {
+        const int uMin = (box + 1)*r1;
+        const int uMax = numRows - (box + 1)*r1;
+
+        Real sum[BLOCK_SIZE];
+        for (j = 0; j < bs; ++j)
+        {
+            sum[j] = (Real)0;
+        }
+        const Real* row = source + (uMin - mRadius)*bs;
+        for (u = -mRadius; u <= mRadius; ++u, row += bs)
+        {
+            for (j = 0; j < bs; ++j)
+            {
+                sum[j] += row[j];
+            }
+        }
+
+        Real* result = target + uMin*bs;
+        const Real* add = source + (uMin + r1)*bs;
+        const Real* sub = source + (uMin - r1)*bs;
+        for (u = uMin; u < uMax; ++u, result += bs, add += bs, sub += bs)
+        {
+            // The results go through a local array, so that the compiler
+            // need not assume that the stores modify the sources.
+            Real output[BLOCK_SIZE];
+            for (j = 0; j < bs; ++j)
+            {
+                output[j] = inner*sum[j] + outer*(sub[j] + add[j]);
+                sum[j] += add[j] - sub[j+bs];
+            }
+            memcpy(result, output, bs*sizeof(Real));
+        }
+
+        Real* save = source;
+        source = target;
+        target = save;
+    }
+
+    return source + padding*bs;
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_IMAGICS_ITEM
+class GaussianFilter<float>;
+
+template WM5_IMAGICS_ITEM
+class GaussianFilter<double>;
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,139 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5GAUSSIANFILTER_H
+#define WM5GAUSSIANFILTER_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5ThreadPool.h"
+
+// Gaussian smoothing at a cost per voxel that does not depend on the
+// standard deviation.  GaussianBlur2 and GaussianBlur3 iterate the heat
+// equation, and the stable time step limits each pass to a variance of
+// 1/d square pixels in dimension d, so a standard deviation sigma costs
+// d*sigma^2 passes.  This filter is separable; the lines of each axis are
+// smoothed by one of two 1D approximations of the Gaussian.
+//
+// GF_RECURSIVE is the third-order recursive filter of Young and van Vliet,
+// "Recursive implementation of the Gaussian filter", Signal Processing 44
+// (1995), a causal pass followed by an anticausal pass.  It requires
+// sigma >= 0.5.
+//
+// GF_BOX is a cascade of extended box filters, Gwosdek, Grewenig, Bruhn
+// and Weickert, "Theoretical foundations of Gaussian convolution by
+// extended box filtering", SSVM 2011.  Each box has an integer radius and
+// fractional end weights, chosen so that the variance of the cascade is
+// exactly sigma^2.  More boxes are smoother and closer to the Gaussian.
+//
+// Both methods treat the image as extended by the values at its faces, so
+// a constant image is unchanged.  The initial state of the anticausal pass
+// is computed exactly for this extension (Triggs and Sdika, "Boundary
+// conditions for Young-van Vliet recursive filtering", IEEE Trans. Signal
+// Processing 54 (2006)).  GaussianBlur2/3 instead take the values beyond
+// the faces from the border of PdeFilter2/3, so the results differ within a
+// few sigma of the faces.
+//
+// Accuracy, as the maximum difference from a sampled Gaussian impulse
+// response relative to its peak:  GF_RECURSIVE 5.2e-2 at sigma = 2,
+// 3.4e-2 at sigma = 4, 2.5e-2 at sigma = 8 and 1.7e-2 at sigma = 16.  The
+// recursive filter fits the shape of the Gaussian, but its tails make the
+// variance about 1.23*sigma^2.  GF_BOX has variance exactly sigma^2 and
+// errors of 4e-2 to 6e-2 with 3 boxes and 3e-2 with 5 boxes for sigma >= 2.
+// GaussianBlur3 run at its maximum time step leaves an odd-even pattern
+// on an impulse; at a quarter of that step its error is 1.4e-2 at
+// sigma = 4, where GF_RECURSIVE in 3D has 5.6e-2.
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_IMAGICS_ITEM GaussianFilter
+{
+public:
+    enum Method
+    {
+        GF_RECURSIVE,
+        GF_BOX
+    };
+
+    // Construction.  The standard deviation is in pixels.  The number of
+    // boxes is used only by GF_BOX.
+    GaussianFilter (Real sigma, Method method = GF_RECURSIVE,
+        int numBoxes = 3);
+
+    // Member access.
+    inline Real GetSigma () const;
+    inline Method GetMethod () const;
+
+    // Smooth an image in place.  The image has bound0 columns, bound1 rows
+    // and bound2 slices, with voxel (x,y,z) stored at index
+    // x+bound0*(y+bound1*z); a 2D image has bound2 = 1 and a 1D image has
+    // bound1 = bound2 = 1.  ExecuteAxis smooths along one axis only.  The
+    // lines of an axis are processed in blocks of BLOCK_SIZE adjacent
+    // lines, which are interleaved in contiguous storage so that the inner
+    // loops of the recurrences run across the lines of a block and may be
+    // vectorized by the compiler.  If 'pool' is not null, the blocks are
+    // processed concurrently; the result does not depend on the number of
+    // threads.
+    void Execute (int bound0, int bound1, int bound2, Real* data,
+        ThreadPool* pool = 0) const;
+
+    void ExecuteAxis (int axis, int bound0, int bound1, int bound2,
+        Real* data, ThreadPool* pool = 0) const;
+
+    enum
+    {
+        BLOCK_SIZE = 16
+    };
+
+private:
+    class Context
+    {
+    public:
+        const GaussianFilter* Filter;
+        int Bound0, Bound1, Bound2, Axis, Padding;
+        Real* Data;
+
+        // Per-worker storage for a block of lines, ScratchSize reals each.
+        Real* Scratch;
+        int ScratchSize;
+    };
+
+    static void LineTask (int begin, int end, int worker, void* userData);
+
+    // Smooth a block of n-sample lines.  Sample u of line j is
+    // block[(u+padding)*BLOCK_SIZE+j], where the padding is 3 rows for
+    // GF_RECURSIVE and mNumBoxes*(mRadius+1) rows for GF_BOX at both ends.
+    // The functions return a pointer to sample 0 of the smoothed lines.
+    Real* Recursive (int n, Real* block) const;
+    Real* Box (int n, Real* block, Real* temp) const;
+
+    Real mSigma;
+    Method mMethod;
+
+    // GF_RECURSIVE:  w[u] = mB*x[u] + mA[0]*w[u-1] + mA[1]*w[u-2] +
+    // mA[2]*w[u-3] for the causal pass and the same recurrence in the
+    // opposite direction for the anticausal pass.  The anticausal values
+    // beyond the end of a line are mBoundary times the deviations of the
+    // last three causal values from the last input value.
+    Real mB, mA[3], mBoundary[3][3];
+
+    // GF_BOX:  The inner samples of a box have weight mInner and the two
+    // samples at distance mRadius+1 from the center have weight mOuter.
+    int mNumBoxes, mRadius;
+    Real mInner, mOuter;
+};
+
+#include "Wm5GaussianFilter.inl"
+
+typedef GaussianFilter<float> GaussianFilterf;
+typedef GaussianFilter<double> GaussianFilterd;
+
+}
+
+#endif
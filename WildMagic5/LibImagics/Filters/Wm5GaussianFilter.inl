@@ -0,0 +1,22 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+template <typename Real>
+inline Real GaussianFilter<Real>::GetSigma () const
+{
+    return mSigma;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+inline typename GaussianFilter<Real>::Method
+GaussianFilter<Real>::GetMethod () const
+{
+    return mMethod;
+}
+//----------------------------------------------------------------------------
@@ -4,10 +4,11 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5GradientAnisotropic2.h"
+#include "Wm5Memory.h"
 #include "Wm5Math.h"
 using namespace Wm5;
 
@@ -20,24 +21,29 @@ GradientAnisotropic2::GradientAnisotropic2 (int xBound, int yBound,
         scaleType)
 {
     mK = K;
+    mConcurrentRows = true;
+    mRowSums = new1<float>(mYBound);
     ComputeParam();
 }
 //----------------------------------------------------------------------------
 GradientAnisotropic2::~GradientAnisotropic2 ()
 {
+    delete1(mRowSums);
 }
 //----------------------------------------------------------------------------
 void GradientAnisotropic2::ComputeParam ()
 {
+    // The squared gradient lengths are summed for each row, concurrently
+    // when a thread pool is set.  The row sums are added in order, so the
+    // result does not depend on the number of threads.  When the narrow
+    // band is enabled, the sums of the rows outside the band are those of
+    // the previous pass.
+    ThreadPool::ParallelFor(mPool, mYBound, 0, ParamTask, this);
+
     float gradMagSqr = 0.0f;
-    for (int y = 1; y <= mYBound; ++y)
+    for (int y = 0; y < mYBound; ++y)
     {
-        for (int x = 1; x <= mXBound; ++x)
-        {
-            float ux = GetUx(x, y);
-            float uy = GetUy(x, y);
-            gradMagSqr += ux*ux + uy*uy;
-        }
+        gradMagSqr += mRowSums[y];
     }
     gradMagSqr /= (float)mQuantity;
 
@@ -45,6 +51,35 @@ void GradientAnisotropic2::ComputeParam ()
     mMHalfParam = -0.5f*mParam;
 }
 //----------------------------------------------------------------------------
+void GradientAnisotropic2::ParamTask (int begin, int end, int,
+    void* userData)
+{
+    GradientAnisotropic2* filter = (GradientAnisotropic2*)userData;
+    float** src = filter->mSrc;
+
+    for (int y = begin + 1; y <= end; ++y)
+    {
+        // The gradients of row y use the rows y-1 and y+1, whose changes
+        // put row y in the band.
+        if (!filter->IsRowInBand(y))
+        {
+            continue;
+        }
+
+        const float* srcM = src[y-1];
+        const float* srcZ = src[y];
+        const float* srcP = src[y+1];
+        float rowSum = 0.0f;
+        for (int x = 1; x <= filter->mXBound; ++x)
+        {
+            float ux = filter->mHalfInvDx*(srcZ[x+1] - srcZ[x-1]);
+            float uy = filter->mHalfInvDy*(srcP[x] - srcM[x]);
+            rowSum += ux*ux + uy*uy;
+        }
+        filter->mRowSums[y-1] = rowSum;
+    }
+}
+//----------------------------------------------------------------------------
 void GradientAnisotropic2::OnPreUpdate ()
 {
     ComputeParam();
@@ -52,47 +87,76 @@ void GradientAnisotropic2::OnPreUpdate ()
 //----------------------------------------------------------------------------
 void GradientAnisotropic2::OnUpdate (int x, int y)
 {
-    LookUp9(x, y);
-
-    // one-sided U-derivative estimates
-    float uxFwd = mInvDx*(mUpz - mUzz);
-    float uxBwd = mInvDx*(mUzz - mUmz);
-    float uyFwd = mInvDy*(mUzp - mUzz);
-    float uyBwd = mInvDy*(mUzz - mUzm);
-
-    // centered U-derivative estimates
-    float uxCenM = mHalfInvDx*(mUpm - mUmm);
-    float uxCenZ = mHalfInvDx*(mUpz - mUmz);
-    float uxCenP = mHalfInvDx*(mUpp - mUmp);
-    float uyCenM = mHalfInvDy*(mUmp - mUmm);
-    float uyCenZ = mHalfInvDy*(mUzp - mUzm);
-    float uyCenP = mHalfInvDy*(mUpp - mUpm);
-
-    float uxCenZSqr = uxCenZ*uxCenZ;
-    float uyCenZSqr = uyCenZ*uyCenZ;
-    float gradMagSqr;
-
-    // estimate for C(x+1,y)
-    float uyEstP = 0.5f*(uyCenZ + uyCenP);
-    gradMagSqr = uxCenZSqr + uyEstP*uyEstP;
-    float cxp = Mathf::Exp(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x-1,y)
-    float uyEstM = 0.5f*(uyCenZ + uyCenM);
-    gradMagSqr = uxCenZSqr + uyEstM*uyEstM;
-    float cxm = Mathf::Exp(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y+1)
-    float uxEstP = 0.5f*(uxCenZ + uxCenP);
-    gradMagSqr = uyCenZSqr + uxEstP*uxEstP;
-    float cyp = Mathf::Exp(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y-1)
-    float uxEstM = 0.5f*(uxCenZ + uxCenM);
-    gradMagSqr = uyCenZSqr + uxEstM*uxEstM;
-    float cym = Mathf::Exp(mMHalfParam*gradMagSqr);
-
-    mDst[y][x] = mUzz + mTimeStep*(
-        cxp*uxFwd - cxm*uxBwd + cyp*uyFwd - cym*uyBwd);
+    OnUpdateRow(x, x, y);
+}
+//----------------------------------------------------------------------------
+void GradientAnisotropic2::OnUpdateRow (int xMin, int xMax, int y)
+{
+    // In the row name srcY and the value name uXY, the x and y offsets are
+    // in {m,z,p}, referring to subtract 1 (m), no change (z), or add 1 (p).
+    const float* srcM = mSrc[y-1];
+    const float* srcZ = mSrc[y];
+    const float* srcP = mSrc[y+1];
+    const bool* mask = (mMask ? mMask[y] : 0);
+    float* dst = mDst[y];
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
+
+        float umm = srcM[x-1];
+        float uzm = srcM[x];
+        float upm = srcM[x+1];
+        float umz = srcZ[x-1];
+        float uzz = srcZ[x];
+        float upz = srcZ[x+1];
+        float ump = srcP[x-1];
+        float uzp = srcP[x];
+        float upp = srcP[x+1];
+
+        // one-sided U-derivative estimates
+        float uxFwd = mInvDx*(upz - uzz);
+        float uxBwd = mInvDx*(uzz - umz);
+        float uyFwd = mInvDy*(uzp - uzz);
+        float uyBwd = mInvDy*(uzz - uzm);
+
+        // centered U-derivative estimates
+        float uxCenM = mHalfInvDx*(upm - umm);
+        float uxCenZ = mHalfInvDx*(upz - umz);
+        float uxCenP = mHalfInvDx*(upp - ump);
+        float uyCenM = mHalfInvDy*(ump - umm);
+        float uyCenZ = mHalfInvDy*(uzp - uzm);
+        float uyCenP = mHalfInvDy*(upp - upm);
+
+        float uxCenZSqr = uxCenZ*uxCenZ;
+        float uyCenZSqr = uyCenZ*uyCenZ;
+        float gradMagSqr;
+
+        // estimate for C(x+1,y)
+        float uyEstP = 0.5f*(uyCenZ + uyCenP);
+        gradMagSqr = uxCenZSqr + uyEstP*uyEstP;
+        float cxp = Mathf::Exp(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x-1,y)
+        float uyEstM = 0.5f*(uyCenZ + uyCenM);
+        gradMagSqr = uxCenZSqr + uyEstM*uyEstM;
+        float cxm = Mathf::Exp(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y+1)
+        float uxEstP = 0.5f*(uxCenZ + uxCenP);
+        gradMagSqr = uyCenZSqr + uxEstP*uxEstP;
+        float cyp = Mathf::Exp(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y-1)
+        float uxEstM = 0.5f*(uxCenZ + uxCenM);
+        gradMagSqr = uyCenZSqr + uxEstM*uxEstM;
+        float cym = Mathf::Exp(mMHalfParam*gradMagSqr);
+
+        dst[x] = uzz + mTimeStep*(
+            cxp*uxFwd - cxm*uxBwd + cyp*uyFwd - cym*uyBwd);
+    }
 }
 //----------------------------------------------------------------------------
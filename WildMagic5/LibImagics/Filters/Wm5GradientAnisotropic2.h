@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5GRADIENTANISOTROPIC2_H
 #define WM5GRADIENTANISOTROPIC2_H
@@ -28,6 +28,7 @@ protected:
     void ComputeParam ();
     virtual void OnPreUpdate ();
     virtual void OnUpdate (int x, int y);
+    virtual void OnUpdateRow (int xMin, int xMax, int y);
 
     float mK;           // k
 
@@ -35,6 +36,13 @@ protected:
     // average of the squared length of the gradients at the pixels.
     float mParam;       // 1/(k^2*average(gradMagSqr))
     float mMHalfParam;  // -0.5*mParam;
+
+private:
+    // The sums of the squared gradient lengths of the rows, computed
+    // concurrently.
+    float* mRowSums;
+
+    static void ParamTask (int begin, int end, int worker, void* userData);
 };
 
 }
@@ -4,10 +4,11 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5GradientAnisotropic3.h"
+#include "Wm5Memory.h"
 using namespace Wm5;
 
 //----------------------------------------------------------------------------
@@ -20,28 +21,30 @@ GradientAnisotropic3::GradientAnisotropic3 (int xBound, int yBound,
         mask, borderValue, scaleType)
 {
     mK = K;
+    mConcurrentRows = true;
+    mRowSums = new1<float>(mYBound*mZBound);
     ComputeParam();
 }
 //----------------------------------------------------------------------------
 GradientAnisotropic3::~GradientAnisotropic3 ()
 {
+    delete1(mRowSums);
 }
 //----------------------------------------------------------------------------
 void GradientAnisotropic3::ComputeParam ()
 {
+    // The squared gradient lengths are summed for each row, with the slices
+    // processed concurrently when a thread pool is set.  The row sums are
+    // added in order, so the result does not depend on the number of
+    // threads.  When the narrow band is enabled, the sums of the rows
+    // outside the band are those of the previous pass.
+    ThreadPool::ParallelFor(mPool, mZBound, 1, ParamTask, this);
+
     float gradMagSqr = 0.0f;
-    for (int z = 1; z <= mZBound; ++z)
+    const int numRows = mYBound*mZBound;
+    for (int r = 0; r < numRows; ++r)
     {
-        for (int y = 1; y <= mYBound; ++y)
-        {
-            for (int x = 1; x <= mXBound; ++x)
-            {
-                float ux = GetUx(x, y, z);
-                float uy = GetUy(x, y, z);
-                float uz = GetUz(x, y, z);
-                gradMagSqr += ux*ux + uy*uy + uz*uz;
-            }
-        }
+        gradMagSqr += mRowSums[r];
     }
     gradMagSqr /= (float)mQuantity;
 
@@ -49,6 +52,41 @@ void GradientAnisotropic3::ComputeParam ()
     mMHalfParam = -0.5f*mParam;
 }
 //----------------------------------------------------------------------------
+void GradientAnisotropic3::ParamTask (int begin, int end, int,
+    void* userData)
+{
+    GradientAnisotropic3* filter = (GradientAnisotropic3*)userData;
+    float*** src = filter->mSrc;
+
+    for (int z = begin + 1; z <= end; ++z)
+    {
+        for (int y = 1; y <= filter->mYBound; ++y)
+        {
+            // The gradients of row (y,z) use the rows (y-1,z), (y+1,z),
+            // (y,z-1) and (y,z+1), whose changes put row (y,z) in the band.
+            if (!filter->IsRowInBand(y, z))
+            {
+                continue;
+            }
+
+            const float* srcZM = src[z-1][y];
+            const float* srcMZ = src[z][y-1];
+            const float* srcZZ = src[z][y];
+            const float* srcPZ = src[z][y+1];
+            const float* srcZP = src[z+1][y];
+            float rowSum = 0.0f;
+            for (int x = 1; x <= filter->mXBound; ++x)
+            {
+                float ux = filter->mHalfInvDx*(srcZZ[x+1] - srcZZ[x-1]);
+                float uy = filter->mHalfInvDy*(srcPZ[x] - srcMZ[x]);
+                float uz = filter->mHalfInvDz*(srcZP[x] - srcZM[x]);
+                rowSum += ux*ux + uy*uy + uz*uz;
+            }
+            filter->mRowSums[(y-1) + filter->mYBound*(z-1)] = rowSum;
+        }
+    }
+}
+//----------------------------------------------------------------------------
 void GradientAnisotropic3::OnPreUpdate ()
 {
     ComputeParam();
@@ -56,80 +94,126 @@ void GradientAnisotropic3::OnPreUpdate ()
 //----------------------------------------------------------------------------
 void GradientAnisotropic3::OnUpdate (int x, int y, int z)
 {
-    LookUp27(x, y, z);
-
-    // one-sided U-derivative estimates
-    float uxFwd = mInvDx*(mUpzz - mUzzz);
-    float uxBwd = mInvDx*(mUzzz - mUmzz);
-    float uyFwd = mInvDy*(mUzpz - mUzzz);
-    float uyBwd = mInvDy*(mUzzz - mUzmz);
-    float uzFwd = mInvDz*(mUzzp - mUzzz);
-    float uzBwd = mInvDz*(mUzzz - mUzzm);
-
-    // centered U-derivative estimates
-    float duvzz = mHalfInvDx*(mUpzz - mUmzz);
-    float duvpz = mHalfInvDx*(mUppz - mUmpz);
-    float duvmz = mHalfInvDx*(mUpmz - mUmmz);
-    float duvzp = mHalfInvDx*(mUpzp - mUmzp);
-    float duvzm = mHalfInvDx*(mUpzm - mUmzm);
-
-    float duzvz = mHalfInvDy*(mUzpz - mUzmz);
-    float dupvz = mHalfInvDy*(mUppz - mUpmz);
-    float dumvz = mHalfInvDy*(mUmpz - mUmmz);
-    float duzvp = mHalfInvDy*(mUzpp - mUzmp);
-    float duzvm = mHalfInvDy*(mUzpm - mUzmm);
-
-    float duzzv = mHalfInvDz*(mUzzp - mUzzm);
-    float dupzv = mHalfInvDz*(mUpzp - mUpzm);
-    float dumzv = mHalfInvDz*(mUmzp - mUmzm);
-    float duzpv = mHalfInvDz*(mUzpp - mUzpm);
-    float duzmv = mHalfInvDz*(mUzmp - mUzmm);
-
-    float uxCenSqr = duvzz*duvzz;
-    float uyCenSqr = duzvz*duzvz;
-    float uzCenSqr = duzzv*duzzv;
-
-    float uxEst, uyEst, uzEst, gradMagSqr;
-
-    // estimate for C(x+1,y,z)
-    uyEst = 0.5f*(duzvz + dupvz);
-    uzEst = 0.5f*(duzzv + dupzv);
-    gradMagSqr = uxCenSqr + uyEst*uyEst + uzEst*uzEst;
-    float cxp = expf(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x-1,y,z)
-    uyEst = 0.5f*(duzvz + dumvz);
-    uzEst = 0.5f*(duzzv + dumzv);
-    gradMagSqr = uxCenSqr + uyEst*uyEst + uzEst*uzEst;
-    float cxm = expf(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y+1,z)
-    uxEst = 0.5f*(duvzz + duvpz);
-    uzEst = 0.5f*(duzzv + duzpv);
-    gradMagSqr = uxEst*uxEst + uyCenSqr + uzEst*uzEst;
-    float cyp = expf(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y-1,z)
-    uxEst = 0.5f*(duvzz + duvmz);
-    uzEst = 0.5f*(duzzv + duzmv);
-    gradMagSqr = uxEst*uxEst + uyCenSqr + uzEst*uzEst;
-    float cym = expf(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y,z+1)
-    uxEst = 0.5f*(duvzz + duvzp);
-    uyEst = 0.5f*(duzvz + duzvp);
-    gradMagSqr = uxEst*uxEst + uyEst*uyEst + uzCenSqr;
-    float czp = expf(mMHalfParam*gradMagSqr);
-
-    // estimate for C(x,y,z-1)
-    uxEst = 0.5f*(duvzz + duvzm);
-    uyEst = 0.5f*(duzvz + duzvm);
-    gradMagSqr = uxEst*uxEst + uyEst*uyEst + uzCenSqr;
-    float czm = expf(mMHalfParam*gradMagSqr);
-
-    mDst[z][y][x] = mUzzz + mTimeStep*(
-        cxp*uxFwd - cxm*uxBwd +
-        cyp*uyFwd - cym*uyBwd +
-        czp*uzFwd - czm*uzBwd);
+    OnUpdateRow(x, x, y, z);
+}
+//----------------------------------------------------------------------------
+void GradientAnisotropic3::OnUpdateRow (int xMin, int xMax, int y, int z)
+{
+    // In the row name srcYZ and the value name uXYZ, the x, y and z offsets
+    // are in {m,z,p}, referring to subtract 1 (m), no change (z), or add 1
+    // (p).
+    const float* srcMM = mSrc[z-1][y-1];
+    const float* srcZM = mSrc[z-1][y];
+    const float* srcPM = mSrc[z-1][y+1];
+    const float* srcMZ = mSrc[z][y-1];
+    const float* srcZZ = mSrc[z][y];
+    const float* srcPZ = mSrc[z][y+1];
+    const float* srcMP = mSrc[z+1][y-1];
+    const float* srcZP = mSrc[z+1][y];
+    const float* srcPP = mSrc[z+1][y+1];
+    const bool* mask = (mMask ? mMask[z][y] : 0);
+    float* dst = mDst[z][y];
+
+    for (int x = xMin; x <= xMax; ++x)
+    {
+        if (mask && !mask[x])
+        {
+            continue;
+        }
+
+        float uzmm = srcMM[x];
+        float umzm = srcZM[x-1];
+        float uzzm = srcZM[x];
+        float upzm = srcZM[x+1];
+        float uzpm = srcPM[x];
+        float ummz = srcMZ[x-1];
+        float uzmz = srcMZ[x];
+        float upmz = srcMZ[x+1];
+        float umzz = srcZZ[x-1];
+        float uzzz = srcZZ[x];
+        float upzz = srcZZ[x+1];
+        float umpz = srcPZ[x-1];
+        float uzpz = srcPZ[x];
+        float uppz = srcPZ[x+1];
+        float uzmp = srcMP[x];
+        float umzp = srcZP[x-1];
+        float uzzp = srcZP[x];
+        float upzp = srcZP[x+1];
+        float uzpp = srcPP[x];
+
+        // one-sided U-derivative estimates
+        float uxFwd = mInvDx*(upzz - uzzz);
+        float uxBwd = mInvDx*(uzzz - umzz);
+        float uyFwd = mInvDy*(uzpz - uzzz);
+        float uyBwd = mInvDy*(uzzz - uzmz);
+        float uzFwd = mInvDz*(uzzp - uzzz);
+        float uzBwd = mInvDz*(uzzz - uzzm);
+
+        // centered U-derivative estimates
+        float duvzz = mHalfInvDx*(upzz - umzz);
+        float duvpz = mHalfInvDx*(uppz - umpz);
+        float duvmz = mHalfInvDx*(upmz - ummz);
+        float duvzp = mHalfInvDx*(upzp - umzp);
+        float duvzm = mHalfInvDx*(upzm - umzm);
+
+        float duzvz = mHalfInvDy*(uzpz - uzmz);
+        float dupvz = mHalfInvDy*(uppz - upmz);
+        float dumvz = mHalfInvDy*(umpz - ummz);
+        float duzvp = mHalfInvDy*(uzpp - uzmp);
+        float duzvm = mHalfInvDy*(uzpm - uzmm);
+
+        float duzzv = mHalfInvDz*(uzzp - uzzm);
+        float dupzv = mHalfInvDz*(upzp - upzm);
+        float dumzv = mHalfInvDz*(umzp - umzm);
+        float duzpv = mHalfInvDz*(uzpp - uzpm);
+        float duzmv = mHalfInvDz*(uzmp - uzmm);
+
+        float uxCenSqr = duvzz*duvzz;
+        float uyCenSqr = duzvz*duzvz;
+        float uzCenSqr = duzzv*duzzv;
+
+        float uxEst, uyEst, uzEst, gradMagSqr;
+
+        // estimate for C(x+1,y,z)
+        uyEst = 0.5f*(duzvz + dupvz);
+        uzEst = 0.5f*(duzzv + dupzv);
+        gradMagSqr = uxCenSqr + uyEst*uyEst + uzEst*uzEst;
+        float cxp = expf(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x-1,y,z)
+        uyEst = 0.5f*(duzvz + dumvz);
+        uzEst = 0.5f*(duzzv + dumzv);
+        gradMagSqr = uxCenSqr + uyEst*uyEst + uzEst*uzEst;
+        float cxm = expf(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y+1,z)
+        uxEst = 0.5f*(duvzz + duvpz);
+        uzEst = 0.5f*(duzzv + duzpv);
+        gradMagSqr = uxEst*uxEst + uyCenSqr + uzEst*uzEst;
+        float cyp = expf(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y-1,z)
+        uxEst = 0.5f*(duvzz + duvmz);
+        uzEst = 0.5f*(duzzv + duzmv);
+        gradMagSqr = uxEst*uxEst + uyCenSqr + uzEst*uzEst;
+        float cym = expf(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y,z+1)
+        uxEst = 0.5f*(duvzz + duvzp);
+        uyEst = 0.5f*(duzvz + duzvp);
+        gradMagSqr = uxEst*uxEst + uyEst*uyEst + uzCenSqr;
+        float czp = expf(mMHalfParam*gradMagSqr);
+
+        // estimate for C(x,y,z-1)
+        uxEst = 0.5f*(duvzz + duvzm);
+        uyEst = 0.5f*(duzvz + duzvm);
+        gradMagSqr = uxEst*uxEst + uyEst*uyEst + uzCenSqr;
+        float czm = expf(mMHalfParam*gradMagSqr);
+
+        dst[x] = uzzz + mTimeStep*(
+            cxp*uxFwd - cxm*uxBwd +
+            cyp*uyFwd - cym*uyBwd +
+            czp*uzFwd - czm*uzBwd);
+    }
 }
 //----------------------------------------------------------------------------
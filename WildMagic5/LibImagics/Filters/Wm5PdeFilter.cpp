@@ -4,10 +4,11 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5PdeFilter.h"
+#include "Wm5Math.h"
 using namespace Wm5;
 
 //----------------------------------------------------------------------------
@@ -18,6 +19,11 @@ PdeFilter::PdeFilter (int quantity, const float* data, float borderValue,
     mBorderValue = borderValue;
     mScaleType = scaleType;
     mTimeStep = 0.0f;
+    mPool = 0;
+    mConcurrentRows = false;
+    mNarrowBand = false;
+    mBandTolerance = 0.0f;
+    mNumActive = mQuantity;
 
     float maxValue = data[0];
     mMin = maxValue;
@@ -75,3 +81,99 @@ void PdeFilter::Update ()
     OnPostUpdate();
 }
 //----------------------------------------------------------------------------
+void PdeFilter::SetNarrowBand (bool enabled, float tolerance)
+{
+    mNarrowBand = enabled;
+    mBandTolerance = tolerance;
+    if (mNarrowBand)
+    {
+        ResetBand();
+    }
+    else
+    {
+        mActive.clear();
+        mChanged.clear();
+        mNumActive = mQuantity;
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter::CommitRow (const std::vector<Span>& active, const bool* mask,
+    const float* dst, float* src, std::vector<Span>& changed) const
+{
+    changed.clear();
+    std::vector<Span>::const_iterator iter = active.begin();
+    for (/**/; iter != active.end(); ++iter)
+    {
+        for (int x = iter->XMin; x <= iter->XMax; ++x)
+        {
+            if (mask && !mask[x])
+            {
+                continue;
+            }
+
+            float value = dst[x];
+            if (Mathf::FAbs(value - src[x]) > mBandTolerance)
+            {
+                if (!changed.empty() && changed.back().XMax == x - 1)
+                {
+                    changed.back().XMax = x;
+                }
+                else
+                {
+                    Span span;
+                    span.XMin = x;
+                    span.XMax = x;
+                    changed.push_back(span);
+                }
+            }
+            src[x] = value;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter::MergeSpans (std::vector<Span>& spans,
+    std::vector<Span>& merged)
+{
+    merged.clear();
+    if (spans.empty())
+    {
+        return;
+    }
+
+    std::sort(spans.begin(), spans.end(), SpanLess);
+    merged.push_back(spans[0]);
+    for (int i = 1; i < (int)spans.size(); ++i)
+    {
+        Span& last = merged.back();
+        if (spans[i].XMin <= last.XMax + 1)
+        {
+            if (spans[i].XMax > last.XMax)
+            {
+                last.XMax = spans[i].XMax;
+            }
+        }
+        else
+        {
+            merged.push_back(spans[i]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter::CountActive ()
+{
+    mNumActive = 0;
+    for (int r = 0; r < (int)mActive.size(); ++r)
+    {
+        std::vector<Span>::const_iterator iter = mActive[r].begin();
+        for (/**/; iter != mActive[r].end(); ++iter)
+        {
+            mNumActive += iter->XMax - iter->XMin + 1;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+bool PdeFilter::SpanLess (const Span& span0, const Span& span1)
+{
+    return span0.XMin < span1.XMin;
+}
+//----------------------------------------------------------------------------
@@ -4,12 +4,13 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5PDEFILTER_H
 #define WM5PDEFILTER_H
 
 #include "Wm5ImagicsLIB.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -47,6 +48,41 @@ public:
     inline void SetTimeStep (float timeStep);
     inline float GetTimeStep () const;
 
+    // Access to the thread pool used by Update.  If the pool is not null
+    // and the filter supports it, the rows of the image are updated
+    // concurrently.  The caller retains ownership of the pool.
+    inline void SetThreadPool (ThreadPool* pool);
+    inline ThreadPool* GetThreadPool () const;
+
+    // Narrow-band execution.  An update normally processes every element of
+    // the image, even when only a thin band of elements around an evolving
+    // front changes.  When the narrow band is enabled, an update processes
+    // only the active elements, which are those with a neighbor (or
+    // themselves) that changed by more than 'tolerance' in the previous
+    // update; the active elements are kept as sparse lists of runs per row,
+    // and the lists are rebuilt after each update, concurrently when a
+    // thread pool is set.  Enabling the band makes all elements active for
+    // the next update.
+    //
+    // With tolerance 0, an inactive element has the same neighborhood as in
+    // the previous update, in which it did not change, so the results are
+    // bit-identical to those of the full-image updates.  GradientAnisotropic2
+    // and GradientAnisotropic3 are the exception.  Their conductances depend
+    // on the average gradient of the image, which changes with the front.
+    // An element whose conductance-weighted differences summed to exactly
+    // zero, although its neighborhood is not constant, is inactive in the
+    // next update, while the full-image update may change it.  This needs
+    // an exact cancellation and did not occur in our tests, but the results
+    // are not guaranteed to be identical.  A positive tolerance trades
+    // accuracy for a narrower band.  The time step must not change while
+    // the band is enabled.
+    void SetNarrowBand (bool enabled, float tolerance = 0.0f);
+    inline bool GetNarrowBand () const;
+    inline float GetBandTolerance () const;
+
+    // The number of elements processed by the next update.
+    inline int GetNumActive () const;
+
     // This function calls OnPreUpdate, OnUpdate, and OnPostUpdate, in that
     // order.
     void Update ();
@@ -88,6 +124,48 @@ protected:
     // depends on the magnitude of the time step, but the magnitude itself
     // depends on the algorithm.
     float mTimeStep;
+
+    // The optional thread pool.  A derived class sets mConcurrentRows to
+    // 'true' when its row updates write only to the destination buffer and
+    // use no other member storage, so different rows may be updated at the
+    // same time.
+    ThreadPool* mPool;
+    bool mConcurrentRows;
+
+    // Support for the narrow band.  A span is the run of elements
+    // XMin <= x <= XMax of a row, in padded coordinates.  The derived
+    // classes for 2D and 3D store the spans of the active elements and of
+    // the elements changed by the last update for each row of the image, and
+    // they implement ResetBand to make all elements active.
+    class Span
+    {
+    public:
+        int XMin, XMax;
+    };
+
+    virtual void ResetBand () = 0;
+
+    // Copy the updated values of the active elements of a row from 'dst'
+    // to 'src', skipping the elements masked out, and store the spans of
+    // the elements that changed by more than the tolerance.
+    void CommitRow (const std::vector<Span>& active, const bool* mask,
+        const float* dst, float* src, std::vector<Span>& changed) const;
+
+    // Replace 'merged' by the union of 'spans'.  The spans need not be
+    // sorted or disjoint; they are sorted in place.
+    static void MergeSpans (std::vector<Span>& spans,
+        std::vector<Span>& merged);
+
+    // Set mNumActive to the number of elements in the spans of mActive.
+    void CountActive ();
+
+    bool mNarrowBand;
+    float mBandTolerance;
+    int mNumActive;
+    std::vector<std::vector<Span> > mActive, mChanged;
+
+private:
+    static bool SpanLess (const Span& span0, const Span& span1);
 };
 
 #include "Wm5PdeFilter.inl"
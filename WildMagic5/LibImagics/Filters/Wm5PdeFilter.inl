@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 //----------------------------------------------------------------------------
 inline int PdeFilter::GetQuantity () const
@@ -32,3 +32,28 @@ inline float PdeFilter::GetTimeStep () const
     return mTimeStep;
 }
 //----------------------------------------------------------------------------
+inline void PdeFilter::SetThreadPool (ThreadPool* pool)
+{
+    mPool = pool;
+}
+//----------------------------------------------------------------------------
+inline ThreadPool* PdeFilter::GetThreadPool () const
+{
+    return mPool;
+}
+//----------------------------------------------------------------------------
+inline bool PdeFilter::GetNarrowBand () const
+{
+    return mNarrowBand;
+}
+//----------------------------------------------------------------------------
+inline float PdeFilter::GetBandTolerance () const
+{
+    return mBandTolerance;
+}
+//----------------------------------------------------------------------------
+inline int PdeFilter::GetNumActive () const
+{
+    return mNumActive;
+}
+//----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5PdeFilter2.h"
@@ -88,6 +88,11 @@ PdeFilter2::PdeFilter2 (int xBound, int yBound, float xSpacing,
             AssignNeumannMaskBorder();
         }
     }
+
+    // The masked-out pixels are never updated, so both buffers must hold
+    // their values.  Otherwise swapping the buffers exposes uninitialized
+    // values to the filters that read the whole image.
+    memcpy(mDst[0], mSrc[0], xBp2*yBp2*sizeof(float));
 }
 //----------------------------------------------------------------------------
 PdeFilter2::~PdeFilter2 ()
@@ -295,35 +300,52 @@ void PdeFilter2::AssignNeumannMaskBorder ()
 {
     // Recompute the values just outside the masked region.  This guarantees
     // that derivative estimations use the current values around the boundary.
+    Span all;
+    all.XMin = 1;
+    all.XMax = mXBound;
     for (int y = 1; y <= mYBound; ++y)
     {
-        for (int x = 1; x <= mXBound; ++x)
+        // With the narrow band, only the pixels in the band can have
+        // changed neighbors.
+        const Span* span = &all;
+        int numSpans = 1;
+        if (mNarrowBand)
         {
-            if (mMask[y][x])
-            {
-                continue;
-            }
+            const std::vector<Span>& active = mActive[y-1];
+            numSpans = (int)active.size();
+            span = (numSpans > 0 ? &active[0] : 0);
+        }
 
-            int count = 0;
-            float average = 0.0f;
-            int i0, i1, j0, j1;
-            for (i1 = 0, j1 = y-1; i1 < 3; ++i1, ++j1)
+        for (int s = 0; s < numSpans; ++s)
+        {
+            for (int x = span[s].XMin; x <= span[s].XMax; ++x)
             {
-                for (i0 = 0, j0 = x-1; i0 < 3; ++i0, ++j0)
+                if (mMask[y][x])
                 {
-                    if (mMask[j1][j0])
+                    continue;
+                }
+
+                int count = 0;
+                float average = 0.0f;
+                int i0, i1, j0, j1;
+                for (i1 = 0, j1 = y-1; i1 < 3; ++i1, ++j1)
+                {
+                    for (i0 = 0, j0 = x-1; i0 < 3; ++i0, ++j0)
                     {
-                        average += mSrc[j1][j0];
-                        count++;
+                        if (mMask[j1][j0])
+                        {
+                            average += mSrc[j1][j0];
+                            count++;
+                        }
                     }
                 }
-            }
 
-            if (count > 0)
-            {
-                average /= (float)count;
-                mSrc[y][x] = average;
-                mDst[y][x] = average;
+                if (count > 0)
+                {
+                    average /= (float)count;
+                    mSrc[y][x] = average;
+                    mDst[y][x] = average;
+                }
             }
         }
     }
@@ -343,26 +365,119 @@ void PdeFilter2::OnPreUpdate ()
 //----------------------------------------------------------------------------
 void PdeFilter2::OnUpdate ()
 {
-    for (int y = 1; y <= mYBound; ++y)
+    ThreadPool::ParallelFor((mConcurrentRows ? mPool : 0), mYBound, 0,
+        (mNarrowBand ? BandUpdateTask : UpdateTask), this);
+}
+//----------------------------------------------------------------------------
+void PdeFilter2::OnUpdateRow (int xMin, int xMax, int y)
+{
+    for (int x = xMin; x <= xMax; ++x)
     {
-        for (int x = 1; x <= mXBound; ++x)
+        if (!mMask || mMask[y][x])
         {
-            if (!mMask || mMask[y][x])
-            {
-                OnUpdate(x,y);
-            }
+            OnUpdate(x, y);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter2::UpdateTask (int begin, int end, int, void* userData)
+{
+    PdeFilter2* filter = (PdeFilter2*)userData;
+    for (int y = begin + 1; y <= end; ++y)
+    {
+        filter->OnUpdateRow(1, filter->mXBound, y);
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter2::BandUpdateTask (int begin, int end, int, void* userData)
+{
+    PdeFilter2* filter = (PdeFilter2*)userData;
+    for (int y = begin + 1; y <= end; ++y)
+    {
+        const std::vector<Span>& active = filter->mActive[y-1];
+        std::vector<Span>::const_iterator iter = active.begin();
+        for (/**/; iter != active.end(); ++iter)
+        {
+            filter->OnUpdateRow(iter->XMin, iter->XMax, y);
         }
     }
 }
 //----------------------------------------------------------------------------
 void PdeFilter2::OnPostUpdate ()
 {
+    if (mNarrowBand)
+    {
+        // The pixels outside the band are not written to mDst, so the
+        // buffers cannot be swapped; the updated values are copied to mSrc
+        // instead.  All copies must finish before the band is rebuilt from
+        // the changed pixels of the neighboring rows.
+        ThreadPool::ParallelFor(mPool, mYBound, 0, CommitTask, this);
+        ThreadPool::ParallelFor(mPool, mYBound, 0, BuildBandTask, this);
+        CountActive();
+        return;
+    }
+
     // Swap the buffers for the next pass.
     float** save = mSrc;
     mSrc = mDst;
     mDst = save;
 }
 //----------------------------------------------------------------------------
+void PdeFilter2::ResetBand ()
+{
+    Span span;
+    span.XMin = 1;
+    span.XMax = mXBound;
+    mActive.assign(mYBound, std::vector<Span>(1, span));
+    mChanged.assign(mYBound, std::vector<Span>());
+    mNumActive = mQuantity;
+}
+//----------------------------------------------------------------------------
+void PdeFilter2::CommitTask (int begin, int end, int, void* userData)
+{
+    PdeFilter2* filter = (PdeFilter2*)userData;
+    for (int y = begin + 1; y <= end; ++y)
+    {
+        filter->CommitRow(filter->mActive[y-1],
+            (filter->mMask ? filter->mMask[y] : 0), filter->mDst[y],
+            filter->mSrc[y], filter->mChanged[y-1]);
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter2::BuildBandTask (int begin, int end, int, void* userData)
+{
+    PdeFilter2* filter = (PdeFilter2*)userData;
+    const int xBound = filter->mXBound;
+    const int yBound = filter->mYBound;
+    const int radius = (filter->mMask
+        && filter->mBorderValue == Mathf::MAX_REAL ? 2 : 1);
+
+    // Each row of the band is the union of the changed spans of the rows
+    // within the radius, each widened by the radius.
+    std::vector<Span> spans;
+    for (int y = begin + 1; y <= end; ++y)
+    {
+        int y0 = (y - radius >= 1 ? y - radius : 1);
+        int y1 = (y + radius <= yBound ? y + radius : yBound);
+        spans.clear();
+        for (int yy = y0; yy <= y1; ++yy)
+        {
+            const std::vector<Span>& changed = filter->mChanged[yy-1];
+            std::vector<Span>::const_iterator iter = changed.begin();
+            for (/**/; iter != changed.end(); ++iter)
+            {
+                int xMin = iter->XMin - radius;
+                int xMax = iter->XMax + radius;
+                Span span;
+                span.XMin = (xMin >= 1 ? xMin : 1);
+                span.XMax = (xMax <= xBound ? xMax : xBound);
+                spans.push_back(span);
+            }
+        }
+        MergeSpans(spans, filter->mActive[y-1]);
+    }
+}
+//----------------------------------------------------------------------------
 void PdeFilter2::LookUp5 (int x, int y)
 {
     int xm = x - 1, xp = x + 1;
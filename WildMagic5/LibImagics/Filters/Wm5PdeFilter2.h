@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5PDEFILTER2_H
 #define WM5PDEFILTER2_H
@@ -63,19 +63,38 @@ protected:
     // base-class OnPreUpdate first.
     virtual void OnPreUpdate ();
 
-    // Iterate over all the pixels and call OnUpdate(x,y) for each pixel that
-    // is not masked out.
+    // Iterate over all the rows and call OnUpdateRow for each row, or for
+    // each active span of a row when the narrow band is enabled.  The rows
+    // are processed concurrently when a thread pool is set and
+    // mConcurrentRows is 'true'.
     virtual void OnUpdate ();
 
     // If a derived class overrides this, it must call the base-class
     // OnPostUpdate last.  The base-class function swaps the buffers for the
-    // next pass.
+    // next pass.  When the narrow band is enabled, it instead copies the
+    // active pixels of mDst to mSrc and rebuilds the band from the pixels
+    // that changed.
     virtual void OnPostUpdate ();
 
     // The per-pixel processing depends on the PDE algorithm.  The (x,y) must
     // be in padded coordinates: 1 <= x <= xbound and 1 <= y <= ybound.
     virtual void OnUpdate (int x, int y) = 0;
 
+    // Update the pixels (x,y) with xMin <= x <= xMax that are not masked
+    // out, in padded coordinates.  The default calls OnUpdate(x,y) for each
+    // pixel.  A derived class may override this to process the row directly
+    // from the source rows, avoiding the per-pixel virtual calls.
+    virtual void OnUpdateRow (int xMin, int xMax, int y);
+
+    // The spans of row y are mActive[y-1] and mChanged[y-1].  The band is
+    // the set of pixels within one pixel of a changed pixel, or two pixels
+    // when the Neumann mask border is recomputed from the changed pixels.
+    virtual void ResetBand ();
+
+    // This is 'true' when the narrow band is disabled or row y has active
+    // pixels, in padded coordinates.
+    inline bool IsRowInBand (int y) const;
+
     // Copy source data to temporary storage.
     void LookUp5 (int x, int y);
     void LookUp9 (int x, int y);
@@ -103,6 +122,14 @@ protected:
     float** mSrc;
     float** mDst;
     bool** mMask;
+
+private:
+    static void UpdateTask (int begin, int end, int worker, void* userData);
+    static void BandUpdateTask (int begin, int end, int worker,
+        void* userData);
+    static void CommitTask (int begin, int end, int worker, void* userData);
+    static void BuildBandTask (int begin, int end, int worker,
+        void* userData);
 };
 
 #include "Wm5PdeFilter2.inl"
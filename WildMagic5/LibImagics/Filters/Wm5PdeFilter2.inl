@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 //----------------------------------------------------------------------------
 inline int PdeFilter2::GetXBound () const
@@ -70,3 +70,8 @@ inline bool PdeFilter2::GetMask (int x, int y) const
     return (mMask ? mMask[y+1][x+1] : true);
 }
 //----------------------------------------------------------------------------
+inline bool PdeFilter2::IsRowInBand (int y) const
+{
+    return !mNarrowBand || !mActive[y-1].empty();
+}
+//----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5PdeFilter3.h"
@@ -99,6 +99,11 @@ PdeFilter3::PdeFilter3 (int xBound, int yBound, int zBound,
             AssignNeumannMaskBorder();
         }
     }
+
+    // The masked-out voxels are never updated, so both buffers must hold
+    // their values.  Otherwise swapping the buffers exposes uninitialized
+    // values to the filters that read the whole image.
+    memcpy(mDst[0][0], mSrc[0][0], xBp2*yBp2*zBp2*sizeof(float));
 }
 //----------------------------------------------------------------------------
 PdeFilter3::~PdeFilter3 ()
@@ -664,40 +669,58 @@ void PdeFilter3::AssignNeumannMaskBorder ()
 {
     // Recompute the values just outside the masked region.  This guarantees
     // that derivative estimations use the current values around the boundary.
+    Span all;
+    all.XMin = 1;
+    all.XMax = mXBound;
     for (int z = 1; z <= mZBound; ++z)
     {
         for (int y = 1; y <= mYBound; ++y)
         {
-            for (int x = 1; x <= mXBound; ++x)
+            // With the narrow band, only the voxels in the band can have
+            // changed neighbors.
+            const Span* span = &all;
+            int numSpans = 1;
+            if (mNarrowBand)
             {
-                if (mMask[z][y][x])
-                {
-                    continue;
-                }
+                const std::vector<Span>& active =
+                    mActive[(y-1) + mYBound*(z-1)];
+                numSpans = (int)active.size();
+                span = (numSpans > 0 ? &active[0] : 0);
+            }
 
-                int count = 0;
-                float average = 0.0f;
-                int i0, i1, i2, j0, j1, j2;
-                for (i2 = 0, j2 = z-1; i2 < 3; ++i2, ++j2)
+            for (int s = 0; s < numSpans; ++s)
+            {
+                for (int x = span[s].XMin; x <= span[s].XMax; ++x)
                 {
-                    for (i1 = 0, j1 = y-1; i1 < 3; ++i1, ++j1)
+                    if (mMask[z][y][x])
+                    {
+                        continue;
+                    }
+
+                    int count = 0;
+                    float average = 0.0f;
+                    int i0, i1, i2, j0, j1, j2;
+                    for (i2 = 0, j2 = z-1; i2 < 3; ++i2, ++j2)
                     {
-                        for (i0 = 0, j0 = x-1; i0 < 3; ++i0, ++j0)
+                        for (i1 = 0, j1 = y-1; i1 < 3; ++i1, ++j1)
                         {
-                            if (mMask[j2][j1][j0])
+                            for (i0 = 0, j0 = x-1; i0 < 3; ++i0, ++j0)
                             {
-                                average += mSrc[j2][j1][j0];
-                                count++;
+                                if (mMask[j2][j1][j0])
+                                {
+                                    average += mSrc[j2][j1][j0];
+                                    count++;
+                                }
                             }
                         }
                     }
-                }
 
-                if (count > 0)
-                {
-                    average /= (float)count;
-                    mSrc[z][y][x] = average;
-                    mDst[z][y][x] = average;
+                    if (count > 0)
+                    {
+                        average /= (float)count;
+                        mSrc[z][y][x] = average;
+                        mDst[z][y][x] = average;
+                    }
                 }
             }
         }
@@ -718,16 +741,46 @@ void PdeFilter3::OnPreUpdate ()
 //----------------------------------------------------------------------------
 void PdeFilter3::OnUpdate ()
 {
-    for (int z = 1; z <= mZBound; ++z)
+    ThreadPool::ParallelFor((mConcurrentRows ? mPool : 0), mZBound, 1,
+        (mNarrowBand ? BandUpdateTask : UpdateTask), this);
+}
+//----------------------------------------------------------------------------
+void PdeFilter3::OnUpdateRow (int xMin, int xMax, int y, int z)
+{
+    for (int x = xMin; x <= xMax; ++x)
     {
-        for (int y = 1; y <= mYBound; ++y)
+        if (!mMask || mMask[z][y][x])
+        {
+            OnUpdate(x, y, z);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter3::UpdateTask (int begin, int end, int, void* userData)
+{
+    PdeFilter3* filter = (PdeFilter3*)userData;
+    for (int z = begin + 1; z <= end; ++z)
+    {
+        for (int y = 1; y <= filter->mYBound; ++y)
+        {
+            filter->OnUpdateRow(1, filter->mXBound, y, z);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter3::BandUpdateTask (int begin, int end, int, void* userData)
+{
+    PdeFilter3* filter = (PdeFilter3*)userData;
+    for (int z = begin + 1; z <= end; ++z)
+    {
+        for (int y = 1; y <= filter->mYBound; ++y)
         {
-            for (int x = 1; x <= mXBound; ++x)
+            const std::vector<Span>& active =
+                filter->mActive[(y-1) + filter->mYBound*(z-1)];
+            std::vector<Span>::const_iterator iter = active.begin();
+            for (/**/; iter != active.end(); ++iter)
             {
-                if (!mMask || mMask[z][y][x])
-                {
-                    OnUpdate(x,y,z);
-                }
+                filter->OnUpdateRow(iter->XMin, iter->XMax, y, z);
             }
         }
     }
@@ -735,12 +788,93 @@ void PdeFilter3::OnUpdate ()
 //----------------------------------------------------------------------------
 void PdeFilter3::OnPostUpdate ()
 {
+    if (mNarrowBand)
+    {
+        // The voxels outside the band are not written to mDst, so the
+        // buffers cannot be swapped; the updated values are copied to mSrc
+        // instead.  All copies must finish before the band is rebuilt from
+        // the changed voxels of the neighboring slices.
+        ThreadPool::ParallelFor(mPool, mZBound, 1, CommitTask, this);
+        ThreadPool::ParallelFor(mPool, mZBound, 1, BuildBandTask, this);
+        CountActive();
+        return;
+    }
+
     // Swap the buffers for the next pass.
     float*** save = mSrc;
     mSrc = mDst;
     mDst = save;
 }
 //----------------------------------------------------------------------------
+void PdeFilter3::ResetBand ()
+{
+    Span span;
+    span.XMin = 1;
+    span.XMax = mXBound;
+    mActive.assign(mYBound*mZBound, std::vector<Span>(1, span));
+    mChanged.assign(mYBound*mZBound, std::vector<Span>());
+    mNumActive = mQuantity;
+}
+//----------------------------------------------------------------------------
+void PdeFilter3::CommitTask (int begin, int end, int, void* userData)
+{
+    PdeFilter3* filter = (PdeFilter3*)userData;
+    for (int z = begin + 1; z <= end; ++z)
+    {
+        for (int y = 1; y <= filter->mYBound; ++y)
+        {
+            int r = (y-1) + filter->mYBound*(z-1);
+            filter->CommitRow(filter->mActive[r],
+                (filter->mMask ? filter->mMask[z][y] : 0),
+                filter->mDst[z][y], filter->mSrc[z][y], filter->mChanged[r]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void PdeFilter3::BuildBandTask (int begin, int end, int, void* userData)
+{
+    PdeFilter3* filter = (PdeFilter3*)userData;
+    const int xBound = filter->mXBound;
+    const int yBound = filter->mYBound;
+    const int zBound = filter->mZBound;
+    const int radius = (filter->mMask
+        && filter->mBorderValue == Mathf::MAX_REAL ? 2 : 1);
+
+    // Each row of the band is the union of the changed spans of the rows
+    // within the radius, each widened by the radius.
+    std::vector<Span> spans;
+    for (int z = begin + 1; z <= end; ++z)
+    {
+        int z0 = (z - radius >= 1 ? z - radius : 1);
+        int z1 = (z + radius <= zBound ? z + radius : zBound);
+        for (int y = 1; y <= yBound; ++y)
+        {
+            int y0 = (y - radius >= 1 ? y - radius : 1);
+            int y1 = (y + radius <= yBound ? y + radius : yBound);
+            spans.clear();
+            for (int zz = z0; zz <= z1; ++zz)
+            {
+                for (int yy = y0; yy <= y1; ++yy)
+                {
+                    const std::vector<Span>& changed =
+                        filter->mChanged[(yy-1) + yBound*(zz-1)];
+                    std::vector<Span>::const_iterator iter = changed.begin();
+                    for (/**/; iter != changed.end(); ++iter)
+                    {
+                        int xMin = iter->XMin - radius;
+                        int xMax = iter->XMax + radius;
+                        Span span;
+                        span.XMin = (xMin >= 1 ? xMin : 1);
+                        span.XMax = (xMax <= xBound ? xMax : xBound);
+                        spans.push_back(span);
+                    }
+                }
+            }
+            MergeSpans(spans, filter->mActive[(y-1) + yBound*(z-1)]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
 void PdeFilter3::LookUp7 (int x, int y, int z)
 {
     int xm = x - 1, xp = x + 1;
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5PDEFILTER3_H
 #define WM5PDEFILTER3_H
@@ -71,13 +71,17 @@ protected:
     // base-class OnPreUpdate first.
     virtual void OnPreUpdate ();
 
-    // Iterate over all the pixels and call OnUpdate(x,y,z) for each voxel
-    // that is not masked out.
+    // Iterate over all the rows and call OnUpdateRow for each row, or for
+    // each active span of a row when the narrow band is enabled.  The slices
+    // of the image are processed concurrently when a thread pool is set and
+    // mConcurrentRows is 'true'.
     virtual void OnUpdate ();
 
     // If a derived class overrides this, it must call the base-class
     // OnPostUpdate last.  The base-class function swaps the buffers for the
-    // next pass.
+    // next pass.  When the narrow band is enabled, it instead copies the
+    // active voxels of mDst to mSrc and rebuilds the band from the voxels
+    // that changed.
     virtual void OnPostUpdate ();
 
     // The per-pixel processing depends on the PDE algorithm.  The (x,y,z)
@@ -85,6 +89,22 @@ protected:
     // 1 <= z <= zbound.
     virtual void OnUpdate (int x, int y, int z) = 0;
 
+    // Update the voxels (x,y,z) with xMin <= x <= xMax that are not masked
+    // out, in padded coordinates.  The default calls OnUpdate(x,y,z) for
+    // each voxel.  A derived class may override this to process the row
+    // directly from the source rows, avoiding the per-voxel virtual calls.
+    virtual void OnUpdateRow (int xMin, int xMax, int y, int z);
+
+    // The spans of row (y,z) are mActive[(y-1)+mYBound*(z-1)] and
+    // mChanged[(y-1)+mYBound*(z-1)].  The band is the set of voxels within
+    // one voxel of a changed voxel, or two voxels when the Neumann mask
+    // border is recomputed from the changed voxels.
+    virtual void ResetBand ();
+
+    // This is 'true' when the narrow band is disabled or row (y,z) has
+    // active voxels, in padded coordinates.
+    inline bool IsRowInBand (int y, int z) const;
+
     // Copy source data to temporary storage.
     void LookUp7 (int x, int y, int z);
     void LookUp27 (int x, int y, int z);
@@ -122,6 +142,14 @@ protected:
     float*** mSrc;
     float*** mDst;
     bool*** mMask;
+
+private:
+    static void UpdateTask (int begin, int end, int worker, void* userData);
+    static void BandUpdateTask (int begin, int end, int worker,
+        void* userData);
+    static void CommitTask (int begin, int end, int worker, void* userData);
+    static void BuildBandTask (int begin, int end, int worker,
+        void* userData);
 };
 
 #include "Wm5PdeFilter3.inl"
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 //----------------------------------------------------------------------------
 inline int PdeFilter3::GetXBound () const
@@ -110,3 +110,8 @@ inline bool PdeFilter3::GetMask (int x, int y, int z) const
     return (mMask ? mMask[z+1][y+1][x+1] : true);
 }
 //----------------------------------------------------------------------------
+inline bool PdeFilter3::IsRowInBand (int y, int z) const
+{
+    return !mNarrowBand || !mActive[(y-1) + mYBound*(z-1)].empty();
+}
+//----------------------------------------------------------------------------
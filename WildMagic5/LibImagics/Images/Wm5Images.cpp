@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5Images.h"
@@ -53,5 +53,31 @@ template class TImage3D<Efloat>;
 template class TImage3D<Edouble>;
 template class TImage3D<Ergb5>;
 template class TImage3D<Ergb8>;
+
+template class TBrickImage3D<Echar>;
+template class TBrickImage3D<Euchar>;
+template class TBrickImage3D<Eshort>;
+template class TBrickImage3D<Eushort>;
+template class TBrickImage3D<Eint>;
+template class TBrickImage3D<Euint>;
+template class TBrickImage3D<Elong>;
+template class TBrickImage3D<Eulong>;
+template class TBrickImage3D<Efloat>;
+template class TBrickImage3D<Edouble>;
+template class TBrickImage3D<Ergb5>;
+template class TBrickImage3D<Ergb8>;
+
+template class TTiledImage3D<Echar>;
+template class TTiledImage3D<Euchar>;
+template class TTiledImage3D<Eshort>;
+template class TTiledImage3D<Eushort>;
+template class TTiledImage3D<Eint>;
+template class TTiledImage3D<Euint>;
+template class TTiledImage3D<Elong>;
+template class TTiledImage3D<Eulong>;
+template class TTiledImage3D<Efloat>;
+template class TTiledImage3D<Edouble>;
+template class TTiledImage3D<Ergb5>;
+template class TTiledImage3D<Ergb8>;
 }
 //----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #ifndef WM5IMAGES_H
 #define WM5IMAGES_H
@@ -14,6 +14,8 @@
 #include "Wm5TImage.h"
 #include "Wm5TImage2D.h"
 #include "Wm5TImage3D.h"
+#include "Wm5TBrickImage3D.h"
+#include "Wm5TTiledImage3D.h"
 
 namespace Wm5
 {
@@ -56,6 +58,30 @@ typedef TImage3D<Efloat>  ImageFloat3D;
 typedef TImage3D<Edouble> ImageDouble3D;
 typedef TImage3D<Ergb5>   ImageRGB53D;
 typedef TImage3D<Ergb8>   ImageRGB83D;
+typedef TBrickImage3D<Echar>    BrickImageChar3D;
+typedef TBrickImage3D<Euchar>   BrickImageUChar3D;
+typedef TBrickImage3D<Eshort>   BrickImageShort3D;
+typedef TBrickImage3D<Eushort>  BrickImageUShort3D;
+typedef TBrickImage3D<Eint>     BrickImageInt3D;
+typedef TBrickImage3D<Euint>    BrickImageUInt3D;
+typedef TBrickImage3D<Elong>    BrickImageLong3D;
+typedef TBrickImage3D<Eulong>   BrickImageULong3D;
+typedef TBrickImage3D<Efloat>   BrickImageFloat3D;
+typedef TBrickImage3D<Edouble>  BrickImageDouble3D;
+typedef TBrickImage3D<Ergb5>    BrickImageRGB53D;
+typedef TBrickImage3D<Ergb8>    BrickImageRGB83D;
+typedef TTiledImage3D<Echar>    TiledImageChar3D;
+typedef TTiledImage3D<Euchar>   TiledImageUChar3D;
+typedef TTiledImage3D<Eshort>   TiledImageShort3D;
+typedef TTiledImage3D<Eushort>  TiledImageUShort3D;
+typedef TTiledImage3D<Eint>     TiledImageInt3D;
+typedef TTiledImage3D<Euint>    TiledImageUInt3D;
+typedef TTiledImage3D<Elong>    TiledImageLong3D;
+typedef TTiledImage3D<Eulong>   TiledImageULong3D;
+typedef TTiledImage3D<Efloat>   TiledImageFloat3D;
+typedef TTiledImage3D<Edouble>  TiledImageDouble3D;
+typedef TTiledImage3D<Ergb5>    TiledImageRGB53D;
+typedef TTiledImage3D<Ergb8>    TiledImageRGB83D;
 
 }
 
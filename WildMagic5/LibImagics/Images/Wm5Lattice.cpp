@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/04/18)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5Lattice.h"
@@ -237,3 +237,8 @@ bool Lattice::LoadRaw (const char* filename, int& numDimensions,
     return true;
 }
 //----------------------------------------------------------------------------
+const char* Lattice::GetHeader ()
+{
+    return msHeader;
+}
+//----------------------------------------------------------------------------
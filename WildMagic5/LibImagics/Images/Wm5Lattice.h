@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5LATTICE_H
 #define WM5LATTICE_H
@@ -49,6 +49,9 @@ public:
     static bool LoadRaw (const char* filename, int& numDimensions,
         int*& bounds, int& quantity, int& rtti, int& sizeOf, char*& data);
 
+    // The null-terminated string at the beginning of an image file.
+    static const char* GetHeader ();
+
 protected:
     // Construction.  Lattice accepts responsibility for deleting the
     // bound array.
@@ -0,0 +1,187 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5TBRICKIMAGE3D_H
+#define WM5TBRICKIMAGE3D_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5TImage3D.h"
+#include "Wm5ImageConvert.h"
+#include "Wm5MappedFile.h"
+#include "Wm5Endian.h"
+
+namespace Wm5
+{
+
+// A 3D image stored in a file in the format of TImage::Save, for volumes
+// that do not fit in memory.  The voxels are accessed without loading the
+// entire file.  Two storage modes are supported.
+//
+// SM_MAPPED
+//   The file is memory mapped, and the operating system pages the voxels
+//   in and out.  The element type of the file must be T, and the address
+//   space must be large enough to hold the file, which in practice means a
+//   64-bit process.  The file stores the voxels at a 4-byte boundary, so
+//   the voxels of 8-byte types are misaligned; the supported processors
+//   access them correctly.
+//
+// SM_BRICKED
+//   The volume is partitioned into cubic bricks of brickSize voxels per
+//   side, which must be a power of two.  A brick is read from the file
+//   when one of its voxels is accessed, and at most maxBricks bricks are
+//   kept in memory; the least recently used brick is evicted first, and
+//   it is written back to the file if it was modified.  If the element
+//   type of the file is not T, the voxels are converted when the bricks
+//   are read, and the image must be opened read-only.
+//
+// The class is not thread safe.  To process a volume with the filters and
+// extractors of the library, which operate on in-memory images, iterate
+// over the blocks of the volume.  The blocks are the bricks, listed in
+// the order of the voxels of their minimum corners.
+//
+//   for (int b = 0; b < input.GetNumBlocks(); ++b)
+//   {
+//       input.ReadBlock(b, halo, region);
+//       <process region>
+//       output.WriteBlock(b, halo, region);
+//   }
+//
+// For a filter whose stencil has radius r, the halo is r times the number
+// of iterations applied to the region, and the output volume must differ
+// from the input volume.  The voxels of the halo outside the image are
+// copies of the nearest image voxels.  A surface extractor needs the
+// cubes of a block, which are obtained by ReadRegion for the block
+// extended by one voxel on its maximum sides, and the vertices must be
+// translated by the minimum corner of the block.
+template <typename T>
+class TBrickImage3D
+{
+public:
+    enum
+    {
+        SM_MAPPED,
+        SM_BRICKED
+    };
+
+    // Construction and destruction.  The constructor opens the file; call
+    // IsOpen to test for success.  The brickSize is also the size of the
+    // blocks in mode SM_MAPPED; maxBricks is used only in mode SM_BRICKED.
+    // The destructor writes the modified bricks to the file.
+    TBrickImage3D (const char* filename, int mode, bool writable = false,
+        int brickSize = 32, int maxBricks = 256);
+    ~TBrickImage3D ();
+
+    // Create a file for a zero-valued image of the specified dimensions.
+    // It is then opened by the constructor with 'writable' set to true.
+    static bool Create (const char* filename, int xBound, int yBound,
+        int zBound);
+
+    // Member access.
+    inline bool IsOpen () const;
+    inline int GetMode () const;
+    inline bool IsWritable () const;
+    inline int GetBound (int i) const;
+    inline int64_t GetQuantity () const;
+    inline int64_t GetIndex (int x, int y, int z) const;
+
+    // Element access.  The coordinates must be in the image.
+    T Get (int x, int y, int z);
+    void Set (int x, int y, int z, T value);
+
+    // Block iteration.  Block b covers the voxels
+    // xMin <= x < xMax, yMin <= y < yMax, zMin <= z < zMax.
+    inline int GetBrickSize () const;
+    inline int GetNumBlocks () const;
+    void GetBlockExtent (int b, int& xMin, int& xMax, int& yMin, int& yMax,
+        int& zMin, int& zMax) const;
+
+    // Copy block b and a halo of the specified width into 'region', which
+    // is resized to the dimensions of the block plus twice the halo.  The
+    // function WriteBlock stores the interior of such a region.  The region
+    // functions return false when a brick could not be read or written;
+    // see GetNumIOErrors.
+    bool ReadBlock (int b, int halo, TImage3D<T>& region);
+    bool WriteBlock (int b, int halo, const TImage3D<T>& region);
+
+    // Copy the voxels of the box with minimum corner (xMin,yMin,zMin) and
+    // the dimensions of 'region' into 'region'.  The box must intersect
+    // the image.  The voxels of the box outside the image are copies of
+    // the nearest image voxels.
+    bool ReadRegion (int xMin, int yMin, int zMin, TImage3D<T>& region);
+
+    // Store 'region' in the box with minimum corner (xMin,yMin,zMin),
+    // excluding the 'border' voxels on each side of the region.  The part
+    // of the box outside the image is ignored.
+    bool WriteRegion (int xMin, int yMin, int zMin,
+        const TImage3D<T>& region, int border = 0);
+
+    // Write the modified bricks and the mapped pages to the file.  The
+    // return value is false if any of the writes failed.
+    bool Flush ();
+
+    // The numbers of brick reads and writes, for tuning the cache.
+    inline int64_t GetNumBrickReads () const;
+    inline int64_t GetNumBrickWrites () const;
+
+    // The number of brick reads and writes that failed.  A brick that
+    // could not be read has undefined voxels, and the modifications of a
+    // brick that could not be written when it was evicted are lost.  Get
+    // and Set have no return value for the error, so check this count
+    // after accessing voxels one at a time.
+    inline int64_t GetNumIOErrors () const;
+
+private:
+    // Get the data of brick b, loading it if necessary.  If 'modify' is
+    // true, the brick is marked for writing.  The bricks are stored with
+    // x-stride 1, y-stride brickSize, and z-stride brickSize^2.
+    T* GetBrick (int b, bool modify);
+    bool ReadBrick (int b, T* data);
+    bool WriteBrick (int b, const T* data);
+    void GetBrickExtent (int b, int min[3], int max[3]) const;
+
+    // Maintenance of the list of cache slots.
+    void Unlink (int slot);
+    void PushFront (int slot);
+
+    // Clip the box [min,min+size) to the image along axis i, returning the
+    // clipped box relative to the region.
+    void Clip (int i, int min, int size, int& begin, int& end) const;
+
+    // Copy the box [begin,end) of the region, whose minimum corner is
+    // 'origin', from the image (read is true) or to the image.
+    bool CopyRegion (const int origin[3], const int begin[3],
+        const int end[3], T* region, const int size[3], bool read);
+
+    MappedFile mFile;
+    int mMode;
+    bool mOpen;
+    int mBounds[3];
+    int64_t mQuantity, mDataOffset;
+    int mFileRTTI, mFileSizeOf;
+
+    // Mode SM_MAPPED.
+    T* mData;
+
+    // Mode SM_BRICKED.  The cache slots form a doubly linked list in the
+    // order of their last use, most recent first.
+    int mBrickSize, mBrickShift, mBrickVolume;
+    int mNumBricks[3], mNumBlocks;
+    std::vector<int> mSlotOfBrick;
+    int mMaxSlots, mNumSlots, mFirstSlot, mLastSlot;
+    T* mSlotData;
+    std::vector<int> mBrickOfSlot, mPrevSlot, mNextSlot;
+    std::vector<bool> mModified;
+    std::vector<char> mBuffer;
+    int64_t mNumBrickReads, mNumBrickWrites, mNumIOErrors;
+};
+
+#include "Wm5TBrickImage3D.inl"
+
+}
+
+#endif
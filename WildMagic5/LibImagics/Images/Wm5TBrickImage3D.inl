@@ -0,0 +1,714 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+template <typename T>
+TBrickImage3D<T>::TBrickImage3D (const char* filename, int mode,
+    bool writable, int brickSize, int maxBricks)
+    :
+    mMode(mode),
+    mOpen(false),
+    mQuantity(0),
+    mDataOffset(0),
+    mFileRTTI(0),
+    mFileSizeOf(0),
+    mData(0),
+    mBrickSize(brickSize),
+    mBrickShift(0),
+    mBrickVolume(brickSize*brickSize*brickSize),
+    mNumBlocks(0),
+    mMaxSlots(maxBricks),
+    mNumSlots(0),
+    mFirstSlot(-1),
+    mLastSlot(-1),
+    mSlotData(0),
+    mNumBrickReads(0),
+    mNumBrickWrites(0),
+    mNumIOErrors(0)
+{
+    assertion(brickSize > 0 && (brickSize & (brickSize - 1)) == 0,
+        "The brick size must be a power of two\n");
+    assertion(maxBricks > 0, "The cache must hold at least one brick\n");
+    while ((1 << mBrickShift) < brickSize)
+    {
+        ++mBrickShift;
+    }
+    mBounds[0] = 0;
+    mBounds[1] = 0;
+    mBounds[2] = 0;
+
+    if (!mFile.Open(filename, writable))
+    {
+        return;
+    }
+
+    // The header written by Lattice::Save and TImage::Save.
+    const int headerLength = (int)strlen(Lattice::GetHeader()) + 1;
+    std::vector<char> header(headerLength);
+    int values[6];
+    if (!mFile.Read(0, headerLength, &header[0])
+    ||  strncmp(&header[0], Lattice::GetHeader(), headerLength) != 0
+    ||  !mFile.Read(headerLength, 6*sizeof(int), values))
+    {
+        mFile.Close();
+        return;
+    }
+#ifndef WM5_LITTLE_ENDIAN
+    Endian::Swap4(6, values);
+#endif
+    if (values[0] != 3 || values[1] <= 0 || values[2] <= 0 || values[3] <= 0)
+    {
+        assertion(false, "The file %s is not a 3D image\n", filename);
+        mFile.Close();
+        return;
+    }
+
+    mBounds[0] = values[1];
+    mBounds[1] = values[2];
+    mBounds[2] = values[3];
+    mFileRTTI = values[4];
+    mFileSizeOf = values[5];
+    mQuantity = (int64_t)mBounds[0]*mBounds[1]*mBounds[2];
+    mDataOffset = headerLength + 6*sizeof(int);
+    if (mFile.GetSize() < mDataOffset + mQuantity*mFileSizeOf)
+    {
+        assertion(false, "The file %s is truncated\n", filename);
+        mFile.Close();
+        return;
+    }
+
+    int i;
+    mNumBlocks = 1;
+    for (i = 0; i < 3; ++i)
+    {
+        mNumBricks[i] = (mBounds[i] + brickSize - 1) >> mBrickShift;
+        mNumBlocks *= mNumBricks[i];
+    }
+
+    if (mMode == SM_MAPPED)
+    {
+#ifdef WM5_LITTLE_ENDIAN
+        assertion(mFileRTTI == T::GetRTTI(),
+            "Mapped images require the element type of the file\n");
+        if (mFileRTTI != T::GetRTTI() || !mFile.Map())
+        {
+            mFile.Close();
+            return;
+        }
+        mData = (T*)(mFile.GetMapping() + mDataOffset);
+#else
+        assertion(false, "Mapped images require little endian order\n");
+        mFile.Close();
+        return;
+#endif
+    }
+    else
+    {
+        assertion(!writable || mFileRTTI == T::GetRTTI(),
+            "Writable images require the element type of the file\n");
+        if (writable && mFileRTTI != T::GetRTTI())
+        {
+            mFile.Close();
+            return;
+        }
+
+        mSlotOfBrick.resize(mNumBlocks, -1);
+        mBrickOfSlot.resize(mMaxSlots);
+        mPrevSlot.resize(mMaxSlots);
+        mNextSlot.resize(mMaxSlots);
+        mModified.resize(mMaxSlots, false);
+        mSlotData = new1<T>(mMaxSlots*mBrickVolume);
+        mBuffer.resize(brickSize*mFileSizeOf);
+    }
+
+    mOpen = true;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+TBrickImage3D<T>::~TBrickImage3D ()
+{
+    if (mOpen)
+    {
+        Flush();
+    }
+    delete1(mSlotData);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::Create (const char* filename, int xBound, int yBound,
+    int zBound)
+{
+    const int headerLength = (int)strlen(Lattice::GetHeader()) + 1;
+    int values[6];
+    values[0] = 3;
+    values[1] = xBound;
+    values[2] = yBound;
+    values[3] = zBound;
+    values[4] = T::GetRTTI();
+    values[5] = (int)sizeof(T);
+#ifndef WM5_LITTLE_ENDIAN
+    Endian::Swap4(6, values);
+#endif
+
+    int64_t quantity = (int64_t)xBound*yBound*zBound;
+    int64_t size = headerLength + 6*sizeof(int) + quantity*sizeof(T);
+    MappedFile file;
+    if (!file.Create(filename, size))
+    {
+        return false;
+    }
+    bool success = file.Write(0, headerLength, Lattice::GetHeader())
+        && file.Write(headerLength, 6*sizeof(int), values);
+    return file.Close() && success;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline bool TBrickImage3D<T>::IsOpen () const
+{
+    return mOpen;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TBrickImage3D<T>::GetMode () const
+{
+    return mMode;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline bool TBrickImage3D<T>::IsWritable () const
+{
+    return mFile.IsWritable();
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TBrickImage3D<T>::GetBound (int i) const
+{
+    return mBounds[i];
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int64_t TBrickImage3D<T>::GetQuantity () const
+{
+    return mQuantity;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int64_t TBrickImage3D<T>::GetIndex (int x, int y, int z) const
+{
+    return x + mBounds[0]*(y + (int64_t)mBounds[1]*z);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+T TBrickImage3D<T>::Get (int x, int y, int z)
+{
+    if (mMode == SM_MAPPED)
+    {
+        return mData[GetIndex(x, y, z)];
+    }
+
+    const int mask = mBrickSize - 1;
+    int b = (x >> mBrickShift) + mNumBricks[0]*((y >> mBrickShift) +
+        mNumBricks[1]*(z >> mBrickShift));
+    return GetBrick(b, false)[(x & mask) + mBrickSize*((y & mask) +
+        mBrickSize*(z & mask))];
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::Set (int x, int y, int z, T value)
+{
+    assertion(mFile.IsWritable(), "The image is not writable\n");
+    if (mMode == SM_MAPPED)
+    {
+        mData[GetIndex(x, y, z)] = value;
+        return;
+    }
+
+    const int mask = mBrickSize - 1;
+    int b = (x >> mBrickShift) + mNumBricks[0]*((y >> mBrickShift) +
+        mNumBricks[1]*(z >> mBrickShift));
+    GetBrick(b, true)[(x & mask) + mBrickSize*((y & mask) +
+        mBrickSize*(z & mask))] = value;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TBrickImage3D<T>::GetBrickSize () const
+{
+    return mBrickSize;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TBrickImage3D<T>::GetNumBlocks () const
+{
+    return mNumBlocks;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::GetBlockExtent (int b, int& xMin, int& xMax,
+    int& yMin, int& yMax, int& zMin, int& zMax) const
+{
+    int min[3], max[3];
+    GetBrickExtent(b, min, max);
+    xMin = min[0];
+    xMax = max[0];
+    yMin = min[1];
+    yMax = max[1];
+    zMin = min[2];
+    zMax = max[2];
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::ReadBlock (int b, int halo, TImage3D<T>& region)
+{
+    int min[3], max[3], size[3], i;
+    GetBrickExtent(b, min, max);
+    for (i = 0; i < 3; ++i)
+    {
+        size[i] = max[i] - min[i] + 2*halo;
+    }
+    if (region.GetBound(0) != size[0] || region.GetBound(1) != size[1]
+    ||  region.GetBound(2) != size[2])
+    {
+        region = TImage3D<T>(size[0], size[1], size[2]);
+    }
+    return ReadRegion(min[0] - halo, min[1] - halo, min[2] - halo, region);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::WriteBlock (int b, int halo,
+    const TImage3D<T>& region)
+{
+    int min[3], max[3];
+    GetBrickExtent(b, min, max);
+    assertion(region.GetBound(0) == max[0] - min[0] + 2*halo
+        && region.GetBound(1) == max[1] - min[1] + 2*halo
+        && region.GetBound(2) == max[2] - min[2] + 2*halo,
+        "The region does not match the block\n");
+    return WriteRegion(min[0] - halo, min[1] - halo, min[2] - halo, region,
+        halo);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::ReadRegion (int xMin, int yMin, int zMin,
+    TImage3D<T>& region)
+{
+    const int origin[3] = { xMin, yMin, zMin };
+    int size[3], begin[3], end[3], i;
+    for (i = 0; i < 3; ++i)
+    {
+        size[i] = region.GetBound(i);
+        Clip(i, origin[i], size[i], begin[i], end[i]);
+        if (begin[i] >= end[i])
+        {
+            assertion(false, "The region does not intersect the image\n");
+            return false;
+        }
+    }
+
+    T* data = region.GetData();
+    bool success = CopyRegion(origin, begin, end, data, size, true);
+
+    // Replicate the nearest image voxels into the rest of the region, first
+    // along the rows, then along the columns and the slices.
+    const int size01 = size[0]*size[1];
+    int x, y, z;
+    for (z = begin[2]; z < end[2]; ++z)
+    {
+        for (y = begin[1]; y < end[1]; ++y)
+        {
+            T* row = data + size[0]*(y + size[1]*z);
+            for (x = 0; x < begin[0]; ++x)
+            {
+                row[x] = row[begin[0]];
+            }
+            for (x = end[0]; x < size[0]; ++x)
+            {
+                row[x] = row[end[0] - 1];
+            }
+        }
+
+        T* slice = data + size01*z;
+        const T* first = slice + size[0]*begin[1];
+        for (y = 0; y < begin[1]; ++y)
+        {
+            std::copy(first, first + size[0], slice + size[0]*y);
+        }
+        const T* last = slice + size[0]*(end[1] - 1);
+        for (y = end[1]; y < size[1]; ++y)
+        {
+            std::copy(last, last + size[0], slice + size[0]*y);
+        }
+    }
+    const T* first = data + size01*begin[2];
+    for (z = 0; z < begin[2]; ++z)
+    {
+        std::copy(first, first + size01, data + size01*z);
+    }
+    const T* last = data + size01*(end[2] - 1);
+    for (z = end[2]; z < size[2]; ++z)
+    {
+        std::copy(last, last + size01, data + size01*z);
+    }
+    return success;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::WriteRegion (int xMin, int yMin, int zMin,
+    const TImage3D<T>& region, int border)
+{
+    assertion(mFile.IsWritable(), "The image is not writable\n");
+    const int origin[3] = { xMin, yMin, zMin };
+    int size[3], begin[3], end[3], i;
+    for (i = 0; i < 3; ++i)
+    {
+        size[i] = region.GetBound(i);
+        Clip(i, origin[i], size[i], begin[i], end[i]);
+        if (begin[i] < border)
+        {
+            begin[i] = border;
+        }
+        if (end[i] > size[i] - border)
+        {
+            end[i] = size[i] - border;
+        }
+        if (begin[i] >= end[i])
+        {
+            return true;
+        }
+    }
+
+    return CopyRegion(origin, begin, end, region.GetData(), size, false);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::Flush ()
+{
+    if (!mOpen)
+    {
+        return false;
+    }
+
+    bool success = true;
+    for (int slot = 0; slot < mNumSlots; ++slot)
+    {
+        if (mModified[slot])
+        {
+            if (!WriteBrick(mBrickOfSlot[slot],
+                mSlotData + slot*mBrickVolume))
+            {
+                success = false;
+            }
+            mModified[slot] = false;
+        }
+    }
+    return mFile.Flush() && success;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int64_t TBrickImage3D<T>::GetNumBrickReads () const
+{
+    return mNumBrickReads;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int64_t TBrickImage3D<T>::GetNumBrickWrites () const
+{
+    return mNumBrickWrites;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int64_t TBrickImage3D<T>::GetNumIOErrors () const
+{
+    return mNumIOErrors;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+T* TBrickImage3D<T>::GetBrick (int b, bool modify)
+{
+    int slot = mSlotOfBrick[b];
+    if (slot < 0)
+    {
+        if (mNumSlots < mMaxSlots)
+        {
+            slot = mNumSlots++;
+        }
+        else
+        {
+            // Evict the least recently used brick.  If it cannot be
+            // written, its modifications are lost.
+            slot = mLastSlot;
+            if (mModified[slot])
+            {
+                WriteBrick(mBrickOfSlot[slot], mSlotData + slot*mBrickVolume);
+            }
+            mSlotOfBrick[mBrickOfSlot[slot]] = -1;
+            Unlink(slot);
+        }
+
+        ReadBrick(b, mSlotData + slot*mBrickVolume);
+        mSlotOfBrick[b] = slot;
+        mBrickOfSlot[slot] = b;
+        mModified[slot] = false;
+        PushFront(slot);
+    }
+    else if (slot != mFirstSlot)
+    {
+        Unlink(slot);
+        PushFront(slot);
+    }
+
+    if (modify)
+    {
+        mModified[slot] = true;
+    }
+    return mSlotData + slot*mBrickVolume;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::ReadBrick (int b, T* data)
+{
+    int min[3], max[3];
+    GetBrickExtent(b, min, max);
+    const int numRow = max[0] - min[0];
+    const bool convert = (mFileRTTI != T::GetRTTI());
+    bool success = true;
+    for (int z = min[2]; z < max[2]; ++z)
+    {
+        for (int y = min[1]; y < max[1]; ++y)
+        {
+            T* row = data + mBrickSize*((y - min[1]) +
+                mBrickSize*(z - min[2]));
+            int64_t offset = mDataOffset + GetIndex(min[0], y, z)*mFileSizeOf;
+            if (!convert)
+            {
+                if (!mFile.Read(offset, numRow*sizeof(T), row))
+                {
+                    success = false;
+                }
+#ifndef WM5_LITTLE_ENDIAN
+                Endian::Swap(sizeof(T), numRow, row);
+#endif
+            }
+            else
+            {
+                if (!mFile.Read(offset, numRow*mFileSizeOf, &mBuffer[0]))
+                {
+                    success = false;
+                }
+#ifndef WM5_LITTLE_ENDIAN
+                Endian::Swap(mFileSizeOf, numRow, &mBuffer[0]);
+#endif
+                ImageConvert(numRow, mFileRTTI, &mBuffer[0], T::GetRTTI(),
+                    row);
+            }
+        }
+    }
+    ++mNumBrickReads;
+
+    if (!success)
+    {
+        assertion(false, "Cannot read brick %d\n", b);
+        ++mNumIOErrors;
+    }
+    return success;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::WriteBrick (int b, const T* data)
+{
+    int min[3], max[3];
+    GetBrickExtent(b, min, max);
+    const int numRow = max[0] - min[0];
+    bool success = true;
+    for (int z = min[2]; z < max[2]; ++z)
+    {
+        for (int y = min[1]; y < max[1]; ++y)
+        {
+            const T* row = data + mBrickSize*((y - min[1]) +
+                mBrickSize*(z - min[2]));
+            int64_t offset = mDataOffset + GetIndex(min[0], y, z)*sizeof(T);
+#ifdef WM5_LITTLE_ENDIAN
+            const void* source = row;
+#else
+            memcpy(&mBuffer[0], row, numRow*sizeof(T));
+            Endian::Swap(sizeof(T), numRow, &mBuffer[0]);
+            const void* source = &mBuffer[0];
+#endif
+            if (!mFile.Write(offset, numRow*sizeof(T), source))
+            {
+                success = false;
+            }
+        }
+    }
+    ++mNumBrickWrites;
+
+    if (!success)
+    {
+        assertion(false, "Cannot write brick %d\n", b);
+        ++mNumIOErrors;
+    }
+    return success;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::GetBrickExtent (int b, int min[3], int max[3]) const
+{
+    int coord[3];
+    coord[0] = b % mNumBricks[0];
+    b /= mNumBricks[0];
+    coord[1] = b % mNumBricks[1];
+    coord[2] = b / mNumBricks[1];
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] = coord[i] << mBrickShift;
+        max[i] = min[i] + mBrickSize;
+        if (max[i] > mBounds[i])
+        {
+            max[i] = mBounds[i];
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::Unlink (int slot)
+{
+    int prev = mPrevSlot[slot], next = mNextSlot[slot];
+    if (prev >= 0)
+    {
+        mNextSlot[prev] = next;
+    }
+    else
+    {
+        mFirstSlot = next;
+    }
+    if (next >= 0)
+    {
+        mPrevSlot[next] = prev;
+    }
+    else
+    {
+        mLastSlot = prev;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::PushFront (int slot)
+{
+    mPrevSlot[slot] = -1;
+    mNextSlot[slot] = mFirstSlot;
+    if (mFirstSlot >= 0)
+    {
+        mPrevSlot[mFirstSlot] = slot;
+    }
+    else
+    {
+        mLastSlot = slot;
+    }
+    mFirstSlot = slot;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TBrickImage3D<T>::Clip (int i, int min, int size, int& begin,
+    int& end) const
+{
+    begin = (min < 0 ? -min : 0);
+    end = mBounds[i] - min;
+    if (end > size)
+    {
+        end = size;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+bool TBrickImage3D<T>::CopyRegion (const int origin[3], const int begin[3],
+    const int end[3], T* region, const int size[3], bool read)
+{
+    int y, z;
+    if (mMode == SM_MAPPED)
+    {
+        const int numRow = end[0] - begin[0];
+        for (z = begin[2]; z < end[2]; ++z)
+        {
+            for (y = begin[1]; y < end[1]; ++y)
+            {
+                T* row = region + begin[0] + size[0]*(y + size[1]*z);
+                T* image = mData + GetIndex(origin[0] + begin[0],
+                    origin[1] + y, origin[2] + z);
+                if (read)
+                {
+                    std::copy(image, image + numRow, row);
+                }
+                else
+                {
+                    std::copy(row, row + numRow, image);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Visit the bricks that overlap the box one at a time, so that each
+    // brick is loaded once regardless of the size of the cache.
+    int bMin[3], bMax[3], i;
+    for (i = 0; i < 3; ++i)
+    {
+        bMin[i] = (origin[i] + begin[i]) >> mBrickShift;
+        bMax[i] = (origin[i] + end[i] - 1) >> mBrickShift;
+    }
+
+    const int64_t numIOErrors = mNumIOErrors;
+    const int mask = mBrickSize - 1;
+    for (int bz = bMin[2]; bz <= bMax[2]; ++bz)
+    {
+        for (int by = bMin[1]; by <= bMax[1]; ++by)
+        {
+            for (int bx = bMin[0]; bx <= bMax[0]; ++bx)
+            {
+                // The part of the box in the brick, in image coordinates.
+                const int brickCoord[3] = { bx, by, bz };
+                int min[3], max[3];
+                for (i = 0; i < 3; ++i)
+                {
+                    min[i] = brickCoord[i] << mBrickShift;
+                    max[i] = min[i] + mBrickSize;
+                    if (min[i] < origin[i] + begin[i])
+                    {
+                        min[i] = origin[i] + begin[i];
+                    }
+                    if (max[i] > origin[i] + end[i])
+                    {
+                        max[i] = origin[i] + end[i];
+                    }
+                }
+
+                int b = bx + mNumBricks[0]*(by + mNumBricks[1]*bz);
+                T* brick = GetBrick(b, !read);
+                const int numRow = max[0] - min[0];
+                for (z = min[2]; z < max[2]; ++z)
+                {
+                    for (y = min[1]; y < max[1]; ++y)
+                    {
+                        T* row = region + (min[0] - origin[0]) + size[0]*(
+                            (y - origin[1]) + size[1]*(z - origin[2]));
+                        T* voxel = brick + (min[0] & mask) + mBrickSize*(
+                            (y & mask) + mBrickSize*(z & mask));
+                        if (read)
+                        {
+                            std::copy(voxel, voxel + numRow, row);
+                        }
+                        else
+                        {
+                            std::copy(row, row + numRow, voxel);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return mNumIOErrors == numIOErrors;
+}
+//----------------------------------------------------------------------------
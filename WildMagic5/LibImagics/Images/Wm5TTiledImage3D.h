@@ -0,0 +1,108 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5TTILEDIMAGE3D_H
+#define WM5TTILEDIMAGE3D_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5TImage3D.h"
+
+namespace Wm5
+{
+
+// A 3D image with a tiled layout.  The volume is partitioned into cubic
+// bricks of brickSize voxels per side, which must be a power of two and
+// must divide the bounds.  The voxels of a brick are contiguous, with
+// x-stride 1, y-stride brickSize, and z-stride brickSize^2, and the bricks
+// are stored in the Morton (Z-curve) order of their coordinates.  The
+// 3x3x3 neighborhood of a voxel then lies in one brick unless the voxel is
+// on a brick face, and bricks that are close in the volume are mostly close
+// in memory.
+//
+// The coordinate interface is that of TImage3D; GetIndex and
+// GetCoordinates convert between (x,y,z) and the storage index.  The
+// algorithms of the library that take the data array of a TImage3D assume
+// the linear layout x+xBound*(y+yBound*z), so use GetLinear and SetLinear
+// to exchange the voxels with them, or GetSlices for algorithms that read
+// the volume a few slices at a time, such as the streaming extraction of
+// ExtractSurfaceCubes.  Save and Load transfer the voxels in the storage
+// order.
+//
+// A brick and its halo form a small working set that may be processed,
+// paged, or handed to a thread as a unit.  The layout does not by itself
+// make stencils faster.  The hardware prefetchers handle the few row
+// streams of a 3x3x3 stencil in the linear layout well, and GetIndex costs
+// more than the linear index, so measure before converting.
+template <typename T>
+class TTiledImage3D : public TImage<T>
+{
+public:
+    // Construction.  The voxels are initially zero.
+    TTiledImage3D (int xBound, int yBound, int zBound, int brickSize = 8);
+    TTiledImage3D (const TTiledImage3D& image);
+
+    // Data access.
+    T& operator() (int x, int y, int z) const;
+
+    // Conversion between 3D coordinates and 1D indexing.
+    int GetIndex (int x, int y, int z) const;
+    void GetCoordinates (int index, int& x, int& y, int& z) const;
+
+    // Conversion to and from the linear layout.  The image must have the
+    // bounds of this image.
+    void GetLinear (TImage3D<T>& image) const;
+    void SetLinear (const TImage3D<T>& image);
+
+    // Copy the slices zMin <= z < zMin+numSlices into 'slices' in the
+    // linear layout, xBound*yBound voxels per slice.
+    void GetSlices (int zMin, int numSlices, T* slices) const;
+
+    // Brick iteration.  Brick b, 0 <= b < GetNumBricks(), occupies the
+    // storage indices [b*V,(b+1)*V) with V = brickSize^3, and its voxel
+    // with the minimum coordinates is at (xMin,yMin,zMin).  Visiting the
+    // bricks in increasing b visits the storage sequentially.
+    inline int GetBrickSize () const;
+    inline int GetNumBricks () const;
+    void GetBrickOrigin (int b, int& xMin, int& yMin, int& zMin) const;
+    inline T* GetBrickData (int b) const;
+
+    // Copy brick b and a halo of the specified width, at most brickSize,
+    // into 'block', which must store (brickSize+2*halo)^3 voxels in the
+    // linear layout.  The voxels of the halo outside the image are copies
+    // of the nearest image voxels.  Stencils are then applied to the block
+    // without testing for brick faces.
+    void GetBrickWithHalo (int b, int halo, T* block) const;
+
+    // Assignment.
+    TTiledImage3D& operator= (const TTiledImage3D& image);
+    TTiledImage3D& operator= (T value);
+
+protected:
+    // Compute the storage offsets of the bricks.
+    void Initialize (int brickSize);
+
+    int mBrickSize, mBrickShift, mBrickMask, mBrickVolume;
+    int mNumBricks[3];
+
+    // mOffset[i] is the first storage index of the brick with coordinates
+    // (i % mNumBricks[0], (i / mNumBricks[0]) % mNumBricks[1], ...), and
+    // mBrick[b] is the i of the brick at storage position b.
+    std::vector<int> mOffset, mBrick;
+
+    using TImage<T>::SetBounds;
+    using TImage<T>::SetData;
+    using TImage<T>::mBounds;
+    using TImage<T>::mQuantity;
+    using TImage<T>::mData;
+};
+
+#include "Wm5TTiledImage3D.inl"
+
+}
+
+#endif
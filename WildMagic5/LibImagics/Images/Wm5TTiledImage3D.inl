@@ -0,0 +1,288 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+template <typename T>
+TTiledImage3D<T>::TTiledImage3D (int xBound, int yBound, int zBound,
+    int brickSize)
+    :
+    TImage<T>(3)
+{
+    int* bounds = new1<int>(3);
+    bounds[0] = xBound;
+    bounds[1] = yBound;
+    bounds[2] = zBound;
+    SetBounds(bounds);
+    SetData(0);
+    Initialize(brickSize);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+TTiledImage3D<T>::TTiledImage3D (const TTiledImage3D& image)
+    :
+    TImage<T>(image)
+{
+    Initialize(image.mBrickSize);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::Initialize (int brickSize)
+{
+    assertion(brickSize > 0 && (brickSize & (brickSize - 1)) == 0,
+        "The brick size must be a power of two\n");
+    mBrickSize = brickSize;
+    mBrickShift = 0;
+    while ((1 << mBrickShift) < brickSize)
+    {
+        ++mBrickShift;
+    }
+    mBrickMask = brickSize - 1;
+    mBrickVolume = brickSize*brickSize*brickSize;
+
+    int i, numBricks = 1;
+    for (i = 0; i < 3; ++i)
+    {
+        assertion((mBounds[i] & mBrickMask) == 0,
+            "The brick size must divide the bounds\n");
+        mNumBricks[i] = mBounds[i] >> mBrickShift;
+        numBricks *= mNumBricks[i];
+    }
+
+    // Sort the bricks by the Morton codes of their coordinates, which
+    // interleave the bits of the coordinates.  The bricks are not required
+    // to form a power-of-two grid, so the storage position of a brick is
+    // the rank of its code.
+    std::vector<std::pair<uint64_t,int> > codes(numBricks);
+    int b = 0;
+    for (int bz = 0; bz < mNumBricks[2]; ++bz)
+    {
+        for (int by = 0; by < mNumBricks[1]; ++by)
+        {
+            for (int bx = 0; bx < mNumBricks[0]; ++bx, ++b)
+            {
+                uint64_t code = 0;
+                for (int bit = 0; bit < 21; ++bit)
+                {
+                    code |= (uint64_t)((bx >> bit) & 1) << (3*bit);
+                    code |= (uint64_t)((by >> bit) & 1) << (3*bit + 1);
+                    code |= (uint64_t)((bz >> bit) & 1) << (3*bit + 2);
+                }
+                codes[b] = std::make_pair(code, b);
+            }
+        }
+    }
+    std::sort(codes.begin(), codes.end());
+
+    mOffset.resize(numBricks);
+    mBrick.resize(numBricks);
+    for (b = 0; b < numBricks; ++b)
+    {
+        mBrick[b] = codes[b].second;
+        mOffset[codes[b].second] = b*mBrickVolume;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+T& TTiledImage3D<T>::operator() (int x, int y, int z) const
+{
+    return mData[GetIndex(x, y, z)];
+}
+//----------------------------------------------------------------------------
+template <typename T>
+int TTiledImage3D<T>::GetIndex (int x, int y, int z) const
+{
+    int brick = (x >> mBrickShift) + mNumBricks[0]*((y >> mBrickShift) +
+        mNumBricks[1]*(z >> mBrickShift));
+    return mOffset[brick] + (x & mBrickMask) + mBrickSize*((y & mBrickMask)
+        + mBrickSize*(z & mBrickMask));
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::GetCoordinates (int index, int& x, int& y, int& z)
+    const
+{
+    int xMin, yMin, zMin;
+    GetBrickOrigin(index >> (3*mBrickShift), xMin, yMin, zMin);
+    index &= mBrickVolume - 1;
+    x = xMin + (index & mBrickMask);
+    index >>= mBrickShift;
+    y = yMin + (index & mBrickMask);
+    z = zMin + (index >> mBrickShift);
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::GetLinear (TImage3D<T>& image) const
+{
+    assertion(image.GetBound(0) == mBounds[0]
+        && image.GetBound(1) == mBounds[1]
+        && image.GetBound(2) == mBounds[2],
+        "The image must have the same bounds\n");
+
+    const int numBricks = GetNumBricks();
+    for (int b = 0; b < numBricks; ++b)
+    {
+        int xMin, yMin, zMin;
+        GetBrickOrigin(b, xMin, yMin, zMin);
+        const T* brick = GetBrickData(b);
+        for (int z = 0; z < mBrickSize; ++z)
+        {
+            for (int y = 0; y < mBrickSize; ++y, brick += mBrickSize)
+            {
+                std::copy(brick, brick + mBrickSize,
+                    &image(xMin, yMin + y, zMin + z));
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::SetLinear (const TImage3D<T>& image)
+{
+    assertion(image.GetBound(0) == mBounds[0]
+        && image.GetBound(1) == mBounds[1]
+        && image.GetBound(2) == mBounds[2],
+        "The image must have the same bounds\n");
+
+    const int numBricks = GetNumBricks();
+    for (int b = 0; b < numBricks; ++b)
+    {
+        int xMin, yMin, zMin;
+        GetBrickOrigin(b, xMin, yMin, zMin);
+        T* brick = GetBrickData(b);
+        for (int z = 0; z < mBrickSize; ++z)
+        {
+            for (int y = 0; y < mBrickSize; ++y, brick += mBrickSize)
+            {
+                const T* source = &image(xMin, yMin + y, zMin + z);
+                std::copy(source, source + mBrickSize, brick);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::GetSlices (int zMin, int numSlices, T* slices) const
+{
+    assertion(0 <= zMin && numSlices >= 0
+        && zMin + numSlices <= mBounds[2], "Invalid slices\n");
+
+    // Each slice crosses one layer of bricks, and each brick row is a
+    // contiguous copy.
+    const int sliceSize = mBrickSize*mBrickSize;
+    for (int z = zMin; z < zMin + numSlices; ++z)
+    {
+        T* slice = slices + mBounds[0]*mBounds[1]*(z - zMin);
+        const int layer = mNumBricks[0]*mNumBricks[1]*(z >> mBrickShift);
+        for (int by = 0; by < mNumBricks[1]; ++by)
+        {
+            for (int bx = 0; bx < mNumBricks[0]; ++bx)
+            {
+                const T* source = mData + mOffset[bx + mNumBricks[0]*by +
+                    layer] + sliceSize*(z & mBrickMask);
+                T* target = slice + (bx << mBrickShift) +
+                    mBounds[0]*(by << mBrickShift);
+                for (int y = 0; y < mBrickSize; ++y)
+                {
+                    std::copy(source, source + mBrickSize, target);
+                    source += mBrickSize;
+                    target += mBounds[0];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TTiledImage3D<T>::GetBrickSize () const
+{
+    return mBrickSize;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline int TTiledImage3D<T>::GetNumBricks () const
+{
+    return (int)mBrick.size();
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::GetBrickOrigin (int b, int& xMin, int& yMin,
+    int& zMin) const
+{
+    int brick = mBrick[b];
+    xMin = (brick % mNumBricks[0]) << mBrickShift;
+    brick /= mNumBricks[0];
+    yMin = (brick % mNumBricks[1]) << mBrickShift;
+    zMin = (brick / mNumBricks[1]) << mBrickShift;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline T* TTiledImage3D<T>::GetBrickData (int b) const
+{
+    return mData + b*mBrickVolume;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void TTiledImage3D<T>::GetBrickWithHalo (int b, int halo, T* block) const
+{
+    assertion(0 <= halo && halo <= mBrickSize, "Invalid halo\n");
+    int xMin, yMin, zMin;
+    GetBrickOrigin(b, xMin, yMin, zMin);
+    const T* brick = GetBrickData(b);
+    const int size = mBrickSize + 2*halo;
+
+    for (int z = -halo; z < mBrickSize + halo; ++z)
+    {
+        int zImage = zMin + z;
+        zImage = (zImage < 0 ? 0 :
+            (zImage >= mBounds[2] ? mBounds[2] - 1 : zImage));
+        for (int y = -halo; y < mBrickSize + halo; ++y)
+        {
+            int yImage = yMin + y;
+            yImage = (yImage < 0 ? 0 :
+                (yImage >= mBounds[1] ? mBounds[1] - 1 : yImage));
+            T* row = block + halo + size*((y + halo) + size*(z + halo));
+
+            // The part of the row in the brick is a contiguous copy.
+            const T* source;
+            if (0 <= y && y < mBrickSize && 0 <= z && z < mBrickSize)
+            {
+                source = brick + mBrickSize*(y + mBrickSize*z);
+            }
+            else
+            {
+                source = &(*this)(xMin, yImage, zImage);
+            }
+            std::copy(source, source + mBrickSize, row);
+
+            for (int x = 1; x <= halo; ++x)
+            {
+                int xImage = xMin - x;
+                row[-x] = (*this)((xImage < 0 ? 0 : xImage), yImage,
+                    zImage);
+                xImage = xMin + mBrickSize - 1 + x;
+                row[mBrickSize - 1 + x] = (*this)((xImage >= mBounds[0] ?
+                    mBounds[0] - 1 : xImage), yImage, zImage);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+TTiledImage3D<T>& TTiledImage3D<T>::operator= (const TTiledImage3D& image)
+{
+    TImage<T>::operator=(image);
+    Initialize(image.mBrickSize);
+    return *this;
+}
+//----------------------------------------------------------------------------
+template <typename T>
+TTiledImage3D<T>& TTiledImage3D<T>::operator= (T value)
+{
+    return (TTiledImage3D<T>&) TImage<T>::operator=(value);
+}
+//----------------------------------------------------------------------------
@@ -4,10 +4,11 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5RasterDrawing.h"
+#include "Wm5RasterSpans.h"
 #include "Wm5Integer.h"
 #include "Wm5Math.h"
 #include "Wm5Memory.h"
@@ -728,265 +729,35 @@ void Wm5::EllipseArc2D (int xc, int yc, int A, int B, float fx0,
     }
 }
 //----------------------------------------------------------------------------
-void Wm5::GeneralEllipse2D (int xc, int yc, int xa, int ya, int xb, int yb,
-    void (*callback)(int,int))
+namespace Wm5
 {
-    // Change sign and/or swap the direction vectors in order to satisfy this
-    // algorithm's requirement for visiting pixels in a particular order.
-    int save;
-    if (xa <= 0 && ya > 0)
-    {
-        // Use (-xb,-yb,xa,ya).
-        save = xa;
-        xa = -xb;
-        xb = save;
-        save = ya;
-        ya = -yb;
-        yb = save;
-    }
-    else if (xa < 0 && ya <= 0)
-    {
-        // Use (-xa,-ya,-xb,-yb).
-        xa = -xa;
-        ya = -ya;
-        xb = -xb;
-        yb = -yb;
-    }
-    else if (xa >= 0 && ya < 0)
-    {
-        // Use (xb,yb,-xa,-ya).
-        save = xa;
-        xa = xb;
-        xb = -save;
-        save = ya;
-        ya = yb;
-        yb = -save;
-    }
-    // else (xa > 0 && ya >= 0): use (xa,ya,xb,yb)
-
-    // Ellipse is a*(x-xc)^2+2*b*(x-xc)*(y-yc)+c*(y-yc)^2 = d where
-    //
-    //   a = xa^2*Lb^4 + xb^2*La^4
-    //   b = xa*ya*Lb^4 + xb*yb*La^4
-    //   c = ya^2*Lb^4 + yb^2*La^4
-    //   d = La^4*Lb^4
-    //   La^2 = xa^2+ya^2
-    //   Lb^2 = xb^2+yb^2
-    //
-    // Pixel determination is performed relative to origin (0,0).  The
-    // ellipse at origin is a*x^2+b*x*y+c*y^2=d.  Slope of curve is
-    // dy/dx = -(a*x+b*y)/(b*x+c*y).  Slope at (xb,yb) is
-    // dy/dx = -xb/yb >= 0 and slope at (xa,ya) is dy/dx = -xa/ya < 0.
-
-    Integer<4> iXA2 = xa*xa;
-    Integer<4> iYA2 = ya*ya;
-    Integer<4> iXB2 = xb*xb;
-    Integer<4> iYB2 = yb*yb;
-    Integer<4> iXAYA = xa*ya;
-    Integer<4> iXBYB = xb*yb;
-    Integer<4> iLa2 = iXA2+iYA2;
-    Integer<4> iLa4 = iLa2*iLa2;
-    Integer<4> iLb2 = iXB2+iYB2;
-    Integer<4> iLb4 = iLb2*iLb2;
-    Integer<4> iA = iXA2*iLb4 + iXB2*iLa4;
-    Integer<4> iB = iXAYA*iLb4 + iXBYB*iLa4;
-    Integer<4> iC = iYA2*iLb4 + iYB2*iLa4;
-    Integer<4> iD = iLa4*iLb4;
-
-    Integer<4> dx, dy, sigma;
-    int x, y, xp1, ym1, yp1;
-
-    if (ya <= xa)
+namespace
+{
+// The visitor of GeneralEllipse2DHalf used by GeneralEllipse2D.  It is
+// local to this file.
+class SymmetricPixels
+{
+public:
+    void operator() (int x, int y)
     {
-        // Start at (-xA,-yA).
-        x = -xa;
-        y = -ya;
-        dx = -(iB*xa + iC*ya);
-        dy = iA*xa + iB*ya;
-
-        // Arc from (-xA,-yA) to point (x0,y0) where dx/dy = 0.
-        while (dx <= 0)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            y++;
-            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
-            if (sigma < 0)
-            {
-                dx -= iB;
-                dy += iA;
-                x--;
-            }
-            dx += iC;
-            dy -= iB;
-        }
-
-        // Arc from (x0,y0) to point (x1,y1) where dy/dx = 1.
-        while (dx <= dy)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            y++;
-            xp1 = x+1;
-            sigma = iA*xp1*xp1 + 2*iB*xp1*y + iC*y*y - iD;
-            if (sigma >= 0)
-            {
-                dx += iB;
-                dy -= iA;
-                x = xp1;
-            }
-            dx += iC;
-            dy -= iB;
-        }
-
-        // Arc from (x1,y1) to point (x2,y2) where dy/dx = 0.
-        while (dy >= 0)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            x++;
-            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
-            if (sigma < 0)
-            {
-                dx += iC;
-                dy -= iB;
-                y++;
-            }
-            dx += iB;
-            dy -= iA;
-        }
-
-        // Arc from (x2,y2) to point (x3,y3) where dy/dx = -1.
-        while (dy >= -dx)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            x++;
-            ym1 = y-1;
-            sigma = iA*x*x + 2*iB*x*ym1 + iC*ym1*ym1 - iD;
-            if (sigma >= 0)
-            {
-                dx -= iC;
-                dy += iB;
-                y = ym1;
-            }
-            dx += iB;
-            dy -= iA;
-        }
-
-        // Arc from (x3,y3) to (xa,ya).
-        while (y >= ya)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            y--;
-            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
-            if (sigma < 0)
-            {
-                dx += iB;
-                dy -= iA;
-                x++;
-            }
-            dx -= iC;
-            dy += iB;
-        }
+        Callback(XC + x, YC + y);
+        Callback(XC - x, YC - y);
     }
-    else
-    {
-        // Start at (-xa,-ya).
-        x = -xa;
-        y = -ya;
-        dx = -(iB*xa + iC*ya);
-        dy = iA*xa + iB*ya;
-
-        // Arc from (-xa,-ya) to point (x0,y0) where dy/dx = -1.
-        while (-dx >= dy)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            x--;
-            yp1 = y+1;
-            sigma = iA*x*x + 2*iB*x*yp1 + iC*yp1*yp1 - iD;
-            if (sigma >= 0)
-            {
-                dx += iC;
-                dy -= iB;
-                y = yp1;
-            }
-            dx -= iB;
-            dy += iA;
-        }
-
-        // Arc from (x0,y0) to point (x1,y1) where dx/dy = 0.
-        while (dx <= 0)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            y++;
-            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
-            if (sigma < 0)
-            {
-                dx -= iB;
-                dy += iA;
-                x--;
-            }
-            dx += iC;
-            dy -= iB;
-        }
-
-        // Arc from (x1,y1) to point (x2,y2) where dy/dx = 1.
-        while (dx <= dy)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            y++;
-            xp1 = x+1;
-            sigma = iA*xp1*xp1 + 2*iB*xp1*y+iC*y*y - iD;
-            if (sigma >= 0)
-            {
-                dx += iB;
-                dy -= iA;
-                x = xp1;
-            }
-            dx += iC;
-            dy -= iB;
-        }
 
-        // Arc from (x2,y2) to point (x3,y3) where dy/dx = 0.
-        while (dy >= 0)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            x++;
-            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
-            if (sigma < 0)
-            {
-                dx += iC;
-                dy -= iB;
-                y++;
-            }
-            dx += iB;
-            dy -= iA;
-        }
-
-        // Arc from (x3,y3) to (xa,ya).
-        while (x <= xa)
-        {
-            callback(xc+x, yc+y);
-            callback(xc-x, yc-y);
-            x++;
-            ym1 = y-1;
-            sigma = iA*x*x + 2*iB*x*ym1 + iC*ym1*ym1 - iD;
-            if (sigma >= 0)
-            {
-                dx -= iC;
-                dy += iB;
-                y = ym1;
-            }
-            dx += iB;
-            dy -= iA;
-        }
-    }
+    int XC, YC;
+    void (*Callback)(int,int);
+};
+}
+}
+//----------------------------------------------------------------------------
+void Wm5::GeneralEllipse2D (int xc, int yc, int xa, int ya, int xb, int yb,
+    void (*callback)(int,int))
+{
+    SymmetricPixels visitor;
+    visitor.XC = xc;
+    visitor.YC = yc;
+    visitor.Callback = callback;
+    GeneralEllipse2DHalf(xa, ya, xb, yb, visitor);
 }
 //----------------------------------------------------------------------------
 void Wm5::RecursiveFill (int x, int y, int xMax, int yMax, int** image,
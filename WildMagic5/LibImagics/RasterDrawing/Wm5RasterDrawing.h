@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5RASTERDRAWING_H
 #define WM5RASTERDRAWING_H
@@ -68,6 +68,11 @@ WM5_IMAGICS_ITEM void GeneralEllipse2D (int xc, int yc, int xa, int ya,
 // The initial call must guarantee that the seed point (x,y) satisfies
 // 0 <= x < xMax and 0 <= y < yMax and that image[y][x] is the
 // background color (backColor).  The fill color is specified by foreColor.
+// RecursiveFill recurses once per pixel and can overflow the call stack for
+// large regions, and NonrecursiveFill allocates two stacks of xMax*yMax
+// integers.  ScanlineFill in Wm5RasterSpans.h has neither problem.  For
+// drawing many primitives, the span versions in Wm5RasterSpans.h avoid the
+// callback per pixel.
 WM5_IMAGICS_ITEM void RecursiveFill (int x, int y, int xMax, int yMax,
     int** image, int foreColor, int backColor);
 
@@ -0,0 +1,898 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void Line2DSpans (int x0, int y0, int x1, int y1, Visitor& visitor)
+{
+    // Starting point of line.
+    int x = x0, y = y0;
+
+    // Direction of line.
+    int dx = x1 - x0, dy = y1 - y0;
+
+    // Increment or decrement depending on direction of line.
+    int sx = (dx > 0 ? 1 : (dx < 0 ? -1 : 0));
+    int sy = (dy > 0 ? 1 : (dy < 0 ? -1 : 0));
+
+    // Decision parameters for pixel selection.
+    if (dx < 0)
+    {
+        dx = -dx;
+    }
+    if (dy < 0)
+    {
+        dy = -dy;
+    }
+    int ax = 2*dx, ay = 2*dy;
+
+    if (dy > dx)
+    {
+        // Single-step in y-direction.  Each row has one pixel.
+        for (int decX = ax - dy; /**/; y += sy, decX += ax)
+        {
+            visitor(y, x, x);
+            if (y == y1)
+            {
+                break;
+            }
+            if (decX >= 0)
+            {
+                decX -= ay;
+                x += sx;
+            }
+        }
+        return;
+    }
+
+    // Single-step in x-direction.  The pixels of a row are consecutive, and
+    // the span of the row ends where the Bresenham step changes y.
+    int xStart = x;
+    for (int decY = ay - dx; /**/; x += sx, decY += ay)
+    {
+        bool last = (x == x1);
+        if (last || decY >= 0)
+        {
+            if (sx >= 0)
+            {
+                visitor(y, xStart, x);
+            }
+            else
+            {
+                visitor(y, x, xStart);
+            }
+            if (last)
+            {
+                break;
+            }
+            decY -= ax;
+            y += sy;
+            xStart = x + sx;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void Line3DSpans (int x0, int y0, int z0, int x1, int y1, int z1,
+    Visitor& visitor)
+{
+    // Starting point of line.
+    int x = x0, y = y0, z = z0;
+
+    // Direction of line.
+    int dx = x1 - x0, dy = y1 - y0, dz = z1 - z0;
+
+    // Increment or decrement depending on direction of line.
+    int sx = (dx > 0 ? 1 : (dx < 0 ? -1 : 0));
+    int sy = (dy > 0 ? 1 : (dy < 0 ? -1 : 0));
+    int sz = (dz > 0 ? 1 : (dz < 0 ? -1 : 0));
+
+    // Decision parameters for voxel selection.
+    if (dx < 0)
+    {
+        dx = -dx;
+    }
+    if (dy < 0)
+    {
+        dy = -dy;
+    }
+    if (dz < 0)
+    {
+        dz = -dz;
+    }
+    int ax = 2*dx, ay = 2*dy, az = 2*dz;
+    int decX, decY, decZ;
+
+    if (dy > dx || dz > dx)
+    {
+        // Single-step in y- or z-direction.  Each row has one voxel.
+        if (dz > dy)
+        {
+            decX = ax - dz;
+            decY = ay - dz;
+            for (/**/; /**/; z += sz, decX += ax, decY += ay)
+            {
+                visitor(y, z, x, x);
+                if (z == z1)
+                {
+                    break;
+                }
+                if (decX >= 0)
+                {
+                    decX -= az;
+                    x += sx;
+                }
+                if (decY >= 0)
+                {
+                    decY -= az;
+                    y += sy;
+                }
+            }
+        }
+        else
+        {
+            decX = ax - dy;
+            decZ = az - dy;
+            for (/**/; /**/; y += sy, decX += ax, decZ += az)
+            {
+                visitor(y, z, x, x);
+                if (y == y1)
+                {
+                    break;
+                }
+                if (decX >= 0)
+                {
+                    decX -= ay;
+                    x += sx;
+                }
+                if (decZ >= 0)
+                {
+                    decZ -= ay;
+                    z += sz;
+                }
+            }
+        }
+        return;
+    }
+
+    // Single-step in x-direction.  The span of a row ends where a Bresenham
+    // step changes y or z.
+    int xStart = x;
+    decY = ay - dx;
+    decZ = az - dx;
+    for (/**/; /**/; x += sx, decY += ay, decZ += az)
+    {
+        bool last = (x == x1);
+        if (last || decY >= 0 || decZ >= 0)
+        {
+            if (sx >= 0)
+            {
+                visitor(y, z, xStart, x);
+            }
+            else
+            {
+                visitor(y, z, x, xStart);
+            }
+            if (last)
+            {
+                break;
+            }
+            if (decY >= 0)
+            {
+                decY -= ax;
+                y += sy;
+            }
+            if (decZ >= 0)
+            {
+                decZ -= ax;
+                z += sz;
+            }
+            xStart = x + sx;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void Circle2DSpans (int xc, int yc, int radius, Visitor& visitor)
+{
+    // The octants next to the y-axis have a run of pixels in each of the
+    // rows yc+y and yc-y, which ends where the Bresenham step decrements y.
+    // The octants next to the x-axis have one pixel per row.
+    int xStart = 0;
+    for (int x = 0, y = radius, dec = 3 - 2*radius; x <= y; ++x)
+    {
+        visitor(yc + x, xc + y, xc + y);
+        visitor(yc + x, xc - y, xc - y);
+        visitor(yc - x, xc + y, xc + y);
+        visitor(yc - x, xc - y, xc - y);
+
+        int yNext = (dec >= 0 ? y - 1 : y);
+        if (yNext < y || x + 1 > yNext)
+        {
+            for (int i = 0, yRow = yc + y; i < 2; ++i, yRow = yc - y)
+            {
+                if (xStart == 0)
+                {
+                    visitor(yRow, xc - x, xc + x);
+                }
+                else
+                {
+                    visitor(yRow, xc - x, xc - xStart);
+                    visitor(yRow, xc + xStart, xc + x);
+                }
+            }
+            xStart = x + 1;
+        }
+
+        if (dec >= 0)
+        {
+            dec += -4*(y--) + 4;
+        }
+        dec += 4*x + 6;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void Ellipse2DSpans (int xc, int yc, int A, int B, Visitor& visitor)
+{
+    int A2 = A*A, B2 = B*B;
+    int x, y, dec, i, yRow;
+
+    // The arcs next to the y-axis have a run of pixels in each of the rows
+    // yc+y and yc-y, which ends where the Bresenham step decrements y.
+    int xStart = 0;
+    for (x = 0, y = B, dec = 2*B2+A2*(1-2*B); B2*x <= A2*y; ++x)
+    {
+        int yNext = (dec >= 0 ? y - 1 : y);
+        if (yNext < y || B2*(x + 1) > A2*yNext)
+        {
+            for (i = 0, yRow = yc + y; i < 2; ++i, yRow = yc - y)
+            {
+                if (xStart == 0)
+                {
+                    visitor(yRow, xc - x, xc + x);
+                }
+                else
+                {
+                    visitor(yRow, xc - x, xc - xStart);
+                    visitor(yRow, xc + xStart, xc + x);
+                }
+            }
+            xStart = x + 1;
+        }
+
+        if (dec >= 0)
+        {
+            dec += 4*A2*(1-(y--));
+        }
+        dec += B2*(4*x+6);
+    }
+    if (y == 0 && x < A)
+    {
+        // The discretization caused us to reach the y-axis before the
+        // x-values reached the ellipse vertices.  Draw a solid line along
+        // the x-axis to those vertices.
+        visitor(yc, xc + x, xc + A);
+        visitor(yc, xc - A, xc - x);
+        return;
+    }
+
+    // The arcs next to the x-axis have one pixel per row and side.
+    for (x = A, y = 0, dec = 2*A2+B2*(1-2*A); A2*y <= B2*x; ++y)
+    {
+        visitor(yc + y, xc + x, xc + x);
+        visitor(yc + y, xc - x, xc - x);
+        visitor(yc - y, xc + x, xc + x);
+        visitor(yc - y, xc - x, xc - x);
+
+        if (dec >= 0)
+        {
+            dec += 4*B2*(1-(x--));
+        }
+        dec += A2*(4*y+6);
+    }
+    if (x == 0 && y < B)
+    {
+        // The discretization caused us to reach the x-axis before the
+        // y-values reached the ellipse vertices.  Draw a solid line along
+        // the y-axis to those vertices.
+        for (/**/; y <= B; ++y)
+        {
+            visitor(yc + y, xc, xc);
+            visitor(yc - y, xc, xc);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void GeneralEllipse2DSpans (int xc, int yc, int xa, int ya, int xb, int yb,
+    Visitor& visitor)
+{
+    SymmetricSpanBuilder<Visitor> builder(xc, yc, visitor);
+    GeneralEllipse2DHalf(xa, ya, xb, yb, builder);
+    builder.Flush();
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void GeneralEllipse2DHalf (int xa, int ya, int xb, int yb, Visitor& visitor)
+{
+    // Change sign and/or swap the direction vectors in order to satisfy this
+    // algorithm's requirement for visiting pixels in a particular order.
+    int save;
+    if (xa <= 0 && ya > 0)
+    {
+        // Use (-xb,-yb,xa,ya).
+        save = xa;
+        xa = -xb;
+        xb = save;
+        save = ya;
+        ya = -yb;
+        yb = save;
+    }
+    else if (xa < 0 && ya <= 0)
+    {
+        // Use (-xa,-ya,-xb,-yb).
+        xa = -xa;
+        ya = -ya;
+        xb = -xb;
+        yb = -yb;
+    }
+    else if (xa >= 0 && ya < 0)
+    {
+        // Use (xb,yb,-xa,-ya).
+        save = xa;
+        xa = xb;
+        xb = -save;
+        save = ya;
+        ya = yb;
+        yb = -save;
+    }
+    // else (xa > 0 && ya >= 0): use (xa,ya,xb,yb)
+
+    // Ellipse is a*(x-xc)^2+2*b*(x-xc)*(y-yc)+c*(y-yc)^2 = d where
+    //
+    //   a = xa^2*Lb^4 + xb^2*La^4
+    //   b = xa*ya*Lb^4 + xb*yb*La^4
+    //   c = ya^2*Lb^4 + yb^2*La^4
+    //   d = La^4*Lb^4
+    //   La^2 = xa^2+ya^2
+    //   Lb^2 = xb^2+yb^2
+    //
+    // Pixel determination is performed relative to origin (0,0).  The
+    // ellipse at origin is a*x^2+b*x*y+c*y^2=d.  Slope of curve is
+    // dy/dx = -(a*x+b*y)/(b*x+c*y).  Slope at (xb,yb) is
+    // dy/dx = -xb/yb >= 0 and slope at (xa,ya) is dy/dx = -xa/ya < 0.
+
+    Integer<4> iXA2 = xa*xa;
+    Integer<4> iYA2 = ya*ya;
+    Integer<4> iXB2 = xb*xb;
+    Integer<4> iYB2 = yb*yb;
+    Integer<4> iXAYA = xa*ya;
+    Integer<4> iXBYB = xb*yb;
+    Integer<4> iLa2 = iXA2+iYA2;
+    Integer<4> iLa4 = iLa2*iLa2;
+    Integer<4> iLb2 = iXB2+iYB2;
+    Integer<4> iLb4 = iLb2*iLb2;
+    Integer<4> iA = iXA2*iLb4 + iXB2*iLa4;
+    Integer<4> iB = iXAYA*iLb4 + iXBYB*iLa4;
+    Integer<4> iC = iYA2*iLb4 + iYB2*iLa4;
+    Integer<4> iD = iLa4*iLb4;
+
+    Integer<4> dx, dy, sigma;
+    int x, y, xp1, ym1, yp1;
+
+    if (ya <= xa)
+    {
+        // Start at (-xA,-yA).
+        x = -xa;
+        y = -ya;
+        dx = -(iB*xa + iC*ya);
+        dy = iA*xa + iB*ya;
+
+        // Arc from (-xA,-yA) to point (x0,y0) where dx/dy = 0.
+        while (dx <= 0)
+        {
+            visitor(x, y);
+            y++;
+            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
+            if (sigma < 0)
+            {
+                dx -= iB;
+                dy += iA;
+                x--;
+            }
+            dx += iC;
+            dy -= iB;
+        }
+
+        // Arc from (x0,y0) to point (x1,y1) where dy/dx = 1.
+        while (dx <= dy)
+        {
+            visitor(x, y);
+            y++;
+            xp1 = x+1;
+            sigma = iA*xp1*xp1 + 2*iB*xp1*y + iC*y*y - iD;
+            if (sigma >= 0)
+            {
+                dx += iB;
+                dy -= iA;
+                x = xp1;
+            }
+            dx += iC;
+            dy -= iB;
+        }
+
+        // Arc from (x1,y1) to point (x2,y2) where dy/dx = 0.
+        while (dy >= 0)
+        {
+            visitor(x, y);
+            x++;
+            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
+            if (sigma < 0)
+            {
+                dx += iC;
+                dy -= iB;
+                y++;
+            }
+            dx += iB;
+            dy -= iA;
+        }
+
+        // Arc from (x2,y2) to point (x3,y3) where dy/dx = -1.
+        while (dy >= -dx)
+        {
+            visitor(x, y);
+            x++;
+            ym1 = y-1;
+            sigma = iA*x*x + 2*iB*x*ym1 + iC*ym1*ym1 - iD;
+            if (sigma >= 0)
+            {
+                dx -= iC;
+                dy += iB;
+                y = ym1;
+            }
+            dx += iB;
+            dy -= iA;
+        }
+
+        // Arc from (x3,y3) to (xa,ya).
+        while (y >= ya)
+        {
+            visitor(x, y);
+            y--;
+            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
+            if (sigma < 0)
+            {
+                dx += iB;
+                dy -= iA;
+                x++;
+            }
+            dx -= iC;
+            dy += iB;
+        }
+    }
+    else
+    {
+        // Start at (-xa,-ya).
+        x = -xa;
+        y = -ya;
+        dx = -(iB*xa + iC*ya);
+        dy = iA*xa + iB*ya;
+
+        // Arc from (-xa,-ya) to point (x0,y0) where dy/dx = -1.
+        while (-dx >= dy)
+        {
+            visitor(x, y);
+            x--;
+            yp1 = y+1;
+            sigma = iA*x*x + 2*iB*x*yp1 + iC*yp1*yp1 - iD;
+            if (sigma >= 0)
+            {
+                dx += iC;
+                dy -= iB;
+                y = yp1;
+            }
+            dx -= iB;
+            dy += iA;
+        }
+
+        // Arc from (x0,y0) to point (x1,y1) where dx/dy = 0.
+        while (dx <= 0)
+        {
+            visitor(x, y);
+            y++;
+            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
+            if (sigma < 0)
+            {
+                dx -= iB;
+                dy += iA;
+                x--;
+            }
+            dx += iC;
+            dy -= iB;
+        }
+
+        // Arc from (x1,y1) to point (x2,y2) where dy/dx = 1.
+        while (dx <= dy)
+        {
+            visitor(x, y);
+            y++;
+            xp1 = x+1;
+            sigma = iA*xp1*xp1 + 2*iB*xp1*y+iC*y*y - iD;
+            if (sigma >= 0)
+            {
+                dx += iB;
+                dy -= iA;
+                x = xp1;
+            }
+            dx += iC;
+            dy -= iB;
+        }
+
+        // Arc from (x2,y2) to point (x3,y3) where dy/dx = 0.
+        while (dy >= 0)
+        {
+            visitor(x, y);
+            x++;
+            sigma = iA*x*x + 2*iB*x*y + iC*y*y - iD;
+            if (sigma < 0)
+            {
+                dx += iC;
+                dy -= iB;
+                y++;
+            }
+            dx += iB;
+            dy -= iA;
+        }
+
+        // Arc from (x3,y3) to (xa,ya).
+        while (x <= xa)
+        {
+            visitor(x, y);
+            x++;
+            ym1 = y-1;
+            sigma = iA*x*x + 2*iB*x*ym1 + iC*ym1*ym1 - iD;
+            if (sigma >= 0)
+            {
+                dx -= iC;
+                dy += iB;
+                y = ym1;
+            }
+            dx += iB;
+            dy -= iA;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+SymmetricSpanBuilder<Visitor>::SymmetricSpanBuilder (int xc, int yc,
+    Visitor& visitor)
+    :
+    mXC(xc),
+    mYC(yc),
+    mY(0),
+    mX0(0),
+    mX1(0),
+    mEmpty(true),
+    mVisitor(visitor)
+{
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void SymmetricSpanBuilder<Visitor>::operator() (int x, int y)
+{
+    if (!mEmpty && y == mY)
+    {
+        if (x == mX1 + 1)
+        {
+            mX1 = x;
+            return;
+        }
+        if (x == mX0 - 1)
+        {
+            mX0 = x;
+            return;
+        }
+        if (mX0 <= x && x <= mX1)
+        {
+            return;
+        }
+    }
+
+    Flush();
+    mY = y;
+    mX0 = x;
+    mX1 = x;
+    mEmpty = false;
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void SymmetricSpanBuilder<Visitor>::Flush ()
+{
+    if (!mEmpty)
+    {
+        mVisitor(mYC + mY, mXC + mX0, mXC + mX1);
+        mVisitor(mYC - mY, mXC - mX1, mXC - mX0);
+        mEmpty = true;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Visitor>
+void FillPolygons2D (int numPolygons, const int* numVertices,
+    const Vector2f* vertices, int yMin, int yMax, Visitor& visitor,
+    FillRule rule)
+{
+    if (yMin >= yMax)
+    {
+        return;
+    }
+
+    // The edge table.  Edge e crosses the rows edgeBegin[e] <= y < edgeEnd[e]
+    // at x = edgeX[e] + edgeSlope[e]*(y - edgeY[e]), and edgeWinding[e] is
+    // +1 for an edge that goes to larger y and -1 otherwise.  Horizontal
+    // edges cross no rows.
+    std::vector<double> edgeX, edgeY, edgeSlope;
+    std::vector<int> edgeBegin, edgeEnd, edgeWinding;
+    int p, i, e, y;
+    int rowMin = yMax, rowMax = yMin;
+    const Vector2f* polygon = vertices;
+    for (p = 0; p < numPolygons; polygon += numVertices[p], ++p)
+    {
+        const int n = numVertices[p];
+        for (i = 0; i < n; ++i)
+        {
+            const Vector2f& v0 = polygon[i];
+            const Vector2f& v1 = polygon[i + 1 < n ? i + 1 : 0];
+            if (v0[1] == v1[1])
+            {
+                continue;
+            }
+
+            const int winding = (v1[1] > v0[1] ? +1 : -1);
+            const Vector2f& lower = (winding > 0 ? v0 : v1);
+            const Vector2f& upper = (winding > 0 ? v1 : v0);
+            int begin = (int)Mathd::Ceil((double)lower[1]);
+            int end = (int)Mathd::Ceil((double)upper[1]);
+            if (begin < yMin)
+            {
+                begin = yMin;
+            }
+            if (end > yMax)
+            {
+                end = yMax;
+            }
+            if (begin >= end)
+            {
+                continue;
+            }
+
+            edgeX.push_back((double)lower[0]);
+            edgeY.push_back((double)lower[1]);
+            edgeSlope.push_back(((double)upper[0] - (double)lower[0])/
+                ((double)upper[1] - (double)lower[1]));
+            edgeBegin.push_back(begin);
+            edgeEnd.push_back(end);
+            edgeWinding.push_back(winding);
+            if (begin < rowMin)
+            {
+                rowMin = begin;
+            }
+            if (end > rowMax)
+            {
+                rowMax = end;
+            }
+        }
+    }
+
+    // Bucket the edges by their first row.  rowFirst[r] is the first of
+    // the edges that begin at row rowMin+r, and edgeNext links the others.
+    const int numEdges = (int)edgeBegin.size();
+    if (numEdges == 0)
+    {
+        return;
+    }
+    std::vector<int> rowFirst(rowMax - rowMin, -1), edgeNext(numEdges);
+    for (e = numEdges - 1; e >= 0; --e)
+    {
+        edgeNext[e] = rowFirst[edgeBegin[e] - rowMin];
+        rowFirst[edgeBegin[e] - rowMin] = e;
+    }
+
+    // The active edges and the x of their crossings with the row, sorted by
+    // x.  From row to row the order of the remaining edges changes only
+    // where edges cross, so an insertion sort restores it in nearly linear
+    // time.  The edges that enter at a row are sorted separately and
+    // merged.
+    std::vector<std::pair<double,int> > active, entering, merged;
+    for (y = rowMin; y < rowMax; ++y)
+    {
+        int numActive = 0;
+        for (i = 0; i < (int)active.size(); ++i)
+        {
+            e = active[i].second;
+            if (edgeEnd[e] > y)
+            {
+                double x = edgeX[e] + edgeSlope[e]*((double)y - edgeY[e]);
+                int j = numActive++;
+                for (/**/; j > 0 && active[j-1].first > x; --j)
+                {
+                    active[j] = active[j-1];
+                }
+                active[j] = std::make_pair(x, e);
+            }
+        }
+        active.resize(numActive);
+
+        entering.clear();
+        for (e = rowFirst[y - rowMin]; e >= 0; e = edgeNext[e])
+        {
+            double x = edgeX[e] + edgeSlope[e]*((double)y - edgeY[e]);
+            entering.push_back(std::make_pair(x, e));
+        }
+        if (!entering.empty())
+        {
+            std::sort(entering.begin(), entering.end());
+            merged.resize(numActive + entering.size());
+            std::merge(active.begin(), active.end(), entering.begin(),
+                entering.end(), merged.begin());
+            active.swap(merged);
+            numActive = (int)active.size();
+        }
+
+        // The pixels x with xLeft <= x < xRight are inside.
+        int winding = 0;
+        double xLeft = 0.0;
+        for (i = 0; i < numActive; ++i)
+        {
+            int previous = winding;
+            if (rule == FR_EVEN_ODD)
+            {
+                winding ^= 1;
+            }
+            else
+            {
+                winding += edgeWinding[active[i].second];
+            }
+
+            if (previous == 0)
+            {
+                xLeft = active[i].first;
+            }
+            else if (winding == 0)
+            {
+                int x0 = (int)Mathd::Ceil(xLeft);
+                int x1 = (int)Mathd::Ceil(active[i].first) - 1;
+                if (x0 <= x1)
+                {
+                    visitor(y, x0, x1);
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+TImageSpanWriter<T>::TImageSpanWriter (TImage2D<T>& image, T value)
+    :
+    mData(image.GetData()),
+    mXBound(image.GetBound(0)),
+    mYBound(image.GetBound(1)),
+    mValue(value)
+{
+}
+//----------------------------------------------------------------------------
+template <typename T>
+inline void TImageSpanWriter<T>::operator() (int y, int x0, int x1)
+{
+    if (y < 0 || y >= mYBound)
+    {
+        return;
+    }
+    if (x0 < 0)
+    {
+        x0 = 0;
+    }
+    if (x1 >= mXBound)
+    {
+        x1 = mXBound - 1;
+    }
+
+    T* row = mData + mXBound*y;
+    for (int x = x0; x <= x1; ++x)
+    {
+        row[x] = mValue;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void ScanlineFill (int x, int y, int xMax, int yMax, T** image,
+    T foreColor)
+{
+    const T backColor = image[y][x];
+    if (backColor == foreColor)
+    {
+        return;
+    }
+
+    // The stack of seeds, as (x,y) pairs.
+    std::vector<int> stack;
+    stack.push_back(x);
+    stack.push_back(y);
+    while (!stack.empty())
+    {
+        y = stack.back();
+        stack.pop_back();
+        x = stack.back();
+        stack.pop_back();
+        T* row = image[y];
+        if (row[x] != backColor)
+        {
+            // The seed was filled as part of the span of an earlier seed.
+            continue;
+        }
+
+        // Fill the maximal span of the background color that contains the
+        // seed.
+        int x0 = x, x1 = x;
+        while (x0 > 0 && row[x0-1] == backColor)
+        {
+            --x0;
+        }
+        while (x1 + 1 < xMax && row[x1+1] == backColor)
+        {
+            ++x1;
+        }
+        for (x = x0; x <= x1; ++x)
+        {
+            row[x] = foreColor;
+        }
+
+        // Push one seed for each run of the background color in the rows
+        // above and below the span.
+        for (int adjacent = y - 1; adjacent <= y + 1; adjacent += 2)
+        {
+            if (adjacent < 0 || adjacent >= yMax)
+            {
+                continue;
+            }
+
+            const T* adjacentRow = image[adjacent];
+            bool inRun = false;
+            for (x = x0; x <= x1; ++x)
+            {
+                if (adjacentRow[x] == backColor)
+                {
+                    if (!inRun)
+                    {
+                        stack.push_back(x);
+                        stack.push_back(adjacent);
+                        inRun = true;
+                    }
+                }
+                else
+                {
+                    inRun = false;
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename T>
+void ScanlineFill (TImage2D<T>& image, int x, int y, T foreColor)
+{
+    const int xBound = image.GetBound(0);
+    const int yBound = image.GetBound(1);
+    std::vector<T*> rows(yBound);
+    for (int i = 0; i < yBound; ++i)
+    {
+        rows[i] = &image(0, i);
+    }
+    ScanlineFill(x, y, xBound, yBound, &rows[0], foreColor);
+}
+//----------------------------------------------------------------------------
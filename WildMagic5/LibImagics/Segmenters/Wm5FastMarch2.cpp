@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5FastMarch2.h"
@@ -259,45 +259,50 @@ void FastMarch2::ComputeTime (int i)
         yConst = 0.0f;
     }
 
-    if (hasXTerm)
+    if (!hasXTerm && !hasYTerm)
     {
-        if (hasYTerm)
-        {
-            float sum = xConst + yConst;
-            float diff = xConst - yConst;
-            float discr = 2.0f*mInvSpeeds[i]*mInvSpeeds[i] - diff*diff;
-            if (discr >= 0.0f)
-            {
-                // The quadratic equation has a real-valued solution.  Choose
-                // the largest positive root for the crossing time.
-                mTimes[i] = 0.5f*(sum + Mathf::Sqrt(discr));
-            }
-            else
-            {
-                // The quadratic equation does not have a real-valued
-                // solution.  This can happen when the speed is so large
-                // that the time gradient has very small length, which means
-                // that the time has not changed significantly from the
-                // neighbors to the current pixel.  Just choose the maximum
-                // time of the neighbors (Is there a better choice?).
-                mTimes[i] = (diff >= 0.0f ? xConst : yConst);
-            }
-        }
-        else
-        {
-            // The equation is linear.
-            mTimes[i] = mInvSpeeds[i] + xConst;
-        }
+        // The pixel must have at least one known neighbor.
+        assertion(false, "Pixel must have a known neighbor\n");
+        return;
     }
-    else if (hasYTerm)
+
+    // The upwind discretization uses only the axes whose neighbor times are
+    // smaller than the crossing time, as in FastMarch3.  The single-axis
+    // root is the crossing time when it does not exceed the larger neighbor
+    // time; otherwise it is larger than both neighbor times, so the
+    // discriminant of the two-axis equation is positive.
+    float invSpeed = mInvSpeeds[i];
+    if (!hasYTerm)
     {
-        // The equation is linear.
-        mTimes[i] = mInvSpeeds[i] + yConst;
+        mTimes[i] = xConst + invSpeed;
+        return;
+    }
+    if (!hasXTerm)
+    {
+        mTimes[i] = yConst + invSpeed;
+        return;
+    }
+
+    float minTime, maxTime;
+    if (xConst <= yConst)
+    {
+        minTime = xConst;
+        maxTime = yConst;
     }
     else
     {
-        // The pixel must have at least one known neighbor.
-        assertion(false, "Pixel must have a known neighbor\n");
+        minTime = yConst;
+        maxTime = xConst;
+    }
+
+    float time = minTime + invSpeed;
+    if (time > maxTime)
+    {
+        float sum = xConst + yConst;
+        float diff = xConst - yConst;
+        float discr = 2.0f*invSpeed*invSpeed - diff*diff;
+        time = 0.5f*(sum + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f));
     }
+    mTimes[i] = time;
 }
 //----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "Wm5ImagicsPCH.h"
 #include "Wm5FastMarch3.h"
@@ -57,110 +57,46 @@ void FastMarch3::Initialize (int xBound, int yBound, int zBound,
     // to process the boundary pixels separately during the iteration.
     int x, y, z, i;
 
-    // vertex (0,0,0)
-    i = Index(0,0,0);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (xmax,0,0)
-    i = Index(mXBm1,0,0);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (0,ymax,0)
-    i = Index(0,mYBm1,0);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (xmax,ymax,0)
-    i = Index(mXBm1,mYBm1,0);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (0,0,zmax)
-    i = Index(0,0,mZBm1);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (xmax,0,zmax)
-    i = Index(mXBm1,0,mZBm1);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (0,ymax,zmax)
-    i = Index(0,mYBm1,mZBm1);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // vertex (xmax,ymax,zmax)
-    i = Index(mXBm1,mYBm1,mZBm1);
-    mInvSpeeds[i] = Mathf::MAX_REAL;
-    mTimes[i] = -Mathf::MAX_REAL;
-
-    // edges (x,0,0) and (x,ymax,0)
-    for (x = 0; x < mXBound; ++x)
-    {
-        i = Index(x,0,0);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(x,mYBm1,0);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-    }
-
-    // edges (0,y,0) and (xmax,y,0)
+    // faces (x,y,0) and (x,y,zmax)
     for (y = 0; y < mYBound; ++y)
     {
-        i = Index(0,y,0);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(mXBm1,y,0);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-    }
-
-    // edges (x,0,zmax) and (x,ymax,zmax)
-    for (x = 0; x < mXBound; ++x)
-    {
-        i = Index(x,0,mZBm1);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(x,mYBm1,mZBm1);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-    }
-
-    // edges (0,y,zmax) and (xmax,y,zmax)
-    for (y = 0; y < mYBound; ++y)
-    {
-        i = Index(0,y,mZBm1);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(mXBm1,y,mZBm1);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
+        for (x = 0; x < mXBound; ++x)
+        {
+            i = Index(x,y,0);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+            i = Index(x,y,mZBm1);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+        }
     }
 
-    // edges (0,0,z) and (xmax,0,z)
+    // faces (x,0,z) and (x,ymax,z)
     for (z = 0; z < mZBound; ++z)
     {
-        i = Index(0,0,z);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(mXBm1,0,z);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
+        for (x = 0; x < mXBound; ++x)
+        {
+            i = Index(x,0,z);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+            i = Index(x,mYBm1,z);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+        }
     }
 
-    // edges (0,ymax,z) and (xmax,ymax,z)
+    // faces (0,y,z) and (xmax,y,z)
     for (z = 0; z < mZBound; ++z)
     {
-        i = Index(0,mYBm1,z);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
-        i = Index(mXBm1,mYBm1,z);
-        mInvSpeeds[i] = Mathf::MAX_REAL;
-        mTimes[i] = -Mathf::MAX_REAL;
+        for (y = 0; y < mYBound; ++y)
+        {
+            i = Index(0,y,z);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+            i = Index(mXBm1,y,z);
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+            mTimes[i] = -Mathf::MAX_REAL;
+        }
     }
 
     // Compute the first batch of trial pixels.  These are pixels a grid
@@ -390,155 +326,60 @@ void FastMarch3::ComputeTime (int i)
         zConst = 0.0f;
     }
 
-    float sum, diff, discr;
-
+    // Sort the times of the axes that have a valid neighbor.
+    float times[3] = { 0.0f, 0.0f, 0.0f };
+    int numTerms = 0;
     if (hasXTerm)
     {
-        if (hasYTerm)
-        {
-            if (hasZTerm)
-            {
-                // xyz
-                sum = xConst + yConst + zConst;
-                discr = 3.0f*mInvSpeeds[i]*mInvSpeeds[i];
-                diff = xConst - yConst;
-                discr -= diff*diff;
-                diff = xConst - zConst;
-                discr -= diff*diff;
-                diff = yConst - zConst;
-                discr -= diff*diff;
-                if (discr >= 0.0f)
-                {
-                    // The quadratic equation has a real-valued solution.
-                    // Choose the largest positive root for the crossing time.
-                    mTimes[i] = msOneThird*(sum + Mathf::Sqrt(discr));
-                }
-                else
-                {
-                    // The quadratic equation does not have a real-valued
-                    // solution.  This can happen when the speed is so large
-                    // that the time gradient has very small length, which
-                    // means that the time has not changed significantly from
-                    // the neighbors to the current pixel.  Just choose the
-                    // maximum time of the neighbors.  Is there a better
-                    // choice?.
-                    mTimes[i] = xConst;
-                    if (yConst > mTimes[i])
-                    {
-                        mTimes[i] = yConst;
-                    }
-                    if (zConst > mTimes[i])
-                    {
-                        mTimes[i] = zConst;
-                    }
-                }
-            }
-            else
-            {
-                // xy
-                sum = xConst + yConst;
-                diff = xConst - yConst;
-                discr = 2.0f*mInvSpeeds[i]*mInvSpeeds[i] - diff*diff;
-                if (discr >= 0.0f)
-                {
-                    // The quadratic equation has a real-valued solution.
-                    // Choose the largest positive root for the crossing time.
-                    mTimes[i] = 0.5f*(sum + Mathf::Sqrt(discr));
-                }
-                else
-                {
-                    // The quadratic equation does not have a real-valued
-                    // solution.  This can happen when the speed is so large
-                    // that the time gradient has very small length, which
-                    // means that the time has not changed significantly from
-                    // the neighbors to the current pixel.  Just choose the
-                    // maximum time of the neighbors.  Is there a better
-                    // choice?.
-                    mTimes[i] = (diff >= 0.0f ? xConst : yConst);
-                }
-            }
-        }
-        else
-        {
-            if (hasZTerm)
-            {
-                // xz
-                sum = xConst + zConst;
-                diff = xConst - zConst;
-                discr = 2.0f*mInvSpeeds[i]*mInvSpeeds[i] - diff*diff;
-                if (discr >= 0.0f)
-                {
-                    // The quadratic equation has a real-valued solution.
-                    // Choose the largest positive root for the crossing time.
-                    mTimes[i] = 0.5f*(sum + Mathf::Sqrt(discr));
-                }
-                else
-                {
-                    // The quadratic equation does not have a real-valued
-                    // solution.  This can happen when the speed is so large
-                    // that the time gradient has very small length, which
-                    // means that the time has not changed significantly from
-                    // the neighbors to the current pixel.  Just choose the
-                    // maximum time of the neighbors.  Is there a better
-                    // choice?.
-                    mTimes[i] = (diff >= 0.0f ? xConst : zConst);
-                }
-            }
-            else
-            {
-                // x
-                mTimes[i] = mInvSpeeds[i] + xConst;
-            }
-        }
+        times[numTerms++] = xConst;
     }
-    else
+    if (hasYTerm)
     {
-        if (hasYTerm)
-        {
-            if (hasZTerm)
-            {
-                // yz
-                sum = yConst + zConst;
-                diff = yConst - zConst;
-                discr = 2.0f*mInvSpeeds[i]*mInvSpeeds[i] - diff*diff;
-                if (discr >= 0.0f)
-                {
-                    // The quadratic equation has a real-valued solution.
-                    // Choose the largest positive root for the crossing time.
-                    mTimes[i] = 0.5f*(sum + Mathf::Sqrt(discr));
-                }
-                else
-                {
-                    // The quadratic equation does not have a real-valued
-                    // solution.  This can happen when the speed is so large
-                    // that the time gradient has very small length, which
-                    // means that the time has not changed significantly from
-                    // the neighbors to the current pixel.  Just choose the
-                    // maximum time of the neighbors.  Is there a better
-                    // choice?.
-                    mTimes[i] = (diff >= 0.0f ? yConst : zConst);
-                }
-            }
-            else
-            {
-                // y
-                mTimes[i] = mInvSpeeds[i] + yConst;
-            }
-        }
-        else
+        times[numTerms++] = yConst;
+    }
+    if (hasZTerm)
+    {
+        times[numTerms++] = zConst;
+    }
+    if (numTerms == 0)
+    {
+        // The voxel has no known neighbor, so its time cannot be computed.
+        // This does not happen for voxels in the trial heap.
+        assertion(false, "Voxel must have a known neighbor\n");
+        return;
+    }
+    std::sort(times, times + numTerms);
+
+    // The upwind discretization uses only the axes whose neighbor times are
+    // smaller than the crossing time.  The axes are added in increasing
+    // order of time, and the quadratic equation for the axes used so far
+    // is solved, choosing the largest root.  When the root does not exceed
+    // the time of the next axis, that axis is not upwind and the root is
+    // the crossing time.  Otherwise the root is larger than the time of
+    // each axis used, so the discriminant of the next equation is
+    // positive.
+    float invSpeed = mInvSpeeds[i];
+    float time = times[0] + invSpeed;
+    if (numTerms > 1 && time > times[1])
+    {
+        // Two axes.
+        float sum = times[0] + times[1];
+        float diff = times[0] - times[1];
+        float discr = 2.0f*invSpeed*invSpeed - diff*diff;
+        time = 0.5f*(sum + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f));
+        if (numTerms > 2 && time > times[2])
         {
-            if (hasZTerm)
-            {
-                // z
-                mTimes[i] = mInvSpeeds[i] + zConst;
-            }
-            else
-            {
-                // No terms, which cannot happen.  The voxel must have at
-                // least one valid neighbor.
-                assertion(false, "Voxel must have a known neighbor\n");
-            }
+            // Three axes.
+            sum += times[2];
+            discr = 3.0f*invSpeed*invSpeed - diff*diff;
+            diff = times[0] - times[2];
+            discr -= diff*diff;
+            diff = times[1] - times[2];
+            discr -= diff*diff;
+            time = msOneThird*(sum + Mathf::Sqrt(discr > 0.0f ?
+                discr : 0.0f));
         }
     }
+    mTimes[i] = time;
 }
 //----------------------------------------------------------------------------
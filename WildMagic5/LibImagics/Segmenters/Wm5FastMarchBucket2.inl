@@ -0,0 +1,79 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+inline int FastMarchBucket2::GetXBound () const
+{
+    return mXBound;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket2::GetYBound () const
+{
+    return mYBound;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket2::GetXSpacing () const
+{
+    return mXSpacing;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket2::GetYSpacing () const
+{
+    return mYSpacing;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket2::GetQuantity () const
+{
+    return mQuantity;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket2::Index (int x, int y) const
+{
+    return x + mXBound*y;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket2::GetBucketWidth () const
+{
+    return mBucketWidth;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket2::GetNumBuckets () const
+{
+    return mNumBuckets;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket2::GetTime (int i) const
+{
+    return (mStates[i] != VS_FROZEN ? mTimes[i] : -Mathf::MAX_REAL);
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket2::IsValid (int i) const
+{
+    return mStates[i] == VS_TRIAL || mStates[i] == VS_KNOWN;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket2::IsTrial (int i) const
+{
+    return mStates[i] == VS_TRIAL;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket2::IsFar (int i) const
+{
+    return mStates[i] == VS_FAR;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket2::IsZeroSpeed (int i) const
+{
+    return mStates[i] == VS_FROZEN;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket2::IsInterior (int i) const
+{
+    return mStates[i] == VS_KNOWN;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,391 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5ImagicsPCH.h"
+#include "Wm5FastMarchBucket3.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+const int FastMarchBucket3::msMaxBuckets = 65536;
+
+//----------------------------------------------------------------------------
+FastMarchBucket3::FastMarchBucket3 (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing, const float* speeds,
+    const std::vector<int>& seeds, float bucketWidth)
+{
+    // Invert the speeds since the reciprocals are all that are needed in the
+    // numerical method.  Zero speeds are marked in Initialize.
+    int quantity = xBound*yBound*zBound;
+    mInvSpeeds = new1<float>(quantity);
+    mInvSpeed = 0.0f;
+    float minInvSpeed = Mathf::MAX_REAL, maxInvSpeed = 0.0f;
+    for (int i = 0; i < quantity; ++i)
+    {
+        assertion(speeds[i] >= 0.0f, "Invalid speed\n");
+        if (speeds[i] > 0.0f)
+        {
+            float invSpeed = 1.0f/speeds[i];
+            mInvSpeeds[i] = invSpeed;
+            if (invSpeed < minInvSpeed)
+            {
+                minInvSpeed = invSpeed;
+            }
+            if (invSpeed > maxInvSpeed)
+            {
+                maxInvSpeed = invSpeed;
+            }
+        }
+        else
+        {
+            mInvSpeeds[i] = Mathf::MAX_REAL;
+        }
+    }
+
+    Initialize(xBound, yBound, zBound, xSpacing, ySpacing, zSpacing, seeds,
+        minInvSpeed, maxInvSpeed, bucketWidth);
+}
+//----------------------------------------------------------------------------
+FastMarchBucket3::FastMarchBucket3 (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing, const float speed,
+    const std::vector<int>& seeds, float bucketWidth)
+{
+    assertion(speed > 0.0f, "Invalid speed\n");
+    mInvSpeeds = 0;
+    mInvSpeed = 1.0f/speed;
+
+    Initialize(xBound, yBound, zBound, xSpacing, ySpacing, zSpacing, seeds,
+        mInvSpeed, mInvSpeed, bucketWidth);
+}
+//----------------------------------------------------------------------------
+FastMarchBucket3::~FastMarchBucket3 ()
+{
+    delete1(mBuckets);
+    delete1(mStates);
+    delete1(mTimes);
+    delete1(mInvSpeeds);
+}
+//----------------------------------------------------------------------------
+void FastMarchBucket3::Initialize (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing,
+    const std::vector<int>& seeds, float minInvSpeed, float maxInvSpeed,
+    float bucketWidth)
+{
+    assertion(xBound >= 3 && yBound >= 3 && zBound >= 3,
+        "Image must have interior voxels\n");
+
+    mXBound = xBound;
+    mYBound = yBound;
+    mZBound = zBound;
+    mXYBound = xBound*yBound;
+    mQuantity = mXYBound*zBound;
+    mXSpacing = xSpacing;
+    mYSpacing = ySpacing;
+    mZSpacing = zSpacing;
+    mXWeight = 1.0f/(xSpacing*xSpacing);
+    mYWeight = 1.0f/(ySpacing*ySpacing);
+    mZWeight = 1.0f/(zSpacing*zSpacing);
+
+    // Boundary voxels and zero-speed voxels are frozen, which avoids
+    // processing the boundary voxels separately during the march.
+    mTimes = new1<float>(mQuantity);
+    mStates = new1<unsigned char>(mQuantity);
+    int x, y, z, i = 0;
+    for (z = 0; z < mZBound; ++z)
+    {
+        bool zBoundary = (z == 0 || z == mZBound - 1);
+        for (y = 0; y < mYBound; ++y)
+        {
+            bool yzBoundary = (zBoundary || y == 0 || y == mYBound - 1);
+            for (x = 0; x < mXBound; ++x, ++i)
+            {
+                mTimes[i] = Mathf::MAX_REAL;
+                if (yzBoundary || x == 0 || x == mXBound - 1
+                ||  (mInvSpeeds && mInvSpeeds[i] == Mathf::MAX_REAL))
+                {
+                    mStates[i] = VS_FROZEN;
+                }
+                else
+                {
+                    mStates[i] = VS_FAR;
+                }
+            }
+        }
+    }
+
+    // The time step between neighboring voxels lies in [minStep,maxStep].
+    float minSpacing = xSpacing, maxSpacing = xSpacing;
+    if (ySpacing < minSpacing)
+    {
+        minSpacing = ySpacing;
+    }
+    if (ySpacing > maxSpacing)
+    {
+        maxSpacing = ySpacing;
+    }
+    if (zSpacing < minSpacing)
+    {
+        minSpacing = zSpacing;
+    }
+    if (zSpacing > maxSpacing)
+    {
+        maxSpacing = zSpacing;
+    }
+    float minStep = minSpacing*minInvSpeed;
+    float maxStep = maxSpacing*maxInvSpeed;
+
+    mBucketWidth = (bucketWidth > 0.0f ? bucketWidth : minStep);
+    if (!(mBucketWidth > 0.0f && mBucketWidth < Mathf::MAX_REAL))
+    {
+        // All speeds are zero.
+        mBucketWidth = 1.0f;
+        maxStep = 0.0f;
+    }
+    mInvBucketWidth = 1.0f/mBucketWidth;
+    float numBuckets = maxStep*mInvBucketWidth + 2.0f;
+    mNumBuckets = (numBuckets < (float)msMaxBuckets ? (int)numBuckets :
+        msMaxBuckets);
+    mBuckets = new1<std::vector<int> >(mNumBuckets);
+    mBaseTime = 0.0;
+    mSlot = 0;
+    mNumQueued = 0;
+
+    // The seeds are queued with time zero.
+    for (i = 0; i < (int)seeds.size(); ++i)
+    {
+        int seed = seeds[i];
+        if (mStates[seed] == VS_FAR)
+        {
+            mTimes[seed] = 0.0f;
+            mStates[seed] = VS_TRIAL;
+            mBuckets[0].push_back(seed);
+            ++mNumQueued;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void FastMarchBucket3::GetTimeExtremes (float& minValue, float& maxValue)
+    const
+{
+    minValue = Mathf::MAX_REAL;
+    maxValue = -Mathf::MAX_REAL;
+    for (int i = 0; i < mQuantity; ++i)
+    {
+        if (IsValid(i))
+        {
+            if (mTimes[i] < minValue)
+            {
+                minValue = mTimes[i];
+            }
+            if (mTimes[i] > maxValue)
+            {
+                maxValue = mTimes[i];
+            }
+        }
+    }
+    assertion(minValue <= maxValue, "At least one time must be valid\n");
+}
+//----------------------------------------------------------------------------
+void FastMarchBucket3::March (float maxTime)
+{
+    std::vector<int> work, deferred;
+    while (mNumQueued > 0 && mBaseTime <= (double)maxTime)
+    {
+        // Accept the voxels of the current bucket.  Relaxing the neighbors
+        // can add voxels to this bucket, so repeat until it is empty.
+        std::vector<int>& bucket = mBuckets[mSlot];
+        while (!bucket.empty())
+        {
+            work.swap(bucket);
+            mNumQueued -= (int)work.size();
+
+            const int numWork = (int)work.size();
+            for (int j = 0; j < numWork; ++j)
+            {
+                // A voxel may be queued more than once; only its first
+                // removal while trial is processed.
+                int i = work[j];
+                if (mStates[i] != VS_TRIAL)
+                {
+                    continue;
+                }
+
+                float t = mTimes[i];
+                if (t > maxTime)
+                {
+                    deferred.push_back(i);
+                    continue;
+                }
+                mStates[i] = VS_KNOWN;
+
+                // Only neighbors with larger times can be lowered by t.
+                if (mTimes[i-1] > t)
+                {
+                    Relax(i-1);
+                }
+                if (mTimes[i+1] > t)
+                {
+                    Relax(i+1);
+                }
+                if (mTimes[i-mXBound] > t)
+                {
+                    Relax(i-mXBound);
+                }
+                if (mTimes[i+mXBound] > t)
+                {
+                    Relax(i+mXBound);
+                }
+                if (mTimes[i-mXYBound] > t)
+                {
+                    Relax(i-mXYBound);
+                }
+                if (mTimes[i+mXYBound] > t)
+                {
+                    Relax(i+mXYBound);
+                }
+            }
+            work.clear();
+        }
+
+        if (!deferred.empty())
+        {
+            // The cap lies in the current bucket.  Keep the voxels beyond
+            // it for a later call.
+            mNumQueued += (int)deferred.size();
+            bucket.swap(deferred);
+            break;
+        }
+
+        mSlot = (mSlot + 1 < mNumBuckets ? mSlot + 1 : 0);
+        mBaseTime += (double)mBucketWidth;
+    }
+}
+//----------------------------------------------------------------------------
+void FastMarchBucket3::Relax (int i)
+{
+    unsigned char state = mStates[i];
+    if (state == VS_FROZEN)
+    {
+        return;
+    }
+
+    float t = ComputeTime(i);
+    if (t < mTimes[i])
+    {
+        int offset = GetOffset(t);
+        if (state != VS_TRIAL || offset != GetOffset(mTimes[i]))
+        {
+            // A far voxel becomes trial, an accepted voxel is reopened, or
+            // a trial voxel moves to an earlier bucket.  Any older queue
+            // entry of the voxel is skipped when removed.
+            int slot = mSlot + offset;
+            if (slot >= mNumBuckets)
+            {
+                slot -= mNumBuckets;
+            }
+            mBuckets[slot].push_back(i);
+            ++mNumQueued;
+            mStates[i] = VS_TRIAL;
+        }
+        mTimes[i] = t;
+    }
+}
+//----------------------------------------------------------------------------
+int FastMarchBucket3::GetOffset (float t) const
+{
+    double offset = ((double)t - mBaseTime)*(double)mInvBucketWidth;
+    if (offset < 1.0)
+    {
+        return 0;
+    }
+    if (offset < (double)(mNumBuckets - 1))
+    {
+        return (int)offset;
+    }
+    return mNumBuckets - 1;
+}
+//----------------------------------------------------------------------------
+float FastMarchBucket3::ComputeTime (int i) const
+{
+    // The smaller neighbor time along each axis, with the axis weight
+    // 1/spacing^2.  Far and frozen neighbors have time MAX_REAL.
+    float a0 = mTimes[i-1], a1 = mTimes[i-mXBound], a2 = mTimes[i-mXYBound];
+    float tmp = mTimes[i+1];
+    if (tmp < a0)
+    {
+        a0 = tmp;
+    }
+    tmp = mTimes[i+mXBound];
+    if (tmp < a1)
+    {
+        a1 = tmp;
+    }
+    tmp = mTimes[i+mXYBound];
+    if (tmp < a2)
+    {
+        a2 = tmp;
+    }
+    float w0 = mXWeight, w1 = mYWeight, w2 = mZWeight;
+
+    // Sort so that a0 <= a1 <= a2.
+    if (a1 < a0)
+    {
+        tmp = a0;
+        a0 = a1;
+        a1 = tmp;
+        tmp = w0;
+        w0 = w1;
+        w1 = tmp;
+    }
+    if (a2 < a1)
+    {
+        tmp = a1;
+        a1 = a2;
+        a2 = tmp;
+        tmp = w1;
+        w1 = w2;
+        w2 = tmp;
+    }
+    if (a1 < a0)
+    {
+        tmp = a0;
+        a0 = a1;
+        a1 = tmp;
+        tmp = w0;
+        w0 = w1;
+        w1 = tmp;
+    }
+
+    // Solve sum_k w[k]*(t - a[k])^2 = invSpeed^2 over the upwind axes, that
+    // is, those with a[k] < t.  Adding the axes in increasing order of
+    // a[k], the solution u = t - a0 is accepted as soon as it does not
+    // exceed the next a[k] - a0.
+    float invSpeed = (mInvSpeeds ? mInvSpeeds[i] : mInvSpeed);
+    float invSpeedSqr = invSpeed*invSpeed;
+    float u = invSpeed/Mathf::Sqrt(w0);
+    float d1 = a1 - a0;
+    if (u <= d1)
+    {
+        return a0 + u;
+    }
+
+    float wSum = w0 + w1;
+    float discr = wSum*invSpeedSqr - w0*w1*d1*d1;
+    u = (w1*d1 + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f))/wSum;
+    float d2 = a2 - a0;
+    if (u <= d2)
+    {
+        return a0 + u;
+    }
+
+    wSum += w2;
+    float b = w1*d1 + w2*d2;
+    discr = b*b - wSum*(w1*d1*d1 + w2*d2*d2 - invSpeedSqr);
+    u = (b + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f))/wSum;
+    return a0 + u;
+}
+//----------------------------------------------------------------------------
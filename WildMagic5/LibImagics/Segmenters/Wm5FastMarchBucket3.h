@@ -0,0 +1,140 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5FASTMARCHBUCKET3_H
+#define WM5FASTMARCHBUCKET3_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5Math.h"
+
+namespace Wm5
+{
+
+class WM5_IMAGICS_ITEM FastMarchBucket3
+{
+public:
+    // Fast marching for speed functions bounded away from zero.  The trial
+    // voxels are kept in a circular array of buckets of width 'bucketWidth'
+    // in time rather than in a heap, so insertion and removal are constant
+    // time.  Voxels in the same bucket are accepted in arbitrary order.  The
+    // ordering error is repaired by reopening an accepted voxel whenever a
+    // neighbor accepted later lowers its time, so the result is the solution
+    // of the upwind discretization regardless of the bucket width.  A width
+    // of zero selects the smallest time step between neighboring voxels,
+    // min(spacing)/max(speed).  The number of buckets is proportional to
+    // (max(spacing)/min(spacing))*(max(speed)/min(speed)) and is limited to
+    // msMaxBuckets.  Beyond that limit the result is still correct, but
+    // more voxels are reopened, so the class is intended for speeds whose
+    // ratio is moderate.
+    //
+    // The times satisfy the Eikonal equation |grad(T)|*speed = 1 with the
+    // grid spacing applied to each axis.  As in FastMarch3, the voxels on the
+    // boundary of the image are treated as zero speed, and seeds are the
+    // voxels with time zero.  Seeds on the boundary or at zero-speed voxels
+    // are ignored, as they are by FastMarch3 and FastSweep3, so the three
+    // classes solve the same problem for any set of seeds.  FastMarch3 solves
+    // the same discretization but ignores the spacing; for unit spacing the
+    // times of the two classes differ only by the rounding errors of the
+    // different update orders, about 1e-5 relative to the time.
+
+    // Construction and destruction.
+    FastMarchBucket3 (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const float* speeds,
+        const std::vector<int>& seeds, float bucketWidth = 0.0f);
+
+    FastMarchBucket3 (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const float speed,
+        const std::vector<int>& seeds, float bucketWidth = 0.0f);
+
+    ~FastMarchBucket3 ();
+
+    // Member access.
+    inline int GetXBound () const;
+    inline int GetYBound () const;
+    inline int GetZBound () const;
+    inline float GetXSpacing () const;
+    inline float GetYSpacing () const;
+    inline float GetZSpacing () const;
+    inline int GetQuantity () const;
+    inline int Index (int x, int y, int z) const;
+    inline float GetBucketWidth () const;
+    inline int GetNumBuckets () const;
+
+    // The crossing times use the conventions of FastMarch: MAX_REAL for
+    // voxels not reached by the front and -MAX_REAL for zero-speed voxels.
+    inline float GetTime (int i) const;
+    void GetTimeExtremes (float& minValue, float& maxValue) const;
+
+    // Voxel classification.
+    inline bool IsValid (int i) const;
+    inline bool IsTrial (int i) const;
+    inline bool IsFar (int i) const;
+    inline bool IsZeroSpeed (int i) const;
+    inline bool IsInterior (int i) const;
+
+    // Run the fast marching algorithm until all voxels with time at most
+    // 'maxTime' are interior.  Voxels beyond the cap stay trial or far, so
+    // the march may be resumed with a larger cap.  The default runs the
+    // march to completion.
+    void March (float maxTime = Mathf::MAX_REAL);
+
+private:
+    enum
+    {
+        VS_FAR,
+        VS_TRIAL,
+        VS_KNOWN,
+        VS_FROZEN
+    };
+
+    // Called by the constructors.
+    void Initialize (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const std::vector<int>& seeds,
+        float minInvSpeed, float maxInvSpeed, float bucketWidth);
+
+    // Solve the upwind discretization at voxel i using the current times
+    // of its neighbors.
+    float ComputeTime (int i) const;
+
+    // Lower the time of voxel i if its neighbors allow it, queueing the
+    // voxel again when necessary.
+    void Relax (int i);
+
+    // The bucket that holds time t, as an offset from the current bucket.
+    int GetOffset (float t) const;
+
+    int mXBound, mYBound, mZBound, mXYBound, mQuantity;
+    float mXSpacing, mYSpacing, mZSpacing;
+    float mXWeight, mYWeight, mZWeight;  // 1/spacing^2
+
+    // Per-voxel inverse speeds, or null for a constant speed.
+    float* mInvSpeeds;
+    float mInvSpeed;
+
+    // Internally, far and zero-speed voxels have time MAX_REAL so that the
+    // upwind minimum ignores them without tests.
+    float* mTimes;
+    unsigned char* mStates;
+
+    // The circular bucket array.  The current bucket is in slot mSlot and
+    // holds the times in [mBaseTime,mBaseTime+mBucketWidth); the following
+    // slots hold the following intervals.  Times beyond the last interval
+    // are placed in the last one.
+    float mBucketWidth, mInvBucketWidth;
+    double mBaseTime;
+    int mNumBuckets, mSlot, mNumQueued;
+    std::vector<int>* mBuckets;
+
+    static const int msMaxBuckets;
+};
+
+#include "Wm5FastMarchBucket3.inl"
+
+}
+
+#endif
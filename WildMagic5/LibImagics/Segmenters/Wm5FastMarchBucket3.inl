@@ -0,0 +1,89 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::GetXBound () const
+{
+    return mXBound;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::GetYBound () const
+{
+    return mYBound;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::GetZBound () const
+{
+    return mZBound;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket3::GetXSpacing () const
+{
+    return mXSpacing;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket3::GetYSpacing () const
+{
+    return mYSpacing;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket3::GetZSpacing () const
+{
+    return mZSpacing;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::GetQuantity () const
+{
+    return mQuantity;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::Index (int x, int y, int z) const
+{
+    return x + mXBound*(y + mYBound*z);
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket3::GetBucketWidth () const
+{
+    return mBucketWidth;
+}
+//----------------------------------------------------------------------------
+inline int FastMarchBucket3::GetNumBuckets () const
+{
+    return mNumBuckets;
+}
+//----------------------------------------------------------------------------
+inline float FastMarchBucket3::GetTime (int i) const
+{
+    return (mStates[i] != VS_FROZEN ? mTimes[i] : -Mathf::MAX_REAL);
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket3::IsValid (int i) const
+{
+    return mStates[i] == VS_TRIAL || mStates[i] == VS_KNOWN;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket3::IsTrial (int i) const
+{
+    return mStates[i] == VS_TRIAL;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket3::IsFar (int i) const
+{
+    return mStates[i] == VS_FAR;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket3::IsZeroSpeed (int i) const
+{
+    return mStates[i] == VS_FROZEN;
+}
+//----------------------------------------------------------------------------
+inline bool FastMarchBucket3::IsInterior (int i) const
+{
+    return mStates[i] == VS_KNOWN;
+}
+//----------------------------------------------------------------------------
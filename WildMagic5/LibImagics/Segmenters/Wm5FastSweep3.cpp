@@ -0,0 +1,399 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5ImagicsPCH.h"
+#include "Wm5FastSweep3.h"
+#include "Wm5Memory.h"
+using namespace Wm5;
+
+//----------------------------------------------------------------------------
+FastSweep3::FastSweep3 (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing, const float* speeds,
+    const std::vector<int>& seeds)
+{
+    // Invert the speeds since the reciprocals are all that are needed in the
+    // numerical method.
+    int quantity = xBound*yBound*zBound;
+    mInvSpeeds = new1<float>(quantity);
+    mInvSpeed = 0.0f;
+    for (int i = 0; i < quantity; ++i)
+    {
+        assertion(speeds[i] >= 0.0f, "Invalid speed\n");
+        mInvSpeeds[i] = (speeds[i] > 0.0f ? 1.0f/speeds[i] :
+            Mathf::MAX_REAL);
+    }
+
+    Initialize(xBound, yBound, zBound, xSpacing, ySpacing, zSpacing, seeds);
+}
+//----------------------------------------------------------------------------
+FastSweep3::FastSweep3 (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing, const float speed,
+    const std::vector<int>& seeds)
+{
+    assertion(speed > 0.0f, "Invalid speed\n");
+    mInvSpeeds = 0;
+    mInvSpeed = 1.0f/speed;
+
+    Initialize(xBound, yBound, zBound, xSpacing, ySpacing, zSpacing, seeds);
+}
+//----------------------------------------------------------------------------
+FastSweep3::~FastSweep3 ()
+{
+    delete1(mActive);
+    delete1(mTimes);
+    delete1(mInvSpeeds);
+}
+//----------------------------------------------------------------------------
+void FastSweep3::Initialize (int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing,
+    const std::vector<int>& seeds)
+{
+    assertion(xBound >= 3 && yBound >= 3 && zBound >= 3,
+        "Image must have interior voxels\n");
+
+    mXBound = xBound;
+    mYBound = yBound;
+    mZBound = zBound;
+    mXYBound = xBound*yBound;
+    mQuantity = mXYBound*zBound;
+    mXSpacing = xSpacing;
+    mYSpacing = ySpacing;
+    mZSpacing = zSpacing;
+    mXWeight = 1.0f/(xSpacing*xSpacing);
+    mYWeight = 1.0f/(ySpacing*ySpacing);
+    mZWeight = 1.0f/(zSpacing*zSpacing);
+
+    mTimes = new1<float>(mQuantity);
+    int i;
+    for (i = 0; i < mQuantity; ++i)
+    {
+        mTimes[i] = Mathf::MAX_REAL;
+    }
+    for (i = 0; i < (int)seeds.size(); ++i)
+    {
+        if (!IsZeroSpeed(seeds[i]))
+        {
+            mTimes[seeds[i]] = 0.0f;
+        }
+    }
+
+    mXBlocks = (mXBound + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    mYBlocks = (mYBound + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    mZBlocks = (mZBound + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    mNumBlocks = mXBlocks*mYBlocks*mZBlocks;
+    mActive = new1<unsigned char>(mNumBlocks);
+    memset(mActive, 0, mNumBlocks*sizeof(unsigned char));
+    mMaxTime = Mathf::MAX_REAL;
+    mNumBlockUpdates = 0;
+}
+//----------------------------------------------------------------------------
+void FastSweep3::GetTimeExtremes (float& minValue, float& maxValue) const
+{
+    minValue = Mathf::MAX_REAL;
+    maxValue = -Mathf::MAX_REAL;
+    for (int i = 0; i < mQuantity; ++i)
+    {
+        if (IsValid(i))
+        {
+            if (mTimes[i] < minValue)
+            {
+                minValue = mTimes[i];
+            }
+            if (mTimes[i] > maxValue)
+            {
+                maxValue = mTimes[i];
+            }
+        }
+    }
+    assertion(minValue <= maxValue, "At least one time must be valid\n");
+}
+//----------------------------------------------------------------------------
+void FastSweep3::Sweep (float maxTime, ThreadPool* pool)
+{
+    mMaxTime = maxTime;
+    mNumBlockUpdates = 0;
+
+    // The blocks that contain valid times are active.
+    ThreadPool::ParallelFor(pool, mNumBlocks, 0, ActivateTask, this);
+
+    const int xyBlocks = mXBlocks*mYBlocks;
+    bool hasActive = true;
+    while (hasActive)
+    {
+        hasActive = false;
+        for (int color = 0; color < 8; ++color)
+        {
+            // List the active blocks of this color.
+            mList.clear();
+            int bx, by, bz;
+            for (bz = ((color >> 2) & 1); bz < mZBlocks; bz += 2)
+            {
+                for (by = ((color >> 1) & 1); by < mYBlocks; by += 2)
+                {
+                    int b = mXBlocks*(by + mYBlocks*bz) + (color & 1);
+                    for (bx = (color & 1); bx < mXBlocks; bx += 2, b += 2)
+                    {
+                        if (mActive[b])
+                        {
+                            mActive[b] = 0;
+                            mList.push_back(b);
+                        }
+                    }
+                }
+            }
+            if (mList.empty())
+            {
+                continue;
+            }
+            hasActive = true;
+
+            const int numList = (int)mList.size();
+            mFaces.resize(numList);
+            ThreadPool::ParallelFor(pool, numList, 1, SweepTask, this);
+            mNumBlockUpdates += numList;
+
+            // Activate the neighbors across the faces that changed.
+            for (int j = 0; j < numList; ++j)
+            {
+                int faces = mFaces[j];
+                if (faces == 0)
+                {
+                    continue;
+                }
+
+                int b = mList[j];
+                bx = b % mXBlocks;
+                by = (b / mXBlocks) % mYBlocks;
+                bz = b / xyBlocks;
+                if ((faces & 0x01) && bx > 0)
+                {
+                    mActive[b - 1] = 1;
+                }
+                if ((faces & 0x02) && bx < mXBlocks - 1)
+                {
+                    mActive[b + 1] = 1;
+                }
+                if ((faces & 0x04) && by > 0)
+                {
+                    mActive[b - mXBlocks] = 1;
+                }
+                if ((faces & 0x08) && by < mYBlocks - 1)
+                {
+                    mActive[b + mXBlocks] = 1;
+                }
+                if ((faces & 0x10) && bz > 0)
+                {
+                    mActive[b - xyBlocks] = 1;
+                }
+                if ((faces & 0x20) && bz < mZBlocks - 1)
+                {
+                    mActive[b + xyBlocks] = 1;
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+int FastSweep3::SweepBlock (int b, float maxTime)
+{
+    int bx = b % mXBlocks;
+    int by = (b / mXBlocks) % mYBlocks;
+    int bz = b / (mXBlocks*mYBlocks);
+
+    // The block range, excluding the frozen boundary voxels of the image.
+    int xMin = bx*BLOCK_SIZE, xMax = xMin + BLOCK_SIZE - 1;
+    int yMin = by*BLOCK_SIZE, yMax = yMin + BLOCK_SIZE - 1;
+    int zMin = bz*BLOCK_SIZE, zMax = zMin + BLOCK_SIZE - 1;
+    xMin = (xMin > 1 ? xMin : 1);
+    yMin = (yMin > 1 ? yMin : 1);
+    zMin = (zMin > 1 ? zMin : 1);
+    xMax = (xMax < mXBound - 2 ? xMax : mXBound - 2);
+    yMax = (yMax < mYBound - 2 ? yMax : mYBound - 2);
+    zMax = (zMax < mZBound - 2 ? zMax : mZBound - 2);
+    if (xMin > xMax || yMin > yMax || zMin > zMax)
+    {
+        // The block contains only boundary voxels.
+        return 0;
+    }
+
+    int faces = 0;
+    for (int sweep = 0; /**/; ++sweep)
+    {
+        // The axis orderings cycle through the eight sign combinations.
+        int dx = ((sweep & 1) ? -1 : 1);
+        int dy = ((sweep & 2) ? -1 : 1);
+        int dz = ((sweep & 4) ? -1 : 1);
+        int x0 = (dx > 0 ? xMin : xMax), x1 = (dx > 0 ? xMax : xMin) + dx;
+        int y0 = (dy > 0 ? yMin : yMax), y1 = (dy > 0 ? yMax : yMin) + dy;
+        int z0 = (dz > 0 ? zMin : zMax), z1 = (dz > 0 ? zMax : zMin) + dz;
+
+        bool changed = false;
+        for (int z = z0; z != z1; z += dz)
+        {
+            int zFaces = (z == zMin ? 0x10 : 0) | (z == zMax ? 0x20 : 0);
+            for (int y = y0; y != y1; y += dy)
+            {
+                int yzFaces = zFaces | (y == yMin ? 0x04 : 0) |
+                    (y == yMax ? 0x08 : 0);
+                int i = Index(x0, y, z);
+                for (int x = x0; x != x1; x += dx, i += dx)
+                {
+                    if (mInvSpeeds && mInvSpeeds[i] == Mathf::MAX_REAL)
+                    {
+                        continue;
+                    }
+
+                    float t = ComputeTime(i);
+                    if (t < mTimes[i] && t <= maxTime)
+                    {
+                        mTimes[i] = t;
+                        changed = true;
+                        faces |= yzFaces | (x == xMin ? 0x01 : 0) |
+                            (x == xMax ? 0x02 : 0);
+                    }
+                }
+            }
+        }
+
+        if (!changed)
+        {
+            // Every time is consistent with its neighbors.
+            return faces;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+float FastSweep3::ComputeTime (int i) const
+{
+    // The smaller neighbor time along each axis, with the axis weight
+    // 1/spacing^2.  Far and frozen neighbors have time MAX_REAL.
+    float a0 = mTimes[i-1], a1 = mTimes[i-mXBound], a2 = mTimes[i-mXYBound];
+    float tmp = mTimes[i+1];
+    if (tmp < a0)
+    {
+        a0 = tmp;
+    }
+    tmp = mTimes[i+mXBound];
+    if (tmp < a1)
+    {
+        a1 = tmp;
+    }
+    tmp = mTimes[i+mXYBound];
+    if (tmp < a2)
+    {
+        a2 = tmp;
+    }
+    float w0 = mXWeight, w1 = mYWeight, w2 = mZWeight;
+
+    // Sort so that a0 <= a1 <= a2.
+    if (a1 < a0)
+    {
+        tmp = a0;
+        a0 = a1;
+        a1 = tmp;
+        tmp = w0;
+        w0 = w1;
+        w1 = tmp;
+    }
+    if (a2 < a1)
+    {
+        tmp = a1;
+        a1 = a2;
+        a2 = tmp;
+        tmp = w1;
+        w1 = w2;
+        w2 = tmp;
+    }
+    if (a1 < a0)
+    {
+        tmp = a0;
+        a0 = a1;
+        a1 = tmp;
+        tmp = w0;
+        w0 = w1;
+        w1 = tmp;
+    }
+    if (a0 == Mathf::MAX_REAL)
+    {
+        return Mathf::MAX_REAL;
+    }
+
+    // Solve sum_k w[k]*(t - a[k])^2 = invSpeed^2 over the upwind axes, that
+    // is, those with a[k] < t.  Adding the axes in increasing order of
+    // a[k], the solution u = t - a0 is accepted as soon as it does not
+    // exceed the next a[k] - a0.
+    float invSpeed = (mInvSpeeds ? mInvSpeeds[i] : mInvSpeed);
+    float invSpeedSqr = invSpeed*invSpeed;
+    float u = invSpeed/Mathf::Sqrt(w0);
+    float d1 = a1 - a0;
+    if (u <= d1)
+    {
+        return a0 + u;
+    }
+
+    float wSum = w0 + w1;
+    float discr = wSum*invSpeedSqr - w0*w1*d1*d1;
+    u = (w1*d1 + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f))/wSum;
+    float d2 = a2 - a0;
+    if (u <= d2)
+    {
+        return a0 + u;
+    }
+
+    wSum += w2;
+    float b = w1*d1 + w2*d2;
+    discr = b*b - wSum*(w1*d1*d1 + w2*d2*d2 - invSpeedSqr);
+    u = (b + Mathf::Sqrt(discr > 0.0f ? discr : 0.0f))/wSum;
+    return a0 + u;
+}
+//----------------------------------------------------------------------------
+void FastSweep3::ActivateTask (int begin, int end, int, void* userData)
+{
+    FastSweep3* sweep = (FastSweep3*)userData;
+    const int xBlocks = sweep->mXBlocks, yBlocks = sweep->mYBlocks;
+    for (int b = begin; b < end; ++b)
+    {
+        int xMin = (b % xBlocks)*BLOCK_SIZE;
+        int yMin = ((b / xBlocks) % yBlocks)*BLOCK_SIZE;
+        int zMin = (b / (xBlocks*yBlocks))*BLOCK_SIZE;
+        int xMax = xMin + BLOCK_SIZE, yMax = yMin + BLOCK_SIZE;
+        int zMax = zMin + BLOCK_SIZE;
+        xMax = (xMax < sweep->mXBound ? xMax : sweep->mXBound);
+        yMax = (yMax < sweep->mYBound ? yMax : sweep->mYBound);
+        zMax = (zMax < sweep->mZBound ? zMax : sweep->mZBound);
+
+        unsigned char active = 0;
+        for (int z = zMin; z < zMax && !active; ++z)
+        {
+            for (int y = yMin; y < yMax && !active; ++y)
+            {
+                const float* times = &sweep->mTimes[sweep->Index(0, y, z)];
+                for (int x = xMin; x < xMax; ++x)
+                {
+                    if (times[x] < Mathf::MAX_REAL)
+                    {
+                        active = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        sweep->mActive[b] = active;
+    }
+}
+//----------------------------------------------------------------------------
+void FastSweep3::SweepTask (int begin, int end, int, void* userData)
+{
+    FastSweep3* sweep = (FastSweep3*)userData;
+    for (int j = begin; j < end; ++j)
+    {
+        sweep->mFaces[j] = sweep->SweepBlock(sweep->mList[j],
+            sweep->mMaxTime);
+    }
+}
+//----------------------------------------------------------------------------
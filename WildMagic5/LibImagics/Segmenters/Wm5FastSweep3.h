@@ -0,0 +1,134 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5FASTSWEEP3_H
+#define WM5FASTSWEEP3_H
+
+#include "Wm5ImagicsLIB.h"
+#include "Wm5Math.h"
+#include "Wm5ThreadPool.h"
+
+namespace Wm5
+{
+
+class WM5_IMAGICS_ITEM FastSweep3
+{
+public:
+    // Block-parallel fast sweeping for the crossing times of FastMarch3 on
+    // large volumes.  The volume is partitioned into cubic blocks of
+    // BLOCK_SIZE voxels per side.  An active block is processed by
+    // Gauss-Seidel sweeps in the eight axis orderings until a sweep changes
+    // no time.  A block whose face voxels changed activates the neighboring
+    // blocks across those faces, and the process repeats until no block is
+    // active.  The blocks are processed in eight colors by the parity of
+    // their block coordinates; blocks of one color share no faces, edges or
+    // corners, so they are processed concurrently when a thread pool is
+    // supplied.  The result does not depend on the number of threads.
+    //
+    // The times satisfy the same upwind discretization as those of
+    // FastMarchBucket3 and agree with them up to rounding errors, as do
+    // those of FastMarch3 for unit spacing.  The voxels on the boundary of
+    // the image are treated as zero speed, and seeds are the voxels with
+    // time zero.  Seeds on the boundary or at zero-speed voxels are ignored,
+    // as they are by FastMarch3 and FastMarchBucket3.
+
+    // Construction and destruction.
+    FastSweep3 (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const float* speeds,
+        const std::vector<int>& seeds);
+
+    FastSweep3 (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const float speed,
+        const std::vector<int>& seeds);
+
+    ~FastSweep3 ();
+
+    // Member access.
+    inline int GetXBound () const;
+    inline int GetYBound () const;
+    inline int GetZBound () const;
+    inline float GetXSpacing () const;
+    inline float GetYSpacing () const;
+    inline float GetZSpacing () const;
+    inline int GetQuantity () const;
+    inline int Index (int x, int y, int z) const;
+
+    // The crossing times use the conventions of FastMarch: MAX_REAL for
+    // voxels not reached by the front and -MAX_REAL for zero-speed voxels.
+    inline float GetTime (int i) const;
+    void GetTimeExtremes (float& minValue, float& maxValue) const;
+
+    // Voxel classification.
+    inline bool IsValid (int i) const;
+    inline bool IsFar (int i) const;
+    inline bool IsZeroSpeed (int i) const;
+
+    // Compute the times of all voxels whose times are at most 'maxTime';
+    // the other voxels remain far.  The blocks that contain valid times are
+    // the initial active blocks, so a call may follow a call with a smaller
+    // cap.  If 'pool' is not null, it is used for the blocks of one color;
+    // the caller retains ownership.
+    void Sweep (float maxTime = Mathf::MAX_REAL, ThreadPool* pool = 0);
+
+    // The number of block updates of the last call to Sweep.  Each update
+    // is two or more sweeps over the block.
+    inline int GetNumBlockUpdates () const;
+
+    enum
+    {
+        BLOCK_SIZE = 16
+    };
+
+private:
+    // Called by the constructors.
+    void Initialize (int xBound, int yBound, int zBound, float xSpacing,
+        float ySpacing, float zSpacing, const std::vector<int>& seeds);
+
+    // Solve the upwind discretization at voxel i using the current times
+    // of its neighbors.
+    float ComputeTime (int i) const;
+
+    // Sweep block b until its times do not change.  The return value has
+    // bit 2*d (bit 2*d+1) set when a voxel on the minimum (maximum) face
+    // of the block along axis d changed.
+    int SweepBlock (int b, float maxTime);
+
+    // Support for ThreadPool.
+    static void ActivateTask (int begin, int end, int worker,
+        void* userData);
+    static void SweepTask (int begin, int end, int worker, void* userData);
+
+    int mXBound, mYBound, mZBound, mXYBound, mQuantity;
+    float mXSpacing, mYSpacing, mZSpacing;
+    float mXWeight, mYWeight, mZWeight;  // 1/spacing^2
+
+    // Per-voxel inverse speeds, or null for a constant speed.  Zero-speed
+    // voxels have inverse speed MAX_REAL.
+    float* mInvSpeeds;
+    float mInvSpeed;
+
+    // Internally, far and zero-speed voxels have time MAX_REAL so that the
+    // upwind minimum ignores them without tests.
+    float* mTimes;
+
+    // The block grid.  mActive[b] is nonzero for an active block.  The
+    // blocks of the current color are listed in mList with their face
+    // masks in mFaces.
+    int mXBlocks, mYBlocks, mZBlocks, mNumBlocks;
+    unsigned char* mActive;
+    std::vector<int> mList;
+    std::vector<int> mFaces;
+    float mMaxTime;
+    int mNumBlockUpdates;
+};
+
+#include "Wm5FastSweep3.inl"
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+inline int FastSweep3::GetXBound () const
+{
+    return mXBound;
+}
+//----------------------------------------------------------------------------
+inline int FastSweep3::GetYBound () const
+{
+    return mYBound;
+}
+//----------------------------------------------------------------------------
+inline int FastSweep3::GetZBound () const
+{
+    return mZBound;
+}
+//----------------------------------------------------------------------------
+inline float FastSweep3::GetXSpacing () const
+{
+    return mXSpacing;
+}
+//----------------------------------------------------------------------------
+inline float FastSweep3::GetYSpacing () const
+{
+    return mYSpacing;
+}
+//----------------------------------------------------------------------------
+inline float FastSweep3::GetZSpacing () const
+{
+    return mZSpacing;
+}
+//----------------------------------------------------------------------------
+inline int FastSweep3::GetQuantity () const
+{
+    return mQuantity;
+}
+//----------------------------------------------------------------------------
+inline int FastSweep3::Index (int x, int y, int z) const
+{
+    return x + mXBound*(y + mYBound*z);
+}
+//----------------------------------------------------------------------------
+inline float FastSweep3::GetTime (int i) const
+{
+    return (!IsZeroSpeed(i) ? mTimes[i] : -Mathf::MAX_REAL);
+}
+//----------------------------------------------------------------------------
+inline bool FastSweep3::IsValid (int i) const
+{
+    return mTimes[i] < Mathf::MAX_REAL;
+}
+//----------------------------------------------------------------------------
+inline bool FastSweep3::IsFar (int i) const
+{
+    return mTimes[i] == Mathf::MAX_REAL && !IsZeroSpeed(i);
+}
+//----------------------------------------------------------------------------
+inline bool FastSweep3::IsZeroSpeed (int i) const
+{
+    int x = i % mXBound;
+    int y = (i / mXBound) % mYBound;
+    int z = i / mXYBound;
+    return x == 0 || x == mXBound - 1 || y == 0 || y == mYBound - 1
+        || z == 0 || z == mZBound - 1
+        || (mInvSpeeds && mInvSpeeds[i] == Mathf::MAX_REAL);
+}
+//----------------------------------------------------------------------------
+inline int FastSweep3::GetNumBlockUpdates () const
+{
+    return mNumBlockUpdates;
+}
+//----------------------------------------------------------------------------
@@ -12,6 +12,8 @@
 // BinaryOperations
 #include "Wm5Binary2D.h"
 #include "Wm5Binary3D.h"
+#include "Wm5ComponentLabeler.h"
+#include "Wm5DistanceTransform.h"
 
 // Extraction
 #include "Wm5ExtractCurveSquares.h"
@@ -24,6 +26,7 @@
 #include "Wm5CurvatureFlow3.h"
 #include "Wm5GaussianBlur2.h"
 #include "Wm5GaussianBlur3.h"
+#include "Wm5GaussianFilter.h"
 #include "Wm5GradientAnisotropic2.h"
 #include "Wm5GradientAnisotropic3.h"
 #include "Wm5FastBlur.h"
@@ -36,16 +39,22 @@
 #include "Wm5ImageConvert.h"
 #include "Wm5Images.h"
 #include "Wm5Lattice.h"
+#include "Wm5TBrickImage3D.h"
 #include "Wm5TImage.h"
 #include "Wm5TImage2D.h"
 #include "Wm5TImage3D.h"
+#include "Wm5TTiledImage3D.h"
 
 // RasterDrawing
 #include "Wm5RasterDrawing.h"
+#include "Wm5RasterSpans.h"
 
 // Segmenters
 #include "Wm5FastMarch.h"
 #include "Wm5FastMarch2.h"
 #include "Wm5FastMarch3.h"
+#include "Wm5FastMarchBucket2.h"
+#include "Wm5FastMarchBucket3.h"
+#include "Wm5FastSweep3.h"
 
 #endif
@@ -4,12 +4,13 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ApprCylinderFit3.h"
 #include "Wm5ApprLineFit3.h"
 #include "Wm5PolynomialRoots.h"
+#include "Wm5Memory.h"
 
 namespace Wm5
 {
@@ -17,7 +18,7 @@ namespace Wm5
 template <typename Real>
 CylinderFit3<Real>::CylinderFit3 (int numPoints, const Vector3<Real>* points,
     Vector3<Real>& center, Vector3<Real>& axis, Real& radius, Real& height,
-    bool inputsAreInitialGuess)
+    bool inputsAreInitialGuess, ThreadPool* pool)
 {
     Real invRSqr = (Real)1;
     if (!inputsAreInitialGuess)
@@ -29,40 +30,70 @@ CylinderFit3<Real>::CylinderFit3 (int numPoints, const Vector3<Real>* points,
         axis = line.Direction;
     }
 
-    mError = Math<Real>::MAX_REAL;
-    const int iMax = 8;
+    PointArrays arrays(numPoints, points);
+    mError = Iterate(arrays, center, axis, invRSqr, pool);
+    ComputeExtent(numPoints, points, center, axis, invRSqr, radius, height);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CylinderFit3<Real>::CylinderFit3 (int numPoints, const Vector3<Real>* points,
+    int numAxisSeeds, Vector3<Real>& center, Vector3<Real>& axis,
+    Real& radius, Real& height, ThreadPool* pool)
+{
+    assertion(numAxisSeeds >= 1, "Invalid number of seeds\n");
+
+    // The first seed is the least-squares line.  The others are on a
+    // spiral that covers the hemisphere z >= 0 uniformly; the axes U and -U
+    // describe the same cylinder.
+    Line3<Real> line = OrthogonalLineFit3(numPoints, points);
+    SeedTaskData data;
+    data.Centers = new1<Vector3<Real> >(numAxisSeeds);
+    data.Axes = new1<Vector3<Real> >(numAxisSeeds);
+    data.InvRSqrs = new1<Real>(numAxisSeeds);
+    data.Errors = new1<Real>(numAxisSeeds);
+    data.Axes[0] = line.Direction;
+    const Real goldenAngle = Math<Real>::PI*((Real)3 -
+        Math<Real>::Sqrt((Real)5));
+    const Real invNumSpiral = ((Real)1)/(Real)(numAxisSeeds > 1 ?
+        numAxisSeeds - 1 : 1);
     int i;
-    for (i = 0; i < iMax; ++i)
+    for (i = 0; i < numAxisSeeds; ++i)
     {
-        mError = UpdateInvRSqr(numPoints, points, center, axis, invRSqr);
-        mError = UpdateDirection(numPoints, points, center, axis, invRSqr);
-        mError = UpdateCenter(numPoints, points, center, axis, invRSqr);
+        data.Centers[i] = line.Origin;
+        data.InvRSqrs[i] = (Real)1;
+        if (i > 0)
+        {
+            Real z = ((Real)i - (Real)0.5)*invNumSpiral;
+            Real r = Math<Real>::Sqrt((Real)1 - z*z);
+            Real angle = goldenAngle*(Real)i;
+            data.Axes[i] = Vector3<Real>(r*Math<Real>::Cos(angle),
+                r*Math<Real>::Sin(angle), z);
+        }
     }
 
-    // Compute the radius.
-    radius = Math<Real>::InvSqrt(invRSqr);
+    PointArrays arrays(numPoints, points);
+    data.Arrays = &arrays;
+    ThreadPool::ParallelFor(pool, numAxisSeeds, 1, SeedTask, &data);
 
-    // Project points onto fitted axis to determine extent of cylinder along
-    // the axis.
-    Real tMin = axis.Dot(points[0] - center);
-    Real tMax = tMin;
-    for (i = 1; i < numPoints; ++i)
+    // Ties are resolved by the smaller seed index.
+    int best = 0;
+    for (i = 1; i < numAxisSeeds; ++i)
     {
-        Real t = axis.Dot(points[i] - center);
-        if (t < tMin)
+        if (data.Errors[i] < data.Errors[best])
         {
-            tMin = t;
-        }
-        else if (t > tMax)
-        {
-            tMax = t;
+            best = i;
         }
     }
+    center = data.Centers[best];
+    axis = data.Axes[best];
+    mError = data.Errors[best];
+    ComputeExtent(numPoints, points, center, axis, data.InvRSqrs[best],
+        radius, height);
 
-    // Compute the height.  Adjust the center to point that projects to
-    // midpoint of extent.
-    height = tMax - tMin;
-    center += (((Real)0.5)*(tMin + tMax))*axis;
+    delete1(data.Centers);
+    delete1(data.Axes);
+    delete1(data.InvRSqrs);
+    delete1(data.Errors);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -72,84 +103,114 @@ CylinderFit3<Real>::operator Real ()
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-Real CylinderFit3<Real>::UpdateInvRSqr (int numPoints,
-    const Vector3<Real>* points, const Vector3<Real>& center,
-    const Vector3<Real>& axis, Real& invRSqr)
+CylinderFit3<Real>::PointArrays::PointArrays (int numPoints,
+    const Vector3<Real>* points)
+    :
+    NumPoints(numPoints),
+    NumPadded((numPoints + 3) & ~3)
+{
+    X = new1<Real>(NumPadded);
+    Y = new1<Real>(NumPadded);
+    Z = new1<Real>(NumPadded);
+    W = new1<Real>(NumPadded);
+    int i;
+    for (i = 0; i < NumPoints; ++i)
+    {
+        X[i] = points[i].X();
+        Y[i] = points[i].Y();
+        Z[i] = points[i].Z();
+        W[i] = (Real)1;
+    }
+    for (/**/; i < NumPadded; ++i)
+    {
+        X[i] = (Real)0;
+        Y[i] = (Real)0;
+        Z[i] = (Real)0;
+        W[i] = (Real)0;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CylinderFit3<Real>::PointArrays::~PointArrays ()
 {
-    Real aSum = (Real)0, aaSum = (Real)0;
-    for (int i = 0; i < numPoints; ++i)
+    delete1(X);
+    delete1(Y);
+    delete1(Z);
+    delete1(W);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real CylinderFit3<Real>::Iterate (const PointArrays& arrays,
+    Vector3<Real>& center, Vector3<Real>& axis, Real& invRSqr,
+    ThreadPool* pool)
+{
+    Real error = Math<Real>::MAX_REAL;
+    for (int i = 0; i < MAX_ITERATIONS; ++i)
     {
-        Vector3<Real> delta = points[i] - center;
-        Vector3<Real> deltaCrossAxis = delta.Cross(axis);
-        Real len2 = deltaCrossAxis.SquaredLength();
-        aSum += len2;
-        aaSum += len2*len2;
+        error = UpdateInvRSqr(arrays, center, axis, invRSqr, pool);
+        error = UpdateDirection(arrays, center, axis, invRSqr, pool);
+        error = UpdateCenter(arrays, center, axis, invRSqr, pool);
     }
+    return error;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real CylinderFit3<Real>::UpdateInvRSqr (const PointArrays& arrays,
+    const Vector3<Real>& center, const Vector3<Real>& axis, Real& invRSqr,
+    ThreadPool* pool)
+{
+    ReduceTaskData data;
+    data.Arrays = &arrays;
+    data.Type = RT_INV_RSQR;
+    data.Center = center;
+    data.Axis = axis;
+    // ReduceTask reads every field, so the ones that this reduction does
+    // not use are initialized too.
+    data.Direction = Vector3<Real>::ZERO;
+    data.InvRSqr = (Real)0;
+    Real sums[MAX_SUMS];
+    Reduce(pool, data, sums);
+    Real aSum = sums[0], aaSum = sums[1];
 
     invRSqr = aSum/aaSum;
-    Real min = (Real)1 - invRSqr*aSum/(Real)numPoints;
+    Real min = (Real)1 - invRSqr*aSum/(Real)arrays.NumPoints;
     return min;
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-Real CylinderFit3<Real>::UpdateDirection (int numPoints,
-    const Vector3<Real>* points, const Vector3<Real>& center,
-    Vector3<Real>& axis, Real& invRSqr)
+Real CylinderFit3<Real>::UpdateDirection (const PointArrays& arrays,
+    const Vector3<Real>& center, Vector3<Real>& axis, Real& invRSqr,
+    ThreadPool* pool)
 {
-    Real invNumPoints = ((Real)1)/(Real)numPoints;
+    Real invNumPoints = ((Real)1)/(Real)arrays.NumPoints;
     int i;
-    Vector3<Real> delta, deltaCrossAxis, deltaCrossVDir;
-    Real a, b, c;
 
     // Compute the direction of steepest descent.
-    Vector3<Real> vDir = Vector3<Real>::ZERO;
-    Real aMean = (Real)0, aaMean = (Real)0;
-    for (i = 0; i < numPoints; ++i)
-    {
-        delta = points[i] - center;
-        deltaCrossAxis = delta.Cross(axis);
-        a = invRSqr*deltaCrossAxis.SquaredLength() - (Real)1;
-        aMean += a;
-        aaMean += a*a;
-        vDir.X() += a*(axis.X()*(delta.Y()*delta.Y() +
-            delta.Z()*delta.Z()) - delta.X()*(axis.Y()*delta.Y() +
-            axis.Z()*delta.Z()));
-        vDir.Y() += a*(axis.Y()*(delta.X()*delta.X() +
-            delta.Z()*delta.Z()) - delta.Y()*(axis.X()*delta.X() +
-            axis.Z()*delta.Z()));
-        vDir.Z() += a*(axis.Z()*(delta.X()*delta.X() + 
-            delta.Y()*delta.Y()) - delta.Z()*(axis.X()*delta.X() +
-            axis.Y()*delta.Y()));
-    }
-    aMean *= invNumPoints;
-    aaMean *= invNumPoints;
+    ReduceTaskData data;
+    data.Arrays = &arrays;
+    data.Type = RT_AXIS_GRADIENT;
+    data.Center = center;
+    data.Axis = axis;
+    data.Direction = Vector3<Real>::ZERO;
+    data.InvRSqr = invRSqr;
+    Real sums[MAX_SUMS];
+    Reduce(pool, data, sums);
+    Real aaMean = sums[1]*invNumPoints;
+    Vector3<Real> vDir(sums[2], sums[3], sums[4]);
     if (vDir.Normalize() < Math<Real>::ZERO_TOLERANCE)
     {
         return aaMean;
     }
 
     // Compute the 4th-degree polynomial for the line of steepest descent.
-    Real abMean = (Real)0, acMean = (Real)0;
-    Real bbMean = (Real)0, bcMean = (Real)0, ccMean = (Real)0;
-    for (i = 0; i < numPoints; ++i)
-    {
-        delta = points[i] - center;
-        deltaCrossAxis = delta.Cross(axis);
-        deltaCrossVDir = delta.Cross(vDir);
-        a = invRSqr*deltaCrossAxis.SquaredLength() - (Real)1;
-        b = invRSqr*(deltaCrossAxis.Dot(deltaCrossVDir));
-        c = invRSqr*deltaCrossVDir.SquaredLength();
-        abMean += a*b;
-        acMean += a*c;
-        bbMean += b*b;
-        bcMean += b*c;
-        ccMean += c*c;
-    }
-    abMean *= invNumPoints;
-    acMean *= invNumPoints;
-    bbMean *= invNumPoints;
-    bcMean *= invNumPoints;
-    ccMean *= invNumPoints;
+    data.Type = RT_AXIS_POLYNOMIAL;
+    data.Direction = vDir;
+    Reduce(pool, data, sums);
+    Real abMean = sums[0]*invNumPoints;
+    Real acMean = sums[1]*invNumPoints;
+    Real bbMean = sums[2]*invNumPoints;
+    Real bcMean = sums[3]*invNumPoints;
+    Real ccMean = sums[4]*invNumPoints;
 
     Polynomial1<Real> poly(4);
     poly[0] = aaMean;
@@ -188,51 +249,40 @@ Real CylinderFit3<Real>::UpdateDirection (int numPoints,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-Real CylinderFit3<Real>::UpdateCenter (int numPoints,
-    const Vector3<Real>* points, Vector3<Real>& center,
-    const Vector3<Real>& axis, const Real& invRSqr)
+Real CylinderFit3<Real>::UpdateCenter (const PointArrays& arrays,
+    Vector3<Real>& center, const Vector3<Real>& axis, const Real& invRSqr,
+    ThreadPool* pool)
 {
-    Real invNumPoints = ((Real)1)/(Real)numPoints;
+    Real invNumPoints = ((Real)1)/(Real)arrays.NumPoints;
     int i;
-    Vector3<Real> delta, deltaCrossAxis, cDirCrossAxis;
-    Real a, b, c;
 
     // Compute the direction of steepest descent.
-    Vector3<Real> cDir = Vector3<Real>::ZERO;
-    Real aMean = (Real)0, aaMean = (Real)0;
-    for (i = 0; i < numPoints; ++i)
-    {
-        delta = points[i] - center;
-        deltaCrossAxis = delta.Cross(axis);
-        a = invRSqr*deltaCrossAxis.SquaredLength() - (Real)1;
-        aMean += a;
-        aaMean += a*a;
-        cDir += a*(delta - axis.Dot(delta)*axis); // |axis|=1 assumed
-    }
-    aMean *= invNumPoints;
-    aaMean *= invNumPoints;
+    ReduceTaskData data;
+    data.Arrays = &arrays;
+    data.Type = RT_CENTER_GRADIENT;
+    data.Center = center;
+    data.Axis = axis;
+    data.Direction = Vector3<Real>::ZERO;
+    data.InvRSqr = invRSqr;
+    Real sums[MAX_SUMS];
+    Reduce(pool, data, sums);
+    Real aMean = sums[0]*invNumPoints;
+    Real aaMean = sums[1]*invNumPoints;
+    Vector3<Real> cDir(sums[2], sums[3], sums[4]);
     if (cDir.Normalize() < Math<Real>::ZERO_TOLERANCE)
     {
         return aaMean;
     }
 
     // Compute the 4th-degree polynomial for the line of steepest descent.
-    cDirCrossAxis = cDir.Cross(axis);
-    c = cDirCrossAxis.SquaredLength()*invNumPoints*invRSqr;
-    Real bMean = (Real)0,  abMean = (Real)0, bbMean = (Real)0;
-    for (i = 0; i < numPoints; ++i)
-    {
-        delta = points[i] - center;
-        deltaCrossAxis = delta.Cross(axis);
-        a = invRSqr*deltaCrossAxis.SquaredLength() - (Real)1;
-        b = invRSqr*(deltaCrossAxis.Dot(cDirCrossAxis));
-        bMean += b;
-        abMean += a*b;
-        bbMean += b*b;
-    }
-    bMean *= invNumPoints;
-    abMean *= invNumPoints;
-    bbMean *= invNumPoints;
+    Vector3<Real> cDirCrossAxis = cDir.Cross(axis);
+    Real c = cDirCrossAxis.SquaredLength()*invNumPoints*invRSqr;
+    data.Type = RT_CENTER_POLYNOMIAL;
+    data.Direction = cDirCrossAxis;
+    Reduce(pool, data, sums);
+    Real bMean = sums[0]*invNumPoints;
+    Real abMean = sums[1]*invNumPoints;
+    Real bbMean = sums[2]*invNumPoints;
 
     Polynomial1<Real> poly(4);
     poly[0] = aaMean;
@@ -268,6 +318,238 @@ Real CylinderFit3<Real>::UpdateCenter (int numPoints,
     return pMin;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void CylinderFit3<Real>::ComputeExtent (int numPoints,
+    const Vector3<Real>* points, Vector3<Real>& center,
+    const Vector3<Real>& axis, Real invRSqr, Real& radius, Real& height)
+{
+    // Compute the radius.
+    radius = Math<Real>::InvSqrt(invRSqr);
+
+    // Project points onto fitted axis to determine extent of cylinder along
+    // the axis.
+    Real tMin = axis.Dot(points[0] - center);
+    Real tMax = tMin;
+    for (int i = 1; i < numPoints; ++i)
+    {
+        Real t = axis.Dot(points[i] - center);
+        if (t < tMin)
+        {
+            tMin = t;
+        }
+        else if (t > tMax)
+        {
+            tMax = t;
+        }
+    }
+
+    // Compute the height.  Adjust the center to point that projects to
+    // midpoint of extent.
+    height = tMax - tMin;
+    center += (((Real)0.5)*(tMin + tMax))*axis;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CylinderFit3<Real>::Reduce (ThreadPool* pool, ReduceTaskData& data,
+    Real sums[MAX_SUMS])
+{
+    const int numBlocks = (data.Arrays->NumPadded + BLOCK_SIZE - 1)/
+        BLOCK_SIZE;
+    data.BlockSums = new1<Real>(MAX_SUMS*numBlocks);
+    ThreadPool::ParallelFor(pool, numBlocks, 0, ReduceTask, &data);
+
+    int s;
+    for (s = 0; s < MAX_SUMS; ++s)
+    {
+        sums[s] = (Real)0;
+    }
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const Real* blockSums = &data.BlockSums[MAX_SUMS*block];
+        for (s = 0; s < MAX_SUMS; ++s)
+        {
+            sums[s] += blockSums[s];
+        }
+    }
+    delete1(data.BlockSums);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CylinderFit3<Real>::ReduceTask (int begin, int end, int,
+    void* userData)
+{
+    const ReduceTaskData& data = *(const ReduceTaskData*)userData;
+    const PointArrays& arrays = *data.Arrays;
+    const Real* X = arrays.X;
+    const Real* Y = arrays.Y;
+    const Real* Z = arrays.Z;
+    const Real* W = arrays.W;
+    const Real cx = data.Center.X(), cy = data.Center.Y();
+    const Real cz = data.Center.Z();
+    const Real ux = data.Axis.X(), uy = data.Axis.Y(), uz = data.Axis.Z();
+    const Real vx = data.Direction.X(), vy = data.Direction.Y();
+    const Real vz = data.Direction.Z();
+    const Real invRSqr = data.InvRSqr;
+
+    // The sums of four points at a time are kept in separate accumulators.
+    // The padding points have weight zero.
+    Real sum[MAX_SUMS][4];
+    int s, j, k;
+    for (int block = begin; block < end; ++block)
+    {
+        const int j0 = block*BLOCK_SIZE;
+        const int j1 = std::min(j0 + (int)BLOCK_SIZE, arrays.NumPadded);
+        for (s = 0; s < MAX_SUMS; ++s)
+        {
+            for (k = 0; k < 4; ++k)
+            {
+                sum[s][k] = (Real)0;
+            }
+        }
+
+        switch (data.Type)
+        {
+        case RT_INV_RSQR:
+            for (j = j0; j < j1; j += 4)
+            {
+                for (k = 0; k < 4; ++k)
+                {
+                    const Real dx = X[j+k] - cx;
+                    const Real dy = Y[j+k] - cy;
+                    const Real dz = Z[j+k] - cz;
+                    const Real px = dy*uz - dz*uy;
+                    const Real py = dz*ux - dx*uz;
+                    const Real pz = dx*uy - dy*ux;
+                    const Real len2 = px*px + py*py + pz*pz;
+                    const Real wlen2 = W[j+k]*len2;
+                    sum[0][k] += wlen2;
+                    sum[1][k] += wlen2*len2;
+                }
+            }
+            break;
+
+        case RT_AXIS_GRADIENT:
+            for (j = j0; j < j1; j += 4)
+            {
+                for (k = 0; k < 4; ++k)
+                {
+                    const Real dx = X[j+k] - cx;
+                    const Real dy = Y[j+k] - cy;
+                    const Real dz = Z[j+k] - cz;
+                    const Real px = dy*uz - dz*uy;
+                    const Real py = dz*ux - dx*uz;
+                    const Real pz = dx*uy - dy*ux;
+                    const Real a = invRSqr*(px*px + py*py + pz*pz) -
+                        (Real)1;
+                    const Real wa = W[j+k]*a;
+                    sum[0][k] += wa;
+                    sum[1][k] += wa*a;
+                    sum[2][k] += wa*(ux*(dy*dy + dz*dz) -
+                        dx*(uy*dy + uz*dz));
+                    sum[3][k] += wa*(uy*(dx*dx + dz*dz) -
+                        dy*(ux*dx + uz*dz));
+                    sum[4][k] += wa*(uz*(dx*dx + dy*dy) -
+                        dz*(ux*dx + uy*dy));
+                }
+            }
+            break;
+
+        case RT_AXIS_POLYNOMIAL:
+            for (j = j0; j < j1; j += 4)
+            {
+                for (k = 0; k < 4; ++k)
+                {
+                    const Real dx = X[j+k] - cx;
+                    const Real dy = Y[j+k] - cy;
+                    const Real dz = Z[j+k] - cz;
+                    const Real px = dy*uz - dz*uy;
+                    const Real py = dz*ux - dx*uz;
+                    const Real pz = dx*uy - dy*ux;
+                    const Real qx = dy*vz - dz*vy;
+                    const Real qy = dz*vx - dx*vz;
+                    const Real qz = dx*vy - dy*vx;
+                    const Real a = invRSqr*(px*px + py*py + pz*pz) -
+                        (Real)1;
+                    const Real b = invRSqr*(px*qx + py*qy + pz*qz);
+                    const Real c = invRSqr*(qx*qx + qy*qy + qz*qz);
+                    const Real wb = W[j+k]*b;
+                    const Real wc = W[j+k]*c;
+                    sum[0][k] += a*wb;
+                    sum[1][k] += a*wc;
+                    sum[2][k] += b*wb;
+                    sum[3][k] += b*wc;
+                    sum[4][k] += c*wc;
+                }
+            }
+            break;
+
+        case RT_CENTER_GRADIENT:
+            for (j = j0; j < j1; j += 4)
+            {
+                for (k = 0; k < 4; ++k)
+                {
+                    // |axis| = 1 is assumed.
+                    const Real dx = X[j+k] - cx;
+                    const Real dy = Y[j+k] - cy;
+                    const Real dz = Z[j+k] - cz;
+                    const Real px = dy*uz - dz*uy;
+                    const Real py = dz*ux - dx*uz;
+                    const Real pz = dx*uy - dy*ux;
+                    const Real a = invRSqr*(px*px + py*py + pz*pz) -
+                        (Real)1;
+                    const Real wa = W[j+k]*a;
+                    const Real dot = ux*dx + uy*dy + uz*dz;
+                    sum[0][k] += wa;
+                    sum[1][k] += wa*a;
+                    sum[2][k] += wa*(dx - dot*ux);
+                    sum[3][k] += wa*(dy - dot*uy);
+                    sum[4][k] += wa*(dz - dot*uz);
+                }
+            }
+            break;
+
+        case RT_CENTER_POLYNOMIAL:
+            for (j = j0; j < j1; j += 4)
+            {
+                for (k = 0; k < 4; ++k)
+                {
+                    const Real dx = X[j+k] - cx;
+                    const Real dy = Y[j+k] - cy;
+                    const Real dz = Z[j+k] - cz;
+                    const Real px = dy*uz - dz*uy;
+                    const Real py = dz*ux - dx*uz;
+                    const Real pz = dx*uy - dy*ux;
+                    const Real a = invRSqr*(px*px + py*py + pz*pz) -
+                        (Real)1;
+                    const Real b = invRSqr*(px*vx + py*vy + pz*vz);
+                    const Real wb = W[j+k]*b;
+                    sum[0][k] += wb;
+                    sum[1][k] += a*wb;
+                    sum[2][k] += b*wb;
+                }
+            }
+            break;
+        }
+
+        Real* blockSums = &data.BlockSums[MAX_SUMS*block];
+        for (s = 0; s < MAX_SUMS; ++s)
+        {
+            blockSums[s] = (sum[s][0] + sum[s][1]) + (sum[s][2] + sum[s][3]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CylinderFit3<Real>::SeedTask (int begin, int end, int, void* userData)
+{
+    const SeedTaskData& data = *(const SeedTaskData*)userData;
+    for (int i = begin; i < end; ++i)
+    {
+        data.Errors[i] = Iterate(*data.Arrays, data.Centers[i], data.Axes[i],
+            data.InvRSqrs[i], 0);
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5APPRCYLINDERFIT3_H
 #define WM5APPRCYLINDERFIT3_H
@@ -35,9 +35,25 @@
 //     if (eError1 not changed much from error0)
 //         break;
 // }
+//
+// The iterations can converge to a local minimum that is far from the
+// cylinder when the initial axis is poor, for example for short, wide
+// cylinders whose least-squares line is not along the axis.  The second
+// constructor starts the fit from numAxisSeeds axes, the least-squares line
+// direction and directions distributed uniformly on the unit hemisphere,
+// and returns the fit of smallest error.  The seeds are independent, so
+// they are distributed to the threads of 'pool'.
+//
+// Each iteration reduces sums over all the points.  The points are copied
+// to separate x-, y- and z-arrays and the sums are computed on blocks of
+// points, four points at a time in separate accumulators so that the
+// compiler can vectorize the loops.  When 'pool' is not null, the blocks
+// are distributed to its threads.  The sums of the blocks are added in
+// block order, so the result does not depend on the number of threads.
 
 #include "Wm5MathematicsLIB.h"
 #include "Wm5Vector3.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -48,23 +64,105 @@ class WM5_MATHEMATICS_ITEM CylinderFit3
 public:
     CylinderFit3 (int numPoints, const Vector3<Real>* points,
         Vector3<Real>& center, Vector3<Real>& axis, Real& radius,
-        Real& height, bool inputsAreInitialGuess);
+        Real& height, bool inputsAreInitialGuess, ThreadPool* pool = 0);
+
+    // Fit from multiple initial axes.  A 'numAxisSeeds' of 1 is the same as
+    // the first constructor with inputsAreInitialGuess set to 'false'.
+    CylinderFit3 (int numPoints, const Vector3<Real>* points,
+        int numAxisSeeds, Vector3<Real>& center, Vector3<Real>& axis,
+        Real& radius, Real& height, ThreadPool* pool = 0);
 
     // Return the error value.
     operator Real ();
 
 private:
-    static Real UpdateInvRSqr (int numPoints, const Vector3<Real>* points,
+    enum
+    {
+        MAX_ITERATIONS = 8,
+        BLOCK_SIZE = 1024,  // a multiple of 4
+        MAX_SUMS = 5
+    };
+
+    // The points are stored in the arrays X, Y, and Z, each with NumPadded
+    // elements, a multiple of 4.  The elements of W are 1 for the points
+    // and 0 for the padding.
+    class PointArrays
+    {
+    public:
+        PointArrays (int numPoints, const Vector3<Real>* points);
+        ~PointArrays ();
+
+        int NumPoints, NumPadded;
+        Real* X;
+        Real* Y;
+        Real* Z;
+        Real* W;
+    };
+
+    // Iterate the updates of the inverse squared radius, the axis, and the
+    // center, and return the error.
+    static Real Iterate (const PointArrays& arrays, Vector3<Real>& center,
+        Vector3<Real>& axis, Real& invRSqr, ThreadPool* pool);
+
+    static Real UpdateInvRSqr (const PointArrays& arrays,
         const Vector3<Real>& center, const Vector3<Real>& axis,
-        Real& invRadiusSqr);
+        Real& invRSqr, ThreadPool* pool);
 
-    static Real UpdateDirection (int numPoints, const Vector3<Real>* points,
-        const Vector3<Real>& center, Vector3<Real>& axis,
-        Real& invRadiusSqr);
+    static Real UpdateDirection (const PointArrays& arrays,
+        const Vector3<Real>& center, Vector3<Real>& axis, Real& invRSqr,
+        ThreadPool* pool);
 
-    static Real UpdateCenter (int numPoints, const Vector3<Real>* points,
+    static Real UpdateCenter (const PointArrays& arrays,
         Vector3<Real>& center, const Vector3<Real>& axis,
-        const Real& invRadiusSqr);
+        const Real& invRSqr, ThreadPool* pool);
+
+    // Compute the radius and the height, and move the center to the middle
+    // of the extent of the points along the axis.
+    static void ComputeExtent (int numPoints, const Vector3<Real>* points,
+        Vector3<Real>& center, const Vector3<Real>& axis, Real invRSqr,
+        Real& radius, Real& height);
+
+    // Support for the parallel reductions.  The task items are blocks of
+    // BLOCK_SIZE points.  Direction is the steepest-descent direction for
+    // the axis polynomial and the cross product of the steepest-descent
+    // direction and the axis for the center polynomial.
+    enum ReductionType
+    {
+        RT_INV_RSQR,          // len2, len2^2
+        RT_AXIS_GRADIENT,     // a, a^2, vDir
+        RT_AXIS_POLYNOMIAL,   // a*b, a*c, b^2, b*c, c^2
+        RT_CENTER_GRADIENT,   // a, a^2, cDir
+        RT_CENTER_POLYNOMIAL  // b, a*b, b^2
+    };
+
+    class ReduceTaskData
+    {
+    public:
+        const PointArrays* Arrays;
+        ReductionType Type;
+        Vector3<Real> Center, Axis, Direction;
+        Real InvRSqr;
+        Real* BlockSums;
+    };
+
+    static void Reduce (ThreadPool* pool, ReduceTaskData& data,
+        Real sums[MAX_SUMS]);
+
+    static void ReduceTask (int begin, int end, int worker, void* userData);
+
+    // Support for the parallel fit from multiple axes.  The task items are
+    // the seeds, each iterated serially.
+    class SeedTaskData
+    {
+    public:
+        const PointArrays* Arrays;
+        Vector3<Real>* Centers;
+        Vector3<Real>* Axes;
+        Real* InvRSqrs;
+        Real* Errors;
+    };
+
+    static void SeedTask (int begin, int end, int worker, void* userData);
 
     Real mError;
 };
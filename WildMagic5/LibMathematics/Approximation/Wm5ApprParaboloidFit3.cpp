@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ApprParaboloidFit3.h"
@@ -88,7 +88,7 @@ bool ParaboloidFit3 (int numPoints, const Vector3<Real>* points,
     mat[5][4] = mat[4][5];
     mat[5][5] = (Real)numPoints;
 
-    return LinearSystem<Real>().Solve(mat, rhs, coeff);
+    return LinearSystem<Real>().SolveSymmetric(mat, rhs, coeff);
 }
 //----------------------------------------------------------------------------
 
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ApprPolyFit3.h"
@@ -77,7 +77,7 @@ Real* PolyFit3 (int numSamples, const Real* xSamples, const Real* ySamples,
     }
 
     // Solve for the polynomial coefficients.
-    bool hasSolution = LinearSystem<Real>().Solve(A, B, coeff);
+    bool hasSolution = LinearSystem<Real>().SolveSymmetric(A, B, coeff);
     assertion(hasSolution, "Failed to solve linear system\n");
     WM5_UNUSED(hasSolution);
 
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.2.1 (2010/10/01)
+// File Version: 5.2.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ApprPolynomialFit2.h"
@@ -74,7 +74,7 @@ PolynomialFit2<Real>::PolynomialFit2 (int numSamples, const Real* xSamples,
         rhs[row] *= invNumSamples;
     }
 
-    if (LinearSystem<Real>().Solve(mat, rhs, mCoefficients))
+    if (LinearSystem<Real>().SolveSymmetric(mat, rhs, mCoefficients))
     {
         mSolved = true;
     }
@@ -264,7 +264,7 @@ void PolynomialFit2<Real>::DoLeastSquaresFit (int numSamples,
         rhs[row] *= invNumSamples;
     }
 
-    if (LinearSystem<Real>().Solve(mat, rhs, mCoefficients))
+    if (LinearSystem<Real>().SolveSymmetric(mat, rhs, mCoefficients))
     {
         mSolved = true;
     }
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.4 (2010/12/22)
+// File Version: 5.0.5 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5Delaunay3.h"
@@ -752,12 +752,14 @@ void Delaunay3<Real>::Update (int i)
     Tetrahedron* tetra = GetContainingTetrahedron(i);
 
     // Locate and remove the tetrahedra forming the insertion polyhedron.
+    // The faces of the polyhedron are numbered in the order of insertion.
     std::stack<Tetrahedron*> tetraStack;
-    ETManifoldMesh polyhedron(0, Face::TCreator);
+    mPolyhedron.Clear();
+    mFaceNullIndex.clear();
+    mFaceTetra.clear();
     tetraStack.push(tetra);
     tetra->OnStack = true;
     int j, v0, v1, v2;
-    Face* face;
     while (!tetraStack.empty())
     {
         tetra = tetraStack.top();
@@ -788,9 +790,11 @@ void Delaunay3<Real>::Update (int i)
                     v0 = tetra->V[gsIndex[j][0]];
                     v1 = tetra->V[gsIndex[j][1]];
                     v2 = tetra->V[gsIndex[j][2]];
-                    face = (Face*)polyhedron.InsertTriangle(v0, v1, v2);
-                    face->NullIndex = nullIndex;
-                    face->Tetra = adj;
+                    if (mPolyhedron.InsertTriangle(v0, v1, v2) >= 0)
+                    {
+                        mFaceNullIndex.push_back(nullIndex);
+                        mFaceTetra.push_back(adj);
+                    }
                 }
             }
             else
@@ -813,10 +817,11 @@ void Delaunay3<Real>::Update (int i)
                         v2 = tetra->V[gsIndex[j][2]];
                         if (IsSupervertex(v2))
                         {
-                            face = (Face*)polyhedron.InsertTriangle(v0, v1,
-                                v2);
-                            face->NullIndex = -1;
-                            face->Tetra = 0;
+                            if (mPolyhedron.InsertTriangle(v0, v1, v2) >= 0)
+                            {
+                                mFaceNullIndex.push_back(-1);
+                                mFaceTetra.push_back(0);
+                            }
                         }
                     }
                 }
@@ -828,54 +833,45 @@ void Delaunay3<Real>::Update (int i)
 
     // Insert the new tetrahedra formed by the input point and the faces of
     // the insertion polyhedron.
-    const ETManifoldMesh::TMap& tetraMap = polyhedron.GetTriangles();
-    assertion(tetraMap.size() >= 4 && polyhedron.IsClosed(),
+    const int numFaces = mPolyhedron.GetNumTriangles();
+    assertion(numFaces >= 4 && mPolyhedron.IsClosed(),
         "Polyhedron must be at least a tetrahedron\n");
-    typename ETManifoldMesh::TMapCIterator iter = tetraMap.begin();
-    typename ETManifoldMesh::TMapCIterator end = tetraMap.end();
-    for (/**/; iter != end; ++iter)
+    int face;
+    for (face = 0; face < numFaces; ++face)
     {
-        face = (Face*)iter->second;
-
         // Create and insert the new tetrahedron.
-        tetra = new0 Tetrahedron(i, face->V[0], face->V[1], face->V[2]);
+        const int* vertices = mPolyhedron.GetVertices(face);
+        tetra = new0 Tetrahedron(i, vertices[0], vertices[1], vertices[2]);
         mTetrahedra.insert(tetra);
 
         // Establish the adjacency links across the polyhedron face.
-        tetra->Adj[0] = face->Tetra;
-        if (face->Tetra)
+        Tetrahedron* adj = mFaceTetra[face];
+        tetra->Adj[0] = adj;
+        if (adj)
         {
-            face->Tetra->Adj[face->NullIndex] = tetra;
+            adj->Adj[mFaceNullIndex[face]] = tetra;
         }
 
         // Update the faces's tetrahedron pointer to point to the newly
         // created tetrahedron.  This information is used later to establish
         // the links between the new tetrahedra.
-        face->Tetra = tetra;
+        mFaceTetra[face] = tetra;
     }
 
-    // Establish the adjacency links between the new tetrahedra.
-    Face* adjFace;
-    iter = tetraMap.begin();
-    end = tetraMap.end();
-    for (/**/; iter != end; ++iter)
+    // Establish the adjacency links between the new tetrahedra.  Edge k of
+    // a face is opposite vertex (k+2)%3 of the face, which is vertex
+    // 1+(k+2)%3 of its tetrahedron.
+    for (face = 0; face < numFaces; ++face)
     {
-        face = (Face*)iter->second;
-
-        adjFace = (Face*)face->T[0];
-        face->Tetra->Adj[3] = adjFace->Tetra;
-        assertion(SharesFace(3, face->Tetra, adjFace->Tetra),
-            "Face sharing is incorrect\n");
-
-        adjFace = (Face*)face->T[1];
-        face->Tetra->Adj[1] = adjFace->Tetra;
-        assertion(SharesFace(1, face->Tetra, adjFace->Tetra),
-            "Face sharing is incorrect\n");
-
-        adjFace = (Face*)face->T[2];
-        face->Tetra->Adj[2] = adjFace->Tetra;
-        assertion(SharesFace(2, face->Tetra, adjFace->Tetra),
-            "Face sharing is incorrect\n");
+        tetra = mFaceTetra[face];
+        for (int k = 0; k < 3; ++k)
+        {
+            Tetrahedron* adj = mFaceTetra[mPolyhedron.GetAdjacent(face, k)];
+            int index = 1 + (k + 2) % 3;
+            tetra->Adj[index] = adj;
+            assertion(SharesFace(index, tetra, adj),
+                "Face sharing is incorrect\n");
+        }
     }
 }
 //----------------------------------------------------------------------------
@@ -1185,26 +1181,6 @@ int Delaunay3<Real>::Tetrahedron::DetachFrom (int adjIndex, Tetrahedron* adj)
 }
 //----------------------------------------------------------------------------
 
-//----------------------------------------------------------------------------
-// Delaunay3::Face
-//----------------------------------------------------------------------------
-template <typename Real>
-Delaunay3<Real>::Face::Face (int v0, int v1, int v2, int nullIndex,
-    Tetrahedron* tetra)
-    :
-    ETManifoldMesh::Triangle(v0, v1, v2),
-    NullIndex(nullIndex),
-    Tetra(tetra)
-{
-}
-//----------------------------------------------------------------------------
-template <typename Real>
-ETManifoldMesh::TPtr Delaunay3<Real>::Face::TCreator (int v0, int v1, int v2)
-{
-    return new0 Face(v0, v1, v2, 0, 0);
-}
-//----------------------------------------------------------------------------
-
 //----------------------------------------------------------------------------
 // Explicit instantiation.
 //----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5DELAUNAY3_H
 #define WM5DELAUNAY3_H
@@ -12,7 +12,7 @@
 #include "Wm5MathematicsLIB.h"
 #include "Wm5Delaunay1.h"
 #include "Wm5Delaunay2.h"
-#include "Wm5ETManifoldMesh.h"
+#include "Wm5HalfEdgeMesh.h"
 #include "Wm5Query3.h"
 
 namespace Wm5
@@ -147,18 +147,6 @@ private:
         bool OnStack;
     };
 
-    class Face : public ETManifoldMesh::Triangle
-    {
-    public:
-        Face (int v0 = -1, int v1 = -1, int v2 = -1, int nullIndex = -1,
-            Tetrahedron* tri = 0);
-
-        static ETManifoldMesh::TPtr TCreator (int v0, int v1, int v2);
-
-        int NullIndex;
-        Tetrahedron* Tetra;
-    };
-
     void Update (int i);
     Tetrahedron* GetContainingTetrahedron (int i) const;
     void RemoveTetrahedra ();
@@ -185,6 +173,14 @@ private:
     // The current tetrahedralization.
     std::set<Tetrahedron*> mTetrahedra;
 
+    // The insertion polyhedron of Update, kept between calls to reuse its
+    // storage.  Face f of the polyhedron has the tetrahedron mFaceTetra[f]
+    // on its other side (null on the supertetrahedron), whose adjacency
+    // slot mFaceNullIndex[f] refers to the face.
+    HalfEdgeMesh mPolyhedron;
+    std::vector<int> mFaceNullIndex;
+    std::vector<Tetrahedron*> mFaceTetra;
+
     // The line of containment if the dimension is 1.
     Vector3<Real> mLineOrigin, mLineDirection;
 
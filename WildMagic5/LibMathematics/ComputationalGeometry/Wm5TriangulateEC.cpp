@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.3 (2012/07/08)
+// File Version: 5.0.4 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5TriangulateEC.h"
@@ -60,8 +60,10 @@ TriangulateEC<Real>::TriangulateEC (const Positions& positions,
     int nextElement = (int)positions.size();  // next available element
     IndexMap indexMap;
     Indices combined;
-    CombinePolygons(queryType, epsilon, nextElement, outer, inner, indexMap,
-        combined);
+    IndicesArray inners(1);
+    inners[0] = (Indices*)&inner;
+    ProcessOuterAndInners(queryType, epsilon, outer, inners, nextElement,
+        indexMap, combined);
 
     // The combined polygon is now in the format of a simple polygon, albeit
     // one with coincident edges.
@@ -188,6 +190,7 @@ void TriangulateEC<Real>::InitializePositions (const Positions& positions,
     assertion(numPositions >= 3, "Must have at least one triangle\n");
     int numPosExtras = numPositions + extraElements;
     mSPositions.resize(numPosExtras);
+    mQueryType = queryType;
 
     if (queryType == Query::QT_FILTERED)
     {
@@ -356,7 +359,36 @@ void TriangulateEC<Real>::DoEarClipping (int numVertices, const int* indices,
     // vertex inside T, it is sufficient to search only the reflex vertices.
     // This is an O(C*R) process, where C is the number of convex vertices and
     // R is the number of reflex vertices with N = C+R.  The order is O(N^2),
-    // for example when C = R = N/2.
+    // for example when C = R = N/2.  The reflex vertices are stored in a
+    // grid, so an ear test visits only those near its triangle.
+    Vector2<Real> minimum = mSPositions[V(0).Index], maximum = minimum;
+    int numReflex = 0;
+    for (i = 0; i < numVertices; ++i)
+    {
+        const Vector2<Real>& position = mSPositions[V(i).Index];
+        for (int j = 0; j < 2; ++j)
+        {
+            if (position[j] < minimum[j])
+            {
+                minimum[j] = position[j];
+            }
+            else if (position[j] > maximum[j])
+            {
+                maximum[j] = position[j];
+            }
+        }
+        if (!V(i).IsConvex)
+        {
+            ++numReflex;
+        }
+    }
+    mReflexGrid.Create(minimum, maximum, numReflex);
+    for (i = mRFirst; i != -1; i = V(i).SNext)
+    {
+        const Vector2<Real>& position = mSPositions[V(i).Index];
+        mReflexGrid.Insert(i, position, position);
+    }
+
     for (i = mCFirst; i != -1; i = V(i).SNext)
     {
         if (IsEar(i))
@@ -478,317 +510,444 @@ int TriangulateEC<Real>::TriangleQuery (const Vector2<Real>& position,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-void TriangulateEC<Real>::CombinePolygons (Query::Type queryType,
-    Real epsilon, int nextElement, const Indices& outer,
-    const Indices& inner, IndexMap& indexMap, Indices& combined)
+void TriangulateEC<Real>::ProcessOuterAndInners (Query::Type queryType,
+    Real epsilon, const Indices& outer, const IndicesArray& inners,
+    int& nextElement, IndexMap& indexMap, Indices& combined)
 {
+    // Sort the inner polygons based on maximum x-values.  Each inner polygon
+    // has two extra nodes for the duplicated vertices.
     int numOuterVertices = (int)outer.size();
-    int numInnerVertices = (int)inner.size();
+    int numInners = (int)inners.size();
+    int numNodes = numOuterVertices + 2*numInners;
+    std::vector<std::pair<Real,int> > pairs(numInners);
+    std::vector<int> xmaxIndices(numInners);
+    int i, j;
+    for (i = 0; i < numInners; ++i)
+    {
+        const Indices& inner = *inners[i];
+        int numVertices = (int)inner.size();
+        Real xmax = mSPositions[inner[0]][0];
+        xmaxIndices[i] = 0;
+        for (j = 1; j < numVertices; ++j)
+        {
+            Real x = mSPositions[inner[j]][0];
+            if (x > xmax)
+            {
+                xmax = x;
+                xmaxIndices[i] = j;
+            }
+        }
+        pairs[i].first = xmax;
+        pairs[i].second = i;
+        numNodes += numVertices;
+    }
+    std::sort(pairs.begin(),pairs.end());
 
-    // Locate the inner-polygon vertex of maximum x-value, call this vertex M.
-    Real xmax = mSPositions[inner[0]][0];
-    int xmaxIndex = 0;
-    int i;
-    for (i = 1; i < numInnerVertices; ++i)
+    // Create the nodes of the outer polygon, followed by those of the inner
+    // polygons, each inner polygon a separate circular list.
+    CombinedPolygon polygon;
+    polygon.Index.resize(numNodes);
+    polygon.Next.resize(numNodes);
+    polygon.Prev.resize(numNodes);
+    polygon.Stamp.resize(numNodes);
+    polygon.Head = 0;
+    std::vector<int> firstNodes(numInners);
+    int node = 0;
+    for (i = 0; i < numOuterVertices; ++i, ++node)
+    {
+        polygon.Index[node] = outer[i];
+        polygon.Next[node] = (i + 1 < numOuterVertices ? node + 1 : 0);
+        polygon.Prev[node] = (i > 0 ? node - 1 : numOuterVertices - 1);
+    }
+    for (i = 0; i < numInners; ++i)
+    {
+        const Indices& inner = *inners[i];
+        int numVertices = (int)inner.size();
+        firstNodes[i] = node;
+        for (j = 0; j < numVertices; ++j)
+        {
+            polygon.Index[node + j] = inner[j];
+            polygon.Next[node + j] = node + (j + 1)%numVertices;
+            polygon.Prev[node + j] = node + (j + numVertices - 1)%numVertices;
+        }
+        node += numVertices;
+    }
+    for (i = 0; i < numNodes; ++i)
+    {
+        polygon.Stamp[i] = -1;
+    }
+
+    // The grids cover the outer polygon, which contains the inner polygons.
+    Vector2<Real> minimum = mSPositions[outer[0]], maximum = minimum;
+    for (i = 1; i < numOuterVertices; ++i)
+    {
+        const Vector2<Real>& position = mSPositions[outer[i]];
+        for (j = 0; j < 2; ++j)
+        {
+            if (position[j] < minimum[j])
+            {
+                minimum[j] = position[j];
+            }
+            else if (position[j] > maximum[j])
+            {
+                maximum[j] = position[j];
+            }
+        }
+    }
+    polygon.Edges.Create(minimum, maximum, numNodes);
+    polygon.Points.Create(minimum, maximum, numNodes);
+    for (i = 0; i < numOuterVertices; ++i)
+    {
+        const Vector2<Real>& position = mSPositions[outer[i]];
+        InsertEdge(polygon, i);
+        polygon.Points.Insert(i, position, position);
+    }
+
+    // Merge the inner polygons with the outer polygon.
+    for (i = numInners - 1; i >= 0; --i)
     {
-        Real x = mSPositions[inner[i]][0];
-        if (x > xmax)
+        int inner = pairs[i].second;
+        int M = firstNodes[inner] + xmaxIndices[inner];
+        int P = FindVisibleNode(queryType, epsilon, polygon, M, i);
+
+        // The visible vertices are those of nodes M and P.  Two coincident
+        // edges with these endpoints are inserted to connect the outer and
+        // inner polygons into a simple polygon.  Each of the two positions
+        // must be duplicated, because the original might be convex (or
+        // reflex) and the duplicate is reflex (or convex).  The ear-clipping
+        // algorithm needs to distinguish between them.  The polygon becomes
+        // <...,Q,M,...,L,MDup,P,...>, where L is the predecessor of M in the
+        // inner polygon and Q is a new node with the original index of P.
+        // Node P keeps its outgoing edge in the edge grid and receives the
+        // duplicated index, and the incoming edge of Q has the geometry of
+        // the former incoming edge of P.
+        int Q = node++;
+        int MDup = node++;
+        int L = polygon.Prev[M];
+        int prevP = polygon.Prev[P];
+
+        int innerIndex = polygon.Index[M];
+        mSPositions[nextElement] = mSPositions[innerIndex];
+        polygon.Index[MDup] = nextElement;
+        IndexMap::iterator iter = indexMap.find(innerIndex);
+        if (iter != indexMap.end())
         {
-            xmax = x;
-            xmaxIndex = i;
+            innerIndex = iter->second;
         }
+        indexMap[nextElement] = innerIndex;
+        ++nextElement;
+
+        int outerIndex = polygon.Index[P];
+        mSPositions[nextElement] = mSPositions[outerIndex];
+        polygon.Index[Q] = outerIndex;
+        polygon.Index[P] = nextElement;
+        iter = indexMap.find(outerIndex);
+        if (iter != indexMap.end())
+        {
+            outerIndex = iter->second;
+        }
+        indexMap[nextElement] = outerIndex;
+        ++nextElement;
+
+        polygon.Next[prevP] = Q;
+        polygon.Prev[Q] = prevP;
+        polygon.Next[Q] = M;
+        polygon.Prev[M] = Q;
+        polygon.Next[L] = MDup;
+        polygon.Prev[MDup] = L;
+        polygon.Next[MDup] = P;
+        polygon.Prev[P] = MDup;
+        if (polygon.Head == P)
+        {
+            polygon.Head = Q;
+        }
+
+        // Insert the new edges and vertices into the grids.
+        InsertEdge(polygon, Q);
+        InsertEdge(polygon, MDup);
+        const Vector2<Real>& PPosition = mSPositions[polygon.Index[Q]];
+        const Vector2<Real>& MPosition = mSPositions[polygon.Index[MDup]];
+        polygon.Points.Insert(Q, PPosition, PPosition);
+        polygon.Points.Insert(MDup, MPosition, MPosition);
+        for (j = M; j != MDup; j = polygon.Next[j])
+        {
+            const Vector2<Real>& position = mSPositions[polygon.Index[j]];
+            InsertEdge(polygon, j);
+            polygon.Points.Insert(j, position, position);
+        }
+    }
+
+    combined.reserve(combined.size() + node);
+    j = polygon.Head;
+    do
+    {
+        combined.push_back(polygon.Index[j]);
+        j = polygon.Next[j];
     }
-    Vector2<Real> M = mSPositions[inner[xmaxIndex]];
+    while (j != polygon.Head);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int TriangulateEC<Real>::FindVisibleNode (Query::Type queryType,
+    Real epsilon, CombinedPolygon& polygon, int M, int stamp)
+{
+    const std::vector<int>& index = polygon.Index;
+    const Vector2<Real> MPosition = mSPositions[index[M]];
 
     // Find the edge whose intersection Intr with the ray M+t*(1,0) minimizes
-    // the ray parameter t >= 0.
-    Vector2<Real> intr(Math<Real>::MAX_REAL, M[1]);
+    // the ray parameter t >= 0.  The cells of the edge grid in the row of M
+    // are visited from left to right, until the cells are beyond the
+    // closest intersection found so far.  An edge is stored in each cell
+    // that its bounding rectangle overlaps, so it is stamped when tested.
+    const CellGrid& edges = polygon.Edges;
+    Vector2<Real> intr(Math<Real>::MAX_REAL, MPosition[1]);
     int v0min = -1, v1min = -1, endMin = -1;
-    int i0, i1;
     Real s = Math<Real>::MAX_REAL;
     Real t = Math<Real>::MAX_REAL;
-    for (i0 = numOuterVertices - 1, i1 = 0; i1 < numOuterVertices; i0 = i1++)
+    int y = edges.GetY(MPosition[1]);
+    for (int x = edges.GetX(MPosition[0]); x < edges.NumX; ++x)
     {
-        // Only consider edges for which the first vertex is below (or on)
-        // the ray and the second vertex is above (or on) the ray.
-        Vector2<Real> diff0 = mSPositions[outer[i0]] - M;
-        if (diff0[1] > (Real)0)
+        if (v0min >= 0 && x > edges.GetX(MPosition[0] + intr[0]) + 1)
         {
-            continue;
-        }
-        Vector2<Real> diff1 = mSPositions[outer[i1]] - M;
-        if (diff1[1] < (Real)0)
-        {
-            continue;
+            break;
         }
 
-        // At this time, diff0.y <= 0 and diff1.y >= 0.
-        int currentEndMin = -1;
-        if (diff0[1] < (Real)0)
+        const std::vector<int>& cell = edges.Cells[x + edges.NumX*y];
+        const int numItems = (int)cell.size();
+        for (int k = 0; k < numItems; ++k)
         {
-            if (diff1[1] > (Real)0)
+            int i0 = cell[k];
+            if (polygon.Stamp[i0] == stamp)
             {
-                // The intersection of the edge and ray occurs at an interior
-                // edge point.
-                s = diff0[1]/(diff0[1] - diff1[1]);
-                t = diff0[0] + s*(diff1[0] - diff0[0]);
+                continue;
             }
-            else  // diff1.y == 0
+            polygon.Stamp[i0] = stamp;
+            int i1 = polygon.Next[i0];
+
+            // Only consider edges for which the first vertex is below (or
+            // on) the ray and the second vertex is above (or on) the ray.
+            Vector2<Real> diff0 = mSPositions[index[i0]] - MPosition;
+            if (diff0[1] > (Real)0)
             {
-                // The vertex Outer[i1] is the intersection of the edge and
-                // the ray.
-                t = diff1[0];
-                currentEndMin = i1;
+                continue;
             }
-        }
-        else  // diff0.y == 0
-        {
-            if (diff1[1] > (Real)0)
+            Vector2<Real> diff1 = mSPositions[index[i1]] - MPosition;
+            if (diff1[1] < (Real)0)
             {
-                // The vertex Outer[i0] is the intersection of the edge and
-                // the ray;
-                t = diff0[0];
-                currentEndMin = i0;
+                continue;
             }
-            else  // diff1.y == 0
+
+            // At this time, diff0.y <= 0 and diff1.y >= 0.
+            int currentEndMin = -1;
+            if (diff0[1] < (Real)0)
             {
-                if (diff0[0] < diff1[0])
+                if (diff1[1] > (Real)0)
                 {
-                    t = diff0[0];
-                    currentEndMin = i0;
+                    // The intersection of the edge and ray occurs at an
+                    // interior edge point.
+                    s = diff0[1]/(diff0[1] - diff1[1]);
+                    t = diff0[0] + s*(diff1[0] - diff0[0]);
                 }
-                else
+                else  // diff1.y == 0
                 {
+                    // The vertex of i1 is the intersection of the edge and
+                    // the ray.
                     t = diff1[0];
                     currentEndMin = i1;
                 }
             }
-        }
-
-        if ((Real)0 <= t && t < intr[0])
-        {
-            intr[0] = t;
-            v0min = i0;
-            v1min = i1;
-            if (currentEndMin == -1)
+            else  // diff0.y == 0
             {
-                // The current closest point is an edge-interior point.
-                endMin = -1;
-            }
-            else
-            {
-                // The current closest point is a vertex.
-                endMin = currentEndMin;
+                if (diff1[1] > (Real)0)
+                {
+                    // The vertex of i0 is the intersection of the edge and
+                    // the ray;
+                    t = diff0[0];
+                    currentEndMin = i0;
+                }
+                else  // diff1.y == 0
+                {
+                    if (diff0[0] < diff1[0])
+                    {
+                        t = diff0[0];
+                        currentEndMin = i0;
+                    }
+                    else
+                    {
+                        t = diff1[0];
+                        currentEndMin = i1;
+                    }
+                }
             }
-        }
-        else if (t == intr[0])
-        {
-            // The current closest point is a vertex shared by multiple edges;
-            // thus, endMin and currentMin refer to the same point.
-            assertion(endMin != -1 && currentEndMin != -1,
-                "Unexpected condition\n");
-
-            // We need to select the edge closest to M.  The previous closest
-            // edge is <outer[v0min],outer[v1min]>.  The current candidate is
-            // <outer[i0],outer[i1]>.
-            Vector2<Real> shared = mSPositions[outer[i1]];
-            
-            // For the previous closest edge, endMin refers to a vertex of
-            // the edge.  Get the index of the other vertex.
-            int other = (endMin == v0min ? v1min : v0min);
-
-            // The new edge is closer if the other vertex of the old edge is
-            // left-of the new edge.
-            diff0 = mSPositions[outer[i0]] - shared;
-            diff1 = mSPositions[outer[other]] - shared;
-            Real dotperp = diff0.DotPerp(diff1);
-            if (dotperp > (Real)0)
+
+            if ((Real)0 <= t && t < intr[0])
             {
-                // The new edge is closer to M.
+                intr[0] = t;
                 v0min = i0;
                 v1min = i1;
                 endMin = currentEndMin;
             }
-        }
-    }
-
-    // The intersection intr[0] stored only the t-value of the ray.  The
-    // actual point is (mx,my)+t*(1,0), so intr[0] must be adjusted.
-    intr[0] += M[0];
-
-    int maxCosIndex;
-    if (endMin == -1)
-    {
-        // If you reach this assert, there is a good chance that you have two
-        // inner polygons that share a vertex or an edge.
-        assertion(v0min >= 0 && v1min >= 0, "Unexpected condition\n");
-
-        // Select one of Outer[v0min] and Outer[v1min] that has an x-value
-        // larger than M.x, call this vertex P.  The triangle <M,I,P> must
-        // contain an outer-polygon vertex that is visible to M, which is
-        // possibly P itself.
-        Vector2<Real> sTriangle[3];  // <P,M,I> or <P,I,M>
-        int pIndex;
-        if (mSPositions[outer[v0min]][0] > mSPositions[outer[v1min]][0])
-        {
-            sTriangle[0] = mSPositions[outer[v0min]];
-            sTriangle[1] = intr;
-            sTriangle[2] = M;
-            pIndex = v0min;
-        }
-        else
-        {
-            sTriangle[0] = mSPositions[outer[v1min]];
-            sTriangle[1] = M;
-            sTriangle[2] = intr;
-            pIndex = v1min;
-        }
-
-        // If any outer-polygon vertices other than P are inside the triangle
-        // <M,I,P>, then at least one of these vertices must be a reflex
-        // vertex.  It is sufficient to locate the reflex vertex R (if any)
-        // in <M,I,P> that minimizes the angle between R-M and (1,0).  The
-        // data member mQuery is used for the reflex query.
-        Vector2<Real> diff = sTriangle[0] - M;
-        Real maxSqrLen = diff.SquaredLength();
-        Real maxCos = diff[0]*diff[0]/maxSqrLen;
-        maxCosIndex = pIndex;
-        for (i = 0; i < numOuterVertices; ++i)
-        {
-            if (i == pIndex)
-            {
-                continue;
-            }
-
-            int curr = outer[i];
-            int prev = outer[(i + numOuterVertices - 1) % numOuterVertices];
-            int next = outer[(i + 1) % numOuterVertices];
-            if (mQuery->ToLine(curr, prev, next) <= 0
-            &&  TriangleQuery(mSPositions[curr], queryType, epsilon,
-                    sTriangle) <= 0)
+            else if (t == intr[0])
             {
-                // The vertex is reflex and inside the <M,I,P> triangle.
-                diff = mSPositions[curr] - M;
-                Real sqrLen = diff.SquaredLength();
-                Real cs = diff[0]*diff[0]/sqrLen;
-                if (cs > maxCos)
+                // The current closest point is a vertex shared by multiple
+                // edges; thus, endMin and currentEndMin refer to the same
+                // point.
+                assertion(endMin != -1 && currentEndMin != -1,
+                    "Unexpected condition\n");
+
+                // The nodes differ when the vertex is an endpoint of a
+                // bridge to a hole that was merged earlier.  Select the node
+                // whose interior wedge, swept counterclockwise from its
+                // outgoing edge to its incoming edge, contains the direction
+                // (-1,0) toward M.  Exactly one node has this property, so
+                // the choice does not depend on the order in which the cells
+                // are visited.
+                Vector2<Real> shared = mSPositions[index[currentEndMin]];
+                Vector2<Real> dNext =
+                    mSPositions[index[polygon.Next[currentEndMin]]] - shared;
+                Vector2<Real> dPrev =
+                    mSPositions[index[polygon.Prev[currentEndMin]]] - shared;
+                bool contains;
+                if (dNext.DotPerp(dPrev) > (Real)0)
                 {
-                    // The reflex vertex forms a smaller angle with the
-                    // positive x-axis, so it becomes the new visible
-                    // candidate.
-                    maxSqrLen = sqrLen;
-                    maxCos = cs;
-                    maxCosIndex = i;
+                    // The wedge is convex.
+                    contains = (dNext[1] >= (Real)0 && dPrev[1] <= (Real)0);
                 }
-                else if (cs == maxCos && sqrLen < maxSqrLen)
+                else
+                {
+                    // The wedge is reflex.
+                    contains = (dNext[1] >= (Real)0 || dPrev[1] <= (Real)0);
+                }
+                if (contains)
                 {
-                    // The reflex vertex has angle equal to the current
-                    // minimum but the length is smaller, so it becomes the
-                    // new visible candidate.
-                    maxSqrLen = sqrLen;
-                    maxCosIndex = i;
+                    v0min = i0;
+                    v1min = i1;
+                    endMin = currentEndMin;
                 }
             }
         }
     }
-    else
-    {
-        maxCosIndex = endMin;
-    }
-
-    // The visible vertices are Position[Inner[xmaxIndex]] and
-    // Position[Outer[maxCosIndex]].  Two coincident edges with these
-    // endpoints are inserted to connect the outer and inner polygons into a
-    // simple polygon.  Each of the two Position[] values must be duplicated,
-    // because the original might be convex (or reflex) and the duplicate is
-    // reflex (or convex).  The ear-clipping algorithm needs to distinguish
-    // between them.
-    combined.resize(numOuterVertices + numInnerVertices + 2);
-    int cIndex = 0;
-    for (i = 0; i <= maxCosIndex; ++i, ++cIndex)
-    {
-        combined[cIndex] = outer[i];
-    }
 
-    for (i = 0; i < numInnerVertices; ++i, ++cIndex)
+    if (endMin != -1)
     {
-        int j = (xmaxIndex + i) % numInnerVertices;
-        combined[cIndex] = inner[j];
+        return endMin;
     }
 
-    int innerIndex = inner[xmaxIndex];
-    mSPositions[nextElement] = mSPositions[innerIndex];
-    combined[cIndex] = nextElement;
-    IndexMap::iterator iter = indexMap.find(innerIndex);
-    if (iter != indexMap.end())
+    // The intersection intr[0] stored only the t-value of the ray.  The
+    // actual point is (mx,my)+t*(1,0), so intr[0] must be adjusted.
+    intr[0] += MPosition[0];
+
+    // If you reach this assert, there is a good chance that you have two
+    // inner polygons that share a vertex or an edge.
+    assertion(v0min >= 0 && v1min >= 0, "Unexpected condition\n");
+
+    // Select one of v0min and v1min that has an x-value larger than M.x,
+    // call this vertex P.  The triangle <M,I,P> must contain an outer-
+    // polygon vertex that is visible to M, which is possibly P itself.
+    Vector2<Real> sTriangle[3];  // <P,M,I> or <P,I,M>
+    int pIndex;
+    if (mSPositions[index[v0min]][0] > mSPositions[index[v1min]][0])
     {
-        innerIndex = iter->second;
+        sTriangle[0] = mSPositions[index[v0min]];
+        sTriangle[1] = intr;
+        sTriangle[2] = MPosition;
+        pIndex = v0min;
     }
-    indexMap[nextElement] = innerIndex;
-    ++cIndex;
-    ++nextElement;
-
-    int outerIndex = outer[maxCosIndex];
-    mSPositions[nextElement] = mSPositions[outerIndex];
-    combined[cIndex] = nextElement;
-    iter = indexMap.find(outerIndex);
-    if (iter != indexMap.end())
+    else
     {
-        outerIndex = iter->second;
+        sTriangle[0] = mSPositions[index[v1min]];
+        sTriangle[1] = MPosition;
+        sTriangle[2] = intr;
+        pIndex = v1min;
     }
-    indexMap[nextElement] = outerIndex;
-    ++cIndex;
-    ++nextElement;
 
-    for (i = maxCosIndex + 1; i < numOuterVertices; ++i, ++cIndex)
+    // If any vertices other than P are inside the triangle <M,I,P>, then at
+    // least one of these vertices must be a reflex vertex.  It is
+    // sufficient to locate the reflex vertex R (if any) in <M,I,P> that
+    // minimizes the angle between R-M and (1,0).  Only the cells of the
+    // point grid that overlap the bounding rectangle of the triangle are
+    // searched.  The data member mQuery is used for the reflex query.
+    Vector2<Real> diff = sTriangle[0] - MPosition;
+    Real maxSqrLen = diff.SquaredLength();
+    Real maxCos = diff[0]*diff[0]/maxSqrLen;
+    int maxCosIndex = pIndex;
+
+    const CellGrid& points = polygon.Points;
+    Real padding = GetGridPadding();
+    int x0 = points.GetX(MPosition[0] - padding);
+    int x1 = points.GetX(std::max(sTriangle[0][0], intr[0]) + padding);
+    int y0 = points.GetY(std::min(sTriangle[0][1], MPosition[1])
+        - padding);
+    int y1 = points.GetY(std::max(sTriangle[0][1], MPosition[1])
+        + padding);
+    for (y = y0; y <= y1; ++y)
     {
-        combined[cIndex] = outer[i];
-    }
-}
-//----------------------------------------------------------------------------
-template <typename Real>
-void TriangulateEC<Real>::ProcessOuterAndInners (Query::Type queryType,
-    Real epsilon, const Indices& outer, const IndicesArray& inners,
-    int& nextElement, IndexMap& indexMap, Indices& combined)
-{
-    // Sort the inner polygons based on maximum x-values.
-    int numInners = (int)inners.size();
-    std::vector<std::pair<Real,int> > pairs(numInners);
-    int i;
-    for (i = 0; i < numInners; ++i)
-    {
-        const Indices& inner = *inners[i];
-        int numVertices = (int)inner.size();
-        Real xmax = mSPositions[inner[0]][0];
-        for (int j = 1; j < numVertices; ++j)
+        for (int x = x0; x <= x1; ++x)
         {
-            Real x = mSPositions[inner[j]][0];
-            if (x > xmax)
+            const std::vector<int>& cell = points.Cells[x + points.NumX*y];
+            const int numItems = (int)cell.size();
+            for (int k = 0; k < numItems; ++k)
             {
-                xmax = x;
+                int i = cell[k];
+                if (i == pIndex)
+                {
+                    continue;
+                }
+
+                int curr = index[i];
+                int prev = index[polygon.Prev[i]];
+                int next = index[polygon.Next[i]];
+                if (mQuery->ToLine(curr, prev, next) <= 0
+                &&  TriangleQuery(mSPositions[curr], queryType, epsilon,
+                        sTriangle) <= 0)
+                {
+                    // The vertex is reflex and inside the <M,I,P> triangle.
+                    diff = mSPositions[curr] - MPosition;
+                    Real sqrLen = diff.SquaredLength();
+                    Real cs = diff[0]*diff[0]/sqrLen;
+                    if (cs > maxCos)
+                    {
+                        // The reflex vertex forms a smaller angle with the
+                        // positive x-axis, so it becomes the new visible
+                        // candidate.
+                        maxSqrLen = sqrLen;
+                        maxCos = cs;
+                        maxCosIndex = i;
+                    }
+                    else if (cs == maxCos && sqrLen < maxSqrLen)
+                    {
+                        // The reflex vertex has angle equal to the current
+                        // minimum but the length is smaller, so it becomes
+                        // the new visible candidate.
+                        maxSqrLen = sqrLen;
+                        maxCosIndex = i;
+                    }
+                }
             }
         }
-        pairs[i].first = xmax;
-        pairs[i].second = i;
-    }
-    std::sort(pairs.begin(),pairs.end());
-
-    // Merge the inner polygons with the outer polygon.
-    Indices currentOuter = outer;
-    for (i = numInners - 1; i >= 0; --i)
-    {
-        const Indices& inner = *inners[pairs[i].second];
-        Indices currentCombined;
-        CombinePolygons(queryType, epsilon, nextElement, currentOuter,
-            inner, indexMap, currentCombined);
-        currentOuter = currentCombined;
-        nextElement += 2;
     }
 
-    for (i = 0; i < (int)currentOuter.size(); ++i)
+    return maxCosIndex;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void TriangulateEC<Real>::InsertEdge (CombinedPolygon& polygon, int node)
+{
+    const Vector2<Real>& P0 = mSPositions[polygon.Index[node]];
+    const Vector2<Real>& P1 = mSPositions[polygon.Index[polygon.Next[node]]];
+    Vector2<Real> minimum(std::min(P0[0], P1[0]), std::min(P0[1], P1[1]));
+    Vector2<Real> maximum(std::max(P0[0], P1[0]), std::max(P0[1], P1[1]));
+    polygon.Edges.Insert(node, minimum, maximum);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real TriangulateEC<Real>::GetGridPadding () const
+{
+    if (mQueryType == Query::QT_INT64 || mQueryType == Query::QT_INTEGER)
     {
-        combined.push_back(currentOuter[i]);
+        return (Real)1;
     }
+    return (Real)0;
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -842,41 +1001,69 @@ bool TriangulateEC<Real>::IsEar (int i)
     }
 
     // Search the reflex vertices and test if any are in the triangle
-    // <V[prev],V[curr],V[next]>.
+    // <V[prev],V[curr],V[next]>.  Only the cells of the reflex grid that
+    // overlap the bounding rectangle of the triangle are visited.  The grid
+    // still contains the vertices that have become convex since it was
+    // built, so these are skipped.
     int prev = V(vertex.VPrev).Index;
     int curr = vertex.Index;
     int next = V(vertex.VNext).Index;
+    const Vector2<Real>& P0 = mSPositions[prev];
+    const Vector2<Real>& P1 = mSPositions[curr];
+    const Vector2<Real>& P2 = mSPositions[next];
+    Real padding = GetGridPadding();
+    int x0 = mReflexGrid.GetX(std::min(std::min(P0[0], P1[0]), P2[0])
+        - padding);
+    int x1 = mReflexGrid.GetX(std::max(std::max(P0[0], P1[0]), P2[0])
+        + padding);
+    int y0 = mReflexGrid.GetY(std::min(std::min(P0[1], P1[1]), P2[1])
+        - padding);
+    int y1 = mReflexGrid.GetY(std::max(std::max(P0[1], P1[1]), P2[1])
+        + padding);
     vertex.IsEar = true;
-    for (int j = mRFirst; j != -1; j = V(j).SNext)
+    for (int y = y0; y <= y1; ++y)
     {
-        // Check if the test vertex is already one of the triangle vertices.
-        if (j == vertex.VPrev || j == i || j == vertex.VNext)
+        for (int x = x0; x <= x1; ++x)
         {
-            continue;
-        }
+            const std::vector<int>& cell =
+                mReflexGrid.Cells[x + mReflexGrid.NumX*y];
+            const int numItems = (int)cell.size();
+            for (int k = 0; k < numItems; ++k)
+            {
+                // Check if the test vertex is already one of the triangle
+                // vertices.
+                int j = cell[k];
+                if (V(j).IsConvex || j == vertex.VPrev || j == i
+                ||  j == vertex.VNext)
+                {
+                    continue;
+                }
 
-        // V[j] has been ruled out as one of the original vertices of the
-        // triangle <V[prev],V[curr],V[next]>.  When triangulating polygons
-        // with holes, V[j] might be a duplicated vertex, in which case it
-        // does not affect the earness of V[curr].
-        int test = V(j).Index;
-        if (mSPositions[test] == mSPositions[prev]
-        ||  mSPositions[test] == mSPositions[curr]
-        ||  mSPositions[test] == mSPositions[next])
-        {
-            continue;
-        }
+                // V[j] has been ruled out as one of the original vertices of
+                // the triangle <V[prev],V[curr],V[next]>.  When
+                // triangulating polygons with holes, V[j] might be a
+                // duplicated vertex, in which case it does not affect the
+                // earness of V[curr].
+                int test = V(j).Index;
+                if (mSPositions[test] == P0
+                ||  mSPositions[test] == P1
+                ||  mSPositions[test] == P2)
+                {
+                    continue;
+                }
 
-        // Test if the vertex is inside or on the triangle.  When it is, it
-        // causes V[curr] not to be an ear.
-        if (mQuery->ToTriangle(test, prev, curr, next) <= 0)
-        {
-            vertex.IsEar = false;
-            break;
+                // Test if the vertex is inside or on the triangle.  When it
+                // is, it causes V[curr] not to be an ear.
+                if (mQuery->ToTriangle(test, prev, curr, next) <= 0)
+                {
+                    vertex.IsEar = false;
+                    return false;
+                }
+            }
         }
     }
 
-    return vertex.IsEar;
+    return true;
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -1003,6 +1190,95 @@ void TriangulateEC<Real>::RemoveR (int i)
 }
 //----------------------------------------------------------------------------
 
+//----------------------------------------------------------------------------
+// Grid support.
+//----------------------------------------------------------------------------
+template <typename Real>
+void TriangulateEC<Real>::CellGrid::Create (const Vector2<Real>& minimum,
+    const Vector2<Real>& maximum, int numItems)
+{
+    // The cells are nearly square, with about one item per cell.
+    if (numItems < 1)
+    {
+        numItems = 1;
+    }
+    Origin = minimum;
+    Vector2<Real> range = maximum - minimum;
+    Real area = range[0]*range[1];
+    Real cellSize;
+    if (area > (Real)0)
+    {
+        cellSize = Math<Real>::Sqrt(area/(Real)numItems);
+    }
+    else
+    {
+        cellSize = std::max(range[0], range[1])/(Real)numItems;
+    }
+
+    int num[2];
+    for (int j = 0; j < 2; ++j)
+    {
+        num[j] = 1;
+        InvCellSize[j] = (Real)0;
+        if (cellSize > (Real)0 && range[j] > (Real)0)
+        {
+            Real count = range[j]/cellSize;
+            num[j] = (count < (Real)numItems ? (int)count + 1 : numItems);
+            InvCellSize[j] = ((Real)num[j])/range[j];
+        }
+    }
+    NumX = num[0];
+    NumY = num[1];
+    Cells.clear();
+    Cells.resize(NumX*NumY);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int TriangulateEC<Real>::CellGrid::GetX (Real x) const
+{
+    Real t = (x - Origin[0])*InvCellSize[0];
+    if (t <= (Real)0)
+    {
+        return 0;
+    }
+    if (t >= (Real)NumX)
+    {
+        return NumX - 1;
+    }
+    return (int)t;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int TriangulateEC<Real>::CellGrid::GetY (Real y) const
+{
+    Real t = (y - Origin[1])*InvCellSize[1];
+    if (t <= (Real)0)
+    {
+        return 0;
+    }
+    if (t >= (Real)NumY)
+    {
+        return NumY - 1;
+    }
+    return (int)t;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void TriangulateEC<Real>::CellGrid::Insert (int item,
+    const Vector2<Real>& minimum, const Vector2<Real>& maximum)
+{
+    int x0 = GetX(minimum[0]), x1 = GetX(maximum[0]);
+    int y0 = GetY(minimum[1]), y1 = GetY(maximum[1]);
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            Cells[x + NumX*y].push_back(item);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+
 //----------------------------------------------------------------------------
 // Tree support.
 //----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5TRIANGULATEEC_H
 #define WM5TRIANGULATEEC_H
@@ -21,7 +21,14 @@ class WM5_MATHEMATICS_ITEM TriangulateEC
 {
 public:
     // This class implements triangulation of polygons using ear clipping.
-    // The method is O(n^2) for n input points.  There are five constructors.
+    // The method is O(n^2) for n input points in the worst case.  The
+    // reflex vertices are stored in a uniform grid, so the test whether a
+    // vertex is an ear visits only the reflex vertices near the triangle
+    // of the ear, and the search for the mutually visible vertices that
+    // connect an inner polygon to its outer polygon uses grids of the edges
+    // and vertices of the polygon, so for polygons whose vertices are
+    // distributed reasonably uniformly, such as those in geographic data,
+    // the time is nearly linear in n.  There are five constructors.
     // The query type and epsilon parameters are discussed later.  In all
     // cases, the output is
     //
@@ -203,13 +210,6 @@ private:
     int TriangleQuery (const Vector2<Real>& position, Query::Type queryType,
         Real epsilon, const Vector2<Real> triangle[3]) const;
 
-    // Given an outer polygon that contains an inner polygon, this function
-    // determines a pair of visible vertices and inserts two coincident edges
-    // to generate a nearly simple polygon.
-    void CombinePolygons (Query::Type queryType, Real epsilon,
-        int nextElement, const Indices& outer, const Indices& inner,
-        IndexMap& indexMap, Indices& combined);
-
     // Two extra elements are needed in the position array per outer-inners
     // polygon.  This function computes the total number of extra elements
     // needed for the input tree.  This number is passed to the function
@@ -218,9 +218,11 @@ private:
 
     // Given an outer polygon that contains a set of nonoverlapping inner
     // polygons, this function determines pairs of visible vertices and
-    // inserts coincident edges to generate a nearly simple polygon.  It
-    // repeatedly calls CombinePolygons for each inner polygon of the outer
-    // polygon.
+    // inserts coincident edges to generate a nearly simple polygon.  The
+    // inner polygons are processed in decreasing order of their maximum
+    // x-values.  For each inner polygon, the ray from the vertex M of
+    // maximum x-value in the direction (1,0) is intersected with the edges
+    // of the current combined polygon to find a vertex visible to M.
     void ProcessOuterAndInners (Query::Type queryType, Real epsilon,
         const Indices& outer, const IndicesArray& inners,
         int& nextElement, IndexMap& indexMap, Indices& combined);
@@ -231,6 +233,51 @@ private:
     // the duplicated vertices are converted to the original indices.
     void RemapIndices (const IndexMap& indexMap, Indices& triangles) const;
 
+    // A uniform grid of cells that store the indices of items, points or
+    // edges, whose bounding rectangles overlap the cells.  Points outside
+    // the grid are assigned to the nearest cells.
+    class CellGrid
+    {
+    public:
+        void Create (const Vector2<Real>& minimum,
+            const Vector2<Real>& maximum, int numItems);
+        int GetX (Real x) const;
+        int GetY (Real y) const;
+        void Insert (int item, const Vector2<Real>& minimum,
+            const Vector2<Real>& maximum);
+
+        Vector2<Real> Origin;
+        Real InvCellSize[2];
+        int NumX, NumY;
+        std::vector<std::vector<int> > Cells;
+    };
+
+    // The combined polygon that is built by ProcessOuterAndInners, a
+    // circular linked list of nodes.  Node k is the vertex
+    // mSPositions[Index[k]], and Next[k] is the following node.  The edge
+    // grid stores each edge as its first node; the point grid stores the
+    // nodes.
+    class CombinedPolygon
+    {
+    public:
+        std::vector<int> Index, Next, Prev, Stamp;
+        CellGrid Edges, Points;
+        int Head;
+    };
+
+    // Find the node of the combined polygon that is visible to the node M,
+    // the vertex of maximum x-value of an inner polygon.
+    int FindVisibleNode (Query::Type queryType, Real epsilon,
+        CombinedPolygon& polygon, int M, int stamp);
+
+    // Insert the edge starting at a node into the edge grid.
+    void InsertEdge (CombinedPolygon& polygon, int node);
+
+    // The amount by which bounding rectangles are enlarged for grid
+    // searches.  The integer queries round the positions, so a point
+    // within one unit of a triangle might be classified as on it.
+    Real GetGridPadding () const;
+
     // Doubly linked lists for storing specially tagged vertices.
     class Vertex
     {
@@ -262,8 +309,13 @@ private:
     int mRFirst, mRLast;  // linear list of reflex vertices
     int mEFirst, mELast;  // cyclical list of ears
 
+    // The grid of reflex vertices for the ear tests.  Vertices that become
+    // convex are not removed from the grid; the ear test skips them.
+    CellGrid mReflexGrid;
+
     // For robust determinant calculation.
     Query2<Real>* mQuery;
+    Query::Type mQueryType;
     std::vector<Vector2<Real> >mSPositions;
 };
 
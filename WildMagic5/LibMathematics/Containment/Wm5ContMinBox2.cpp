@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ContMinBox2.h"
@@ -18,11 +18,17 @@ template <typename Real>
 MinBox2<Real>::MinBox2 (int numPoints, const Vector2<Real>* points,
     Real epsilon, Query::Type queryType, bool isConvexPolygon)
 {
-    // Get the convex hull of the points.
+    // Get the convex hull of the points.  The vertices are copied so that
+    // coincident ones can be removed.
     Vector2<Real>* hullPoints = 0;
+    int i;
     if (isConvexPolygon)
     {
-        hullPoints = (Vector2<Real>*)points;
+        hullPoints = new1<Vector2<Real> >(numPoints);
+        for (i = 0; i < numPoints; ++i)
+        {
+            hullPoints[i] = points[i];
+        }
     }
     else
     {
@@ -62,12 +68,79 @@ MinBox2<Real>::MinBox2 (int numPoints, const Vector2<Real>* points,
 
         numPoints = hullNumSimplices;
         hullPoints = new1<Vector2<Real> >(numPoints);
-        for (int i = 0; i < numPoints; ++i)
+        for (i = 0; i < numPoints; ++i)
         {
             hullPoints[i] = points[hullIndices[i]];
         }
     }
-    
+
+    // Remove the vertices that coincide with their predecessors, which
+    // occur when distinct points are nearly equal.  The direction of an
+    // edge of zero length is the zero vector; it never attracts a caliper,
+    // so the caliper would stall at that vertex while the others rotate,
+    // and the box would no longer contain the polygon.  The tolerance is
+    // relative to the extent of the hull so that the test does not depend
+    // on the scale of the input.
+    Vector2<Real> vmin = hullPoints[0], vmax = vmin;
+    for (i = 1; i < numPoints; ++i)
+    {
+        for (int j = 0; j < 2; ++j)
+        {
+            if (hullPoints[i][j] < vmin[j])
+            {
+                vmin[j] = hullPoints[i][j];
+            }
+            else if (hullPoints[i][j] > vmax[j])
+            {
+                vmax[j] = hullPoints[i][j];
+            }
+        }
+    }
+    Real range = vmax[0] - vmin[0];
+    if (vmax[1] - vmin[1] > range)
+    {
+        range = vmax[1] - vmin[1];
+    }
+    Real tolerance = Math<Real>::ZERO_TOLERANCE*range;
+
+    int numUnique = 1;
+    for (i = 1; i < numPoints; ++i)
+    {
+        Vector2<Real> diff = hullPoints[i] - hullPoints[numUnique - 1];
+        if (diff.Length() > tolerance)
+        {
+            hullPoints[numUnique++] = hullPoints[i];
+        }
+    }
+    while (numUnique > 1)
+    {
+        Vector2<Real> diff = hullPoints[0] - hullPoints[numUnique - 1];
+        if (diff.Length() > tolerance)
+        {
+            break;
+        }
+        --numUnique;
+    }
+    numPoints = numUnique;
+
+    if (numPoints < 3)
+    {
+        // The polygon is degenerate, a point or a segment.
+        Vector2<Real> diff = hullPoints[numPoints - 1] - hullPoints[0];
+        mMinBox.Center = ((Real)0.5)*(hullPoints[0] +
+            hullPoints[numPoints - 1]);
+        mMinBox.Extent[0] = ((Real)0.5)*diff.Normalize();
+        mMinBox.Extent[1] = (Real)0;
+        if (mMinBox.Extent[0] == (Real)0)
+        {
+            diff = Vector2<Real>::UNIT_X;
+        }
+        mMinBox.Axis[0] = diff;
+        mMinBox.Axis[1] = -mMinBox.Axis[0].Perp();
+        delete1(hullPoints);
+        return;
+    }
+
     // The input points are V[0] through V[N-1] and are assumed to be the
     // vertices of a convex polygon that are counterclockwise ordered.  The
     // input points must not contain three consecutive collinear points.
@@ -77,7 +150,6 @@ MinBox2<Real>::MinBox2 (int numPoints, const Vector2<Real>* points,
     int numPointsM1 = numPoints -1;
     Vector2<Real>* edges = new1<Vector2<Real> >(numPoints);
     bool* visited = new1<bool>(numPoints);
-    int i;
     for (i = 0; i < numPointsM1; ++i)
     {
         edges[i] = hullPoints[i + 1] - hullPoints[i];
@@ -310,10 +382,7 @@ MinBox2<Real>::MinBox2 (int numPoints, const Vector2<Real>* points,
 
     delete1(visited);
     delete1(edges);
-    if (!isConvexPolygon)
-    {
-        delete1(hullPoints);
-    }
+    delete1(hullPoints);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ContMinBox3.h"
@@ -18,7 +18,8 @@ namespace Wm5
 //----------------------------------------------------------------------------
 template <typename Real>
 MinBox3<Real>::MinBox3 (int numPoints, const Vector3<Real>* points,
-    Real epsilon, Query::Type queryType)
+    Real epsilon, Query::Type queryType, ThreadPool* pool,
+    int maxHullVertices)
 {
     // Get the convex hull of the points.
     ConvexHull3<Real> kHull(numPoints,(Vector3<Real>*)points, epsilon, false,
@@ -57,7 +58,7 @@ MinBox3<Real>::MinBox3 (int numPoints, const Vector3<Real>* points,
         return;
     }
 
-    int i, j;
+    int i;
     Vector3<Real> origin, diff, U, V, W;
     Vector2<Real>* points2;
     Box2<Real> box2;
@@ -100,224 +101,485 @@ MinBox3<Real>::MinBox3 (int numPoints, const Vector3<Real>* points,
         return;
     }
 
-    int hullQuantity = kHull.GetNumSimplices();
-    const int* hullIndices = kHull.GetIndices();
-    Real volume, minVolume = Math<Real>::MAX_REAL;
+    // Copy the hull vertices to a contiguous array, so that the candidates
+    // project them in order.
+    std::vector<Vector3<Real> > vertices, allVertices;
+    std::vector<int> faces;
+    GetHullMesh(points, 3*kHull.GetNumSimplices(), kHull.GetIndices(),
+        vertices, faces);
 
-    // Create the unique set of hull vertices to minimize the time spent
-    // projecting vertices onto planes of the hull faces.
-    std::set<int> uniqueIndices;
-    for (i = 0; i < 3*hullQuantity; ++i)
+    if (maxHullVertices > 0 && (int)vertices.size() > maxHullVertices)
     {
-        uniqueIndices.insert(hullIndices[i]);
+        // Compute the orientation for the hull of a subset of the vertices.
+        // The box is enlarged to contain all vertices at the end.
+        std::vector<Vector3<Real> > selected = vertices;
+        SelectExtremeVertices(maxHullVertices, selected);
+        ConvexHull3<Real> reduced((int)selected.size(), &selected[0],
+            epsilon, false, queryType);
+        if (reduced.GetDimension() == 3)
+        {
+            allVertices.swap(vertices);
+            GetHullMesh(&selected[0], 3*reduced.GetNumSimplices(),
+                reduced.GetIndices(), vertices, faces);
+        }
     }
 
-    // Use the rotating calipers method on the projection of the hull onto
-    // the plane of each face.  Also project the hull onto the normal line
-    // of each face.  The minimum area box in the plane and the height on
-    // the line produce a containing box.  If its volume is smaller than the
-    // current volume, this box is the new candidate for the minimum volume
-    // box.  The unique edges are accumulated into a set for use by a later
-    // step in the algorithm.
-    const int* currentHullIndex = hullIndices;
-    Real height, minHeight, maxHeight;
-    std::set<EdgeKey> edges;
-    points2 = new1<Vector2<Real> >(uniqueIndices.size());
-    for (i = 0; i < hullQuantity; ++i)
+    // The candidates are the orientations with a box face containing a
+    // hull face and those with box edges parallel to three mutually
+    // orthogonal hull edges.
+    std::vector<Vector3<Real> > axes;
+    FindOrthogonalEdges(vertices, faces, axes);
+
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+    Candidate* best = new1<Candidate>(numWorkers);
+    for (i = 0; i < numWorkers; ++i)
     {
-        // Get the triangle.
-        int v0 = *currentHullIndex++;
-        int v1 = *currentHullIndex++;
-        int v2 = *currentHullIndex++;
-
-        // Save the edges for later use.
-        edges.insert(EdgeKey(v0, v1));
-        edges.insert(EdgeKey(v1, v2));
-        edges.insert(EdgeKey(v2, v0));
-
-        // Get 3D coordinate system relative to plane of triangle.
-        origin = (points[v0] + points[v1] + points[v2])/(Real)3.0;
-        Vector3<Real> edge1 = points[v1] - points[v0];
-        Vector3<Real> edge2 = points[v2] - points[v0];
-        W = edge2.UnitCross(edge1);  // inner-pointing normal
-        if (W == Vector3<Real>::ZERO)
+        best[i].Volume = Math<Real>::MAX_REAL;
+        best[i].Index = -1;
+    }
+
+    EvaluateTaskData data;
+    data.Vertices = &vertices[0];
+    data.AllVertices = (allVertices.size() > 0 ? &allVertices[0] : 0);
+    data.NumAllVertices = (int)allVertices.size();
+    data.Faces = &faces[0];
+    data.Axes = (axes.size() > 0 ? &axes[0] : 0);
+    data.NumVertices = (int)vertices.size();
+    data.NumFaces = (int)faces.size()/3;
+    data.Epsilon = epsilon;
+    data.QueryType = queryType;
+    data.Best = best;
+    ThreadPool::ParallelFor(pool, data.NumFaces + (int)axes.size()/3, 0,
+        EvaluateTask, &data);
+
+    int found = -1;
+    for (i = 0; i < numWorkers; ++i)
+    {
+        if (best[i].Index >= 0 && (found < 0
+        ||  best[i].Volume < best[found].Volume
+        ||  (best[i].Volume == best[found].Volume
+        &&   best[i].Index < best[found].Index)))
         {
-            // The triangle is needle-like, so skip it.
-            continue;
+            found = i;
         }
-        Vector3<Real>::GenerateComplementBasis(U, V, W);
+    }
+
+    if (found >= 0)
+    {
+        mMinBox = best[found].Box;
+    }
+    else
+    {
+        // All hull faces are needle-like and no orthogonal edges exist.
+        mMinBox.Axis[0] = Vector3<Real>::UNIT_X;
+        mMinBox.Axis[1] = Vector3<Real>::UNIT_Y;
+        mMinBox.Axis[2] = Vector3<Real>::UNIT_Z;
+        FitExtents(mMinBox, (int)vertices.size(), &vertices[0]);
+    }
+    delete1(best);
 
-        // Project points onto plane of triangle, onto normal line of plane.
-        // TO DO.  In theory, minHeight should be zero since W points to the
-        // interior of the hull.  However, the snap rounding used in the 3D
-        // convex hull finder involves loss of precision, which in turn can
-        // cause a hull facet to have the wrong ordering (clockwise instead
-        // of counterclockwise when viewed from outside the hull).  The
-        // height calculations here trap that problem (the incorrectly ordered
-        // face will not affect the minimum volume box calculations).
-        minHeight = (Real)0;
-        maxHeight = (Real)0;
-        j = 0;
-        std::set<int>::const_iterator iter = uniqueIndices.begin();
-        while (iter != uniqueIndices.end())
+    if (found < 0 && allVertices.size() > 0)
+    {
+        FitExtents(mMinBox, (int)allVertices.size(), &allVertices[0]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+MinBox3<Real>::operator Box3<Real> () const
+{
+    return mMinBox;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void MinBox3<Real>::GetHullMesh (const Vector3<Real>* points,
+    int numIndices, const int* indices, std::vector<Vector3<Real> >&
+    vertices, std::vector<int>& faces)
+{
+    std::vector<int> unique(indices, indices + numIndices);
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    vertices.resize(unique.size());
+    int i;
+    for (i = 0; i < (int)unique.size(); ++i)
+    {
+        vertices[i] = points[unique[i]];
+    }
+
+    faces.resize(numIndices);
+    for (i = 0; i < numIndices; ++i)
+    {
+        faces[i] = (int)(std::lower_bound(unique.begin(), unique.end(),
+            indices[i]) - unique.begin());
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void MinBox3<Real>::SelectExtremeVertices (int maxHullVertices,
+    std::vector<Vector3<Real> >& vertices)
+{
+    // The directions are on a Fibonacci spiral, which distributes them
+    // nearly uniformly on the sphere.
+    const int numDirections = maxHullVertices/2;
+    const int numVertices = (int)vertices.size();
+    const Real angle = Math<Real>::PI*((Real)3 - Math<Real>::Sqrt((Real)5));
+    std::vector<int> selected;
+    selected.reserve(2*numDirections);
+    int i;
+    for (int k = 0; k < numDirections; ++k)
+    {
+        Real z = (Real)1 - ((Real)(2*k + 1))/(Real)numDirections;
+        Real r = Math<Real>::Sqrt(Math<Real>::FAbs((Real)1 - z*z));
+        Vector3<Real> direction(r*Math<Real>::Cos(angle*k),
+            r*Math<Real>::Sin(angle*k), z);
+
+        int iMin = 0, iMax = 0;
+        Real dMin = direction.Dot(vertices[0]), dMax = dMin;
+        for (i = 1; i < numVertices; ++i)
         {
-            int index = *iter++;
-            diff = points[index] - origin;
-            points2[j].X() = U.Dot(diff);
-            points2[j].Y() = V.Dot(diff);
-            height = W.Dot(diff);
-            if (height > maxHeight)
+            Real d = direction.Dot(vertices[i]);
+            if (d < dMin)
             {
-                maxHeight = height;
+                dMin = d;
+                iMin = i;
             }
-            else if (height < minHeight)
+            else if (d > dMax)
             {
-                minHeight = height;
+                dMax = d;
+                iMax = i;
             }
-
-            j++;
-        }
-        if (-minHeight > maxHeight)
-        {
-            maxHeight = -minHeight;
         }
+        selected.push_back(iMin);
+        selected.push_back(iMax);
+    }
 
-        // Compute minimum area box in 2D.
-        box2 = MinBox2<Real>((int)uniqueIndices.size(), points2, epsilon,
-            queryType, false);
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()),
+        selected.end());
 
-        // Update current minimum-volume box (if necessary).
-        volume = maxHeight*box2.Extent[0]*box2.Extent[1];
-        if (volume < minVolume)
-        {
-            minVolume = volume;
+    std::vector<Vector3<Real> > subset(selected.size());
+    for (i = 0; i < (int)selected.size(); ++i)
+    {
+        subset[i] = vertices[selected[i]];
+    }
+    vertices.swap(subset);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void MinBox3<Real>::FindOrthogonalEdges (const std::vector<Vector3<Real> >&
+    vertices, const std::vector<int>& faces,
+    std::vector<Vector3<Real> >& axes)
+{
+    // The unique edges of the hull.
+    std::set<EdgeKey> edges;
+    const int numIndices = (int)faces.size();
+    int i;
+    for (i = 0; i < numIndices; i += 3)
+    {
+        edges.insert(EdgeKey(faces[i], faces[i + 1]));
+        edges.insert(EdgeKey(faces[i + 1], faces[i + 2]));
+        edges.insert(EdgeKey(faces[i + 2], faces[i]));
+    }
 
-            // Lift the values into 3D.
-            mMinBox.Extent[0] = box2.Extent[0];
-            mMinBox.Extent[1] = box2.Extent[1];
-            mMinBox.Extent[2] = ((Real)0.5)*maxHeight;
-            mMinBox.Axis[0] = box2.Axis[0].X()*U + box2.Axis[0].Y()*V;
-            mMinBox.Axis[1] = box2.Axis[1].X()*U + box2.Axis[1].Y()*V;
-            mMinBox.Axis[2] = W;
-            mMinBox.Center = origin + box2.Center.X()*U + box2.Center.Y()*V
-                + mMinBox.Extent[2]*W;
+    // The unit-length edge directions.  Parallel edges of equal direction
+    // produce the same boxes, so only the first edge of each direction is
+    // kept; the directions are sorted to find the duplicates.
+    const int numEdges = (int)edges.size();
+    std::vector<Vector3<Real> > directions(numEdges);
+    std::vector<std::pair<std::pair<Real,Real>,std::pair<Real,int> > >
+        sorted(numEdges);
+    std::set<EdgeKey>::const_iterator iter = edges.begin();
+    for (i = 0; i < numEdges; ++i, ++iter)
+    {
+        Vector3<Real>& D = directions[i];
+        D = vertices[iter->V[1]] - vertices[iter->V[0]];
+        D.Normalize();
+        sorted[i] = std::make_pair(std::make_pair(D.X(), D.Y()),
+            std::make_pair(D.Z(), i));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<int> kept;
+    for (i = 0; i < numEdges; ++i)
+    {
+        if (i == 0 || sorted[i].first != sorted[i - 1].first
+        ||  sorted[i].second.first != sorted[i - 1].second.first)
+        {
+            kept.push_back(sorted[i].second.second);
         }
     }
+    std::sort(kept.begin(), kept.end());
+    const int numDirections = (int)kept.size();
+    for (i = 0; i < numDirections; ++i)
+    {
+        directions[i] = directions[kept[i]];
+    }
 
-    // The minimum-volume box can also be supported by three mutually
-    // orthogonal edges of the convex hull.  For each triple of orthogonal
-    // edges, compute the minimum-volume box for that coordinate frame by
-    // projecting the points onto the axes of the frame.
-    std::set<EdgeKey>::const_iterator e2iter;
-    for (e2iter = edges.begin(); e2iter != edges.end(); e2iter++)
+    // The directions U orthogonal to both W and V are within a small angle
+    // of W.Cross(V) or of its negation.  The directions and their negations
+    // are sorted by their component along a generic axis G, and those with
+    // components near that of W.Cross(V) are found by binary search.  Entry
+    // 2*d is direction d and entry 2*d+1 is its negation.
+    const Vector3<Real> G((Real)0.309016994, (Real)0.5, (Real)0.809016994);
+    std::vector<std::pair<Real,int> > keys(2*numDirections);
+    for (i = 0; i < numDirections; ++i)
     {
-        W = points[e2iter->V[1]] - points[e2iter->V[0]];
-        W.Normalize();
+        Real key = G.Dot(directions[i]);
+        keys[2*i] = std::make_pair(key, 2*i);
+        keys[2*i + 1] = std::make_pair(-key, 2*i + 1);
+    }
+    std::sort(keys.begin(), keys.end());
 
-        std::set<EdgeKey>::const_iterator e1iter = e2iter;
-        for (++e1iter; e1iter != edges.end(); e1iter++)
+    // The triples are enumerated with W before V before U in the order of
+    // the edges, so each set of three directions occurs once.
+    const Real tolerance = Math<Real>::ZERO_TOLERANCE;
+    const Real window = ((Real)4)*tolerance;
+    for (int w = 0; w < numDirections; ++w)
+    {
+        const Vector3<Real>& W = directions[w];
+        for (int v = w + 1; v < numDirections; ++v)
         {
-            V = points[e1iter->V[1]] - points[e1iter->V[0]];
-            V.Normalize();
-            Real dot = V.Dot(W);
-            if (Math<Real>::FAbs(dot) > Math<Real>::ZERO_TOLERANCE)
+            const Vector3<Real>& V = directions[v];
+            if (Math<Real>::FAbs(V.Dot(W)) > tolerance)
             {
                 continue;
             }
 
-            std::set<EdgeKey>::const_iterator e0iter = e1iter;
-            for (++e0iter; e0iter != edges.end(); e0iter++)
+            const Vector3<Real> normal = W.Cross(V);
+            const Real key = G.Dot(normal);
+            typename std::vector<std::pair<Real,int> >::const_iterator
+                entry = std::lower_bound(keys.begin(), keys.end(),
+                std::make_pair(key - window, -1));
+            for (/**/; entry != keys.end() && entry->first <= key + window;
+                ++entry)
             {
-                U = points[e0iter->V[1]] - points[e0iter->V[0]];
-                U.Normalize();
-                dot = U.Dot(V);
-                if (Math<Real>::FAbs(dot) > Math<Real>::ZERO_TOLERANCE)
+                const int u = entry->second/2;
+                if (u <= v)
                 {
                     continue;
                 }
-                dot = U.Dot(W);
-                if (Math<Real>::FAbs(dot) > Math<Real>::ZERO_TOLERANCE)
+
+                // Only the entry with the sign of the normal is used, so the
+                // triple is not stored twice when the key is near zero.
+                const Vector3<Real>& U = directions[u];
+                Real dot = U.Dot(normal);
+                if ((entry->second & 1) ? dot >= (Real)0 : dot < (Real)0)
                 {
                     continue;
                 }
-    
-                // The three edges are mutually orthogonal.  Project the
-                // hull points onto the lines containing the edges.  Use
-                // hull point zero as the origin.
-                Real umin = (Real)0, umax = (Real)0;
-                Real vmin = (Real)0, vmax = (Real)0;
-                Real wmin = (Real)0, wmax = (Real)0;
-                origin = points[hullIndices[0]];
-
-                std::set<int>::const_iterator iter = uniqueIndices.begin();
-                while (iter != uniqueIndices.end())
-                {
-                    int index = *iter++;
-                    diff = points[index] - origin;
-
-                    Real fU = U.Dot(diff);
-                    if (fU < umin)
-                    {
-                        umin = fU;
-                    }
-                    else if (fU > umax)
-                    {
-                        umax = fU;
-                    }
-
-                    Real fV = V.Dot(diff);
-                    if (fV < vmin)
-                    {
-                        vmin = fV;
-                    }
-                    else if (fV > vmax)
-                    {
-                        vmax = fV;
-                    }
-
-                    Real fW = W.Dot(diff);
-                    if (fW < wmin)
-                    {
-                        wmin = fW;
-                    }
-                    else if (fW > wmax)
-                    {
-                        wmax = fW;
-                    }
-                }
-
-                Real uExtent = ((Real)0.5)*(umax - umin);
-                Real vExtent = ((Real)0.5)*(vmax - vmin);
-                Real wExtent = ((Real)0.5)*(wmax - wmin);
 
-                // Update current minimum-volume box (if necessary).
-                volume = uExtent*vExtent*wExtent;
-                if (volume < minVolume)
+                if (Math<Real>::FAbs(U.Dot(V)) <= tolerance
+                &&  Math<Real>::FAbs(U.Dot(W)) <= tolerance)
                 {
-                    minVolume = volume;
-
-                    mMinBox.Extent[0] = uExtent;
-                    mMinBox.Extent[1] = vExtent;
-                    mMinBox.Extent[2] = wExtent;
-                    mMinBox.Axis[0] = U;
-                    mMinBox.Axis[1] = V;
-                    mMinBox.Axis[2] = W;
-                    mMinBox.Center = origin +
-                        ((Real)0.5)*(umin+umax)*U +
-                        ((Real)0.5)*(vmin+vmax)*V +
-                        ((Real)0.5)*(wmin+wmax)*W;
+                    axes.push_back(U);
+                    axes.push_back(V);
+                    axes.push_back(W);
                 }
             }
         }
     }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void MinBox3<Real>::FitExtents (Box3<Real>& box, int numVertices,
+    const Vector3<Real>* vertices)
+{
+    Real minimum[3], maximum[3];
+    int i, j;
+    for (j = 0; j < 3; ++j)
+    {
+        minimum[j] = box.Axis[j].Dot(vertices[0]);
+        maximum[j] = minimum[j];
+    }
 
-    delete1(points2);
+    for (i = 1; i < numVertices; ++i)
+    {
+        for (j = 0; j < 3; ++j)
+        {
+            Real d = box.Axis[j].Dot(vertices[i]);
+            if (d < minimum[j])
+            {
+                minimum[j] = d;
+            }
+            else if (d > maximum[j])
+            {
+                maximum[j] = d;
+            }
+        }
+    }
+
+    box.Center = Vector3<Real>::ZERO;
+    for (j = 0; j < 3; ++j)
+    {
+        box.Center += ((Real)0.5)*(minimum[j] + maximum[j])*
+            box.Axis[j];
+        box.Extent[j] = ((Real)0.5)*(maximum[j] - minimum[j]);
+    }
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-MinBox3<Real>::operator Box3<Real> () const
+void MinBox3<Real>::EvaluateTask (int begin, int end, int worker,
+    void* userData)
 {
-    return mMinBox;
+    const EvaluateTaskData& data = *(const EvaluateTaskData*)userData;
+    const Vector3<Real>* vertices = data.Vertices;
+    const int numVertices = data.NumVertices;
+    Candidate& best = data.Best[worker];
+
+    Vector2<Real>* points2 = 0;
+    if (begin < data.NumFaces)
+    {
+        points2 = new1<Vector2<Real> >(numVertices);
+    }
+
+    Vector3<Real> origin, diff, U, V, W;
+    Box3<Real> box;
+    Real volume;
+    int i;
+    for (int item = begin; item < end; ++item)
+    {
+        if (item < data.NumFaces)
+        {
+            // Get the triangle.
+            const int* face = &data.Faces[3*item];
+            const Vector3<Real>& P0 = vertices[face[0]];
+            const Vector3<Real>& P1 = vertices[face[1]];
+            const Vector3<Real>& P2 = vertices[face[2]];
+
+            // Get 3D coordinate system relative to plane of triangle.
+            origin = (P0 + P1 + P2)/(Real)3.0;
+            Vector3<Real> edge1 = P1 - P0;
+            Vector3<Real> edge2 = P2 - P0;
+            W = edge2.UnitCross(edge1);  // inner-pointing normal
+            if (W == Vector3<Real>::ZERO)
+            {
+                // The triangle is needle-like, so skip it.
+                continue;
+            }
+            Vector3<Real>::GenerateComplementBasis(U, V, W);
+
+            // Project points onto plane of triangle, onto normal line of
+            // plane.  In theory, minHeight should be zero since W points to
+            // the interior of the hull.  However, the snap rounding used in
+            // the 3D convex hull finder involves loss of precision, which in
+            // turn can cause a hull facet to have the wrong ordering
+            // (clockwise instead of counterclockwise when viewed from
+            // outside the hull).  The height calculations here trap that
+            // problem (the incorrectly ordered face will not affect the
+            // minimum volume box calculations).
+            Real minHeight = (Real)0, maxHeight = (Real)0;
+            for (i = 0; i < numVertices; ++i)
+            {
+                diff = vertices[i] - origin;
+                points2[i].X() = U.Dot(diff);
+                points2[i].Y() = V.Dot(diff);
+                Real height = W.Dot(diff);
+                if (height > maxHeight)
+                {
+                    maxHeight = height;
+                }
+                else if (height < minHeight)
+                {
+                    minHeight = height;
+                }
+            }
+            if (-minHeight > maxHeight)
+            {
+                maxHeight = -minHeight;
+            }
+
+            // Compute minimum area box in 2D.
+            Box2<Real> box2 = MinBox2<Real>(numVertices, points2,
+                data.Epsilon, data.QueryType, false);
+
+            // Lift the values into 3D.
+            box.Extent[0] = box2.Extent[0];
+            box.Extent[1] = box2.Extent[1];
+            box.Extent[2] = ((Real)0.5)*maxHeight;
+            box.Axis[0] = box2.Axis[0].X()*U + box2.Axis[0].Y()*V;
+            box.Axis[1] = box2.Axis[1].X()*U + box2.Axis[1].Y()*V;
+            box.Axis[2] = W;
+            box.Center = origin + box2.Center.X()*U + box2.Center.Y()*V
+                + box.Extent[2]*W;
+        }
+        else
+        {
+            // The three edges are mutually orthogonal.  Project the hull
+            // points onto the lines containing the edges.  Use the first
+            // vertex of the first hull face as the origin.
+            const Vector3<Real>* axes = &data.Axes[3*(item - data.NumFaces)];
+            U = axes[0];
+            V = axes[1];
+            W = axes[2];
+            Real umin = (Real)0, umax = (Real)0;
+            Real vmin = (Real)0, vmax = (Real)0;
+            Real wmin = (Real)0, wmax = (Real)0;
+            origin = vertices[data.Faces[0]];
+
+            for (i = 0; i < numVertices; ++i)
+            {
+                diff = vertices[i] - origin;
+
+                Real fU = U.Dot(diff);
+                if (fU < umin)
+                {
+                    umin = fU;
+                }
+                else if (fU > umax)
+                {
+                    umax = fU;
+                }
+
+                Real fV = V.Dot(diff);
+                if (fV < vmin)
+                {
+                    vmin = fV;
+                }
+                else if (fV > vmax)
+                {
+                    vmax = fV;
+                }
+
+                Real fW = W.Dot(diff);
+                if (fW < wmin)
+                {
+                    wmin = fW;
+                }
+                else if (fW > wmax)
+                {
+                    wmax = fW;
+                }
+            }
+
+            box.Extent[0] = ((Real)0.5)*(umax - umin);
+            box.Extent[1] = ((Real)0.5)*(vmax - vmin);
+            box.Extent[2] = ((Real)0.5)*(wmax - wmin);
+            box.Axis[0] = U;
+            box.Axis[1] = V;
+            box.Axis[2] = W;
+            box.Center = origin +
+                ((Real)0.5)*(umin+umax)*U +
+                ((Real)0.5)*(vmin+vmax)*V +
+                ((Real)0.5)*(wmin+wmax)*W;
+        }
+
+        if (data.AllVertices)
+        {
+            FitExtents(box, data.NumAllVertices, data.AllVertices);
+        }
+
+        // Update current minimum-volume box (if necessary).
+        volume = box.Extent[0]*box.Extent[1]*box.Extent[2];
+        if (volume < best.Volume
+        ||  (volume == best.Volume && item < best.Index))
+        {
+            best.Box = box;
+            best.Volume = volume;
+            best.Index = item;
+        }
+    }
+
+    delete1(points2);
 }
 //----------------------------------------------------------------------------
 
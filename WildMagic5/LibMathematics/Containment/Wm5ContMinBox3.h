@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5MINVOLUMEBOX3_H
 #define WM5MINVOLUMEBOX3_H
@@ -12,10 +12,23 @@
 #include "Wm5MathematicsLIB.h"
 #include "Wm5Box3.h"
 #include "Wm5Query.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
 // Compute a minimum volume oriented box containing the specified points.
+// The candidate orientations are those with a box face containing a face of
+// the convex hull and those with box edges parallel to three mutually
+// orthogonal edges of the hull.  The candidates are independent, so they
+// are distributed to the threads of 'pool' when it is not null.
+//
+// The number of candidates grows with the size of the hull.  When
+// 'maxHullVertices' is positive and the hull has more vertices, the hull is
+// replaced by the hull of at most maxHullVertices of its vertices, those
+// extreme in a set of uniformly distributed directions.  The orientations
+// are computed for the smaller hull, and each candidate box is enlarged to
+// contain all the points before the volumes are compared, so the box
+// contains the points but is not necessarily of minimum volume.
 //
 // This is a function class.  Use it as follows:
 //   Box3<Real> minBox = MinBox3(numPoints, points, epsilon, queryType);
@@ -25,11 +38,63 @@ class WM5_MATHEMATICS_ITEM MinBox3
 {
 public:
     MinBox3 (int numPoints, const Vector3<Real>* points, Real epsilon,
-        Query::Type queryType);
+        Query::Type queryType, ThreadPool* pool = 0,
+        int maxHullVertices = 0);
 
     operator Box3<Real> () const;
 
 private:
+    // The hull vertices, in increasing order of their indices into
+    // 'points', and the triangles of the hull as triples of indices into
+    // 'vertices'.
+    static void GetHullMesh (const Vector3<Real>* points, int numIndices,
+        const int* indices, std::vector<Vector3<Real> >& vertices,
+        std::vector<int>& faces);
+
+    // Select at most maxHullVertices of the vertices, those extreme in
+    // maxHullVertices/2 directions.
+    static void SelectExtremeVertices (int maxHullVertices,
+        std::vector<Vector3<Real> >& vertices);
+
+    // The axes of the orientations with box edges parallel to three
+    // mutually orthogonal hull edges, stored as triples (U,V,W).
+    static void FindOrthogonalEdges (const std::vector<Vector3<Real> >&
+        vertices, const std::vector<int>& faces,
+        std::vector<Vector3<Real> >& axes);
+
+    // Compute the center and extents of a box for its axes so that the box
+    // contains the vertices.
+    static void FitExtents (Box3<Real>& box, int numVertices,
+        const Vector3<Real>* vertices);
+
+    // Support for the parallel evaluation of the candidates.  The task
+    // items are the faces followed by the axis triples.  Each worker keeps
+    // its best candidate; ties are resolved by the smaller item index, so
+    // the result does not depend on the number of threads.
+    class Candidate
+    {
+    public:
+        Box3<Real> Box;
+        Real Volume;
+        int Index;
+    };
+
+    class EvaluateTaskData
+    {
+    public:
+        const Vector3<Real>* Vertices;
+        const Vector3<Real>* AllVertices;  // null unless the hull is reduced
+        const int* Faces;
+        const Vector3<Real>* Axes;
+        int NumVertices, NumAllVertices, NumFaces;
+        Real Epsilon;
+        Query::Type QueryType;
+        Candidate* Best;
+    };
+
+    static void EvaluateTask (int begin, int end, int worker,
+        void* userData);
+
     Box3<Real> mMinBox;
 };
 
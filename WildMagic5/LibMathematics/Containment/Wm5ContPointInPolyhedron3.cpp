@@ -4,13 +4,15 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ContPointInPolyhedron3.h"
 #include "Wm5ContPointInPolygon2.h"
 #include "Wm5IntrRay3Plane3.h"
 #include "Wm5IntrRay3Triangle3.h"
+#include "Wm5Query2Rational.h"
+#include "Wm5Query3Rational.h"
 
 namespace Wm5
 {
@@ -28,11 +30,35 @@ PointInPolyhedron3<Real>::PointInPolyhedron3 (int numPoints,
     mSFaces(0),
     mMethod(0),
     mNumRays(numRays),
-    mDirections(directions)
+    mDirections(directions),
+    mQueryType(Query::QT_REAL)
 {
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+PointInPolyhedron3<Real>::PointInPolyhedron3 (int numPoints,
+    const Vector3<Real>* points, int numFaces, const TriangleFace* faces,
+    Query::Type queryType)
+    :
+    mNumPoints(numPoints),
+    mPoints(points),
+    mNumFaces(numFaces),
+    mTFaces(faces),
+    mCFaces(0),
+    mSFaces(0),
+    mMethod(1),
+    mNumRays(0),
+    mDirections(0),
+    mQueryType(queryType)
+{
+    assertion(queryType == Query::QT_REAL
+        || queryType == Query::QT_RATIONAL
+        || queryType == Query::QT_FILTERED, "Unsupported query type\n");
+
+    BuildHierarchy();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 PointInPolyhedron3<Real>::PointInPolyhedron3 (int numPoints,
     const Vector3<Real>* points, int numFaces, const ConvexFace* faces,
     int numRays, const Vector3<Real>* directions, unsigned int method)
@@ -45,7 +71,8 @@ PointInPolyhedron3<Real>::PointInPolyhedron3 (int numPoints,
     mSFaces(0),
     mMethod(method),
     mNumRays(numRays),
-    mDirections(directions)
+    mDirections(directions),
+    mQueryType(Query::QT_REAL)
 {
 }
 //----------------------------------------------------------------------------
@@ -62,7 +89,8 @@ PointInPolyhedron3<Real>::PointInPolyhedron3 (int numPoints,
     mSFaces(faces),
     mMethod(method),
     mNumRays(numRays),
-    mDirections(directions)
+    mDirections(directions),
+    mQueryType(Query::QT_REAL)
 {
 }
 //----------------------------------------------------------------------------
@@ -71,7 +99,12 @@ bool PointInPolyhedron3<Real>::Contains (const Vector3<Real>& p) const
 {
     if (mTFaces)
     {
-        return ContainsT0(p);
+        if (mMethod == 0)
+        {
+            return ContainsT0(p);
+        }
+
+        return ContainsT1(p);
     }
 
     if (mCFaces)
@@ -101,6 +134,23 @@ bool PointInPolyhedron3<Real>::Contains (const Vector3<Real>& p) const
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void PointInPolyhedron3<Real>::Contains (int numQueries,
+    const Vector3<Real>* queries, bool* results, ThreadPool* pool) const
+{
+    if ((mCFaces && mMethod != 0) || (mSFaces && mMethod == 1))
+    {
+        // The queries share mProjVertices.
+        pool = 0;
+    }
+
+    ContainsTaskData data;
+    data.Object = this;
+    data.Queries = queries;
+    data.Results = results;
+    ThreadPool::ParallelFor(pool, numQueries, 0, ContainsTask, &data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 bool PointInPolyhedron3<Real>::FastNoIntersect (const Ray3<Real>& ray,
     const Plane3<Real>& plane)
 {
@@ -465,6 +515,354 @@ bool PointInPolyhedron3<Real>::ContainsS1 (const Vector3<Real>& p) const
     return insideCount > mNumRays/2;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+bool PointInPolyhedron3<Real>::ContainsT1 (const Vector3<Real>& p) const
+{
+    if (mNodes.size() == 0)
+    {
+        return false;
+    }
+
+    // The ray is p+t*(1,0,0) for t >= 0.  A node is visited when its box
+    // contains (y,z) of p in projection and extends to x >= p.X().  The
+    // comparisons are inclusive, because the perturbed point is
+    // infinitesimally close to p.
+    const BVHNode* nodes = &mNodes[0];
+    const Vector3<Real>* triangles = &mTriangles[0];
+    int stack[BVH_MAX_DEPTH];
+    int top = 0;
+    stack[0] = 0;
+    bool odd = false;
+    while (top >= 0)
+    {
+        int current = stack[top--];
+        const BVHNode& node = nodes[current];
+        if (node.Max.X() < p.X()
+        ||  node.Min.Y() > p.Y() || node.Max.Y() < p.Y()
+        ||  node.Min.Z() > p.Z() || node.Max.Z() < p.Z())
+        {
+            continue;
+        }
+
+        if (node.Count == 0)
+        {
+            stack[++top] = node.First;
+            stack[++top] = current + 1;
+            continue;
+        }
+
+        const Vector3<Real>* vertex = &triangles[3*node.First];
+        for (int i = 0; i < node.Count; ++i, vertex += 3)
+        {
+            // The perturbed point is inside the projected triangle when it
+            // is strictly left of each counterclockwise edge.  When p is on
+            // the line of an edge, the sign is that of the first nonzero
+            // term of the perturbation, -(v1-v0).Z()*e + (v1-v0).Y()*e^2.
+            int j0, j1;
+            for (j0 = 2, j1 = 0; j1 < 3; j0 = j1++)
+            {
+                const Vector3<Real>& V0 = vertex[j0];
+                const Vector3<Real>& V1 = vertex[j1];
+                int sign = OrientYZ(V0, V1, p, mQueryType);
+                if (sign == 0)
+                {
+                    if (V1.Z() != V0.Z())
+                    {
+                        sign = (V1.Z() < V0.Z() ? +1 : -1);
+                    }
+                    else
+                    {
+                        sign = (V1.Y() > V0.Y() ? +1 : -1);
+                    }
+                }
+                if (sign < 0)
+                {
+                    break;
+                }
+            }
+            if (j1 < 3)
+            {
+                continue;
+            }
+
+            // The projected triangle is counterclockwise, so the normal
+            // Cross(V1-V0,V2-V0) has a positive x-component, and the ray
+            // crosses the plane of the triangle at x > p.X() exactly when p
+            // is on the negative side of the plane.
+            int sign = Orient(vertex[0], vertex[1], vertex[2], p,
+                mQueryType);
+            if (sign == 0)
+            {
+                // The point is on the boundary.
+                return true;
+            }
+            if (sign < 0)
+            {
+                odd = !odd;
+            }
+        }
+    }
+
+    return odd;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PointInPolyhedron3<Real>::BuildHierarchy ()
+{
+    // Keep the triangles whose projections onto the yz-plane are not
+    // degenerate, ordered so that the projections are counterclockwise.
+    std::vector<Vector3<Real> > vertices;
+    std::vector<Vector3<Real> > centroids;
+    vertices.reserve(3*mNumFaces);
+    centroids.reserve(mNumFaces);
+    int i;
+    for (i = 0; i < mNumFaces; ++i)
+    {
+        const int* indices = mTFaces[i].Indices;
+        const Vector3<Real>& V0 = mPoints[indices[0]];
+        const Vector3<Real>& V1 = mPoints[indices[1]];
+        const Vector3<Real>& V2 = mPoints[indices[2]];
+        int sign = OrientYZ(V0, V1, V2, mQueryType);
+        if (sign == 0)
+        {
+            continue;
+        }
+
+        vertices.push_back(V0);
+        vertices.push_back(sign > 0 ? V1 : V2);
+        vertices.push_back(sign > 0 ? V2 : V1);
+        centroids.push_back((V0 + V1 + V2)/(Real)3);
+    }
+
+    const int numTriangles = (int)centroids.size();
+    if (numTriangles == 0)
+    {
+        return;
+    }
+
+    std::vector<int> triangles(numTriangles);
+    for (i = 0; i < numTriangles; ++i)
+    {
+        triangles[i] = i;
+    }
+    mNodes.reserve(2*numTriangles/BVH_LEAF_SIZE + 1);
+    mTriangles.resize(3*numTriangles);
+    BuildNode(0, numTriangles, triangles, centroids);
+
+    // Store the vertices in the order of the leaves.
+    for (i = 0; i < numTriangles; ++i)
+    {
+        const Vector3<Real>* vertex = &vertices[3*triangles[i]];
+        mTriangles[3*i] = vertex[0];
+        mTriangles[3*i + 1] = vertex[1];
+        mTriangles[3*i + 2] = vertex[2];
+    }
+
+    // The boxes of the nodes, computed from the leaves up.  The children of
+    // a node follow it in the array.
+    for (i = (int)mNodes.size() - 1; i >= 0; --i)
+    {
+        BVHNode& node = mNodes[i];
+        if (node.Count > 0)
+        {
+            const Vector3<Real>* vertex = &mTriangles[3*node.First];
+            node.Min = vertex[0];
+            node.Max = vertex[0];
+            for (int j = 1; j < 3*node.Count; ++j)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (vertex[j][k] < node.Min[k])
+                    {
+                        node.Min[k] = vertex[j][k];
+                    }
+                    else if (vertex[j][k] > node.Max[k])
+                    {
+                        node.Max[k] = vertex[j][k];
+                    }
+                }
+            }
+        }
+        else
+        {
+            const BVHNode& child0 = mNodes[i + 1];
+            const BVHNode& child1 = mNodes[node.First];
+            for (int k = 0; k < 3; ++k)
+            {
+                node.Min[k] = (child0.Min[k] < child1.Min[k] ?
+                    child0.Min[k] : child1.Min[k]);
+                node.Max[k] = (child0.Max[k] > child1.Max[k] ?
+                    child0.Max[k] : child1.Max[k]);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PointInPolyhedron3<Real>::BuildNode (int first, int count,
+    std::vector<int>& triangles, const std::vector<Vector3<Real> >& centroids)
+{
+    int index = (int)mNodes.size();
+    mNodes.push_back(BVHNode());
+    mNodes[index].First = first;
+    mNodes[index].Count = count;
+    if (count <= BVH_LEAF_SIZE)
+    {
+        return index;
+    }
+
+    // Split at the median centroid along the axis of largest extent of the
+    // centroids.
+    Vector3<Real> cmin = centroids[triangles[first]], cmax = cmin;
+    int i, k;
+    for (i = first + 1; i < first + count; ++i)
+    {
+        const Vector3<Real>& centroid = centroids[triangles[i]];
+        for (k = 0; k < 3; ++k)
+        {
+            if (centroid[k] < cmin[k])
+            {
+                cmin[k] = centroid[k];
+            }
+            else if (centroid[k] > cmax[k])
+            {
+                cmax[k] = centroid[k];
+            }
+        }
+    }
+
+    int axis = 0;
+    for (k = 1; k < 3; ++k)
+    {
+        if (cmax[k] - cmin[k] > cmax[axis] - cmin[axis])
+        {
+            axis = k;
+        }
+    }
+
+    CentroidLess less;
+    less.Centroids = &centroids[0];
+    less.Axis = axis;
+    int half = count/2;
+    std::nth_element(triangles.begin() + first,
+        triangles.begin() + first + half, triangles.begin() + first + count,
+        less);
+
+    mNodes[index].Count = 0;
+    BuildNode(first, half, triangles, centroids);
+    int second = BuildNode(first + half, count - half, triangles, centroids);
+    mNodes[index].First = second;
+    return index;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PointInPolyhedron3<Real>::OrientYZ (const Vector3<Real>& v0,
+    const Vector3<Real>& v1, const Vector3<Real>& test,
+    Query::Type queryType)
+{
+    if (queryType != Query::QT_RATIONAL)
+    {
+        // The error bound of the floating-point determinant is that of
+        // Shewchuk's adaptive predicates, rounded up.
+        Real term0 = (v1.Y() - v0.Y())*(test.Z() - v0.Z());
+        Real term1 = (v1.Z() - v0.Z())*(test.Y() - v0.Y());
+        Real det = term0 - term1;
+        Real bound = ((Real)4)*Math<Real>::EPSILON*(Math<Real>::FAbs(term0)
+            + Math<Real>::FAbs(term1));
+        if (queryType == Query::QT_REAL)
+        {
+            bound = (Real)0;
+        }
+
+        if (det > bound)
+        {
+            return +1;
+        }
+        if (det < -bound)
+        {
+            return -1;
+        }
+        if (bound == (Real)0)
+        {
+            return 0;
+        }
+    }
+
+    typedef typename Query2Rational<Real>::QRational QRational;
+    QRational x0 = QRational(v1.Y()) - QRational(v0.Y());
+    QRational y0 = QRational(v1.Z()) - QRational(v0.Z());
+    QRational x1 = QRational(test.Y()) - QRational(v0.Y());
+    QRational y1 = QRational(test.Z()) - QRational(v0.Z());
+    QRational det = Query2Rational<Real>::Det2(x0, y0, x1, y1);
+    return (det > 0 ? +1 : (det < 0 ? -1 : 0));
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int PointInPolyhedron3<Real>::Orient (const Vector3<Real>& v0,
+    const Vector3<Real>& v1, const Vector3<Real>& v2,
+    const Vector3<Real>& test, Query::Type queryType)
+{
+    if (queryType != Query::QT_RATIONAL)
+    {
+        Vector3<Real> U = v1 - v0, V = v2 - v0, W = test - v0;
+        Real uyvz = U.Y()*V.Z(), uzvy = U.Z()*V.Y();
+        Real uzvx = U.Z()*V.X(), uxvz = U.X()*V.Z();
+        Real uxvy = U.X()*V.Y(), uyvx = U.Y()*V.X();
+        Real det = W.X()*(uyvz - uzvy) + W.Y()*(uzvx - uxvz) +
+            W.Z()*(uxvy - uyvx);
+        Real permanent =
+            Math<Real>::FAbs(W.X())*(Math<Real>::FAbs(uyvz) +
+                Math<Real>::FAbs(uzvy)) +
+            Math<Real>::FAbs(W.Y())*(Math<Real>::FAbs(uzvx) +
+                Math<Real>::FAbs(uxvz)) +
+            Math<Real>::FAbs(W.Z())*(Math<Real>::FAbs(uxvy) +
+                Math<Real>::FAbs(uyvx));
+        Real bound = ((Real)8)*Math<Real>::EPSILON*permanent;
+        if (queryType == Query::QT_REAL)
+        {
+            bound = (Real)0;
+        }
+
+        if (det > bound)
+        {
+            return +1;
+        }
+        if (det < -bound)
+        {
+            return -1;
+        }
+        if (bound == (Real)0)
+        {
+            return 0;
+        }
+    }
+
+    typedef typename Query3Rational<Real>::QRational QRational;
+    QRational x0 = QRational(test.X()) - QRational(v0.X());
+    QRational y0 = QRational(test.Y()) - QRational(v0.Y());
+    QRational z0 = QRational(test.Z()) - QRational(v0.Z());
+    QRational x1 = QRational(v1.X()) - QRational(v0.X());
+    QRational y1 = QRational(v1.Y()) - QRational(v0.Y());
+    QRational z1 = QRational(v1.Z()) - QRational(v0.Z());
+    QRational x2 = QRational(v2.X()) - QRational(v0.X());
+    QRational y2 = QRational(v2.Y()) - QRational(v0.Y());
+    QRational z2 = QRational(v2.Z()) - QRational(v0.Z());
+    QRational det = Query3Rational<Real>::Det3(x0, y0, z0, x1, y1, z1, x2,
+        y2, z2);
+    return (det > 0 ? +1 : (det < 0 ? -1 : 0));
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void PointInPolyhedron3<Real>::ContainsTask (int begin, int end, int,
+    void* userData)
+{
+    const ContainsTaskData& data = *(const ContainsTaskData*)userData;
+    for (int i = begin; i < end; ++i)
+    {
+        data.Results[i] = data.Object->Contains(data.Queries[i]);
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
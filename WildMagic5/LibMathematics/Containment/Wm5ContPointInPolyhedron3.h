@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5CONTPOINTINPOLYHEDRON3_H
 #define WM5CONTPOINTINPOLYHEDRON3_H
@@ -13,6 +13,8 @@
 #include "Wm5Plane3.h"
 #include "Wm5Ray3.h"
 #include "Wm5Vector2.h"
+#include "Wm5Query.h"
+#include "Wm5ThreadPool.h"
 
 // This class contains various implementations for point-in-polyhedron
 // queries.  The planes stored with the faces are used in all cases to
@@ -31,19 +33,24 @@
 // rayQuantity is 2*N+1.  The input array Direction must have rayQuantity
 // elements.  If you are feeling lucky, choose rayQuantity to be 1.
 //
-// TO DO.  Add a Contains function that uses exact arithmetic and that
-// casts one ray, keeping track of the parity correctly when the ray
-// intersects a vertex or an edge.  If the faces are always triangles,
-// the use of barycentric coordinates gives us a "normalized" measurement
-// of how close to a vertex or an edge the intersection point is.  This,
-// in turn, might make it easy to use filtered predicates, which will be
-// faster than always using exact arithmetic.  If the faces are not
-// triangles, any triangulation introduces edges that are not face
-// boundary edges.  These should be ignored by the special-case handling
-// of boundary edges.  In the most general case of simple polygon faces
-// without triangulation, it is not immediately clear how to compute a
-// "normalized" measurement that will allow us to use filtered predicates
-// in an easy manner.
+// For triangle faces, a second constructor casts a single ray in the
+// direction (1,0,0) and keeps track of the parity correctly when the ray
+// intersects a vertex or an edge.  The test point is perturbed
+// symbolically to (x,y+e,z+e^2) for an infinitesimal e > 0, which never
+// lies on the projection of an edge onto the yz-plane, so each crossing is
+// counted by exactly one of the triangles that share the edge or vertex.
+// The signs of the determinants are computed according to the query type:
+// QT_REAL uses floating-point arithmetic, QT_RATIONAL uses exact rational
+// arithmetic, and QT_FILTERED uses floating-point arithmetic with an error
+// bound and repeats the computation with rational arithmetic only when the
+// determinant is too close to zero for its sign to be certain.  The
+// triangles are stored in a bounding volume hierarchy, so a query visits
+// only the triangles whose bounding boxes the ray intersects.  A point on
+// the boundary of the polyhedron is reported as inside, except that the
+// result is unspecified on a face that is parallel to the x-axis.  The
+// faces must form a closed surface.  The query requires no per-query
+// storage, so the batched Contains function distributes the points to the
+// workers of a ThreadPool.
 
 namespace Wm5
 {
@@ -71,6 +78,13 @@ public:
         int numFaces, const TriangleFace* faces, int numRays,
         const Vector3<Real>* directions);
 
+    // The Contains query will cast a single ray and use the bounding volume
+    // hierarchy of the triangles.  The queryType must be QT_REAL,
+    // QT_RATIONAL or QT_FILTERED.  The Plane members of the faces are not
+    // used.
+    PointInPolyhedron3 (int numPoints, const Vector3<Real>* points,
+        int numFaces, const TriangleFace* faces, Query::Type queryType);
+
     // For simple polyhedra with convex polygon faces.
     class WM5_MATHEMATICS_ITEM ConvexFace
     {
@@ -139,6 +153,13 @@ public:
     // constructor you used for this class.
     bool Contains (const Vector3<Real>& p) const;
 
+    // Batched queries, results[i] = Contains(points[i]).  The points are
+    // distributed to the workers of 'pool' when it is not null, except for
+    // the convex-face methods 1 and 2 and the simple-face method 1, which
+    // use temporary storage of the class and are always serial.
+    void Contains (int numQueries, const Vector3<Real>* queries,
+        bool* results, ThreadPool* pool = 0) const;
+
 private:
     // For all types of faces.  The ray origin is the test point.  The ray
     // direction is one of those passed to the constructors.  The plane origin
@@ -149,6 +170,65 @@ private:
 
     // For triangle faces.
     bool ContainsT0 (const Vector3<Real>& p) const;
+    bool ContainsT1 (const Vector3<Real>& p) const;
+
+    // Support for the single-ray query.  A node of the hierarchy is a leaf
+    // when Count is positive, in which case it stores the triangles First
+    // through First+Count-1.  The children of an interior node are the
+    // next node and the node First.  The triangles are stored as vertex
+    // triples, ordered so that the projections onto the yz-plane are
+    // counterclockwise; triangles whose projections are degenerate are
+    // discarded, because the perturbed ray never intersects them.
+    enum
+    {
+        BVH_LEAF_SIZE = 4,
+        BVH_MAX_DEPTH = 64
+    };
+
+    class BVHNode
+    {
+    public:
+        Vector3<Real> Min, Max;
+        int First, Count;
+    };
+
+    class CentroidLess
+    {
+    public:
+        bool operator() (int triangle0, int triangle1) const
+        {
+            return Centroids[triangle0][Axis] < Centroids[triangle1][Axis];
+        }
+
+        const Vector3<Real>* Centroids;
+        int Axis;
+    };
+
+    void BuildHierarchy ();
+    int BuildNode (int first, int count, std::vector<int>& triangles,
+        const std::vector<Vector3<Real> >& centroids);
+
+    // The sign of (v1-v0).Y()*(test-v0).Z() - (v1-v0).Z()*(test-v0).Y(),
+    // the orientation of the projections onto the yz-plane.
+    static int OrientYZ (const Vector3<Real>& v0, const Vector3<Real>& v1,
+        const Vector3<Real>& test, Query::Type queryType);
+
+    // The sign of Dot(test-v0,Cross(v1-v0,v2-v0)).
+    static int Orient (const Vector3<Real>& v0, const Vector3<Real>& v1,
+        const Vector3<Real>& v2, const Vector3<Real>& test,
+        Query::Type queryType);
+
+    // Support for the batched queries.  The task items are the points.
+    class ContainsTaskData
+    {
+    public:
+        const PointInPolyhedron3* Object;
+        const Vector3<Real>* Queries;
+        bool* Results;
+    };
+
+    static void ContainsTask (int begin, int end, int worker,
+        void* userData);
 
     // For convex faces.
     bool ContainsC0 (const Vector3<Real>& p) const;
@@ -170,6 +250,11 @@ private:
     int mNumRays;
     const Vector3<Real>* mDirections;
 
+    // The bounding volume hierarchy for the single-ray query.
+    Query::Type mQueryType;
+    std::vector<BVHNode> mNodes;
+    std::vector<Vector3<Real> > mTriangles;
+
     // Temporary storage for those methods that reduce the problem to 2D
     // point-in-polygon queries.  The array stores the projections of
     // face vertices onto the plane of the face.  It is resized as needed.
@@ -0,0 +1,264 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5MathematicsPCH.h"
+#include "Wm5ArcLengthTable.h"
+#include "Wm5Integrate1.h"
+#include "Wm5Math.h"
+#include "Wm5Assert.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+ArcLengthTable<Real>::ArcLengthTable ()
+    :
+    mTolerancePerTime((Real)0)
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+ArcLengthTable<Real>::~ArcLengthTable ()
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ArcLengthTable<Real>::Create (Real tmin, Real tmax, Real tolerance,
+    Function speed, void* userData)
+{
+    assertion(tmin < tmax, "Invalid time interval\n");
+    assertion(tolerance >= (Real)0, "Invalid tolerance\n");
+
+    mTimes.clear();
+    mLengths.clear();
+
+    // The initial intervals, which also estimate the total length for the
+    // error bound.
+    const int numInitial = 16;
+    Real times[numInitial + 1], lengths[numInitial];
+    Real dt = (tmax - tmin)/numInitial;
+    Real totalLength = (Real)0;
+    int i;
+    for (i = 0; i < numInitial; ++i)
+    {
+        times[i] = tmin + dt*i;
+    }
+    times[numInitial] = tmax;
+    for (i = 0; i < numInitial; ++i)
+    {
+        lengths[i] = Integrate1<Real>::GaussianQuadrature(times[i],
+            times[i + 1], speed, userData);
+        totalLength += lengths[i];
+    }
+    mTolerancePerTime = tolerance*totalLength/(tmax - tmin);
+
+    mTimes.push_back(tmin);
+    mLengths.push_back((Real)0);
+    for (i = 0; i < numInitial; ++i)
+    {
+        Subdivide(times[i], times[i + 1], lengths[i], 0, speed, userData);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ArcLengthTable<Real>::Subdivide (Real t0, Real t1, Real length,
+    int level, Function speed, void* userData)
+{
+    Real tMid = ((Real)0.5)*(t0 + t1);
+    Real length0 = Integrate1<Real>::GaussianQuadrature(t0, tMid, speed,
+        userData);
+    Real length1 = Integrate1<Real>::GaussianQuadrature(tMid, t1, speed,
+        userData);
+
+    Real error = Math<Real>::FAbs(length0 + length1 - length);
+    if (error <= mTolerancePerTime*(t1 - t0) || level == MAX_LEVEL)
+    {
+        // Keep the halves, whose quadratures are the more accurate ones.
+        Real s0 = mLengths.back();
+        mTimes.push_back(tMid);
+        mLengths.push_back(s0 + length0);
+        mTimes.push_back(t1);
+        mLengths.push_back(s0 + length0 + length1);
+    }
+    else
+    {
+        Subdivide(t0, tMid, length0, level + 1, speed, userData);
+        Subdivide(tMid, t1, length1, level + 1, speed, userData);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ArcLengthTable<Real>::Clear ()
+{
+    mTimes.clear();
+    mLengths.clear();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool ArcLengthTable<Real>::IsCreated () const
+{
+    return mTimes.size() > 0;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetMinTime () const
+{
+    return mTimes.front();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetMaxTime () const
+{
+    return mTimes.back();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetTotalLength () const
+{
+    return mLengths.back();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int ArcLengthTable<Real>::GetNumIntervals () const
+{
+    return (int)mTimes.size() - 1;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetLength (Real t, Function speed,
+    void* userData) const
+{
+    if (t <= mTimes.front())
+    {
+        return (Real)0;
+    }
+    if (t >= mTimes.back())
+    {
+        return mLengths.back();
+    }
+
+    int i = (int)(std::upper_bound(mTimes.begin(), mTimes.end(), t)
+        - mTimes.begin()) - 1;
+    return mLengths[i] + Integrate1<Real>::GaussianQuadrature(mTimes[i], t,
+        speed, userData);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetTime (Real length, int iterations,
+    Real tolerance, Function speed, void* userData) const
+{
+    if (length <= (Real)0)
+    {
+        return mTimes.front();
+    }
+    if (length >= mLengths.back())
+    {
+        return mTimes.back();
+    }
+
+    int i = (int)(std::upper_bound(mLengths.begin(), mLengths.end(), length)
+        - mLengths.begin()) - 1;
+    return GetTimeInterval(i, length, iterations, tolerance, speed,
+        userData);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ArcLengthTable<Real>::GetTimes (int numLengths, const Real* lengths,
+    Real* times, int iterations, Real tolerance, Function speed,
+    void* userData) const
+{
+    const int numIntervals = GetNumIntervals();
+    int i = 0;
+    for (int j = 0; j < numLengths; ++j)
+    {
+        Real length = lengths[j];
+        if (length <= (Real)0)
+        {
+            times[j] = mTimes.front();
+            continue;
+        }
+        if (length >= mLengths.back())
+        {
+            times[j] = mTimes.back();
+            continue;
+        }
+
+        // Nondecreasing lengths are usually in the interval of the previous
+        // length or in one of the next intervals.
+        if (length < mLengths[i])
+        {
+            i = 0;
+        }
+        int last = i + 4;
+        while (i < numIntervals && mLengths[i + 1] <= length && i < last)
+        {
+            ++i;
+        }
+        if (mLengths[i + 1] <= length)
+        {
+            i = (int)(std::upper_bound(mLengths.begin() + i, mLengths.end(),
+                length) - mLengths.begin()) - 1;
+        }
+
+        times[j] = GetTimeInterval(i, length, iterations, tolerance, speed,
+            userData);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real ArcLengthTable<Real>::GetTimeInterval (int i, Real length,
+    int iterations, Real tolerance, Function speed, void* userData) const
+{
+    // The length is in [s[i],s[i+1]).  L(t) = s[i] + integral(t[i],t) is
+    // increasing on [t[i],t[i+1]], so Newton's method is safeguarded by
+    // bisection of the root-bounding interval, as in SingleCurve2 and
+    // SingleCurve3, but the interval is short and the initial guess, by
+    // linear interpolation of the table, is close to the root.
+    Real lower = mTimes[i], upper = mTimes[i + 1];
+    Real len0 = length - mLengths[i];
+    Real len1 = mLengths[i + 1] - mLengths[i];
+    Real t = lower + (upper - lower)*len0/len1;
+
+    for (int j = 0; j < iterations; ++j)
+    {
+        Real difference = Integrate1<Real>::GaussianQuadrature(mTimes[i], t,
+            speed, userData) - len0;
+        if (Math<Real>::FAbs(difference) < tolerance)
+        {
+            return t;
+        }
+
+        Real speedT = speed(t, userData);
+        Real tCandidate = (speedT > (Real)0 ? t - difference/speedT : t);
+        if (difference > (Real)0)
+        {
+            upper = t;
+            t = (tCandidate > lower && tCandidate < upper ? tCandidate :
+                ((Real)0.5)*(upper + lower));
+        }
+        else
+        {
+            lower = t;
+            t = (tCandidate > lower && tCandidate < upper ? tCandidate :
+                ((Real)0.5)*(upper + lower));
+        }
+    }
+    return t;
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_MATHEMATICS_ITEM
+class ArcLengthTable<float>;
+
+template WM5_MATHEMATICS_ITEM
+class ArcLengthTable<double>;
+//----------------------------------------------------------------------------
+}
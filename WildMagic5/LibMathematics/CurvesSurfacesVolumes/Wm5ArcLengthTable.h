@@ -0,0 +1,90 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5ARCLENGTHTABLE_H
+#define WM5ARCLENGTHTABLE_H
+
+#include "Wm5MathematicsLIB.h"
+
+// A table of the arc length s(t) of a curve with speed |x'(t)|, for the
+// curve parameter t in [tmin,tmax].  The table stores the times
+// tmin = t[0] < t[1] < ... < t[n] = tmax and the lengths s[i] = s(t[i]),
+// which are nondecreasing.  The intervals [t[i],t[i+1]] are chosen by
+// adaptive bisection, so they are short where the speed varies quickly.
+// Between the table entries, s(t) = s[i] + integral(t[i],t) of the speed,
+// computed with a 5-point Gaussian quadrature.  The lengths are therefore
+// found with a table lookup and one quadrature, and the inverse t(s) with
+// a few Newton steps inside one interval.  The table does not store the
+// speed function; the queries take it as input, so a copy of the table
+// remains valid for a copy of the curve.  The queries do not modify the
+// table, so several threads may query one table concurrently.
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_MATHEMATICS_ITEM ArcLengthTable
+{
+public:
+    // The speed of the curve.  The last parameter is for user-defined data.
+    typedef Real (*Function)(Real,void*);
+
+    ArcLengthTable ();
+    ~ArcLengthTable ();
+
+    // Build the table.  An interval is bisected until its length estimate
+    // changes by at most tolerance*totalLength*(t[i+1]-t[i])/(tmax-tmin),
+    // so the error of the table lengths is about tolerance*totalLength.
+    void Create (Real tmin, Real tmax, Real tolerance, Function speed,
+        void* userData);
+
+    // Remove the entries.  IsCreated returns 'false' until the next call
+    // to Create.
+    void Clear ();
+
+    // Member access.
+    bool IsCreated () const;
+    Real GetMinTime () const;
+    Real GetMaxTime () const;
+    Real GetTotalLength () const;
+    int GetNumIntervals () const;
+
+    // The queries integrate the same speed function that was passed to
+    // Create.
+
+    // The length from tmin to t.  The input t is clamped to [tmin,tmax].
+    Real GetLength (Real t, Function speed, void* userData) const;
+
+    // The inverse of GetLength.  The Newton iterations stop when the length
+    // at the time is within 'tolerance' of the input length.  GetTimes
+    // computes times[i] = GetTime(lengths[i]); it is faster for
+    // nondecreasing lengths, and the arrays may be the same.
+    Real GetTime (Real length, int iterations, Real tolerance,
+        Function speed, void* userData) const;
+    void GetTimes (int numLengths, const Real* lengths, Real* times,
+        int iterations, Real tolerance, Function speed, void* userData)
+        const;
+
+private:
+    void Subdivide (Real t0, Real t1, Real length, int level,
+        Function speed, void* userData);
+    Real GetTimeInterval (int i, Real length, int iterations,
+        Real tolerance, Function speed, void* userData) const;
+
+    enum { MAX_LEVEL = 20 };
+
+    Real mTolerancePerTime;
+    std::vector<Real> mTimes, mLengths;
+};
+
+typedef ArcLengthTable<float> ArcLengthTablef;
+typedef ArcLengthTable<double> ArcLengthTabled;
+
+}
+
+#endif
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2010/12/11)
+// File Version: 5.0.3 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5BSplineBasis.h"
@@ -220,6 +220,12 @@ Real BSplineBasis<Real>::GetKnot (int j) const
 //----------------------------------------------------------------------------
 template <typename Real>
 int BSplineBasis<Real>::GetKey (Real& t) const
+{
+    return GetKey(t, -1);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int BSplineBasis<Real>::GetKey (Real& t, int key) const
 {
     if (mOpen)
     {
@@ -253,7 +259,10 @@ int BSplineBasis<Real>::GetKey (Real& t) const
     }
     else
     {
-        for (i = mDegree + 1; i <= mNumCtrlPoints; ++i)
+        // The knots are nondecreasing, so the search may skip the knots
+        // not larger than a previous parameter's knot.
+        i = (key > mDegree && mKnot[key] <= t ? key + 1 : mDegree + 1);
+        for (/**/; i <= mNumCtrlPoints; ++i)
         {
             if (t < mKnot[i])
             {
@@ -383,6 +392,195 @@ void BSplineBasis<Real>::Compute (Real t, unsigned int order, int& minIndex,
     maxIndex = i;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void BSplineBasis<Real>::Compute (int numT, const Real* t,
+    unsigned int order, int* minIndex, Real* d0, Real* d1, Real* d2,
+    Real* d3) const
+{
+    assertion(order <= 3, "Only derivatives to third order supported\n");
+
+    const int numBasis = mDegree + 1;
+    Real* work = new1<Real>(2*(order + 1)*numBasis*CHUNK_SIZE);
+    Real* output[4] = { d0, d1, d2, d3 };
+    Real* chunkOutput[4];
+    Real times[CHUNK_SIZE];
+
+    // GetKey clamps or wraps the parameters, so the recurrence uses the
+    // values it returns.
+    int k = 0, iNext = -1;
+    Real tNext = (Real)0;
+    if (numT > 0)
+    {
+        tNext = t[0];
+        iNext = GetKey(tNext, -1);
+    }
+
+    while (k < numT)
+    {
+        // Gather the next parameters in the knot span of index i.
+        int first = k, i = iNext, count = 0;
+        do
+        {
+            times[count++] = tNext;
+            if (++k < numT)
+            {
+                tNext = t[k];
+                iNext = GetKey(tNext, i);
+            }
+        }
+        while (k < numT && iNext == i && count < CHUNK_SIZE);
+
+        for (unsigned int r = 0; r <= order; ++r)
+        {
+            chunkOutput[r] = (output[r] ? output[r] + numBasis*first : 0);
+        }
+        ComputeSpan(i, count, times, order, work, chunkOutput);
+
+        for (int j = first; j < k; ++j)
+        {
+            minIndex[j] = i - mDegree;
+        }
+    }
+
+    delete1(work);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void BSplineBasis<Real>::ComputeSpan (int i, int numT, const Real* t,
+    unsigned int order, Real* work, Real* const* output) const
+{
+    // This is the recurrence of the single-parameter Compute, with the same
+    // arithmetic, so the results are the same.  The values of level j for
+    // the functions i-j <= k <= i are stored at g = k-i+d, and the value of
+    // derivative r of function g for parameter p is at
+    // level[(r*(d+1)+g)*CHUNK_SIZE+p], so the innermost loops are over the
+    // parameters.
+    const int numBasis = mDegree + 1;
+    const int rowSize = numBasis*CHUNK_SIZE;
+    const int numOrders = (int)order + 1;
+    Real* prev = work;
+    Real* curr = work + numOrders*rowSize;
+    int r, g, j, p;
+
+    for (r = 0; r < numOrders; ++r)
+    {
+        Real* B = prev + r*rowSize + mDegree*CHUNK_SIZE;
+        Real value = (r == 0 ? (Real)1 : (Real)0);
+        for (p = 0; p < numT; ++p)
+        {
+            B[p] = value;
+        }
+    }
+
+    for (j = 1; j <= mDegree; ++j)
+    {
+        // The function k = i has only the first term of the recurrence.
+        Real knot0 = mKnot[i];
+        Real invD0 = ((Real)1)/(mKnot[i+j] - mKnot[i]);
+        for (r = 0; r < numOrders; ++r)
+        {
+            const Real* B = prev + r*rowSize + mDegree*CHUNK_SIZE;
+            Real* C = curr + r*rowSize + mDegree*CHUNK_SIZE;
+            if (r == 0)
+            {
+                for (p = 0; p < numT; ++p)
+                {
+                    C[p] = (t[p] - knot0)*B[p]*invD0;
+                }
+            }
+            else
+            {
+                const Real* BLow = B - rowSize;
+                Real factor = (Real)r;
+                for (p = 0; p < numT; ++p)
+                {
+                    C[p] = ((t[p] - knot0)*B[p] + factor*BLow[p])*invD0;
+                }
+            }
+        }
+
+        // The function k = i-j has only the second term.
+        Real knot1 = mKnot[i+1];
+        Real invD1 = ((Real)1)/(mKnot[i+1] - mKnot[i-j+1]);
+        for (r = 0; r < numOrders; ++r)
+        {
+            const Real* B = prev + r*rowSize + (mDegree - j + 1)*CHUNK_SIZE;
+            Real* C = curr + r*rowSize + (mDegree - j)*CHUNK_SIZE;
+            if (r == 0)
+            {
+                for (p = 0; p < numT; ++p)
+                {
+                    C[p] = (knot1 - t[p])*B[p]*invD1;
+                }
+            }
+            else
+            {
+                const Real* BLow = B - rowSize;
+                Real factor = (Real)r;
+                for (p = 0; p < numT; ++p)
+                {
+                    C[p] = ((knot1 - t[p])*B[p] - factor*BLow[p])*invD1;
+                }
+            }
+        }
+
+        // The functions i-j < k < i have both terms.
+        for (g = mDegree - j + 1; g < mDegree; ++g)
+        {
+            int k = i - mDegree + g;
+            knot0 = mKnot[k];
+            knot1 = mKnot[k+j+1];
+            invD0 = ((Real)1)/(mKnot[k+j] - mKnot[k]);
+            invD1 = ((Real)1)/(mKnot[k+j+1] - mKnot[k+1]);
+            for (r = 0; r < numOrders; ++r)
+            {
+                const Real* B0 = prev + r*rowSize + g*CHUNK_SIZE;
+                const Real* B1 = B0 + CHUNK_SIZE;
+                Real* C = curr + r*rowSize + g*CHUNK_SIZE;
+                if (r == 0)
+                {
+                    for (p = 0; p < numT; ++p)
+                    {
+                        C[p] = (t[p] - knot0)*B0[p]*invD0 +
+                            (knot1 - t[p])*B1[p]*invD1;
+                    }
+                }
+                else
+                {
+                    const Real* B0Low = B0 - rowSize;
+                    const Real* B1Low = B1 - rowSize;
+                    Real factor = (Real)r;
+                    for (p = 0; p < numT; ++p)
+                    {
+                        C[p] = ((t[p] - knot0)*B0[p] + factor*B0Low[p])*invD0
+                            + ((knot1 - t[p])*B1[p] - factor*B1Low[p])*invD1;
+                    }
+                }
+            }
+        }
+
+        Real* save = prev;
+        prev = curr;
+        curr = save;
+    }
+
+    for (r = 0; r < numOrders; ++r)
+    {
+        if (output[r])
+        {
+            for (g = 0; g < numBasis; ++g)
+            {
+                const Real* B = prev + r*rowSize + g*CHUNK_SIZE;
+                Real* D = output[r] + g;
+                for (p = 0; p < numT; ++p, D += numBasis)
+                {
+                    *D = B[p];
+                }
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2010/12/11)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5BSPLINEBASIS_H
 #define WM5BSPLINEBASIS_H
@@ -72,6 +72,21 @@ public:
     void Compute (Real t, unsigned int order, int& minIndex,
         int& maxIndex) const;
 
+    // Evaluate the basis functions and their derivatives for the parameters
+    // t[0] through t[numT-1].  For parameter k, the nonzero functions are
+    // those with indices minIndex[k] <= i <= minIndex[k]+d, and the value
+    // of function minIndex[k]+j is d0[(d+1)*k+j].  The derivatives are
+    // stored the same way in d1, d2, and d3, which may be null when 'order'
+    // does not require them.  The results are those of the single-parameter
+    // Compute.  The parameters need not be sorted, but the knot spans are
+    // found incrementally and consecutive parameters in the same span are
+    // evaluated together, in loops over the parameters that the compiler
+    // can vectorize, so nondecreasing parameters are the fastest.  This
+    // function does not use the member storage of the single-parameter
+    // Compute, so it may be called concurrently.
+    void Compute (int numT, const Real* t, unsigned int order, int* minIndex,
+        Real* d0, Real* d1 = 0, Real* d2 = 0, Real* d3 = 0) const;
+
 protected:
     int Initialize (int numCtrlPoints, int degree, bool open);
     Real** Allocate () const;
@@ -80,6 +95,19 @@ protected:
     // Determine knot index i for which knot[i] <= rfTime < knot[i+1].
     int GetKey (Real& t) const;
 
+    // The same, but the search for a nonuniform spline starts after the
+    // index 'key' of a previous parameter when that parameter is not
+    // larger than t.
+    int GetKey (Real& t, int key) const;
+
+    // Support for the batched Compute.  The parameters t[0] through
+    // t[numT-1], numT <= CHUNK_SIZE, are in the knot span of index i.  The
+    // workspace stores two levels of the triangular recurrence for each
+    // derivative order.
+    enum { CHUNK_SIZE = 32 };
+    void ComputeSpan (int i, int numT, const Real* t, unsigned int order,
+        Real* work, Real* const* output) const;
+
     int mNumCtrlPoints;   // n+1
     int mDegree;          // d
     Real* mKnot;          // knot[n+d+2]
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5BSplineCurve2.h"
@@ -108,6 +108,8 @@ void BSplineCurve2<Real>::SetControlPoint (int i, const Vector2<Real>& ctrl)
         {
             mCtrlPoint[mNumCtrlPoints + i] = ctrl;
         }
+
+        SingleCurve2<Real>::InvalidateLengthTable();
     }
 }
 //----------------------------------------------------------------------------
@@ -126,6 +128,7 @@ template <typename Real>
 void BSplineCurve2<Real>::SetKnot (int i, Real knot)
 {
     mBasis.SetKnot(i, knot);
+    SingleCurve2<Real>::InvalidateLengthTable();
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -200,6 +203,55 @@ void BSplineCurve2<Real>::Get (Real t, Vector2<Real>* pos,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void BSplineCurve2<Real>::Get (int numT, const Real* t, Vector2<Real>* pos,
+    Vector2<Real>* der1, Vector2<Real>* der2, Vector2<Real>* der3) const
+{
+    unsigned int order = (der3 ? 3 : (der2 ? 2 : (der1 ? 1 : 0)));
+    const int numBasis = mBasis.GetDegree() + 1;
+    const int chunkSize = 256;
+    int* minIndex = new1<int>(chunkSize);
+    Real* basis = new1<Real>(4*chunkSize*numBasis);
+
+    Vector2<Real>* output[4] = { pos, der1, der2, der3 };
+    Real* outBasis[4];
+    int r;
+    for (r = 0; r < 4; ++r)
+    {
+        outBasis[r] = (output[r] ? basis + r*chunkSize*numBasis : 0);
+    }
+
+    for (int first = 0; first < numT; first += chunkSize)
+    {
+        int count = (numT - first < chunkSize ? numT - first : chunkSize);
+        mBasis.Compute(count, t + first, order, minIndex, outBasis[0],
+            outBasis[1], outBasis[2], outBasis[3]);
+
+        for (r = 0; r < 4; ++r)
+        {
+            if (!output[r])
+            {
+                continue;
+            }
+
+            const Real* B = outBasis[r];
+            for (int k = 0; k < count; ++k, B += numBasis)
+            {
+                const Vector2<Real>* ctrl = &mCtrlPoint[minIndex[k]];
+                Vector2<Real> sum = Vector2<Real>::ZERO;
+                for (int i = 0; i < numBasis; ++i)
+                {
+                    sum += B[i]*ctrl[i];
+                }
+                output[r][first + k] = sum;
+            }
+        }
+    }
+
+    delete1(minIndex);
+    delete1(basis);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 BSplineBasis<Real>& BSplineCurve2<Real>::GetBasis ()
 {
     return mBasis;
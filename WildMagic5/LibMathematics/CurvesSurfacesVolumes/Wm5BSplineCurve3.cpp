@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5BSplineCurve3.h"
@@ -109,6 +109,8 @@ void BSplineCurve3<Real>::SetControlPoint (int i, const Vector3<Real>& ctrl)
         {
             mCtrlPoint[mNumCtrlPoints + i] = ctrl;
         }
+
+        SingleCurve3<Real>::InvalidateLengthTable();
     }
 }
 //----------------------------------------------------------------------------
@@ -128,6 +130,7 @@ template <typename Real>
 void BSplineCurve3<Real>::SetKnot (int i, Real knot)
 {
     mBasis.SetKnot(i, knot);
+    SingleCurve3<Real>::InvalidateLengthTable();
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -202,6 +205,55 @@ void BSplineCurve3<Real>::Get (Real t, Vector3<Real>* pos,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void BSplineCurve3<Real>::Get (int numT, const Real* t, Vector3<Real>* pos,
+    Vector3<Real>* der1, Vector3<Real>* der2, Vector3<Real>* der3) const
+{
+    unsigned int order = (der3 ? 3 : (der2 ? 2 : (der1 ? 1 : 0)));
+    const int numBasis = mBasis.GetDegree() + 1;
+    const int chunkSize = 256;
+    int* minIndex = new1<int>(chunkSize);
+    Real* basis = new1<Real>(4*chunkSize*numBasis);
+
+    Vector3<Real>* output[4] = { pos, der1, der2, der3 };
+    Real* outBasis[4];
+    int r;
+    for (r = 0; r < 4; ++r)
+    {
+        outBasis[r] = (output[r] ? basis + r*chunkSize*numBasis : 0);
+    }
+
+    for (int first = 0; first < numT; first += chunkSize)
+    {
+        int count = (numT - first < chunkSize ? numT - first : chunkSize);
+        mBasis.Compute(count, t + first, order, minIndex, outBasis[0],
+            outBasis[1], outBasis[2], outBasis[3]);
+
+        for (r = 0; r < 4; ++r)
+        {
+            if (!output[r])
+            {
+                continue;
+            }
+
+            const Real* B = outBasis[r];
+            for (int k = 0; k < count; ++k, B += numBasis)
+            {
+                const Vector3<Real>* ctrl = &mCtrlPoint[minIndex[k]];
+                Vector3<Real> sum = Vector3<Real>::ZERO;
+                for (int i = 0; i < numBasis; ++i)
+                {
+                    sum += B[i]*ctrl[i];
+                }
+                output[r][first + k] = sum;
+            }
+        }
+    }
+
+    delete1(minIndex);
+    delete1(basis);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 BSplineBasis<Real>& BSplineCurve3<Real>::GetBasis ()
 {
     return mBasis;
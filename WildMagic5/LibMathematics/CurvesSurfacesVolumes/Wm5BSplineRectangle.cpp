@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5BSplineRectangle.h"
@@ -410,6 +410,128 @@ Vector3<Real> BSplineRectangle<Real>::PVV (Real u, Real v) const
     return derVV;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void BSplineRectangle<Real>::Get (int numU, const Real* u, int numV,
+    const Real* v, Vector3<Real>* pos, Vector3<Real>* derU,
+    Vector3<Real>* derV, ThreadPool* pool) const
+{
+    const int numUBasis = mBasis[0].GetDegree() + 1;
+    const int numVBasis = mBasis[1].GetDegree() + 1;
+    const int numUCtrl = mBasis[0].GetNumCtrlPoints();
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+
+    GridTaskData data;
+    data.Object = this;
+    data.NumU = numU;
+    data.NumV = numV;
+    data.UMin = new1<int>(numU);
+    data.VMin = new1<int>(numV);
+    data.UBasis = new1<Real>(2*numU*numUBasis);
+    data.VBasis = new1<Real>(2*numV*numVBasis);
+    data.Pos = pos;
+    data.DerU = derU;
+    data.DerV = derV;
+    data.Work = new1<Vector3<Real> >(2*numUCtrl*numWorkers);
+
+    mBasis[0].Compute(numU, u, (derU ? 1 : 0), data.UMin, data.UBasis,
+        data.UBasis + numU*numUBasis);
+    mBasis[1].Compute(numV, v, (derV ? 1 : 0), data.VMin, data.VBasis,
+        data.VBasis + numV*numVBasis);
+
+    ThreadPool::ParallelFor(pool, numV, 0, GridTask, &data);
+
+    delete1(data.UMin);
+    delete1(data.VMin);
+    delete1(data.UBasis);
+    delete1(data.VBasis);
+    delete1(data.Work);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void BSplineRectangle<Real>::GridTask (int begin, int end, int worker,
+    void* userData)
+{
+    const GridTaskData& data = *(const GridTaskData*)userData;
+    const BSplineRectangle* object = data.Object;
+    const int numUBasis = object->mBasis[0].GetDegree() + 1;
+    const int numVBasis = object->mBasis[1].GetDegree() + 1;
+    const int numUCtrl = object->mBasis[0].GetNumCtrlPoints();
+    const int numU = data.NumU;
+    const Real* uDer = data.UBasis + numU*numUBasis;
+    const Real* vDer = data.VBasis + data.NumV*numVBasis;
+    Vector3<Real>* rowPos = data.Work + 2*numUCtrl*worker;
+    Vector3<Real>* rowDerV = rowPos + numUCtrl;
+    Vector3<Real> sum;
+    int i, j;
+
+    for (int iv = begin; iv < end; ++iv)
+    {
+        // Combine the control points along v.
+        const int vMin = data.VMin[iv];
+        const Real* BV0 = data.VBasis + iv*numVBasis;
+        const Real* BV1 = vDer + iv*numVBasis;
+        for (i = 0; i < numUCtrl; ++i)
+        {
+            const Vector3<Real>* ctrl = &object->mCtrlPoint[i][vMin];
+            sum = Vector3<Real>::ZERO;
+            for (j = 0; j < numVBasis; ++j)
+            {
+                sum += BV0[j]*ctrl[j];
+            }
+            rowPos[i] = sum;
+
+            if (data.DerV)
+            {
+                sum = Vector3<Real>::ZERO;
+                for (j = 0; j < numVBasis; ++j)
+                {
+                    sum += BV1[j]*ctrl[j];
+                }
+                rowDerV[i] = sum;
+            }
+        }
+
+        // Evaluate the curves in u.
+        const int offset = numU*iv;
+        for (int iu = 0; iu < numU; ++iu)
+        {
+            const int uMin = data.UMin[iu];
+            const Real* BU0 = data.UBasis + iu*numUBasis;
+            const Real* BU1 = uDer + iu*numUBasis;
+
+            if (data.Pos)
+            {
+                sum = Vector3<Real>::ZERO;
+                for (i = 0; i < numUBasis; ++i)
+                {
+                    sum += BU0[i]*rowPos[uMin + i];
+                }
+                data.Pos[offset + iu] = sum;
+            }
+
+            if (data.DerU)
+            {
+                sum = Vector3<Real>::ZERO;
+                for (i = 0; i < numUBasis; ++i)
+                {
+                    sum += BU1[i]*rowPos[uMin + i];
+                }
+                data.DerU[offset + iu] = sum;
+            }
+
+            if (data.DerV)
+            {
+                sum = Vector3<Real>::ZERO;
+                for (i = 0; i < numUBasis; ++i)
+                {
+                    sum += BU0[i]*rowDerV[uMin + i];
+                }
+                data.DerV[offset + iu] = sum;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
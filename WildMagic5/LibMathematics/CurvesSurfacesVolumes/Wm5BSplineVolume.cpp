@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5BSplineVolume.h"
@@ -27,8 +27,10 @@ BSplineVolume<Real>::BSplineVolume (int numUCtrlPoints, int numVCtrlPoints,
     assertion(1 <= wDegree && wDegree <= numWCtrlPoints - 1,
         "Invalid input\n");
 
-    mCtrlPoint = new3<Vector3<Real> >(numUCtrlPoints, numVCtrlPoints,
-        numWCtrlPoints);
+    // new3 takes the bounds from the innermost one, so this allocates
+    // mCtrlPoint[numUCtrlPoints][numVCtrlPoints][numWCtrlPoints].
+    mCtrlPoint = new3<Vector3<Real> >(numWCtrlPoints, numVCtrlPoints,
+        numUCtrlPoints);
     memset(mCtrlPoint[0][0], 0, numUCtrlPoints*numVCtrlPoints*numWCtrlPoints*
         sizeof(Vector3<Real>));
 
@@ -213,6 +215,95 @@ Vector3<Real> BSplineVolume<Real>::GetDerivative (int i, Real pos[3]) const
     return Vector3<Real>::ZERO;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void BSplineVolume<Real>::GetPosition (int numU, const Real* u, int numV,
+    const Real* v, int numW, const Real* w, Vector3<Real>* pos,
+    ThreadPool* pool) const
+{
+    const int numT[3] = { numU, numV, numW };
+    const Real* t[3] = { u, v, w };
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+
+    GridTaskData data;
+    data.Object = this;
+    data.NumU = numU;
+    data.NumV = numV;
+    data.Pos = pos;
+    data.Work = new1<Vector3<Real> >(mBasis[0].GetNumCtrlPoints()*
+        numWorkers);
+    int i;
+    for (i = 0; i < 3; ++i)
+    {
+        data.Min[i] = new1<int>(numT[i]);
+        data.Basis[i] = new1<Real>(numT[i]*(mBasis[i].GetDegree() + 1));
+        mBasis[i].Compute(numT[i], t[i], 0, data.Min[i], data.Basis[i]);
+    }
+
+    ThreadPool::ParallelFor(pool, numV*numW, 0, GridTask, &data);
+
+    for (i = 0; i < 3; ++i)
+    {
+        delete1(data.Min[i]);
+        delete1(data.Basis[i]);
+    }
+    delete1(data.Work);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void BSplineVolume<Real>::GridTask (int begin, int end, int worker,
+    void* userData)
+{
+    const GridTaskData& data = *(const GridTaskData*)userData;
+    const BSplineVolume* object = data.Object;
+    const int numUBasis = object->mBasis[0].GetDegree() + 1;
+    const int numVBasis = object->mBasis[1].GetDegree() + 1;
+    const int numWBasis = object->mBasis[2].GetDegree() + 1;
+    const int numUCtrl = object->mBasis[0].GetNumCtrlPoints();
+    const int numU = data.NumU;
+    Vector3<Real>* rowPos = data.Work + numUCtrl*worker;
+    Vector3<Real> sum;
+    int i, j, k;
+
+    for (int row = begin; row < end; ++row)
+    {
+        // Combine the control points along v and w.
+        const int iv = row % data.NumV;
+        const int iw = row/data.NumV;
+        const int vMin = data.Min[1][iv];
+        const int wMin = data.Min[2][iw];
+        const Real* BV = data.Basis[1] + iv*numVBasis;
+        const Real* BW = data.Basis[2] + iw*numWBasis;
+        for (i = 0; i < numUCtrl; ++i)
+        {
+            sum = Vector3<Real>::ZERO;
+            for (j = 0; j < numVBasis; ++j)
+            {
+                const Vector3<Real>* ctrl =
+                    &object->mCtrlPoint[i][vMin + j][wMin];
+                for (k = 0; k < numWBasis; ++k)
+                {
+                    sum += (BV[j]*BW[k])*ctrl[k];
+                }
+            }
+            rowPos[i] = sum;
+        }
+
+        // Evaluate the curve in u.
+        Vector3<Real>* output = data.Pos + numU*row;
+        for (int iu = 0; iu < numU; ++iu)
+        {
+            const int uMin = data.Min[0][iu];
+            const Real* BU = data.Basis[0] + iu*numUBasis;
+            sum = Vector3<Real>::ZERO;
+            for (i = 0; i < numUBasis; ++i)
+            {
+                sum += BU[i]*rowPos[uMin + i];
+            }
+            output[iu] = sum;
+        }
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5BSPLINEVOLUME_H
 #define WM5BSPLINEVOLUME_H
 
 #include "Wm5MathematicsLIB.h"
 #include "Wm5BSplineBasis.h"
+#include "Wm5ThreadPool.h"
 #include "Wm5Vector3.h"
 
 namespace Wm5
@@ -52,9 +53,34 @@ public:
     Vector3<Real> GetPosition (Real pos[3]) const;
     Vector3<Real> GetDerivative (int i, Real pos[3]) const;
 
+    // Batch evaluation of the positions on the grid of parameters
+    // (u[iu],v[iv],w[iw]), stored at index iu+numU*(iv+numV*iw).  The
+    // control points are combined along v and w once per grid row, so a
+    // position costs d0+1 control point operations instead of
+    // (d0+1)*(d1+1)*(d2+1).  When 'pool' is not null, the rows are
+    // evaluated concurrently.
+    void GetPosition (int numU, const Real* u, int numV, const Real* v,
+        int numW, const Real* w, Vector3<Real>* pos,
+        ThreadPool* pool = 0) const;
+
 private:
     Vector3<Real>*** mCtrlPoint;  // ctrl[unum][vnum][wnum]
     BSplineBasis<Real> mBasis[3];
+
+    // Support for the batched GetPosition.  Work stores, per worker, the
+    // control points combined along v and w.
+    class GridTaskData
+    {
+    public:
+        const BSplineVolume* Object;
+        int NumU, NumV;
+        int* Min[3];
+        Real* Basis[3];
+        Vector3<Real>* Pos;
+        Vector3<Real>* Work;
+    };
+
+    static void GridTask (int begin, int end, int worker, void* userData);
 };
 
 typedef BSplineVolume<float> BSplineVolumef;
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5CURVE2_H
 #define WM5CURVE2_H
@@ -51,6 +51,13 @@ public:
     virtual Real GetTime (Real length, int iterations = 32,
         Real tolerance = (Real)1e-06) const = 0;
 
+    // Compute times[i] = GetTime(lengths[i]) for 0 <= i < numLengths.  The
+    // arrays may be the same.  Derived classes may override this to share
+    // work between the lengths, which is most effective when the lengths
+    // are nondecreasing.
+    virtual void GetTimes (int numLengths, const Real* lengths, Real* times,
+        int iterations = 32, Real tolerance = (Real)1e-06) const;
+
     // Subdivision.
     void SubdivideByTime (int numPoints, Vector2<Real>*& points) const;
     void SubdivideByLength (int numPoints, Vector2<Real>*& points) const;
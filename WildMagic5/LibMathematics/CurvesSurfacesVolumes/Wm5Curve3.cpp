@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5Curve3.h"
@@ -153,6 +153,16 @@ Real Curve3<Real>::GetTorsion (Real t) const
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void Curve3<Real>::GetTimes (int numLengths, const Real* lengths,
+    Real* times, int iterations, Real tolerance) const
+{
+    for (int i = 0; i < numLengths; ++i)
+    {
+        times[i] = GetTime(lengths[i], iterations, tolerance);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 void Curve3<Real>::SubdivideByTime (int numPoints,
     Vector3<Real>*& points) const
 {
@@ -176,13 +186,20 @@ void Curve3<Real>::SubdivideByLength (int numPoints,
     points = new1<Vector3<Real> >(numPoints);
 
     Real delta = GetTotalLength()/(numPoints - 1);
+    Real* times = new1<Real>(numPoints);
 
-    for (int i = 0; i < numPoints; ++i)
+    int i;
+    for (i = 0; i < numPoints; ++i)
     {
-        Real length = delta*i;
-        Real t = GetTime(length);
-        points[i] = GetPosition(t);
+        times[i] = delta*i;
+    }
+    GetTimes(numPoints, times, times);
+
+    for (i = 0; i < numPoints; ++i)
+    {
+        points[i] = GetPosition(times[i]);
     }
+    delete1(times);
 }
 //----------------------------------------------------------------------------
 
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5NURBSCurve2.h"
@@ -116,6 +116,8 @@ void NURBSCurve2<Real>::SetControlPoint (int i, const Vector2<Real>& ctrl)
         {
             mCtrlPoint[mNumCtrlPoints + i] = ctrl;
         }
+
+        SingleCurve2<Real>::InvalidateLengthTable();
     }
 }
 //----------------------------------------------------------------------------
@@ -143,6 +145,8 @@ void NURBSCurve2<Real>::SetControlWeight (int i, Real weight)
         {
             mCtrlWeight[mNumCtrlPoints + i] = weight;
         }
+
+        SingleCurve2<Real>::InvalidateLengthTable();
     }
 }
 //----------------------------------------------------------------------------
@@ -161,6 +165,7 @@ template <typename Real>
 void NURBSCurve2<Real>::SetKnot (int i, Real knot)
 {
     mBasis.SetKnot(i, knot);
+    SingleCurve2<Real>::InvalidateLengthTable();
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -277,6 +282,112 @@ void NURBSCurve2<Real>::Get (Real t, Vector2<Real>* pos,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void NURBSCurve2<Real>::Get (int numT, const Real* t, Vector2<Real>* pos,
+    Vector2<Real>* der1, Vector2<Real>* der2, Vector2<Real>* der3) const
+{
+    unsigned int order = (der3 ? 3 : (der2 ? 2 : (der1 ? 1 : 0)));
+    const int numBasis = mBasis.GetDegree() + 1;
+    const int chunkSize = 256;
+    int* minIndex = new1<int>(chunkSize);
+    Real* basis = new1<Real>((order + 1)*chunkSize*numBasis);
+    Real* B[4] = { 0, 0, 0, 0 };
+    for (unsigned int r = 0; r <= order; ++r)
+    {
+        B[r] = basis + r*chunkSize*numBasis;
+    }
+
+    for (int first = 0; first < numT; first += chunkSize)
+    {
+        int count = (numT - first < chunkSize ? numT - first : chunkSize);
+        mBasis.Compute(count, t + first, order, minIndex, B[0], B[1], B[2],
+            B[3]);
+
+        for (int k = 0; k < count; ++k)
+        {
+            // The same computations as in Get for one parameter.
+            const int offset = k*numBasis;
+            const Vector2<Real>* ctrl = &mCtrlPoint[minIndex[k]];
+            const Real* weight = &mCtrlWeight[minIndex[k]];
+            int i;
+            Real tmp;
+
+            Vector2<Real> X = Vector2<Real>::ZERO;
+            Real w = (Real)0;
+            for (i = 0; i < numBasis; ++i)
+            {
+                tmp = B[0][offset + i]*weight[i];
+                X += tmp*ctrl[i];
+                w += tmp;
+            }
+            Real invW = ((Real)1)/w;
+            Vector2<Real> P = invW*X;
+            if (pos)
+            {
+                pos[first + k] = P;
+            }
+
+            if (order < 1)
+            {
+                continue;
+            }
+
+            Vector2<Real> XDer1 = Vector2<Real>::ZERO;
+            Real wDer1 = (Real)0;
+            for (i = 0; i < numBasis; ++i)
+            {
+                tmp = B[1][offset + i]*weight[i];
+                XDer1 += tmp*ctrl[i];
+                wDer1 += tmp;
+            }
+            Vector2<Real> PDer1 = invW*(XDer1 - wDer1*P);
+            if (der1)
+            {
+                der1[first + k] = PDer1;
+            }
+
+            if (order < 2)
+            {
+                continue;
+            }
+
+            Vector2<Real> XDer2 = Vector2<Real>::ZERO;
+            Real wDer2 = (Real)0;
+            for (i = 0; i < numBasis; ++i)
+            {
+                tmp = B[2][offset + i]*weight[i];
+                XDer2 += tmp*ctrl[i];
+                wDer2 += tmp;
+            }
+            Vector2<Real> PDer2 = invW*(XDer2 - ((Real)2)*wDer1*PDer1 -
+                wDer2*P);
+            if (der2)
+            {
+                der2[first + k] = PDer2;
+            }
+
+            if (order < 3)
+            {
+                continue;
+            }
+
+            Vector2<Real> XDer3 = Vector2<Real>::ZERO;
+            Real wDer3 = (Real)0;
+            for (i = 0; i < numBasis; ++i)
+            {
+                tmp = B[3][offset + i]*weight[i];
+                XDer3 += tmp*ctrl[i];
+                wDer3 += tmp;
+            }
+            der3[first + k] = invW*(XDer3 - ((Real)3)*wDer1*PDer2 -
+                ((Real)3)*wDer2*PDer1 - wDer3*P);
+        }
+    }
+
+    delete1(minIndex);
+    delete1(basis);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 BSplineBasis<Real>& NURBSCurve2<Real>::GetBasis ()
 {
     return mBasis;
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5NURBSCURVE2_H
 #define WM5NURBSCURVE2_H
@@ -96,6 +96,15 @@ public:
     void Get (Real t, Vector2<Real>* pos, Vector2<Real>* der1,
         Vector2<Real>* der2, Vector2<Real>* der3) const;
 
+    // Batch evaluation at the parameters t[0] through t[numT-1], with the
+    // outputs stored at the same indices; pass 0 for outputs you do not
+    // want.  The results are those of Get.  The basis functions are
+    // evaluated by the batched BSplineBasis::Compute, which is the fastest
+    // for nondecreasing parameters, and this function may be called
+    // concurrently.
+    void Get (int numT, const Real* t, Vector2<Real>* pos,
+        Vector2<Real>* der1, Vector2<Real>* der2, Vector2<Real>* der3) const;
+
     // Access the basis function to compute it without control points.  This
     // is useful for least squares fitting of curves.
     BSplineBasis<Real>& GetBasis ();
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5NURBSRectangle.h"
@@ -136,16 +136,10 @@ void NURBSRectangle<Real>::CreateControl (Vector3<Real>** ctrlPoint,
     int newNumUCtrlPoints = mNumUCtrlPoints + mUReplicate;
     int newNumVCtrlPoints = mNumVCtrlPoints + mVReplicate;
 
-    mCtrlPoint = new2<Vector3<Real> >(newNumUCtrlPoints,
-        newNumVCtrlPoints);
+    mCtrlPoint = new2<Vector3<Real> >(newNumVCtrlPoints,
+        newNumUCtrlPoints);
 
-    mCtrlWeight = new2<Real>(newNumUCtrlPoints, newNumVCtrlPoints);
-
-    for (int i = 1; i < newNumUCtrlPoints; ++i)
-    {
-        mCtrlPoint[i] = &mCtrlPoint[0][i*newNumVCtrlPoints];
-        mCtrlWeight[i] = &mCtrlWeight[0][i*newNumVCtrlPoints];
-    }
+    mCtrlWeight = new2<Real>(newNumVCtrlPoints, newNumUCtrlPoints);
 
     for (int iu = 0; iu < newNumUCtrlPoints; iu++)
     {
@@ -513,6 +507,150 @@ Vector3<Real> NURBSRectangle<Real>::PVV (Real u, Real v) const
     return derVV;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void NURBSRectangle<Real>::Get (int numU, const Real* u, int numV,
+    const Real* v, Vector3<Real>* pos, Vector3<Real>* derU,
+    Vector3<Real>* derV, ThreadPool* pool) const
+{
+    const int numUBasis = mBasis[0].GetDegree() + 1;
+    const int numVBasis = mBasis[1].GetDegree() + 1;
+    const int numUCtrl = mBasis[0].GetNumCtrlPoints();
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+
+    GridTaskData data;
+    data.Object = this;
+    data.NumU = numU;
+    data.NumV = numV;
+    data.UMin = new1<int>(numU);
+    data.VMin = new1<int>(numV);
+    data.UBasis = new1<Real>(2*numU*numUBasis);
+    data.VBasis = new1<Real>(2*numV*numVBasis);
+    data.Pos = pos;
+    data.DerU = derU;
+    data.DerV = derV;
+    data.Work = new1<Vector3<Real> >(2*numUCtrl*numWorkers);
+    data.WorkWeights = new1<Real>(2*numUCtrl*numWorkers);
+
+    mBasis[0].Compute(numU, u, (derU ? 1 : 0), data.UMin, data.UBasis,
+        data.UBasis + numU*numUBasis);
+    mBasis[1].Compute(numV, v, (derV ? 1 : 0), data.VMin, data.VBasis,
+        data.VBasis + numV*numVBasis);
+
+    ThreadPool::ParallelFor(pool, numV, 0, GridTask, &data);
+
+    delete1(data.UMin);
+    delete1(data.VMin);
+    delete1(data.UBasis);
+    delete1(data.VBasis);
+    delete1(data.Work);
+    delete1(data.WorkWeights);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void NURBSRectangle<Real>::GridTask (int begin, int end, int worker,
+    void* userData)
+{
+    const GridTaskData& data = *(const GridTaskData*)userData;
+    const NURBSRectangle* object = data.Object;
+    const int numUBasis = object->mBasis[0].GetDegree() + 1;
+    const int numVBasis = object->mBasis[1].GetDegree() + 1;
+    const int numUCtrl = object->mBasis[0].GetNumCtrlPoints();
+    const int numU = data.NumU;
+    const Real* uDer = data.UBasis + numU*numUBasis;
+    const Real* vDer = data.VBasis + data.NumV*numVBasis;
+    Vector3<Real>* rowX = data.Work + 2*numUCtrl*worker;
+    Vector3<Real>* rowXDerV = rowX + numUCtrl;
+    Real* rowW = data.WorkWeights + 2*numUCtrl*worker;
+    Real* rowWDerV = rowW + numUCtrl;
+    Vector3<Real> X;
+    Real w, tmp;
+    int i, j;
+
+    for (int iv = begin; iv < end; ++iv)
+    {
+        // Combine the weighted control points and the weights along v.
+        const int vMin = data.VMin[iv];
+        const Real* BV0 = data.VBasis + iv*numVBasis;
+        const Real* BV1 = vDer + iv*numVBasis;
+        for (i = 0; i < numUCtrl; ++i)
+        {
+            const Vector3<Real>* ctrl = &object->mCtrlPoint[i][vMin];
+            const Real* weight = &object->mCtrlWeight[i][vMin];
+            X = Vector3<Real>::ZERO;
+            w = (Real)0;
+            for (j = 0; j < numVBasis; ++j)
+            {
+                tmp = BV0[j]*weight[j];
+                X += tmp*ctrl[j];
+                w += tmp;
+            }
+            rowX[i] = X;
+            rowW[i] = w;
+
+            if (data.DerV)
+            {
+                X = Vector3<Real>::ZERO;
+                w = (Real)0;
+                for (j = 0; j < numVBasis; ++j)
+                {
+                    tmp = BV1[j]*weight[j];
+                    X += tmp*ctrl[j];
+                    w += tmp;
+                }
+                rowXDerV[i] = X;
+                rowWDerV[i] = w;
+            }
+        }
+
+        // Evaluate the rational curves in u.
+        const int offset = numU*iv;
+        for (int iu = 0; iu < numU; ++iu)
+        {
+            const int uMin = data.UMin[iu];
+            const Real* BU0 = data.UBasis + iu*numUBasis;
+            const Real* BU1 = uDer + iu*numUBasis;
+
+            X = Vector3<Real>::ZERO;
+            w = (Real)0;
+            for (i = 0; i < numUBasis; ++i)
+            {
+                X += BU0[i]*rowX[uMin + i];
+                w += BU0[i]*rowW[uMin + i];
+            }
+            Real invW = ((Real)1)/w;
+            Vector3<Real> P = invW*X;
+            if (data.Pos)
+            {
+                data.Pos[offset + iu] = P;
+            }
+
+            if (data.DerU)
+            {
+                X = Vector3<Real>::ZERO;
+                w = (Real)0;
+                for (i = 0; i < numUBasis; ++i)
+                {
+                    X += BU1[i]*rowX[uMin + i];
+                    w += BU1[i]*rowW[uMin + i];
+                }
+                data.DerU[offset + iu] = invW*(X - w*P);
+            }
+
+            if (data.DerV)
+            {
+                X = Vector3<Real>::ZERO;
+                w = (Real)0;
+                for (i = 0; i < numUBasis; ++i)
+                {
+                    X += BU0[i]*rowXDerV[uMin + i];
+                    w += BU0[i]*rowWDerV[uMin + i];
+                }
+                data.DerV[offset + iu] = invW*(X - w*P);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
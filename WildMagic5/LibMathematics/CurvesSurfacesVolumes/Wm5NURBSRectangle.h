@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5NURBSRECTANGLE_H
 #define WM5NURBSRECTANGLE_H
@@ -12,6 +12,7 @@
 #include "Wm5MathematicsLIB.h"
 #include "Wm5ParametricSurface.h"
 #include "Wm5BSplineBasis.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -100,6 +101,19 @@ public:
         Vector3<Real>* derV, Vector3<Real>* derUU, Vector3<Real>* derUV,
         Vector3<Real>* derVV) const;
 
+    // Batch evaluation on the grid of parameters (u[iu],v[iv]) for
+    // 0 <= iu < numU and 0 <= iv < numV, with the outputs stored at index
+    // iu+numU*iv; pass 0 for outputs you do not want.  The basis functions
+    // are evaluated once per u and once per v by the batched
+    // BSplineBasis::Compute, which is the fastest for nondecreasing
+    // parameters.  Each row of constant v combines the control points along
+    // v first, which leaves a curve in u to evaluate, so an output costs
+    // d0+1 control point operations instead of (d0+1)*(d1+1).  When 'pool'
+    // is not null, the rows are evaluated concurrently.
+    void Get (int numU, const Real* u, int numV, const Real* v,
+        Vector3<Real>* pos, Vector3<Real>* derU, Vector3<Real>* derV,
+        ThreadPool* pool = 0) const;
+
 protected:
     // Replicate the necessary number of control points when the Create
     // function has bLoop equal to true, in which case the spline surface
@@ -112,6 +126,28 @@ protected:
     bool mLoop[2];
     BSplineBasis<Real> mBasis[2];
     int mUReplicate, mVReplicate;
+
+    // Support for the batched Get.  UBasis stores the basis values for all
+    // u followed by their derivatives, and VBasis the same for v.  Work and
+    // WorkWeights store, per worker, the weighted control points and the
+    // weights combined along v for the position and for the v-derivative.
+    class GridTaskData
+    {
+    public:
+        const NURBSRectangle* Object;
+        int NumU, NumV;
+        int* UMin;
+        int* VMin;
+        Real* UBasis;
+        Real* VBasis;
+        Vector3<Real>* Pos;
+        Vector3<Real>* DerU;
+        Vector3<Real>* DerV;
+        Vector3<Real>* Work;
+        Real* WorkWeights;
+    };
+
+    static void GridTask (int begin, int end, int worker, void* userData);
 };
 
 typedef NURBSRectangle<float> NURBSRectanglef;
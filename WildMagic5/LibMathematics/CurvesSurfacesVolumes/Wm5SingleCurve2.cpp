@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5SingleCurve2.h"
@@ -16,7 +16,9 @@ namespace Wm5
 template <typename Real>
 SingleCurve2<Real>::SingleCurve2 (Real tmin, Real tmax)
     :
-    Curve2<Real>(tmin, tmax)
+    Curve2<Real>(tmin, tmax),
+    mUseLengthTable(false),
+    mLengthTableTolerance((Real)1e-06)
 {
 }
 //----------------------------------------------------------------------------
@@ -33,6 +35,12 @@ Real SingleCurve2<Real>::GetLength (Real t0, Real t1) const
     assertion(mTMin <= t1 && t1 <= mTMax, "Invalid input\n");
     assertion(t0 <= t1, "Invalid input\n");
 
+    if (IsLengthTableCurrent())
+    {
+        return mLengthTable.GetLength(t1, GetSpeedWithData, (void*)this) -
+            mLengthTable.GetLength(t0, GetSpeedWithData, (void*)this);
+    }
+
     return Integrate1<Real>::RombergIntegral(8, t0, t1, GetSpeedWithData,
         (void*)this);
 }
@@ -41,6 +49,12 @@ template <typename Real>
 Real SingleCurve2<Real>::GetTime (Real length, int iterations,
     Real tolerance) const
 {
+    if (IsLengthTableCurrent())
+    {
+        return mLengthTable.GetTime(length, iterations, tolerance,
+            GetSpeedWithData, (void*)this);
+    }
+
     if (length <= (Real)0)
     {
         return mTMin;
@@ -128,6 +142,66 @@ Real SingleCurve2<Real>::GetTime (Real length, int iterations,
     return t;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void SingleCurve2<Real>::GetTimes (int numLengths, const Real* lengths,
+    Real* times, int iterations, Real tolerance) const
+{
+    if (IsLengthTableCurrent())
+    {
+        mLengthTable.GetTimes(numLengths, lengths, times, iterations,
+            tolerance, GetSpeedWithData, (void*)this);
+        return;
+    }
+
+    Curve2<Real>::GetTimes(numLengths, lengths, times, iterations,
+        tolerance);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingleCurve2<Real>::EnableLengthTable (Real tolerance)
+{
+    mUseLengthTable = true;
+    mLengthTableTolerance = tolerance;
+    UpdateLengthTable();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingleCurve2<Real>::DisableLengthTable ()
+{
+    mUseLengthTable = false;
+    mLengthTable.Clear();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool SingleCurve2<Real>::IsLengthTableEnabled () const
+{
+    return mUseLengthTable;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingleCurve2<Real>::InvalidateLengthTable ()
+{
+    mLengthTable.Clear();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void SingleCurve2<Real>::UpdateLengthTable ()
+{
+    if (mUseLengthTable)
+    {
+        mLengthTable.Create(mTMin, mTMax, mLengthTableTolerance,
+            GetSpeedWithData, (void*)this);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool SingleCurve2<Real>::IsLengthTableCurrent () const
+{
+    return mUseLengthTable && mLengthTable.IsCreated()
+        && mLengthTable.GetMinTime() == mTMin
+        && mLengthTable.GetMaxTime() == mTMax;
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
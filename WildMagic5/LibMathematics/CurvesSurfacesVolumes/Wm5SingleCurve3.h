@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/07/23)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5SINGLECURVE3_H
 #define WM5SINGLECURVE3_H
 
 #include "Wm5MathematicsLIB.h"
 #include "Wm5Curve3.h"
+#include "Wm5ArcLengthTable.h"
 
 namespace Wm5
 {
@@ -26,6 +27,32 @@ public:
     virtual Real GetLength (Real t0, Real t1) const;
     virtual Real GetTime (Real length, int iterations = 32,
         Real tolerance = (Real)1e-06) const;
+    virtual void GetTimes (int numLengths, const Real* lengths, Real* times,
+        int iterations = 32, Real tolerance = (Real)1e-06) const;
+
+    // The optional arc-length table.  Without it, GetLength integrates the
+    // speed from t0 to t1 with an order-8 Romberg integration, and GetTime
+    // makes such an integration per Newton iteration, so uniform sampling
+    // of a long curve evaluates the speed thousands of times per sample.
+    // EnableLengthTable builds the table, with lengths accurate to about
+    // tolerance times the total length (see ArcLengthTable), and then
+    // GetLength, GetTime, GetTimes, and SubdivideByLength use it.  The
+    // derived classes invalidate the table when their control data is
+    // changed through their member functions, and the table is not used
+    // after the time interval changes.  The queries then integrate the
+    // speed until UpdateLengthTable rebuilds the table, so call it once
+    // after a batch of changes.  A caller that changes the curve by other
+    // means, for example through the basis of a B-spline, must call
+    // UpdateLengthTable or InvalidateLengthTable.
+    //
+    // The queries do not modify the curve, so several threads may query
+    // the same curve.  The functions below must not be called while
+    // another thread queries the curve.
+    void EnableLengthTable (Real tolerance = (Real)1e-06);
+    void DisableLengthTable ();
+    bool IsLengthTableEnabled () const;
+    void UpdateLengthTable ();
+    void InvalidateLengthTable ();
 
 protected:
     using Curve3<Real>::mTMin;
@@ -34,6 +61,14 @@ protected:
     using Curve3<Real>::GetTotalLength;
 
     static Real GetSpeedWithData (Real t, void* data);
+
+    // The queries use the table when it is enabled, built, and built for
+    // the current time interval.
+    bool IsLengthTableCurrent () const;
+
+    bool mUseLengthTable;
+    Real mLengthTableTolerance;
+    ArcLengthTable<Real> mLengthTable;
 };
 
 typedef SingleCurve3<float> SingleCurve3f;
@@ -4,18 +4,20 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/05/22)
+// File Version: 5.0.4 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5IntpThinPlateSpline2.h"
 #include "Wm5LinearSystem.h"
+#include "Wm5LUDecomposition.h"
 
 namespace Wm5
 {
 //----------------------------------------------------------------------------
 template <typename Real>
 IntpThinPlateSpline2<Real>::IntpThinPlateSpline2 (int quantity, Real* X,
-    Real* Y, Real* F, Real smooth, bool owner, bool transformToUnitSquare)
+    Real* Y, Real* F, Real smooth, bool owner, bool transformToUnitSquare,
+    ThreadPool* pool)
     :
     mSmooth(smooth)
 {
@@ -92,19 +94,14 @@ IntpThinPlateSpline2<Real>::IntpThinPlateSpline2 (int quantity, Real* X,
     GMatrix<Real> AMat(mQuantity, mQuantity);
     for (row = 0; row < mQuantity; ++row)
     {
-        for (col = 0; col < mQuantity; ++col)
+        AMat[row][row] = mSmooth;
+        for (col = 0; col < row; ++col)
         {
-            if (row == col)
-            {
-                AMat[row][col] = mSmooth;
-            }
-            else
-            {
-                Real dx = mX[row] - mX[col];
-                Real dy = mY[row] - mY[col];
-                Real t = Math<Real>::Sqrt(dx*dx + dy*dy);
-                AMat[row][col] = Kernel(t);
-            }
+            Real dx = mX[row] - mX[col];
+            Real dy = mY[row] - mY[col];
+            Real t = Math<Real>::Sqrt(dx*dx + dy*dy);
+            AMat[row][col] = Kernel(t);
+            AMat[col][row] = AMat[row][col];
         }
     }
 
@@ -117,68 +114,67 @@ IntpThinPlateSpline2<Real>::IntpThinPlateSpline2 (int quantity, Real* X,
         BMat[row][2] = mY[row];
     }
 
-    // Compute A^{-1}.
-    GMatrix<Real> invAMat(mQuantity, mQuantity);
-    if (!LinearSystem<Real>().Inverse(AMat, invAMat))
+    // Factor A.  The coefficients are computed from solutions of linear
+    // systems with A, so the inverse of A is not needed.
+    LUDecomposition<Real> factorA(AMat, pool);
+    if (!factorA.IsInvertible())
     {
         return;
     }
 
-    // Compute P = B^t A^{-1}  [3xN matrix].
-    GMatrix<Real> PMat = BMat.TransposeTimes(invAMat);
-
-    // Compute Q = P B = B^t A^{-1} B  [3x3 matrix].
-    GMatrix<Real> QMat = PMat*BMat;
-
-    // Compute Q^{-1}.
-    GMatrix<Real> invQMat(3, 3);
-    if (!LinearSystem<Real>().Inverse(QMat, invQMat))
-    {
-        return;
-    }
-
-    // Compute P*z.
-    Real prod[3];
-    for (row = 0; row < 3; ++row)
+    // Solve A*[C|d] = [B|z] for C = A^{-1}*B [Nx3 matrix] and
+    // d = A^{-1}*z [Nx1 vector] in one pass over the factors.
+    GMatrix<Real> CDMat(mQuantity, 4);
+    for (row = 0; row < mQuantity; ++row)
     {
-        prod[row] = (Real)0;
-        for (i = 0; i < mQuantity; ++i)
+        for (i = 0; i < 3; ++i)
         {
-            prod[row] += PMat[row][i]*F[i];
+            CDMat[row][i] = BMat[row][i];
         }
+        CDMat[row][3] = F[row];
     }
+    factorA.Solve(CDMat, CDMat);
 
-    // Compute 'b' vector for smooth thin plate spline.
+    // Compute Q = B^t A^{-1} B = B^t C [3x3 matrix] and
+    // B^t A^{-1} z = B^t d.
+    GMatrix<Real> QMat(3, 3);
+    Real prod[3];
     for (row = 0; row < 3; ++row)
     {
-        mB[row] = (Real)0;
-        for (i = 0; i < 3; ++i)
+        for (col = 0; col <= 3; ++col)
         {
-            mB[row] += invQMat[row][i]*prod[i];
+            Real sum = (Real)0;
+            for (i = 0; i < mQuantity; ++i)
+            {
+                sum += BMat[i][row]*CDMat[i][col];
+            }
+            if (col < 3)
+            {
+                QMat[row][col] = sum;
+            }
+            else
+            {
+                prod[row] = sum;
+            }
         }
     }
 
-    // Compute z-B*b.
-    Real* tmp = new1<Real>(mQuantity);
-    for (row = 0; row < mQuantity; ++row)
+    // Compute 'b' vector for smooth thin plate spline, Q*b = B^t A^{-1} z.
+    if (!LinearSystem<Real>().Solve(QMat, prod, mB))
     {
-        tmp[row] = F[row];
-        for (i = 0; i < 3; ++i)
-        {
-            tmp[row] -= BMat[row][i]*mB[i];
-        }
+        return;
     }
 
-    // Compute 'a' vector for smooth thin plate spline.
+    // Compute 'a' vector for smooth thin plate spline,
+    // a = A^{-1}*(z-B*b) = d-C*b.
     for (row = 0; row < mQuantity; ++row)
     {
-        mA[row] = (Real)0;
-        for (i = 0; i < mQuantity; ++i)
+        mA[row] = CDMat[row][3];
+        for (i = 0; i < 3; ++i)
         {
-            mA[row] += invAMat[row][i]*tmp[i];
+            mA[row] -= CDMat[row][i]*mB[i];
         }
     }
-    delete1(tmp);
 
     mInitialized = true;
 
@@ -277,6 +273,38 @@ Real IntpThinPlateSpline2<Real>::operator() (Real x, Real y)
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void IntpThinPlateSpline2<Real>::Evaluate (int numPoints, const Real* x,
+    const Real* y, Real* values, Real maxError, ThreadPool* pool) const
+{
+    if (!mInitialized)
+    {
+        for (int i = 0; i < numPoints; ++i)
+        {
+            values[i] = Math<Real>::MAX_REAL;
+        }
+        return;
+    }
+
+    ClusterTree tree;
+    EvaluateTaskData data;
+    data.Object = this;
+    data.Tree = 0;
+    data.X = x;
+    data.Y = y;
+    data.Values = values;
+    data.NumPoints = numPoints;
+    data.MaxError = maxError;
+    if (maxError > (Real)0)
+    {
+        BuildClusterTree(tree);
+        data.Tree = &tree;
+    }
+
+    int numTiles = (numPoints + TILE_SIZE - 1)/TILE_SIZE;
+    ThreadPool::ParallelFor(pool, numTiles, 0, EvaluateTask, &data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 Real IntpThinPlateSpline2<Real>::Kernel (Real t)
 {
     if (t > (Real)0)
@@ -287,6 +315,319 @@ Real IntpThinPlateSpline2<Real>::Kernel (Real t)
     return (Real)0;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void IntpThinPlateSpline2<Real>::BuildClusterTree (ClusterTree& tree) const
+{
+    int* indices = new1<int>(mQuantity);
+    int i;
+    for (i = 0; i < mQuantity; ++i)
+    {
+        indices[i] = i;
+    }
+
+    tree.X.resize(mQuantity);
+    tree.Y.resize(mQuantity);
+    tree.A.resize(mQuantity);
+    BuildCluster(tree, indices, 0, mQuantity);
+    delete1(indices);
+
+    // Compute the extent, the weight, and the moments of each cluster from
+    // the permuted control points.
+    const int numClusters = (int)tree.Clusters.size();
+    tree.Moments.resize(numClusters*NUM_MOMENTS);
+    tree.TotalWeight = (Real)0;
+    for (int c = 0; c < numClusters; ++c)
+    {
+        Cluster& cluster = tree.Clusters[c];
+        Real* P = &tree.Moments[c*NUM_MOMENTS];
+        Real* S = P + 2*(MAX_ORDER + 2);
+        memset(P, 0, NUM_MOMENTS*sizeof(Real));
+
+        Real sqrRadius = (Real)0;
+        cluster.Weight = (Real)0;
+        for (i = cluster.First; i < cluster.Last; ++i)
+        {
+            Real tx = tree.X[i] - cluster.Center[0];
+            Real ty = tree.Y[i] - cluster.Center[1];
+            Real sqrLength = tx*tx + ty*ty;
+            if (sqrLength > sqrRadius)
+            {
+                sqrRadius = sqrLength;
+            }
+            cluster.Weight += Math<Real>::FAbs(tree.A[i]);
+
+            // The powers a*t^k as complex numbers.
+            Real powerRe = tree.A[i], powerIm = (Real)0;
+            for (int k = 0; k <= MAX_ORDER + 1; ++k)
+            {
+                P[2*k] += powerRe;
+                P[2*k + 1] += powerIm;
+                if (k <= MAX_ORDER)
+                {
+                    S[2*k] += sqrLength*powerRe;
+                    S[2*k + 1] += sqrLength*powerIm;
+                }
+                Real save = powerRe*tx - powerIm*ty;
+                powerIm = powerRe*ty + powerIm*tx;
+                powerRe = save;
+            }
+        }
+        cluster.Radius = Math<Real>::Sqrt(sqrRadius);
+    }
+    tree.TotalWeight = tree.Clusters[0].Weight;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int IntpThinPlateSpline2<Real>::BuildCluster (ClusterTree& tree,
+    int* indices, int first, int last) const
+{
+    const int index = (int)tree.Clusters.size();
+    tree.Clusters.push_back(Cluster());
+
+    Real xMin = mX[indices[first]], xMax = xMin;
+    Real yMin = mY[indices[first]], yMax = yMin;
+    int i;
+    for (i = first + 1; i < last; ++i)
+    {
+        Real x = mX[indices[i]], y = mY[indices[i]];
+        if (x < xMin)
+        {
+            xMin = x;
+        }
+        else if (x > xMax)
+        {
+            xMax = x;
+        }
+        if (y < yMin)
+        {
+            yMin = y;
+        }
+        else if (y > yMax)
+        {
+            yMax = y;
+        }
+    }
+
+    Cluster cluster;
+    cluster.Center[0] = ((Real)0.5)*(xMin + xMax);
+    cluster.Center[1] = ((Real)0.5)*(yMin + yMax);
+    cluster.Radius = (Real)0;
+    cluster.Weight = (Real)0;
+    cluster.First = first;
+    cluster.Last = last;
+
+    if (last - first > LEAF_SIZE)
+    {
+        // Split at the median along the longer side of the bounding box.
+        const Real* key = (xMax - xMin >= yMax - yMin ? mX : mY);
+        const int middle = (first + last)/2;
+        std::vector<std::pair<Real,int> > items(last - first);
+        for (i = first; i < last; ++i)
+        {
+            items[i - first] = std::make_pair(key[indices[i]], indices[i]);
+        }
+        std::nth_element(items.begin(), items.begin() + (middle - first),
+            items.end());
+        for (i = first; i < last; ++i)
+        {
+            indices[i] = items[i - first].second;
+        }
+
+        cluster.Child[0] = BuildCluster(tree, indices, first, middle);
+        cluster.Child[1] = BuildCluster(tree, indices, middle, last);
+    }
+    else
+    {
+        cluster.Child[0] = -1;
+        cluster.Child[1] = -1;
+        for (i = first; i < last; ++i)
+        {
+            tree.X[i] = mX[indices[i]];
+            tree.Y[i] = mY[indices[i]];
+            tree.A[i] = mA[indices[i]];
+        }
+    }
+
+    tree.Clusters[index] = cluster;
+    return index;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real IntpThinPlateSpline2<Real>::EvaluateFarField (const ClusterTree& tree,
+    Real x, Real y, Real maxError) const
+{
+    // Each cluster is allowed the fraction Weight/TotalWeight of maxError,
+    // so the errors of the expansions sum to at most maxError.
+    const Real scale = (tree.TotalWeight > (Real)0 ?
+        maxError/tree.TotalWeight : (Real)0);
+
+    // The tree is balanced, so its depth is about log2(n/LEAF_SIZE).
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    Real sum = (Real)0;
+    while (top > 0)
+    {
+        const int index = stack[--top];
+        const Cluster& cluster = tree.Clusters[index];
+        const Real wx = x - cluster.Center[0];
+        const Real wy = y - cluster.Center[1];
+        const Real sqrDistance = wx*wx + wy*wy;
+        const Real r = cluster.Radius;
+
+        if (sqrDistance > r*r)
+        {
+            // Choose the smallest order p for which the truncation error
+            // 2*W*(R+r)*r*rho^{p+1}/((p+1)*(p+2)*(1-rho)) is within the
+            // budget of the cluster, where R is the distance to the center
+            // and rho = r/R.
+            const Real distance = Math<Real>::Sqrt(sqrDistance);
+            const Real rho = r/distance;
+            const Real budget = scale*cluster.Weight;
+            Real term = ((Real)2)*cluster.Weight*(distance + r)*r*rho/
+                ((Real)1 - rho);
+            Real bound = ((Real)0.5)*term;
+            int order = 0;
+            while (bound > budget && order < MAX_ORDER)
+            {
+                ++order;
+                term *= rho;
+                bound = term/(Real)((order + 1)*(order + 2));
+            }
+
+            if (bound <= budget)
+            {
+                // The expansion of sum_j a[j]*|w-t[j]|^2*log|w-t[j]| for
+                // the complex number w = (x,y) - center is
+                //   log|w|*(P[0]*|w|^2 - 2*Re(conj(w)*P[1]) + S[0])
+                //   + S[0] - Re(conj(w)*P[1])
+                //   + Re(sum_{m=1}^{p} (conj(w)*P[m+1] - S[m])/w^m/(m(m+1)))
+                // and the kernel is twice the summand.
+                const Real* P = &tree.Moments[index*NUM_MOMENTS];
+                const Real* S = P + 2*(MAX_ORDER + 2);
+                const Real dotP1 = wx*P[2] + wy*P[3];
+                Real value = ((Real)0.5)*Math<Real>::Log(sqrDistance)*(
+                    P[0]*sqrDistance - ((Real)2)*dotP1 + S[0]) + S[0] -
+                    dotP1;
+
+                const Real invRe = wx/sqrDistance, invIm = -wy/sqrDistance;
+                Real powerRe = (Real)1, powerIm = (Real)0;
+                for (int m = 1; m <= order; ++m)
+                {
+                    Real save = powerRe*invRe - powerIm*invIm;
+                    powerIm = powerRe*invIm + powerIm*invRe;
+                    powerRe = save;
+
+                    const Real* Pm = &P[2*(m + 1)];
+                    Real cRe = wx*Pm[0] + wy*Pm[1] - S[2*m];
+                    Real cIm = wx*Pm[1] - wy*Pm[0] - S[2*m + 1];
+                    value += (cRe*powerRe - cIm*powerIm)/(Real)(m*(m + 1));
+                }
+                sum += ((Real)2)*value;
+                continue;
+            }
+        }
+
+        if (cluster.Child[0] < 0)
+        {
+            for (int i = cluster.First; i < cluster.Last; ++i)
+            {
+                Real dx = x - tree.X[i];
+                Real dy = y - tree.Y[i];
+                Real t2 = dx*dx + dy*dy;
+                if (t2 > (Real)0)
+                {
+                    sum += tree.A[i]*t2*Math<Real>::Log(t2);
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = cluster.Child[0];
+            stack[top++] = cluster.Child[1];
+        }
+    }
+    return sum;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void IntpThinPlateSpline2<Real>::EvaluateTile (int numPoints,
+    const Real* x, const Real* y, Real* values) const
+{
+    // The points of the tile are the inner loop, so each control point is
+    // loaded once per tile.  The loop has a constant length; the padding
+    // points are discarded.
+    Real qx[TILE_SIZE], qy[TILE_SIZE], sum[TILE_SIZE];
+    int i, j;
+    for (j = 0; j < TILE_SIZE; ++j)
+    {
+        if (j < numPoints)
+        {
+            qx[j] = (x[j] - mXMin)*mXInvRange;
+            qy[j] = (y[j] - mYMin)*mYInvRange;
+        }
+        else
+        {
+            qx[j] = (Real)0;
+            qy[j] = (Real)0;
+        }
+        sum[j] = (Real)0;
+    }
+
+    for (i = 0; i < mQuantity; ++i)
+    {
+        const Real cx = mX[i], cy = mY[i], a = mA[i];
+        for (j = 0; j < TILE_SIZE; ++j)
+        {
+            Real dx = qx[j] - cx;
+            Real dy = qy[j] - cy;
+            Real t2 = dx*dx + dy*dy;
+            if (t2 > (Real)0)
+            {
+                sum[j] += a*t2*Math<Real>::Log(t2);
+            }
+        }
+    }
+
+    for (j = 0; j < numPoints; ++j)
+    {
+        values[j] = mB[0] + mB[1]*qx[j] + mB[2]*qy[j] + sum[j];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void IntpThinPlateSpline2<Real>::EvaluateTask (int begin, int end, int,
+    void* userData)
+{
+    const EvaluateTaskData& data = *(const EvaluateTaskData*)userData;
+    const IntpThinPlateSpline2* object = data.Object;
+
+    for (int t = begin; t < end; ++t)
+    {
+        const int first = t*TILE_SIZE;
+        const int numPoints = (first + TILE_SIZE < data.NumPoints ?
+            TILE_SIZE : data.NumPoints - first);
+
+        if (data.Tree)
+        {
+            for (int j = first; j < first + numPoints; ++j)
+            {
+                Real x = (data.X[j] - object->mXMin)*object->mXInvRange;
+                Real y = (data.Y[j] - object->mYMin)*object->mYInvRange;
+                data.Values[j] = object->mB[0] + object->mB[1]*x +
+                    object->mB[2]*y + object->EvaluateFarField(*data.Tree,
+                    x, y, data.MaxError);
+            }
+        }
+        else
+        {
+            object->EvaluateTile(numPoints, &data.X[first], &data.Y[first],
+                &data.Values[first]);
+        }
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
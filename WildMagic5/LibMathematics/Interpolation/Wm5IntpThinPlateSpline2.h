@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/05/22)
+// File Version: 5.0.4 (2026/10/19)
 
 #ifndef WM5INTPTHINPLATESPLINE2_H
 #define WM5INTPTHINPLATESPLINE2_H
@@ -17,6 +17,7 @@
 // rotations of (x,y) but not to scaling.
 
 #include "Wm5MathematicsLIB.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -28,9 +29,13 @@ public:
     // Construction and destruction.  Data points are (x,y,f(x,y)).  The
     // smoothing parameter must be nonnegative.  If you want the class to
     // delete the input arrays during destruction, set owner to 'true';
-    // otherwise, you own the arrays and must delete them yourself.
+    // otherwise, you own the arrays and must delete them yourself.  The
+    // coefficients are the solution of a linear system of size 'quantity',
+    // which is factored with LUDecomposition on the threads of 'pool' when
+    // it is not null.
     IntpThinPlateSpline2 (int quantity, Real* X, Real* Y,
-        Real* F, Real smooth, bool owner, bool transformToUnitSquare);
+        Real* F, Real smooth, bool owner, bool transformToUnitSquare,
+        ThreadPool* pool = 0);
 
     ~IntpThinPlateSpline2 ();
 
@@ -56,6 +61,22 @@ public:
     // returns 'false', this operator will always return MAX_REAL.
     Real operator() (Real x, Real y);
 
+    // Evaluate the interpolator at many points, values[i] = f(x[i],y[i]).
+    // The points are processed in tiles of TILE_SIZE points, and the tiles
+    // are distributed to the threads of 'pool' when it is not null.  When
+    // maxError is zero, each value is the sum over all control points, as
+    // for operator().  When maxError is positive, the control points are
+    // grouped into a tree of clusters, and the sum over a cluster far from
+    // the point is replaced by a multipole expansion of the kernel, the
+    // expansion of Beatson and Newsam for r^2*log(r).  The order of each
+    // expansion is chosen by an error bound so that the difference from the
+    // exact sum is at most maxError (up to rounding errors).  The cost is
+    // then about logarithmic in the number of control points instead of
+    // linear.  The tree is built on each call, so call this function with
+    // many points at a time.
+    void Evaluate (int numPoints, const Real* x, const Real* y,
+        Real* values, Real maxError = (Real)0, ThreadPool* pool = 0) const;
+
     // Kernel(t) = t^2*log(t^2)
     static Real Kernel (Real t);
 
@@ -75,6 +96,63 @@ private:
     // Extent of input data.
     Real mXMin, mXMax, mXInvRange;
     Real mYMin, mYMax, mYInvRange;
+
+    // Support for Evaluate.  A cluster stores the moments of the A[]
+    // coefficients of its control points about its center, the complex
+    // numbers P[k] = sum_j a[j]*t[j]^k for 0 <= k <= MAX_ORDER+1 and
+    // S[m] = sum_j a[j]*|t[j]|^2*t[j]^m for 0 <= m <= MAX_ORDER, where t[j]
+    // is the control point relative to the center.  The clusters with
+    // Child[0] < 0 are leaves of at most LEAF_SIZE control points.
+    enum
+    {
+        TILE_SIZE = 64,
+        LEAF_SIZE = 32,
+        MAX_ORDER = 16,
+        NUM_MOMENTS = 4*MAX_ORDER + 6
+    };
+
+    class Cluster
+    {
+    public:
+        Real Center[2];
+        Real Radius, Weight;
+        int First, Last, Child[2];
+    };
+
+    // The control points are permuted so that those of a cluster are
+    // contiguous.
+    class ClusterTree
+    {
+    public:
+        std::vector<Cluster> Clusters;
+        std::vector<Real> X, Y, A, Moments;
+        Real TotalWeight;
+    };
+
+    void BuildClusterTree (ClusterTree& tree) const;
+    int BuildCluster (ClusterTree& tree, int* indices, int first, int last)
+        const;
+    Real EvaluateFarField (const ClusterTree& tree, Real x, Real y,
+        Real maxError) const;
+
+    // The sums over all control points for at most TILE_SIZE points.
+    void EvaluateTile (int numPoints, const Real* x, const Real* y,
+        Real* values) const;
+
+    class EvaluateTaskData
+    {
+    public:
+        const IntpThinPlateSpline2* Object;
+        const ClusterTree* Tree;
+        const Real* X;
+        const Real* Y;
+        Real* Values;
+        int NumPoints;
+        Real MaxError;
+    };
+
+    static void EvaluateTask (int begin, int end, int worker,
+        void* userData);
 };
 
 typedef IntpThinPlateSpline2<float> IntpThinPlateSpline2f;
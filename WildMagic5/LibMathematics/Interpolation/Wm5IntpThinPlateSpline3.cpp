@@ -4,11 +4,12 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/05/22)
+// File Version: 5.0.4 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5IntpThinPlateSpline3.h"
 #include "Wm5LinearSystem.h"
+#include "Wm5LUDecomposition.h"
 
 namespace Wm5
 {
@@ -16,7 +17,7 @@ namespace Wm5
 template <typename Real>
 IntpThinPlateSpline3<Real>::IntpThinPlateSpline3 (int quantity,
     Real* X, Real* Y, Real* Z, Real* F, Real smooth, bool owner,
-    bool transformToUnitCube)
+    bool transformToUnitCube, ThreadPool* pool)
     :
     mSmooth(smooth)
 {
@@ -117,20 +118,15 @@ IntpThinPlateSpline3<Real>::IntpThinPlateSpline3 (int quantity,
     GMatrix<Real> AMat(mQuantity, mQuantity);
     for (row = 0; row < mQuantity; ++row)
     {
-        for (col = 0; col < mQuantity; ++col)
+        AMat[row][row] = mSmooth;
+        for (col = 0; col < row; ++col)
         {
-            if (row == col)
-            {
-                AMat[row][col] = mSmooth;
-            }
-            else
-            {
-                Real dx = mX[row] - mX[col];
-                Real dy = mY[row] - mY[col];
-                Real dz = mZ[row] - mZ[col];
-                Real t = Math<Real>::Sqrt(dx*dx + dy*dy + dz*dz);
-                AMat[row][col] = Kernel(t);
-            }
+            Real dx = mX[row] - mX[col];
+            Real dy = mY[row] - mY[col];
+            Real dz = mZ[row] - mZ[col];
+            Real t = Math<Real>::Sqrt(dx*dx + dy*dy + dz*dz);
+            AMat[row][col] = Kernel(t);
+            AMat[col][row] = AMat[row][col];
         }
     }
 
@@ -144,68 +140,67 @@ IntpThinPlateSpline3<Real>::IntpThinPlateSpline3 (int quantity,
         BMat[row][3] = mZ[row];
     }
 
-    // Compute A^{-1}.
-    GMatrix<Real> invAMat(mQuantity, mQuantity);
-    if (!LinearSystem<Real>().Inverse(AMat, invAMat))
+    // Factor A.  The coefficients are computed from solutions of linear
+    // systems with A, so the inverse of A is not needed.
+    LUDecomposition<Real> factorA(AMat, pool);
+    if (!factorA.IsInvertible())
     {
         return;
     }
 
-    // Compute P = B^t A^{-1} [4xN matrix].
-    GMatrix<Real> PMat = BMat.TransposeTimes(invAMat);
-
-    // Compute Q = P B = B^t A^{-1} B  [4x4 matrix].
-    GMatrix<Real> QMat = PMat*BMat;
-
-    // Compute Q^{-1}.
-    GMatrix<Real> invQMat(4, 4);
-    if (!LinearSystem<Real>().Inverse(QMat, invQMat))
-    {
-        return;
-    }
-
-    // Compute P*w.
-    Real prod[4];
-    for (row = 0; row < 4; ++row)
+    // Solve A*[C|d] = [B|w] for C = A^{-1}*B [Nx4 matrix] and
+    // d = A^{-1}*w [Nx1 vector] in one pass over the factors.
+    GMatrix<Real> CDMat(mQuantity, 5);
+    for (row = 0; row < mQuantity; ++row)
     {
-        prod[row] = (Real)0;
-        for (i = 0; i < mQuantity; ++i)
+        for (i = 0; i < 4; ++i)
         {
-            prod[row] += PMat[row][i]*F[i];
+            CDMat[row][i] = BMat[row][i];
         }
+        CDMat[row][4] = F[row];
     }
+    factorA.Solve(CDMat, CDMat);
 
-    // Compute 'b' vector for smooth thin plate spline.
+    // Compute Q = B^t A^{-1} B = B^t C [4x4 matrix] and
+    // B^t A^{-1} w = B^t d.
+    GMatrix<Real> QMat(4, 4);
+    Real prod[4];
     for (row = 0; row < 4; ++row)
     {
-        mB[row] = (Real)0;
-        for (i = 0; i < 4; ++i)
+        for (col = 0; col <= 4; ++col)
         {
-            mB[row] += invQMat[row][i]*prod[i];
+            Real sum = (Real)0;
+            for (i = 0; i < mQuantity; ++i)
+            {
+                sum += BMat[i][row]*CDMat[i][col];
+            }
+            if (col < 4)
+            {
+                QMat[row][col] = sum;
+            }
+            else
+            {
+                prod[row] = sum;
+            }
         }
     }
 
-    // Compute w-B*b.
-    Real* tmp = new1<Real>(mQuantity);
-    for (row = 0; row < mQuantity; ++row)
+    // Compute 'b' vector for smooth thin plate spline, Q*b = B^t A^{-1} w.
+    if (!LinearSystem<Real>().Solve(QMat, prod, mB))
     {
-        tmp[row] = F[row];
-        for (i = 0; i < 4; ++i)
-        {
-            tmp[row] -= BMat[row][i]*mB[i];
-        }
+        return;
     }
 
-    // Compute 'a' vector for smooth thin plate spline.
+    // Compute 'a' vector for smooth thin plate spline,
+    // a = A^{-1}*(w-B*b) = d-C*b.
     for (row = 0; row < mQuantity; ++row)
     {
-        mA[row] = (Real)0;
-        for (i = 0; i < mQuantity; ++i)
+        mA[row] = CDMat[row][4];
+        for (i = 0; i < 4; ++i)
         {
-            mA[row] += invAMat[row][i]*tmp[i];
+            mA[row] -= CDMat[row][i]*mB[i];
         }
     }
-    delete1(tmp);
 
     mInitialized = true;
 
@@ -309,11 +304,99 @@ Real IntpThinPlateSpline3<Real>::ComputeFunctional () const
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+void IntpThinPlateSpline3<Real>::Evaluate (int numPoints, const Real* x,
+    const Real* y, const Real* z, Real* values, ThreadPool* pool) const
+{
+    if (!mInitialized)
+    {
+        for (int i = 0; i < numPoints; ++i)
+        {
+            values[i] = Math<Real>::MAX_REAL;
+        }
+        return;
+    }
+
+    EvaluateTaskData data;
+    data.Object = this;
+    data.X = x;
+    data.Y = y;
+    data.Z = z;
+    data.Values = values;
+    data.NumPoints = numPoints;
+
+    int numTiles = (numPoints + TILE_SIZE - 1)/TILE_SIZE;
+    ThreadPool::ParallelFor(pool, numTiles, 0, EvaluateTask, &data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 Real IntpThinPlateSpline3<Real>::Kernel (Real t)
 {
     return -Math<Real>::FAbs(t);
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void IntpThinPlateSpline3<Real>::EvaluateTile (int numPoints,
+    const Real* x, const Real* y, const Real* z, Real* values) const
+{
+    // The points of the tile are the inner loop, so each control point is
+    // loaded once per tile.  The loop has a constant length; the padding
+    // points are discarded.
+    Real qx[TILE_SIZE], qy[TILE_SIZE], qz[TILE_SIZE], sum[TILE_SIZE];
+    int i, j;
+    for (j = 0; j < TILE_SIZE; ++j)
+    {
+        if (j < numPoints)
+        {
+            qx[j] = (x[j] - mXMin)*mXInvRange;
+            qy[j] = (y[j] - mYMin)*mYInvRange;
+            qz[j] = (z[j] - mZMin)*mZInvRange;
+        }
+        else
+        {
+            qx[j] = (Real)0;
+            qy[j] = (Real)0;
+            qz[j] = (Real)0;
+        }
+        sum[j] = (Real)0;
+    }
+
+    for (i = 0; i < mQuantity; ++i)
+    {
+        const Real cx = mX[i], cy = mY[i], cz = mZ[i], a = mA[i];
+        for (j = 0; j < TILE_SIZE; ++j)
+        {
+            Real dx = qx[j] - cx;
+            Real dy = qy[j] - cy;
+            Real dz = qz[j] - cz;
+            sum[j] -= a*Math<Real>::Sqrt(dx*dx + dy*dy + dz*dz);
+        }
+    }
+
+    for (j = 0; j < numPoints; ++j)
+    {
+        values[j] = mB[0] + mB[1]*qx[j] + mB[2]*qy[j] + mB[3]*qz[j] +
+            sum[j];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void IntpThinPlateSpline3<Real>::EvaluateTask (int begin, int end, int,
+    void* userData)
+{
+    const EvaluateTaskData& data = *(const EvaluateTaskData*)userData;
+    const IntpThinPlateSpline3* object = data.Object;
+
+    for (int t = begin; t < end; ++t)
+    {
+        const int first = t*TILE_SIZE;
+        const int numPoints = (first + TILE_SIZE < data.NumPoints ?
+            TILE_SIZE : data.NumPoints - first);
+
+        object->EvaluateTile(numPoints, &data.X[first], &data.Y[first],
+            &data.Z[first], &data.Values[first]);
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/05/22)
+// File Version: 5.0.4 (2026/10/19)
 
 #ifndef WM5INTPTHINPLATESPLINE3_H
 #define WM5INTPTHINPLATESPLINE3_H
@@ -17,6 +17,7 @@
 // rotations of (x,y,z) but not to scaling.
 
 #include "Wm5MathematicsLIB.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -28,9 +29,13 @@ public:
     // Construction and destruction.  Data points are (x,y,z,f(x,y,z)).  The
     // smoothing parameter must be nonnegative.  If you want the class to
     // delete the input arrays during destruction, set owner to 'true';
-    // otherwise, you own the arrays and must delete them yourself.
+    // otherwise, you own the arrays and must delete them yourself.  The
+    // coefficients are the solution of a linear system of size 'quantity',
+    // which is factored with LUDecomposition on the threads of 'pool' when
+    // it is not null.
     IntpThinPlateSpline3 (int quantity, Real* X, Real* Y, Real* Z,
-        Real* F, Real smooth, bool owner, bool transformToUnitCube);
+        Real* F, Real smooth, bool owner, bool transformToUnitCube,
+        ThreadPool* pool = 0);
 
     ~IntpThinPlateSpline3 ();
 
@@ -56,6 +61,16 @@ public:
     // returns 'false', this operator will always return MAX_REAL.
     Real operator() (Real x, Real y, Real z);
 
+    // Evaluate the interpolator at many points, values[i] =
+    // f(x[i],y[i],z[i]).  Each value is the sum over all control points, as
+    // for operator().  The points are processed in tiles of TILE_SIZE
+    // points, and the tiles are distributed to the threads of 'pool' when
+    // it is not null.  Unlike IntpThinPlateSpline2, there is no far-field
+    // approximation: the Taylor expansions of the kernel |t| need too many
+    // terms to be faster than the exact sum.
+    void Evaluate (int numPoints, const Real* x, const Real* y,
+        const Real* z, Real* values, ThreadPool* pool = 0) const;
+
     // Kernel(t) = |t|
     static Real Kernel (Real t);
 
@@ -77,6 +92,30 @@ private:
     Real mXMin, mXMax, mXInvRange;
     Real mYMin, mYMax, mYInvRange;
     Real mZMin, mZMax, mZInvRange;
+
+    // Support for Evaluate.
+    enum
+    {
+        TILE_SIZE = 64
+    };
+
+    // The sums over all control points for at most TILE_SIZE points.
+    void EvaluateTile (int numPoints, const Real* x, const Real* y,
+        const Real* z, Real* values) const;
+
+    class EvaluateTaskData
+    {
+    public:
+        const IntpThinPlateSpline3* Object;
+        const Real* X;
+        const Real* Y;
+        const Real* Z;
+        Real* Values;
+        int NumPoints;
+    };
+
+    static void EvaluateTask (int begin, int end, int worker,
+        void* userData);
 };
 
 typedef IntpThinPlateSpline3<float> IntpThinPlateSpline3f;
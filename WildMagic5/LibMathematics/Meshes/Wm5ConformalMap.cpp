@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5ConformalMap.h"
@@ -15,7 +15,7 @@ namespace Wm5
 template <typename Real>
 ConformalMap<Real>::ConformalMap (int numPoints,
     const Vector3<Real>* points, int numTriangles, const int* indices,
-    int punctureTriangle)
+    int punctureTriangle, ThreadPool* pool)
 {
     // Construct a vertex-triangle-edge representation of mesh.
     BasicMesh mesh(numPoints, points, numTriangles, indices);
@@ -26,8 +26,10 @@ ConformalMap<Real>::ConformalMap (int numPoints,
     mPlanes = new1<Vector2<Real> >(numPoints);
     mSpheres = new1<Vector3<Real> >(numPoints);
 
-    // Construct sparse matrix A nondiagonal entries.
-    typename LinearSystem<Real>::SparseMatrix AMat;
+    // Construct the sparse matrix A.  Each edge contributes its weight to
+    // the two nondiagonal entries and subtracts it from the two diagonal
+    // entries, so the rows of A sum to zero.
+    CSRMatrix<Real> AMat(numPoints, numPoints);
     int i, e, t, v0, v1, v2;
     Real value = (Real)0;
     for (e = 0; e < numEdges; ++e)
@@ -63,29 +65,15 @@ ConformalMap<Real>::ConformalMap (int numPoints,
         }
 
         value *= -(Real)0.5;
-        AMat[std::make_pair(v0, v1)] = value;
-    }
-
-    // Aonstruct sparse matrix A diagonal entries.
-    Real* tmp = new1<Real>(numPoints);
-    memset(tmp, 0, numPoints*sizeof(Real));
-    typename LinearSystem<Real>::SparseMatrix::iterator iter = AMat.begin();
-    typename LinearSystem<Real>::SparseMatrix::iterator end = AMat.end();
-    for (/**/; iter != end; ++iter)
-    {
-        v0 = iter->first.first;
-        v1 = iter->first.second;
-        value = iter->second;
         assertion(v0 != v1, "Unexpected condition\n");
-        tmp[v0] -= value;
-        tmp[v1] -= value;
-    }
-    for (int v = 0; v < numPoints; ++v)
-    {
-        AMat[std::make_pair(v, v)] = tmp[v];
+        AMat.Insert(v0, v1, value);
+        AMat.Insert(v1, v0, value);
+        AMat.Insert(v0, v0, -value);
+        AMat.Insert(v1, v1, -value);
     }
+    AMat.Assemble();
 
-    assertion(numPoints + numEdges == (int)AMat.size(),
+    assertion(numPoints + 2*numEdges == AMat.GetNumNonzeros(),
         "Mismatch in sizes\n");
 
     // Construct column vector B (happens to be sparse).
@@ -112,14 +100,18 @@ ConformalMap<Real>::ConformalMap (int numPoints,
     Real re2 = (Real)0;
     Real im2 = -len10*invLenCross;
 
-    // Solve sparse system for real parts.
+    // Solve sparse system for real parts.  The matrix is symmetric and
+    // positive semidefinite, and the right-hand sides sum to zero, so they
+    // are in its range.
+    LinearSystem<Real> solver;
+    solver.Pool = pool;
+    Real* tmp = new1<Real>(numPoints);
     memset(tmp, 0, numPoints*sizeof(Real));
     tmp[v0] = re0;
     tmp[v1] = re1;
     tmp[v2] = re2;
     Real* result = new1<Real>(numPoints);
-    bool solved = LinearSystem<Real>().SolveSymmetricCG(numPoints, AMat, tmp,
-        result);
+    bool solved = solver.SolveSymmetricCG(AMat, tmp, result);
     assertion(solved, "Failed to solve linear system\n");
     WM5_UNUSED(solved);
     for (i = 0; i < numPoints; ++i)
@@ -132,8 +124,7 @@ ConformalMap<Real>::ConformalMap (int numPoints,
     tmp[v0] = -im0;
     tmp[v1] = -im1;
     tmp[v2] = -im2;
-    solved = LinearSystem<Real>().SolveSymmetricCG(numPoints, AMat, tmp,
-        result);
+    solved = solver.SolveSymmetricCG(AMat, tmp, result);
     assertion(solved, "Failed to solve linear system\n");
     for (i = 0; i < numPoints; ++i)
     {
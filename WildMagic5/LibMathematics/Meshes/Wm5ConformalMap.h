@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5CONFORMALMAP_H
 #define WM5CONFORMALMAP_H
@@ -32,8 +32,14 @@ public:
     // The triangles are represented as triples of indices into the vertex
     // array.  These triples are stored in indices.  The caller is responsible
     // for deleting the input arrays.
+    //
+    // The mapping solves two sparse linear systems with the Laplacian of the
+    // mesh by the preconditioned conjugate gradient method.  When a
+    // ThreadPool is supplied, the matrix-vector products are distributed to
+    // its workers.
     ConformalMap (int numPoints, const Vector3<Real>* points,
-        int numTriangles, const int* indices, int punctureTriangle = 0);
+        int numTriangles, const int* indices, int punctureTriangle = 0,
+        ThreadPool* pool = 0);
 
     ~ConformalMap ();
 
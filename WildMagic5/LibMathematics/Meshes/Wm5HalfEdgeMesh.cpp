@@ -0,0 +1,364 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.1 (2026/10/19)
+
+#include "Wm5MathematicsPCH.h"
+#include "Wm5HalfEdgeMesh.h"
+#include "Wm5TriangleKey.h"
+#include "Wm5Assert.h"
+using namespace Wm5;
+
+//----------------------------------------------------------------------------
+HalfEdgeMesh::HalfEdgeMesh ()
+    :
+    mFreeList(-1),
+    mNumTriangles(0),
+    mNumEdges(0),
+    mNumBoundary(0)
+{
+    Rehash(16);
+}
+//----------------------------------------------------------------------------
+HalfEdgeMesh::HalfEdgeMesh (int numTriangles, const int* indices)
+    :
+    mFreeList(-1),
+    mNumTriangles(0),
+    mNumEdges(0),
+    mNumBoundary(0)
+{
+    Rehash(16);
+    Reserve(numTriangles);
+    for (int t = 0; t < numTriangles; ++t, indices += 3)
+    {
+        InsertTriangle(indices[0], indices[1], indices[2]);
+    }
+}
+//----------------------------------------------------------------------------
+HalfEdgeMesh::~HalfEdgeMesh ()
+{
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::Clear ()
+{
+    if (8*mNumEdges < (int)mKeys.size())
+    {
+        // Few edges in a large table, which happens when a mesh is reused
+        // for small inputs after a large one.  Removing the keys one by one
+        // avoids touching the whole table.
+        const int numHalfEdges = (int)mIndices.size();
+        for (int h = 0; h < numHalfEdges && mNumEdges > 0; ++h)
+        {
+            if (mIndices[h - h % 3] >= 0)
+            {
+                int slot = FindSlot(GetKey(mIndices[h],
+                    mIndices[GetNext(h)]));
+                if (slot >= 0)
+                {
+                    RemoveEdge(slot);
+                }
+            }
+        }
+    }
+    else
+    {
+        std::fill(mHalfEdges.begin(), mHalfEdges.end(), (int)EMPTY);
+    }
+
+    mIndices.clear();
+    mTwin.clear();
+    mFreeList = -1;
+    mNumTriangles = 0;
+    mNumEdges = 0;
+    mNumBoundary = 0;
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::Reserve (int numTriangles)
+{
+    mIndices.reserve(3*numTriangles);
+    mTwin.reserve(3*numTriangles);
+
+    // A closed mesh has 3/2 edges per triangle, and the table is kept at
+    // most half full.
+    int capacity = (int)mKeys.size();
+    while (capacity < 3*numTriangles)
+    {
+        capacity *= 2;
+    }
+    if (capacity > (int)mKeys.size())
+    {
+        Rehash(capacity);
+    }
+}
+//----------------------------------------------------------------------------
+int HalfEdgeMesh::InsertTriangle (int v0, int v1, int v2)
+{
+    if (v0 == v1 || v1 == v2 || v2 == v0)
+    {
+        assertion(false, "Degenerate triangle\n");
+        return -1;
+    }
+
+    if (FindTriangle(v0, v1, v2) >= 0)
+    {
+        // Triangle already exists.
+        return -1;
+    }
+
+    // Look up the edges before changing anything, so that a rejected
+    // triangle leaves the mesh unchanged.
+    const int v[3] = { v0, v1, v2 };
+    int twin[3];
+    int i;
+    for (i = 0; i < 3; ++i)
+    {
+        int slot = FindSlot(GetKey(v[i], v[(i + 1) % 3]));
+        twin[i] = (slot >= 0 ? mHalfEdges[slot] : -1);
+        if (twin[i] >= 0 && mTwin[twin[i]] >= 0)
+        {
+            assertion(false, "Mesh must be manifold\n");
+            return -1;
+        }
+    }
+
+    int t;
+    if (mFreeList >= 0)
+    {
+        t = mFreeList;
+        mFreeList = mTwin[3*t];
+    }
+    else
+    {
+        t = (int)mIndices.size()/3;
+        mIndices.resize(3*t + 3);
+        mTwin.resize(3*t + 3);
+    }
+
+    for (i = 0; i < 3; ++i)
+    {
+        int h = 3*t + i;
+        mIndices[h] = v[i];
+        mTwin[h] = twin[i];
+        if (twin[i] >= 0)
+        {
+            mTwin[twin[i]] = h;
+            --mNumBoundary;
+        }
+        else
+        {
+            InsertEdge(GetKey(v[i], v[(i + 1) % 3]), h);
+            ++mNumBoundary;
+        }
+    }
+
+    ++mNumTriangles;
+    return t;
+}
+//----------------------------------------------------------------------------
+bool HalfEdgeMesh::RemoveTriangle (int v0, int v1, int v2)
+{
+    int t = FindTriangle(v0, v1, v2);
+    if (t < 0)
+    {
+        return false;
+    }
+
+    RemoveTriangle(t);
+    return true;
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::RemoveTriangle (int t)
+{
+    assertion(0 <= t && t < GetMaxTriangles() && IsTriangle(t),
+        "Invalid triangle\n");
+
+    for (int h = 3*t; h < 3*t + 3; ++h)
+    {
+        int slot = FindSlot(GetKey(mIndices[h], mIndices[GetNext(h)]));
+        int twin = mTwin[h];
+        if (twin >= 0)
+        {
+            // The edge remains, with the adjacent triangle only.
+            mTwin[twin] = -1;
+            mHalfEdges[slot] = twin;
+            ++mNumBoundary;
+        }
+        else
+        {
+            RemoveEdge(slot);
+            --mNumBoundary;
+        }
+    }
+
+    mIndices[3*t] = -1;
+    mIndices[3*t + 1] = -1;
+    mIndices[3*t + 2] = -1;
+    mTwin[3*t] = mFreeList;
+    mTwin[3*t + 1] = -1;
+    mTwin[3*t + 2] = -1;
+    mFreeList = t;
+    --mNumTriangles;
+}
+//----------------------------------------------------------------------------
+int HalfEdgeMesh::FindHalfEdge (int v0, int v1) const
+{
+    int slot = FindSlot(GetKey(v0, v1));
+    return (slot >= 0 ? mHalfEdges[slot] : -1);
+}
+//----------------------------------------------------------------------------
+int HalfEdgeMesh::FindTriangle (int v0, int v1, int v2) const
+{
+    int h = FindHalfEdge(v0, v1);
+    if (h < 0)
+    {
+        return -1;
+    }
+
+    // The triangles are equal when their keys, the vertex rotations that
+    // start at the minimum vertex, are equal.
+    TriangleKey key(v0, v1, v2);
+    for (int j = 0; j < 2 && h >= 0; ++j, h = mTwin[h])
+    {
+        const int* w = &mIndices[h - h % 3];
+        TriangleKey other(w[0], w[1], w[2]);
+        if (key.V[0] == other.V[0] && key.V[1] == other.V[1]
+        &&  key.V[2] == other.V[2])
+        {
+            return h/3;
+        }
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::Print (const char* filename) const
+{
+    std::ofstream outFile(filename);
+    if (!outFile)
+    {
+        return;
+    }
+
+    outFile << "edge quantity = " << mNumEdges << std::endl;
+    outFile << "triangle quantity = " << mNumTriangles << std::endl;
+    const int maxTriangles = GetMaxTriangles();
+    for (int t = 0; t < maxTriangles; ++t)
+    {
+        if (!IsTriangle(t))
+        {
+            continue;
+        }
+
+        const int* v = GetVertices(t);
+        outFile << 't' << t << " <" << 'v' << v[0] << ",v" << v[1] << ",v"
+            << v[2] << "; ";
+        for (int i = 0; i < 3; ++i)
+        {
+            int adjacent = GetAdjacent(t, i);
+            if (adjacent >= 0)
+            {
+                outFile << 't' << adjacent;
+            }
+            else
+            {
+                outFile << '*';
+            }
+            outFile << (i < 2 ? ',' : '>');
+        }
+        outFile << std::endl;
+    }
+    outFile << std::endl;
+}
+//----------------------------------------------------------------------------
+int HalfEdgeMesh::FindSlot (uint64_t key) const
+{
+    const int mask = (int)mKeys.size() - 1;
+    for (int slot = GetSlot(key); /**/; slot = (slot + 1) & mask)
+    {
+        if (mHalfEdges[slot] == EMPTY)
+        {
+            return -1;
+        }
+        if (mKeys[slot] == key)
+        {
+            return slot;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::InsertEdge (uint64_t key, int h)
+{
+    if (2*(mNumEdges + 1) > (int)mKeys.size())
+    {
+        Rehash(2*(int)mKeys.size());
+    }
+
+    const int mask = (int)mKeys.size() - 1;
+    int slot = GetSlot(key);
+    while (mHalfEdges[slot] != EMPTY)
+    {
+        slot = (slot + 1) & mask;
+    }
+    mKeys[slot] = key;
+    mHalfEdges[slot] = h;
+    ++mNumEdges;
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::RemoveEdge (int slot)
+{
+    // Shift back the keys of the probe sequence that follows the slot,
+    // except those whose home slot lies cyclically in (slot,next].
+    const int mask = (int)mKeys.size() - 1;
+    int next = slot;
+    for (;;)
+    {
+        next = (next + 1) & mask;
+        if (mHalfEdges[next] == EMPTY)
+        {
+            break;
+        }
+
+        int home = GetSlot(mKeys[next]);
+        bool stays = (slot <= next ? (slot < home && home <= next) :
+            (slot < home || home <= next));
+        if (!stays)
+        {
+            mKeys[slot] = mKeys[next];
+            mHalfEdges[slot] = mHalfEdges[next];
+            slot = next;
+        }
+    }
+    mHalfEdges[slot] = EMPTY;
+    --mNumEdges;
+}
+//----------------------------------------------------------------------------
+void HalfEdgeMesh::Rehash (int capacity)
+{
+    std::vector<uint64_t> keys(capacity);
+    std::vector<int> halfEdges(capacity, (int)EMPTY);
+    mKeys.swap(keys);
+    mHalfEdges.swap(halfEdges);
+    mShift = 64;
+    for (int c = capacity; c > 1; c >>= 1)
+    {
+        --mShift;
+    }
+
+    const int mask = capacity - 1;
+    for (int i = 0; i < (int)keys.size(); ++i)
+    {
+        if (halfEdges[i] != EMPTY)
+        {
+            int slot = GetSlot(keys[i]);
+            while (mHalfEdges[slot] != EMPTY)
+            {
+                slot = (slot + 1) & mask;
+            }
+            mKeys[slot] = keys[i];
+            mHalfEdges[slot] = halfEdges[i];
+        }
+    }
+}
+//----------------------------------------------------------------------------
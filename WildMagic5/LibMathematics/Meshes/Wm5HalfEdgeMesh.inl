@@ -0,0 +1,88 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+//----------------------------------------------------------------------------
+inline bool HalfEdgeMesh::IsClosed () const
+{
+    return mNumBoundary == 0;
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetNumTriangles () const
+{
+    return mNumTriangles;
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetNumEdges () const
+{
+    return mNumEdges;
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetMaxTriangles () const
+{
+    return (int)mIndices.size()/3;
+}
+//----------------------------------------------------------------------------
+inline bool HalfEdgeMesh::IsTriangle (int t) const
+{
+    return mIndices[3*t] >= 0;
+}
+//----------------------------------------------------------------------------
+inline const int* HalfEdgeMesh::GetVertices (int t) const
+{
+    return &mIndices[3*t];
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetAdjacent (int t, int i) const
+{
+    int twin = mTwin[3*t + i];
+    return (twin >= 0 ? twin/3 : -1);
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetTriangle (int h)
+{
+    return h/3;
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetNext (int h)
+{
+    return (h % 3 == 2 ? h - 2 : h + 1);
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetPrev (int h)
+{
+    return (h % 3 == 0 ? h + 2 : h - 1);
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetOrigin (int h) const
+{
+    return mIndices[h];
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetTarget (int h) const
+{
+    return mIndices[GetNext(h)];
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetTwin (int h) const
+{
+    return mTwin[h];
+}
+//----------------------------------------------------------------------------
+inline uint64_t HalfEdgeMesh::GetKey (int v0, int v1)
+{
+    return (v0 < v1 ? (uint64_t)v0 | ((uint64_t)v1 << 32) :
+        (uint64_t)v1 | ((uint64_t)v0 << 32));
+}
+//----------------------------------------------------------------------------
+inline int HalfEdgeMesh::GetSlot (uint64_t key) const
+{
+    // Fibonacci hashing:  the high bits of the product depend on all bits
+    // of the key.
+    return (int)((key*(uint64_t)0x9E3779B97F4A7C15ULL) >> mShift);
+}
+//----------------------------------------------------------------------------
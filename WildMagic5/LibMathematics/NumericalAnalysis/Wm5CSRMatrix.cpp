@@ -0,0 +1,358 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5MathematicsPCH.h"
+#include "Wm5CSRMatrix.h"
+#include "Wm5Memory.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+CSRMatrix<Real>::CSRMatrix (int numRows, int numColumns)
+    :
+    mNumRows(numRows),
+    mNumColumns(numColumns),
+    mAssembled(false),
+    mRowStarts(0),
+    mColumns(0),
+    mValues(0),
+    mDiagonal(0)
+{
+    assertion(numRows > 0 && numColumns > 0, "Invalid matrix size\n");
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CSRMatrix<Real>::~CSRMatrix ()
+{
+    delete1(mRowStarts);
+    delete1(mColumns);
+    delete1(mValues);
+    delete1(mDiagonal);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Insert (int row, int column, Real value)
+{
+    assertion(!mAssembled, "The matrix is already assembled\n");
+    assertion(0 <= row && row < mNumRows && 0 <= column
+        && column < mNumColumns, "Invalid index\n");
+
+    mTripletRows.push_back(row);
+    mTripletColumns.push_back(column);
+    mTripletValues.push_back(value);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Assemble ()
+{
+    assertion(!mAssembled, "The matrix is already assembled\n");
+
+    const int numTriplets = (int)mTripletRows.size();
+    int row, i;
+
+    // Count the triplets of each row.  The counts are shifted by one row so
+    // that the partial sums are the row starts.
+    mRowStarts = new1<int>(mNumRows + 1);
+    memset(mRowStarts, 0, (mNumRows + 1)*sizeof(int));
+    for (i = 0; i < numTriplets; ++i)
+    {
+        ++mRowStarts[mTripletRows[i] + 1];
+    }
+    for (row = 0; row < mNumRows; ++row)
+    {
+        mRowStarts[row + 1] += mRowStarts[row];
+    }
+
+    // Distribute the triplets to their rows.
+    std::pair<int,Real>* entries = new1<std::pair<int,Real> >(
+        numTriplets > 0 ? numTriplets : 1);
+    int* next = new1<int>(mNumRows);
+    memcpy(next, mRowStarts, mNumRows*sizeof(int));
+    for (i = 0; i < numTriplets; ++i)
+    {
+        entries[next[mTripletRows[i]]++] =
+            std::make_pair(mTripletColumns[i], mTripletValues[i]);
+    }
+    delete1(next);
+
+    std::vector<int>().swap(mTripletRows);
+    std::vector<int>().swap(mTripletColumns);
+    std::vector<Real>().swap(mTripletValues);
+
+    // Sort each row by column and sum the duplicates.  The rows are
+    // compacted in place; the start of a row is read before the previous
+    // row overwrites it.
+    int numNonzeros = 0;
+    for (row = 0; row < mNumRows; ++row)
+    {
+        const int start = mRowStarts[row];
+        const int stop = mRowStarts[row + 1];
+        std::sort(entries + start, entries + stop);
+        mRowStarts[row] = numNonzeros;
+        for (i = start; i < stop; ++i)
+        {
+            if (numNonzeros > mRowStarts[row]
+            &&  entries[numNonzeros - 1].first == entries[i].first)
+            {
+                entries[numNonzeros - 1].second += entries[i].second;
+            }
+            else
+            {
+                entries[numNonzeros++] = entries[i];
+            }
+        }
+    }
+    mRowStarts[mNumRows] = numNonzeros;
+
+    mColumns = new1<int>(numNonzeros > 0 ? numNonzeros : 1);
+    mValues = new1<Real>(numNonzeros > 0 ? numNonzeros : 1);
+    for (i = 0; i < numNonzeros; ++i)
+    {
+        mColumns[i] = entries[i].first;
+        mValues[i] = entries[i].second;
+    }
+    delete1(entries);
+
+    mDiagonal = new1<int>(mNumRows);
+    for (row = 0; row < mNumRows; ++row)
+    {
+        mDiagonal[row] = -1;
+        for (i = mRowStarts[row]; i < mRowStarts[row + 1]; ++i)
+        {
+            if (mColumns[i] == row)
+            {
+                mDiagonal[row] = i;
+                break;
+            }
+        }
+    }
+
+    mAssembled = true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CSRMatrix<Real>::IsAssembled () const
+{
+    return mAssembled;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int CSRMatrix<Real>::GetNumRows () const
+{
+    return mNumRows;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int CSRMatrix<Real>::GetNumColumns () const
+{
+    return mNumColumns;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int CSRMatrix<Real>::GetNumNonzeros () const
+{
+    return (mAssembled ? mRowStarts[mNumRows] : 0);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const int* CSRMatrix<Real>::GetRowStarts () const
+{
+    return mRowStarts;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const int* CSRMatrix<Real>::GetColumns () const
+{
+    return mColumns;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const Real* CSRMatrix<Real>::GetValues () const
+{
+    return mValues;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real* CSRMatrix<Real>::GetValues ()
+{
+    return mValues;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int CSRMatrix<Real>::GetDiagonalIndex (int row) const
+{
+    assertion(mAssembled, "The matrix is not assembled\n");
+    return mDiagonal[row];
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real CSRMatrix<Real>::operator() (int row, int column) const
+{
+    assertion(mAssembled, "The matrix is not assembled\n");
+
+    const int* first = mColumns + mRowStarts[row];
+    const int* last = mColumns + mRowStarts[row + 1];
+    const int* found = std::lower_bound(first, last, column);
+    if (found != last && *found == column)
+    {
+        return mValues[found - mColumns];
+    }
+    return (Real)0;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::Multiply (const Real* X, Real* Prod,
+    ThreadPool* pool) const
+{
+    assertion(mAssembled, "The matrix is not assembled\n");
+
+    MultiplyTaskData data;
+    data.Object = this;
+    data.X = X;
+    data.Prod = Prod;
+    ThreadPool::ParallelFor(pool, mNumRows, 0, MultiplyTask, &data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CSRMatrix<Real>::FactorIncomplete (Real* factor) const
+{
+    assertion(mAssembled, "The matrix is not assembled\n");
+    assertion(mNumRows == mNumColumns, "The matrix must be square\n");
+
+    int row, i, j;
+    for (row = 0; row < mNumRows; ++row)
+    {
+        if (mDiagonal[row] < 0)
+        {
+            return false;
+        }
+    }
+
+    memcpy(factor, mValues, mRowStarts[mNumRows]*sizeof(Real));
+
+    // The position of each column in the current row, or -1 when the
+    // column is not stored in the row.  Fill-in outside the structure is
+    // discarded.
+    int* position = new1<int>(mNumColumns);
+    for (i = 0; i < mNumColumns; ++i)
+    {
+        position[i] = -1;
+    }
+
+    bool success = true;
+    for (row = 0; row < mNumRows && success; ++row)
+    {
+        const int start = mRowStarts[row];
+        const int stop = mRowStarts[row + 1];
+        for (i = start; i < stop; ++i)
+        {
+            position[mColumns[i]] = i;
+        }
+
+        // Eliminate the entries left of the diagonal with the rows of U
+        // already computed.
+        for (i = start; i < mDiagonal[row]; ++i)
+        {
+            const int pivotRow = mColumns[i];
+            const int pivotIndex = mDiagonal[pivotRow];
+            const Real multiplier = factor[i]/factor[pivotIndex];
+            factor[i] = multiplier;
+
+            const int pivotFinal = mRowStarts[pivotRow + 1];
+            for (j = pivotIndex + 1; j < pivotFinal; ++j)
+            {
+                const int target = position[mColumns[j]];
+                if (target >= 0)
+                {
+                    factor[target] -= multiplier*factor[j];
+                }
+            }
+        }
+
+        if (factor[mDiagonal[row]] == (Real)0)
+        {
+            success = false;
+        }
+
+        for (i = start; i < stop; ++i)
+        {
+            position[mColumns[i]] = -1;
+        }
+    }
+
+    delete1(position);
+    return success;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::SolveIncomplete (const Real* factor, const Real* B,
+    Real* X) const
+{
+    assertion(mAssembled, "The matrix is not assembled\n");
+
+    int row, i;
+
+    // Solve L*Y = B, where L has unit diagonal.  Y is stored in X; the entry
+    // B[row] is read before X[row] is written.
+    for (row = 0; row < mNumRows; ++row)
+    {
+        Real sum = B[row];
+        for (i = mRowStarts[row]; i < mDiagonal[row]; ++i)
+        {
+            sum -= factor[i]*X[mColumns[i]];
+        }
+        X[row] = sum;
+    }
+
+    // Solve U*X = Y.
+    for (row = mNumRows - 1; row >= 0; --row)
+    {
+        const int diagonal = mDiagonal[row];
+        const int stop = mRowStarts[row + 1];
+        Real sum = X[row];
+        for (i = diagonal + 1; i < stop; ++i)
+        {
+            sum -= factor[i]*X[mColumns[i]];
+        }
+        X[row] = sum/factor[diagonal];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CSRMatrix<Real>::MultiplyTask (int begin, int end, int, void* userData)
+{
+    const MultiplyTaskData& data = *(const MultiplyTaskData*)userData;
+    const int* rowStarts = data.Object->mRowStarts;
+    const int* columns = data.Object->mColumns;
+    const Real* values = data.Object->mValues;
+    const Real* X = data.X;
+
+    for (int row = begin; row < end; ++row)
+    {
+        Real sum = (Real)0;
+        const int stop = rowStarts[row + 1];
+        for (int i = rowStarts[row]; i < stop; ++i)
+        {
+            sum += values[i]*X[columns[i]];
+        }
+        data.Prod[row] = sum;
+    }
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_MATHEMATICS_ITEM
+class CSRMatrix<float>;
+
+template WM5_MATHEMATICS_ITEM
+class CSRMatrix<double>;
+//----------------------------------------------------------------------------
+}
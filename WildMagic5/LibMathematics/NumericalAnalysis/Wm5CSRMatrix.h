@@ -0,0 +1,117 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5CSRMATRIX_H
+#define WM5CSRMATRIX_H
+
+#include "Wm5MathematicsLIB.h"
+#include "Wm5ThreadPool.h"
+
+// A sparse matrix in compressed sparse row (CSR) format.  The nonzero
+// entries of row i are stored at the indices GetRowStarts()[i] through
+// GetRowStarts()[i+1]-1 of the column and value arrays, sorted by column.
+// The rows are contiguous in memory, so the product with a vector reads
+// the matrix once in order, and the rows are independent, so the product
+// is distributed to the workers of a ThreadPool.
+//
+// The matrix is built from (row,column,value) triplets that are inserted
+// in any order.  Triplets with the same row and column are summed, which
+// is the natural way to assemble matrices from per-element contributions,
+// for example the Laplacian of a mesh from its edges.  Assemble() converts
+// the triplets to the compressed form; the structure is fixed afterwards,
+// but the values may be modified.
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_MATHEMATICS_ITEM CSRMatrix
+{
+public:
+    // Construction and destruction.  The matrix is empty until assembled.
+    CSRMatrix (int numRows, int numColumns);
+    ~CSRMatrix ();
+
+    // Assembly.  Insert may be called only before Assemble.  A triplet
+    // with a value of zero still creates an entry in the structure.
+    void Insert (int row, int column, Real value);
+    void Assemble ();
+    bool IsAssembled () const;
+
+    // Member access.  The arrays are valid after assembly.
+    int GetNumRows () const;
+    int GetNumColumns () const;
+    int GetNumNonzeros () const;
+    const int* GetRowStarts () const;
+    const int* GetColumns () const;
+    const Real* GetValues () const;
+    Real* GetValues ();
+
+    // The index into the column and value arrays of the diagonal entry of
+    // a row, or -1 when the diagonal entry is not stored.
+    int GetDiagonalIndex (int row) const;
+
+    // The entry at (row,column), which is zero when it is not stored.  The
+    // lookup is a binary search of the row.
+    Real operator() (int row, int column) const;
+
+    // Prod = A*X.  X has GetNumColumns() elements and Prod has GetNumRows()
+    // elements; they must not be the same array.
+    void Multiply (const Real* X, Real* Prod, ThreadPool* pool = 0) const;
+
+    // The incomplete LU factorization with zero fill, ILU(0), of a square
+    // matrix.  The factors L (unit lower triangular) and U (upper
+    // triangular) have the structure of A and are stored in 'factor', an
+    // array of GetNumNonzeros() values; the strict lower triangle is L and
+    // the rest is U.  For a symmetric matrix, L*U = L*D*L^T is the
+    // incomplete Cholesky factorization IC(0).  Every diagonal entry must be
+    // stored.  The return value is 'false' when a pivot is zero.
+    bool FactorIncomplete (Real* factor) const;
+
+    // Solve L*U*X = B for the factors computed by FactorIncomplete.  B and
+    // X may be the same array.
+    void SolveIncomplete (const Real* factor, const Real* B, Real* X) const;
+
+private:
+    // Copying is not supported.
+    CSRMatrix (const CSRMatrix&);
+    CSRMatrix& operator= (const CSRMatrix&);
+
+    // Support for the parallel product with a vector.  The task items are
+    // rows.
+    class MultiplyTaskData
+    {
+    public:
+        const CSRMatrix* Object;
+        const Real* X;
+        Real* Prod;
+    };
+
+    static void MultiplyTask (int begin, int end, int worker,
+        void* userData);
+
+    int mNumRows, mNumColumns;
+
+    // The triplets inserted before assembly.
+    std::vector<int> mTripletRows, mTripletColumns;
+    std::vector<Real> mTripletValues;
+
+    // The compressed form.
+    bool mAssembled;
+    int* mRowStarts;
+    int* mColumns;
+    Real* mValues;
+    int* mDiagonal;
+};
+
+typedef CSRMatrix<float> CSRMatrixf;
+typedef CSRMatrix<double> CSRMatrixd;
+
+}
+
+#endif
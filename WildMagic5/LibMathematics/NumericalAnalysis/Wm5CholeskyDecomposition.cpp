@@ -0,0 +1,443 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5MathematicsPCH.h"
+#include "Wm5CholeskyDecomposition.h"
+#include "Wm5Math.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+CholeskyDecomposition<Real>::CholeskyDecomposition (const GMatrix<Real>& A,
+    ThreadPool* pool)
+    :
+    mL(A),
+    mPositiveDefinite(true),
+    mPool(pool)
+{
+    assertion(A.GetNumRows() == A.GetNumColumns(), "Matrix must be square\n");
+
+    Factor();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+CholeskyDecomposition<Real>::~CholeskyDecomposition ()
+{
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CholeskyDecomposition<Real>::IsPositiveDefinite () const
+{
+    return mPositiveDefinite;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int CholeskyDecomposition<Real>::GetSize () const
+{
+    return mL.GetNumRows();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const GMatrix<Real>& CholeskyDecomposition<Real>::GetFactor () const
+{
+    return mL;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real CholeskyDecomposition<Real>::GetDeterminant () const
+{
+    if (!mPositiveDefinite)
+    {
+        return (Real)0;
+    }
+
+    const int size = mL.GetNumRows();
+    Real det = (Real)1;
+    for (int i = 0; i < size; ++i)
+    {
+        det *= mL[i][i]*mL[i][i];
+    }
+    return det;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CholeskyDecomposition<Real>::Solve (const Real* B, Real* X) const
+{
+    if (!mPositiveDefinite)
+    {
+        return false;
+    }
+
+    const int size = mL.GetNumRows();
+    int i, j;
+
+    // Solve L*Y = B.  Y is stored in X; the entry B[i] is read before X[i]
+    // is written, so B and X may be the same array.
+    for (i = 0; i < size; ++i)
+    {
+        const Real* row = mL[i];
+        Real sum = B[i];
+        for (j = 0; j < i; ++j)
+        {
+            sum -= row[j]*X[j];
+        }
+        X[i] = sum/row[i];
+    }
+
+    // Solve L^T*X = Y.  The rows of L are the columns of L^T, so the
+    // solution is accumulated by columns.
+    for (i = size - 1; i >= 0; --i)
+    {
+        const Real* row = mL[i];
+        X[i] /= row[i];
+        const Real value = X[i];
+        for (j = 0; j < i; ++j)
+        {
+            X[j] -= row[j]*value;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CholeskyDecomposition<Real>::Solve (const GMatrix<Real>& B,
+    GMatrix<Real>& X) const
+{
+    assertion(B.GetNumRows() == mL.GetNumRows(),
+        "Mismatched matrix sizes\n");
+
+    if (!mPositiveDefinite)
+    {
+        return false;
+    }
+
+    if (&X != &B)
+    {
+        X = B;
+    }
+
+    SolveTaskData data;
+    data.Object = this;
+    data.Elements = X.GetElements();
+    data.NumColumns = X.GetNumColumns();
+    int numTiles = (data.NumColumns + COLUMN_TILE - 1)/COLUMN_TILE;
+    ThreadPool::ParallelFor(mPool, numTiles, 1, SolveTask, &data);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool CholeskyDecomposition<Real>::Inverse (GMatrix<Real>& invA) const
+{
+    if (!mPositiveDefinite)
+    {
+        return false;
+    }
+
+    const int size = mL.GetNumRows();
+    GMatrix<Real> identity(size, size);
+    for (int i = 0; i < size; ++i)
+    {
+        identity[i][i] = (Real)1;
+    }
+    return Solve(identity, invA);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CholeskyDecomposition<Real>::Factor ()
+{
+    const int size = mL.GetNumRows();
+    const int numTiles = (size + COLUMN_TILE - 1)/COLUMN_TILE;
+    Real* elements = mL.GetElements();
+    Real* pack = new1<Real>(BLOCK_SIZE*COLUMN_TILE*numTiles);
+    int i, j, k, p;
+
+    for (int k0 = 0; k0 < size; k0 += BLOCK_SIZE)
+    {
+        const int k1 = (k0 + BLOCK_SIZE < size ? k0 + BLOCK_SIZE : size);
+
+        // Factor the panel of columns k0 through k1-1.  The previous panels
+        // have been subtracted by the trailing updates, so only the columns
+        // of this panel contribute to the inner products.
+        for (k = k0; k < k1; ++k)
+        {
+            Real* rowK = &elements[k*size];
+            Real diagonal = rowK[k];
+            for (p = k0; p < k; ++p)
+            {
+                diagonal -= rowK[p]*rowK[p];
+            }
+
+            if (diagonal <= (Real)0)
+            {
+                // The matrix is not positive definite.
+                mPositiveDefinite = false;
+                delete1(pack);
+                return;
+            }
+
+            diagonal = Math<Real>::Sqrt(diagonal);
+            rowK[k] = diagonal;
+            Real inv = ((Real)1)/diagonal;
+            for (i = k + 1; i < size; ++i)
+            {
+                Real* row = &elements[i*size];
+                Real sum = row[k];
+                for (p = k0; p < k; ++p)
+                {
+                    sum -= row[p]*rowK[p];
+                }
+                row[k] = sum*inv;
+            }
+        }
+
+        if (k1 == size)
+        {
+            break;
+        }
+
+        // Copy L21^T to tiles of BLOCK_SIZE-by-COLUMN_TILE entries, padded
+        // with zeros.
+        const int numInner = k1 - k0;
+        const int numTrailing = size - k1;
+        const int numUsedTiles = (numTrailing + COLUMN_TILE - 1)/COLUMN_TILE;
+        for (int t = 0; t < numUsedTiles; ++t)
+        {
+            const int j0 = k1 + t*COLUMN_TILE;
+            const int numColumns = (j0 + COLUMN_TILE < size ? COLUMN_TILE :
+                size - j0);
+            for (p = 0; p < numInner; ++p)
+            {
+                Real* tileRow = &pack[(t*BLOCK_SIZE + p)*COLUMN_TILE];
+                const Real* column = &elements[j0*size + k0 + p];
+                for (j = 0; j < numColumns; ++j)
+                {
+                    tileRow[j] = column[j*size];
+                }
+                for (/**/; j < COLUMN_TILE; ++j)
+                {
+                    tileRow[j] = (Real)0;
+                }
+            }
+        }
+
+        // Update the lower triangle of the trailing submatrix,
+        // A22 = A22 - L21*L21^T.
+        UpdateTaskData data;
+        data.Elements = elements;
+        data.Pack = pack;
+        data.Size = size;
+        data.K0 = k0;
+        data.K1 = k1;
+        int numGroups = (numTrailing + 3)/4;
+        ThreadPool::ParallelFor(mPool, numGroups, 0, UpdateTask, &data);
+    }
+    delete1(pack);
+
+    // The updates also wrote entries above the diagonal.
+    for (i = 0; i < size; ++i)
+    {
+        Real* row = &elements[i*size];
+        for (j = i + 1; j < size; ++j)
+        {
+            row[j] = (Real)0;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CholeskyDecomposition<Real>::UpdateTask (int begin, int end, int,
+    void* userData)
+{
+    const UpdateTaskData& data = *(const UpdateTaskData*)userData;
+    const int size = data.Size;
+    const int k0 = data.K0;
+    const int k1 = data.K1;
+    const int numInner = k1 - k0;
+    const int rowMin = k1 + 4*begin;
+    const int rowMax = (k1 + 4*end < size ? k1 + 4*end : size);
+    Real* elements = data.Elements;
+
+    // The tiles are in the outer loop so that each one is loaded into the
+    // cache once per task.  A group of rows needs the columns up to its
+    // last row, so the groups that end before a tile skip it.
+    for (int j0 = k1, t = 0; j0 < rowMax; j0 += COLUMN_TILE, ++t)
+    {
+        const int tileMax = (j0 + COLUMN_TILE < size ? j0 + COLUMN_TILE :
+            size);
+        const Real* tile = &data.Pack[t*BLOCK_SIZE*COLUMN_TILE];
+        for (int i = rowMin; i < rowMax; i += 4)
+        {
+            const int numRows = (i + 4 < rowMax ? 4 : rowMax - i);
+            const int last = i + numRows - 1;
+            if (last >= j0)
+            {
+                const int numColumns = (last + 1 < tileMax ? last + 1 :
+                    tileMax) - j0;
+                UpdateBlock(numRows, numColumns, numInner,
+                    &elements[i*size + k0], tile, &elements[i*size + j0],
+                    size);
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CholeskyDecomposition<Real>::UpdateBlock (int numRows, int numColumns,
+    int numInner, const Real* L, const Real* U, Real* C, int stride)
+{
+    // The rows are updated in a local block.  The inner loop has a constant
+    // length and does not alias the matrix, which lets the compiler
+    // vectorize it without run-time checks.
+    Real block[4][COLUMN_TILE];
+    Real a[4][BLOCK_SIZE];
+    int r, j, p;
+    for (r = 0; r < 4; ++r)
+    {
+        int numCopied = 0;
+        if (r < numRows)
+        {
+            memcpy(block[r], &C[r*stride], numColumns*sizeof(Real));
+            memcpy(a[r], &L[r*stride], numInner*sizeof(Real));
+            numCopied = numColumns;
+        }
+        else
+        {
+            memset(a[r], 0, numInner*sizeof(Real));
+        }
+        for (j = numCopied; j < COLUMN_TILE; ++j)
+        {
+            block[r][j] = (Real)0;
+        }
+    }
+
+    for (p = 0; p < numInner; ++p)
+    {
+        const Real* tileRow = &U[p*COLUMN_TILE];
+        const Real a0 = a[0][p], a1 = a[1][p], a2 = a[2][p], a3 = a[3][p];
+        for (j = 0; j < COLUMN_TILE; ++j)
+        {
+            const Real u = tileRow[j];
+            block[0][j] -= a0*u;
+            block[1][j] -= a1*u;
+            block[2][j] -= a2*u;
+            block[3][j] -= a3*u;
+        }
+    }
+
+    for (r = 0; r < numRows; ++r)
+    {
+        memcpy(&C[r*stride], block[r], numColumns*sizeof(Real));
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void CholeskyDecomposition<Real>::SolveTask (int begin, int end, int,
+    void* userData)
+{
+    const SolveTaskData& data = *(const SolveTaskData*)userData;
+    const GMatrix<Real>& L = data.Object->mL;
+    const int size = L.GetNumRows();
+    const int stride = data.NumColumns;
+    Real* elements = data.Elements;
+    Real* tile = new1<Real>(size*COLUMN_TILE);
+    Real sum[COLUMN_TILE];
+    int i, j, k;
+
+    for (int t = begin; t < end; ++t)
+    {
+        // Copy the columns of the tile, padded with zeros, so that the
+        // inner loops have a constant length.
+        const int j0 = t*COLUMN_TILE;
+        const int numColumns = (j0 + COLUMN_TILE < stride ? COLUMN_TILE :
+            stride - j0);
+        for (i = 0; i < size; ++i)
+        {
+            Real* tileRow = &tile[i*COLUMN_TILE];
+            memcpy(tileRow, &elements[i*stride + j0],
+                numColumns*sizeof(Real));
+            for (j = numColumns; j < COLUMN_TILE; ++j)
+            {
+                tileRow[j] = (Real)0;
+            }
+        }
+
+        // Solve L*Y = B, row by row of Y.
+        for (i = 0; i < size; ++i)
+        {
+            const Real* row = L[i];
+            Real* Y = &tile[i*COLUMN_TILE];
+            memcpy(sum, Y, COLUMN_TILE*sizeof(Real));
+            for (k = 0; k < i; ++k)
+            {
+                const Real multiplier = row[k];
+                if (multiplier != (Real)0)
+                {
+                    const Real* Yk = &tile[k*COLUMN_TILE];
+                    for (j = 0; j < COLUMN_TILE; ++j)
+                    {
+                        sum[j] -= multiplier*Yk[j];
+                    }
+                }
+            }
+
+            const Real inv = ((Real)1)/row[i];
+            for (j = 0; j < COLUMN_TILE; ++j)
+            {
+                Y[j] = sum[j]*inv;
+            }
+        }
+
+        // Solve L^T*X = Y.  The rows of L are the columns of L^T, so the
+        // solution is accumulated by columns from the last row of X.
+        for (i = size - 1; i >= 0; --i)
+        {
+            const Real* row = L[i];
+            Real* X = &tile[i*COLUMN_TILE];
+            const Real inv = ((Real)1)/row[i];
+            for (j = 0; j < COLUMN_TILE; ++j)
+            {
+                sum[j] = X[j]*inv;
+            }
+            memcpy(X, sum, COLUMN_TILE*sizeof(Real));
+
+            for (k = 0; k < i; ++k)
+            {
+                const Real multiplier = row[k];
+                if (multiplier != (Real)0)
+                {
+                    Real* Xk = &tile[k*COLUMN_TILE];
+                    for (j = 0; j < COLUMN_TILE; ++j)
+                    {
+                        Xk[j] -= multiplier*sum[j];
+                    }
+                }
+            }
+        }
+
+        for (i = 0; i < size; ++i)
+        {
+            memcpy(&elements[i*stride + j0], &tile[i*COLUMN_TILE],
+                numColumns*sizeof(Real));
+        }
+    }
+
+    delete1(tile);
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_MATHEMATICS_ITEM
+class CholeskyDecomposition<float>;
+
+template WM5_MATHEMATICS_ITEM
+class CholeskyDecomposition<double>;
+//----------------------------------------------------------------------------
+}
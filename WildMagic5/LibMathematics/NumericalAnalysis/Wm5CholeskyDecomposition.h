@@ -0,0 +1,109 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5CHOLESKYDECOMPOSITION_H
+#define WM5CHOLESKYDECOMPOSITION_H
+
+#include "Wm5MathematicsLIB.h"
+#include "Wm5GMatrix.h"
+#include "Wm5ThreadPool.h"
+
+// The factorization A = L*L^T of a symmetric positive definite matrix A,
+// where L is lower triangular with positive diagonal.  It costs half of the
+// LU factorization, needs no pivoting, and, as for LUDecomposition, each
+// right-hand side is then solved in O(n^2).  Normal equations of
+// least-squares fits have this form.
+//
+// The factorization is blocked in the same way as LUDecomposition.  Only
+// the lower triangle of A is read.  The update of the trailing submatrix
+// by a panel of BLOCK_SIZE columns, A22 = A22 - L21*L21^T, is computed for
+// the lower triangle only, from tiles of a transposed copy of L21.
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_MATHEMATICS_ITEM CholeskyDecomposition
+{
+public:
+    // Factor the symmetric matrix A.  The factorization fails when a
+    // diagonal entry of L would be the square root of a number that is not
+    // positive, in which case A is not (numerically) positive definite.
+    CholeskyDecomposition (const GMatrix<Real>& A, ThreadPool* pool = 0);
+    ~CholeskyDecomposition ();
+
+    // Member access.  The factor L is stored in the lower triangle, and the
+    // strict upper triangle is zero.
+    bool IsPositiveDefinite () const;
+    int GetSize () const;
+    const GMatrix<Real>& GetFactor () const;
+    Real GetDeterminant () const;
+
+    // Solve A*X = B for one right-hand side.  The arrays have GetSize()
+    // elements and may be the same.  The return value is 'false' when the
+    // matrix is not positive definite.
+    bool Solve (const Real* B, Real* X) const;
+
+    // Solve A*X = B for the columns of B, which has GetSize() rows.  X is
+    // resized to the size of B and may be the same object as B.
+    bool Solve (const GMatrix<Real>& B, GMatrix<Real>& X) const;
+
+    // The inverse, computed as the solution of A*X = I.
+    bool Inverse (GMatrix<Real>& invA) const;
+
+private:
+    enum
+    {
+        BLOCK_SIZE = 64,
+        COLUMN_TILE = 256
+    };
+
+    void Factor ();
+
+    // Support for the parallel update of the lower triangle of the trailing
+    // submatrix.  Pack stores the transpose of L21 in tiles of COLUMN_TILE
+    // columns.  The task items are groups of four rows.
+    class UpdateTaskData
+    {
+    public:
+        Real* Elements;
+        const Real* Pack;
+        int Size, K0, K1;
+    };
+
+    static void UpdateTask (int begin, int end, int worker, void* userData);
+
+    // C = C - L*U for at most four rows of C and at most COLUMN_TILE
+    // columns, where U is a tile of Pack.  The rows of C and L are 'stride'
+    // apart.
+    static void UpdateBlock (int numRows, int numColumns, int numInner,
+        const Real* L, const Real* U, Real* C, int stride);
+
+    // Support for the parallel solve with multiple right-hand sides.  The
+    // task items are tiles of COLUMN_TILE columns of X.
+    class SolveTaskData
+    {
+    public:
+        const CholeskyDecomposition* Object;
+        Real* Elements;
+        int NumColumns;
+    };
+
+    static void SolveTask (int begin, int end, int worker, void* userData);
+
+    GMatrix<Real> mL;
+    bool mPositiveDefinite;
+    ThreadPool* mPool;
+};
+
+typedef CholeskyDecomposition<float> CholeskyDecompositionf;
+typedef CholeskyDecomposition<double> CholeskyDecompositiond;
+
+}
+
+#endif
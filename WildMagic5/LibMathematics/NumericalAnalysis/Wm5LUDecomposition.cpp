@@ -0,0 +1,474 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5MathematicsPCH.h"
+#include "Wm5LUDecomposition.h"
+#include "Wm5Math.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+LUDecomposition<Real>::LUDecomposition (const GMatrix<Real>& A,
+    ThreadPool* pool)
+    :
+    mLU(A),
+    mNumSwaps(0),
+    mInvertible(true),
+    mPool(pool)
+{
+    assertion(A.GetNumRows() == A.GetNumColumns(), "Matrix must be square\n");
+
+    const int size = A.GetNumRows();
+    mPermutation = new1<int>(size);
+    for (int i = 0; i < size; ++i)
+    {
+        mPermutation[i] = i;
+    }
+
+    Factor();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+LUDecomposition<Real>::~LUDecomposition ()
+{
+    delete1(mPermutation);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LUDecomposition<Real>::IsInvertible () const
+{
+    return mInvertible;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int LUDecomposition<Real>::GetSize () const
+{
+    return mLU.GetNumRows();
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const GMatrix<Real>& LUDecomposition<Real>::GetFactors () const
+{
+    return mLU;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const int* LUDecomposition<Real>::GetPermutation () const
+{
+    return mPermutation;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real LUDecomposition<Real>::GetDeterminant () const
+{
+    if (!mInvertible)
+    {
+        return (Real)0;
+    }
+
+    const int size = mLU.GetNumRows();
+    Real det = ((mNumSwaps & 1) ? (Real)-1 : (Real)1);
+    for (int i = 0; i < size; ++i)
+    {
+        det *= mLU[i][i];
+    }
+    return det;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LUDecomposition<Real>::Solve (const Real* B, Real* X) const
+{
+    if (!mInvertible)
+    {
+        return false;
+    }
+
+    const int size = mLU.GetNumRows();
+    int i, j;
+
+    // Apply the permutation.  A temporary array allows B and X to be the
+    // same array.
+    Real* Y = new1<Real>(size);
+    for (i = 0; i < size; ++i)
+    {
+        Y[i] = B[mPermutation[i]];
+    }
+
+    // Solve L*Y = P*B.
+    for (i = 1; i < size; ++i)
+    {
+        const Real* row = mLU[i];
+        Real sum = Y[i];
+        for (j = 0; j < i; ++j)
+        {
+            sum -= row[j]*Y[j];
+        }
+        Y[i] = sum;
+    }
+
+    // Solve U*X = Y.
+    for (i = size - 1; i >= 0; --i)
+    {
+        const Real* row = mLU[i];
+        Real sum = Y[i];
+        for (j = i + 1; j < size; ++j)
+        {
+            sum -= row[j]*X[j];
+        }
+        X[i] = sum/row[i];
+    }
+
+    delete1(Y);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LUDecomposition<Real>::Solve (const GMatrix<Real>& B,
+    GMatrix<Real>& X) const
+{
+    assertion(B.GetNumRows() == mLU.GetNumRows(),
+        "Mismatched matrix sizes\n");
+
+    if (!mInvertible)
+    {
+        return false;
+    }
+
+    // Apply the permutation.  The copy allows B and X to be the same
+    // matrix.
+    const int size = B.GetNumRows();
+    const int numColumns = B.GetNumColumns();
+    GMatrix<Real> PB(size, numColumns);
+    for (int i = 0; i < size; ++i)
+    {
+        memcpy(PB[i], B[mPermutation[i]], numColumns*sizeof(Real));
+    }
+    X = PB;
+
+    SolveTaskData data;
+    data.Object = this;
+    data.Elements = X.GetElements();
+    data.NumColumns = numColumns;
+    int numTiles = (numColumns + COLUMN_TILE - 1)/COLUMN_TILE;
+    ThreadPool::ParallelFor(mPool, numTiles, 1, SolveTask, &data);
+    return true;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LUDecomposition<Real>::Inverse (GMatrix<Real>& invA) const
+{
+    if (!mInvertible)
+    {
+        return false;
+    }
+
+    const int size = mLU.GetNumRows();
+    GMatrix<Real> identity(size, size);
+    for (int i = 0; i < size; ++i)
+    {
+        identity[i][i] = (Real)1;
+    }
+    return Solve(identity, invA);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void LUDecomposition<Real>::Factor ()
+{
+    const int size = mLU.GetNumRows();
+    const int numTiles = (size + COLUMN_TILE - 1)/COLUMN_TILE;
+    Real* elements = mLU.GetElements();
+    Real* pack = new1<Real>(BLOCK_SIZE*COLUMN_TILE*numTiles);
+    int i, j, k, p;
+
+    for (int k0 = 0; k0 < size; k0 += BLOCK_SIZE)
+    {
+        const int k1 = (k0 + BLOCK_SIZE < size ? k0 + BLOCK_SIZE : size);
+
+        // Factor the panel of columns k0 through k1-1.  The row swaps are
+        // applied to entire rows, which keeps the factors of the previous
+        // panels consistent with the permutation.
+        for (k = k0; k < k1; ++k)
+        {
+            int pivot = k;
+            Real maxValue = Math<Real>::FAbs(elements[k*size + k]);
+            for (i = k + 1; i < size; ++i)
+            {
+                Real absValue = Math<Real>::FAbs(elements[i*size + k]);
+                if (absValue > maxValue)
+                {
+                    maxValue = absValue;
+                    pivot = i;
+                }
+            }
+
+            if (maxValue == (Real)0)
+            {
+                // The matrix is not invertible.
+                mInvertible = false;
+                delete1(pack);
+                return;
+            }
+
+            if (pivot != k)
+            {
+                mLU.SwapRows(pivot, k);
+                int save = mPermutation[pivot];
+                mPermutation[pivot] = mPermutation[k];
+                mPermutation[k] = save;
+                ++mNumSwaps;
+            }
+
+            const Real* pivotRow = &elements[k*size];
+            Real inv = ((Real)1)/pivotRow[k];
+            for (i = k + 1; i < size; ++i)
+            {
+                Real* row = &elements[i*size];
+                Real multiplier = row[k]*inv;
+                row[k] = multiplier;
+                for (j = k + 1; j < k1; ++j)
+                {
+                    row[j] -= multiplier*pivotRow[j];
+                }
+            }
+        }
+
+        if (k1 == size)
+        {
+            break;
+        }
+
+        // Compute the rows k0 through k1-1 of U to the right of the panel,
+        // U12 = Inverse(L11)*A12.
+        for (k = k0; k < k1; ++k)
+        {
+            const Real* pivotRow = &elements[k*size];
+            for (i = k + 1; i < k1; ++i)
+            {
+                Real* row = &elements[i*size];
+                Real multiplier = row[k];
+                for (j = k1; j < size; ++j)
+                {
+                    row[j] -= multiplier*pivotRow[j];
+                }
+            }
+        }
+
+        // Copy U12 to tiles of BLOCK_SIZE-by-COLUMN_TILE entries, padded
+        // with zeros.
+        const int numInner = k1 - k0;
+        const int numTrailing = size - k1;
+        const int numUsedTiles = (numTrailing + COLUMN_TILE - 1)/COLUMN_TILE;
+        for (int t = 0; t < numUsedTiles; ++t)
+        {
+            const int j0 = k1 + t*COLUMN_TILE;
+            const int numColumns = (j0 + COLUMN_TILE < size ? COLUMN_TILE :
+                size - j0);
+            for (p = 0; p < numInner; ++p)
+            {
+                Real* tileRow = &pack[(t*BLOCK_SIZE + p)*COLUMN_TILE];
+                memcpy(tileRow, &elements[(k0 + p)*size + j0],
+                    numColumns*sizeof(Real));
+                for (j = numColumns; j < COLUMN_TILE; ++j)
+                {
+                    tileRow[j] = (Real)0;
+                }
+            }
+        }
+
+        // Update the trailing submatrix, A22 = A22 - L21*U12.
+        UpdateTaskData data;
+        data.Elements = elements;
+        data.Pack = pack;
+        data.Size = size;
+        data.K0 = k0;
+        data.K1 = k1;
+        int numGroups = (numTrailing + 3)/4;
+        ThreadPool::ParallelFor(mPool, numGroups, 0, UpdateTask, &data);
+    }
+
+    delete1(pack);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void LUDecomposition<Real>::UpdateTask (int begin, int end, int,
+    void* userData)
+{
+    const UpdateTaskData& data = *(const UpdateTaskData*)userData;
+    const int size = data.Size;
+    const int k0 = data.K0;
+    const int k1 = data.K1;
+    const int numInner = k1 - k0;
+    const int rowMin = k1 + 4*begin;
+    const int rowMax = (k1 + 4*end < size ? k1 + 4*end : size);
+    Real* elements = data.Elements;
+
+    // The tiles are in the outer loop so that each one is loaded into the
+    // cache once per task.
+    for (int j0 = k1, t = 0; j0 < size; j0 += COLUMN_TILE, ++t)
+    {
+        const int numColumns = (j0 + COLUMN_TILE < size ? COLUMN_TILE :
+            size - j0);
+        const Real* tile = &data.Pack[t*BLOCK_SIZE*COLUMN_TILE];
+        for (int i = rowMin; i < rowMax; i += 4)
+        {
+            const int numRows = (i + 4 < rowMax ? 4 : rowMax - i);
+            UpdateBlock(numRows, numColumns, numInner,
+                &elements[i*size + k0], tile, &elements[i*size + j0], size);
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void LUDecomposition<Real>::UpdateBlock (int numRows, int numColumns,
+    int numInner, const Real* L, const Real* U, Real* C, int stride)
+{
+    // The rows are updated in a local block.  The inner loop has a constant
+    // length and does not alias the matrix, which lets the compiler
+    // vectorize it without run-time checks.
+    Real block[4][COLUMN_TILE];
+    Real a[4][BLOCK_SIZE];
+    int r, j, p;
+    for (r = 0; r < 4; ++r)
+    {
+        int numCopied = 0;
+        if (r < numRows)
+        {
+            memcpy(block[r], &C[r*stride], numColumns*sizeof(Real));
+            memcpy(a[r], &L[r*stride], numInner*sizeof(Real));
+            numCopied = numColumns;
+        }
+        else
+        {
+            memset(a[r], 0, numInner*sizeof(Real));
+        }
+        for (j = numCopied; j < COLUMN_TILE; ++j)
+        {
+            block[r][j] = (Real)0;
+        }
+    }
+
+    for (p = 0; p < numInner; ++p)
+    {
+        const Real* tileRow = &U[p*COLUMN_TILE];
+        const Real a0 = a[0][p], a1 = a[1][p], a2 = a[2][p], a3 = a[3][p];
+        for (j = 0; j < COLUMN_TILE; ++j)
+        {
+            const Real u = tileRow[j];
+            block[0][j] -= a0*u;
+            block[1][j] -= a1*u;
+            block[2][j] -= a2*u;
+            block[3][j] -= a3*u;
+        }
+    }
+
+    for (r = 0; r < numRows; ++r)
+    {
+        memcpy(&C[r*stride], block[r], numColumns*sizeof(Real));
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void LUDecomposition<Real>::SolveTask (int begin, int end, int,
+    void* userData)
+{
+    const SolveTaskData& data = *(const SolveTaskData*)userData;
+    const GMatrix<Real>& LU = data.Object->mLU;
+    const int size = LU.GetNumRows();
+    const int stride = data.NumColumns;
+    Real* elements = data.Elements;
+    Real* tile = new1<Real>(size*COLUMN_TILE);
+    Real sum[COLUMN_TILE];
+    int i, j, k;
+
+    for (int t = begin; t < end; ++t)
+    {
+        // Copy the columns of the tile, padded with zeros, so that the
+        // inner loops have a constant length.
+        const int j0 = t*COLUMN_TILE;
+        const int numColumns = (j0 + COLUMN_TILE < stride ? COLUMN_TILE :
+            stride - j0);
+        for (i = 0; i < size; ++i)
+        {
+            Real* tileRow = &tile[i*COLUMN_TILE];
+            memcpy(tileRow, &elements[i*stride + j0],
+                numColumns*sizeof(Real));
+            for (j = numColumns; j < COLUMN_TILE; ++j)
+            {
+                tileRow[j] = (Real)0;
+            }
+        }
+
+        // Solve L*Y = P*B, row by row of Y.
+        for (i = 1; i < size; ++i)
+        {
+            const Real* row = LU[i];
+            Real* Y = &tile[i*COLUMN_TILE];
+            memcpy(sum, Y, COLUMN_TILE*sizeof(Real));
+            for (k = 0; k < i; ++k)
+            {
+                const Real multiplier = row[k];
+                if (multiplier != (Real)0)
+                {
+                    const Real* Yk = &tile[k*COLUMN_TILE];
+                    for (j = 0; j < COLUMN_TILE; ++j)
+                    {
+                        sum[j] -= multiplier*Yk[j];
+                    }
+                }
+            }
+            memcpy(Y, sum, COLUMN_TILE*sizeof(Real));
+        }
+
+        // Solve U*X = Y, row by row of X from the last one.
+        for (i = size - 1; i >= 0; --i)
+        {
+            const Real* row = LU[i];
+            Real* X = &tile[i*COLUMN_TILE];
+            memcpy(sum, X, COLUMN_TILE*sizeof(Real));
+            for (k = i + 1; k < size; ++k)
+            {
+                const Real multiplier = row[k];
+                if (multiplier != (Real)0)
+                {
+                    const Real* Xk = &tile[k*COLUMN_TILE];
+                    for (j = 0; j < COLUMN_TILE; ++j)
+                    {
+                        sum[j] -= multiplier*Xk[j];
+                    }
+                }
+            }
+
+            const Real inv = ((Real)1)/row[i];
+            for (j = 0; j < COLUMN_TILE; ++j)
+            {
+                X[j] = sum[j]*inv;
+            }
+        }
+
+        for (i = 0; i < size; ++i)
+        {
+            memcpy(&elements[i*stride + j0], &tile[i*COLUMN_TILE],
+                numColumns*sizeof(Real));
+        }
+    }
+
+    delete1(tile);
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_MATHEMATICS_ITEM
+class LUDecomposition<float>;
+
+template WM5_MATHEMATICS_ITEM
+class LUDecomposition<double>;
+//----------------------------------------------------------------------------
+}
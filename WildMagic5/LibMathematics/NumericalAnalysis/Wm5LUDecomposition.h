@@ -0,0 +1,119 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5LUDECOMPOSITION_H
+#define WM5LUDECOMPOSITION_H
+
+#include "Wm5MathematicsLIB.h"
+#include "Wm5GMatrix.h"
+#include "Wm5ThreadPool.h"
+
+// The factorization P*A = L*U of a square matrix A by Gaussian elimination
+// with partial pivoting, where P is a permutation matrix, L is lower
+// triangular with unit diagonal, and U is upper triangular.  The
+// factorization costs O(n^3) and is computed once; each right-hand side is
+// then solved in O(n^2).  Use it instead of an explicit inverse when the
+// same matrix is applied to several vectors.
+//
+// The elimination is blocked.  A panel of BLOCK_SIZE columns is factored,
+// and the remainder of the matrix is updated with the panel by a matrix
+// product, which is nearly all of the work.  The product is computed on
+// tiles of COLUMN_TILE columns, copied contiguously so that they stay in
+// the cache, and four rows of the result at a time, accumulated in a local
+// block so that the innermost loop, over the columns of a tile, has a
+// constant length and is vectorized by the compiler.  When a ThreadPool is
+// supplied, the rows of the update and the columns of a multiple
+// right-hand-side solve are distributed to its workers.
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_MATHEMATICS_ITEM LUDecomposition
+{
+public:
+    // Factor the square matrix A.  The factorization fails when a pivot is
+    // exactly zero, in which case A is singular.
+    LUDecomposition (const GMatrix<Real>& A, ThreadPool* pool = 0);
+    ~LUDecomposition ();
+
+    // Member access.  The factors are stored in one matrix; U is the upper
+    // triangle including the diagonal and L is the strict lower triangle.
+    // Row i of P*A is row GetPermutation()[i] of A.
+    bool IsInvertible () const;
+    int GetSize () const;
+    const GMatrix<Real>& GetFactors () const;
+    const int* GetPermutation () const;
+    Real GetDeterminant () const;
+
+    // Solve A*X = B for one right-hand side.  The arrays have GetSize()
+    // elements and may be the same.  The return value is 'false' when the
+    // matrix is singular.
+    bool Solve (const Real* B, Real* X) const;
+
+    // Solve A*X = B for the columns of B, which has GetSize() rows.  X is
+    // resized to the size of B and may be the same object as B.
+    bool Solve (const GMatrix<Real>& B, GMatrix<Real>& X) const;
+
+    // The inverse, computed as the solution of A*X = I.
+    bool Inverse (GMatrix<Real>& invA) const;
+
+private:
+    enum
+    {
+        BLOCK_SIZE = 64,
+        COLUMN_TILE = 256
+    };
+
+    void Factor ();
+
+    // Support for the parallel update of the trailing submatrix,
+    // A[k1..n-1][k1..n-1] -= A[k1..n-1][k0..k1-1]*A[k0..k1-1][k1..n-1].
+    // Pack stores the rows k0 through k1-1 of U in tiles of COLUMN_TILE
+    // columns.  The task items are groups of four rows.
+    class UpdateTaskData
+    {
+    public:
+        Real* Elements;
+        const Real* Pack;
+        int Size, K0, K1;
+    };
+
+    static void UpdateTask (int begin, int end, int worker, void* userData);
+
+    // C = C - L*U for at most four rows of C and at most COLUMN_TILE
+    // columns, where U is a tile of Pack.  The rows of C and L are 'stride'
+    // apart.
+    static void UpdateBlock (int numRows, int numColumns, int numInner,
+        const Real* L, const Real* U, Real* C, int stride);
+
+    // Support for the parallel solve with multiple right-hand sides.  The
+    // task items are tiles of COLUMN_TILE columns of X.
+    class SolveTaskData
+    {
+    public:
+        const LUDecomposition* Object;
+        Real* Elements;
+        int NumColumns;
+    };
+
+    static void SolveTask (int begin, int end, int worker, void* userData);
+
+    GMatrix<Real> mLU;
+    int* mPermutation;
+    int mNumSwaps;
+    bool mInvertible;
+    ThreadPool* mPool;
+};
+
+typedef LUDecomposition<float> LUDecompositionf;
+typedef LUDecomposition<double> LUDecompositiond;
+
+}
+
+#endif
@@ -4,10 +4,12 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/07/09)
+// File Version: 5.0.4 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5LinearSystem.h"
+#include "Wm5CholeskyDecomposition.h"
+#include "Wm5LUDecomposition.h"
 
 namespace Wm5
 {
@@ -16,6 +18,8 @@ template <typename Real>
 LinearSystem<Real>::LinearSystem ()
 {
     ZeroTolerance = Math<Real>::ZERO_TOLERANCE;
+    MaxIterations = 1024;
+    Pool = 0;
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -79,219 +83,28 @@ template <typename Real>
 bool LinearSystem<Real>::Inverse (const GMatrix<Real>& A,
     GMatrix<Real>& invA)
 {
-    // Computations are performed in-place.
-    assertion(A.GetNumRows() == A.GetNumColumns(), "Matrix must be square\n");
-
-    int size = invA.GetNumRows();
-    invA = A;
-
-    int* colIndex = new1<int>(size);
-    int* rowIndex = new1<int>(size);
-    bool* pivoted = new1<bool>(size);
-    memset(pivoted, 0, size*sizeof(bool));
-
-    int i1, i2, row = 0, col = 0;
-    Real save;
-
-    // Elimination by full pivoting.
-    for (int i0 = 0; i0 < size; ++i0)
-    {
-        // Search matrix (excluding pivoted rows) for maximum absolute entry.
-        Real maxValue = (Real)0;
-        for (i1 = 0; i1 < size; ++i1)
-        {
-            if (!pivoted[i1])
-            {
-                for (i2 = 0; i2 < size; ++i2)
-                {
-                    if (!pivoted[i2])
-                    {
-                        Real absValue = Math<Real>::FAbs(invA[i1][i2]);
-                        if (absValue > maxValue)
-                        {
-                            maxValue = absValue;
-                            row = i1;
-                            col = i2;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (maxValue == (Real)0)
-        {
-            // The matrix is not invertible.
-            delete1(colIndex);
-            delete1(rowIndex);
-            delete1(pivoted);
-            return false;
-        }
-
-        pivoted[col] = true;
-
-        // Swap rows so that A[col][col] contains the pivot entry.
-        if (row != col)
-        {
-            invA.SwapRows(row,col);
-        }
-
-        // Keep track of the permutations of the rows.
-        rowIndex[i0] = row;
-        colIndex[i0] = col;
-
-        // Scale the row so that the pivot entry is 1.
-        Real inv = ((Real)1)/invA[col][col];
-        invA[col][col] = (Real)1;
-        for (i2 = 0; i2 < size; i2++)
-        {
-            invA[col][i2] *= inv;
-        }
-
-        // Zero out the pivot column locations in the other rows.
-        for (i1 = 0; i1 < size; ++i1)
-        {
-            if (i1 != col)
-            {
-                save = invA[i1][col];
-                invA[i1][col] = (Real)0;
-                for (i2 = 0; i2 < size; ++i2)
-                {
-                    invA[i1][i2] -= invA[col][i2]*save;
-                }
-            }
-        }
-    }
-
-    // Reorder rows so that A[][] stores the inverse of the original matrix.
-    for (i1 = size-1; i1 >= 0; --i1)
-    {
-        if (rowIndex[i1] != colIndex[i1])
-        {
-            for (i2 = 0; i2 < size; ++i2)
-            {
-                save = invA[i2][rowIndex[i1]];
-                invA[i2][rowIndex[i1]] = invA[i2][colIndex[i1]];
-                invA[i2][colIndex[i1]] = save;
-            }
-        }
-    }
-
-    delete1(colIndex);
-    delete1(rowIndex);
-    delete1(pivoted);
-    return true;
+    return LUDecomposition<Real>(A, Pool).Inverse(invA);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 bool LinearSystem<Real>::Solve (const GMatrix<Real>& A, const Real* B,
     Real* X)
 {
-    // Computations are performed in-place.
-    int size = A.GetNumColumns();
-    GMatrix<Real> invA = A;
-    memcpy(X, B, size*sizeof(Real));
-
-    int* colIndex = new1<int>(size);
-    int* rowIndex = new1<int>(size);
-    bool* pivoted = new1<bool>(size);
-    memset(pivoted, 0, size*sizeof(bool));
-
-    int i1, i2, row = 0, col = 0;
-    Real save;
-
-    // Elimination by full pivoting.
-    for (int i0 = 0; i0 < size; i0++)
-    {
-        // Search matrix (excluding pivoted rows) for maximum absolute entry.
-        Real maxValue = (Real)0;
-        for (i1 = 0; i1 < size; ++i1)
-        {
-            if (!pivoted[i1])
-            {
-                for (i2 = 0; i2 < size; ++i2)
-                {
-                    if (!pivoted[i2])
-                    {
-                        Real absValue = Math<Real>::FAbs(invA[i1][i2]);
-                        if (absValue > maxValue)
-                        {
-                            maxValue = absValue;
-                            row = i1;
-                            col = i2;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (maxValue == (Real)0)
-        {
-            // The matrix is not invertible.
-            delete1(colIndex);
-            delete1(rowIndex);
-            delete1(pivoted);
-            return false;
-        }
-
-        pivoted[col] = true;
-
-        // Swap rows so that A[col][col] contains the pivot entry.
-        if (row != col)
-        {
-            invA.SwapRows(row,col);
-
-            save = X[row];
-            X[row] = X[col];
-            X[col] = save;
-        }
-
-        // Keep track of the permutations of the rows.
-        rowIndex[i0] = row;
-        colIndex[i0] = col;
-
-        // Scale the row so that the pivot entry is 1.
-        Real inv = ((Real)1.0)/invA[col][col];
-        invA[col][col] = (Real)1;
-        for (i2 = 0; i2 < size; ++i2)
-        {
-            invA[col][i2] *= inv;
-        }
-        X[col] *= inv;
-
-        // Zero out the pivot column locations in the other rows.
-        for (i1 = 0; i1 < size; ++i1)
-        {
-            if (i1 != col)
-            {
-                save = invA[i1][col];
-                invA[i1][col] = (Real)0;
-                for (i2 = 0; i2 < size; i2++)
-                {
-                    invA[i1][i2] -= invA[col][i2]*save;
-                }
-                X[i1] -= X[col]*save;
-            }
-        }
-    }
-
-    // Reorder rows so that A[][] stores the inverse of the original matrix.
-    for (i1 = size-1; i1 >= 0; --i1)
+    return LUDecomposition<Real>(A, Pool).Solve(B, X);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LinearSystem<Real>::SolveSymmetric (const GMatrix<Real>& A,
+    const Real* B, Real* X)
+{
+    if (CholeskyDecomposition<Real>(A, Pool).Solve(B, X))
     {
-        if (rowIndex[i1] != colIndex[i1])
-        {
-            for (i2 = 0; i2 < size; ++i2)
-            {
-                save = invA[i2][rowIndex[i1]];
-                invA[i2][rowIndex[i1]] = invA[i2][colIndex[i1]];
-                invA[i2][colIndex[i1]] = save;
-            }
-        }
+        return true;
     }
 
-    delete1(colIndex);
-    delete1(rowIndex);
-    delete1(pivoted);
-    return true;
+    // A is not numerically positive definite, which happens for normal
+    // equations that are nearly rank deficient.
+    return Solve(A, B, X);
 }
 //----------------------------------------------------------------------------
 template <typename Real>
@@ -398,26 +211,6 @@ void LinearSystem<Real>::Multiply (const GMatrix<Real>& A, const Real* X,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
-void LinearSystem<Real>::Multiply (int size, const SparseMatrix& A,
-    const Real* X, Real* Prod)
-{
-    memset(Prod, 0, size*sizeof(Real));
-    typename SparseMatrix::const_iterator iter = A.begin();
-    typename SparseMatrix::const_iterator end = A.end();
-    for (/**/; iter != end; ++iter)
-    {
-        int i = iter->first.first;
-        int j = iter->first.second;
-        Real value = iter->second;
-        Prod[i] += value*X[j];
-        if (i != j)
-        {
-            Prod[j] += value*X[i];
-        }
-    }
-}
-//----------------------------------------------------------------------------
-template <typename Real>
 void LinearSystem<Real>::UpdateX (int size, Real* X, Real alpha,
     const Real* P)
 {
@@ -471,9 +264,8 @@ bool LinearSystem<Real>::SolveSymmetricCG (const GMatrix<Real>& A,
     Real rho1 = Dot(size, R, R);
 
     // The remaining iterations.
-    const int imax = 1024;
     int i;
-    for (i = 1; i < imax; ++i)
+    for (i = 1; i < MaxIterations; ++i)
     {
         Real root0 = Math<Real>::Sqrt(rho1);
         Real norm = Dot(size, B, B);
@@ -497,58 +289,255 @@ bool LinearSystem<Real>::SolveSymmetricCG (const GMatrix<Real>& A,
     delete1(P);
     delete1(R);
 
-    return i < imax;
+    return i < MaxIterations;
 }
 //----------------------------------------------------------------------------
 template <typename Real>
 bool LinearSystem<Real>::SolveSymmetricCG (int size,
     const SparseMatrix& A, const Real* B, Real* X)
 {
-    // Based on the algorithm in "Matrix Computations" by Golum and Van Loan.
+    CSRMatrix<Real> matrix(size, size);
+    typename SparseMatrix::const_iterator iter = A.begin();
+    typename SparseMatrix::const_iterator end = A.end();
+    for (/**/; iter != end; ++iter)
+    {
+        int i = iter->first.first;
+        int j = iter->first.second;
+        Real value = iter->second;
+        matrix.Insert(i, j, value);
+        if (i != j)
+        {
+            matrix.Insert(j, i, value);
+        }
+    }
+    matrix.Assemble();
+
+    return SolveSymmetricCG(matrix, B, X, PRECONDITION_NONE);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LinearSystem<Real>::SolveSymmetricCG (const CSRMatrix<Real>& A,
+    const Real* B, Real* X, int preconditioner)
+{
+    // Based on the algorithm in "Matrix Computations" by Golub and Van Loan.
+    assertion(A.GetNumRows() == A.GetNumColumns(), "Matrix must be square\n");
+    int size = A.GetNumRows();
+    Preconditioner M(A, preconditioner, true);
     Real* R = new1<Real>(size);
+    Real* Z = new1<Real>(size);
     Real* P = new1<Real>(size);
     Real* W = new1<Real>(size);
 
-    // The first iteration.
     size_t numBytes = size*sizeof(Real);
     memset(X, 0, numBytes);
     memcpy(R, B, numBytes);
-    Real rho0 = Dot(size, R, R);
-    memcpy(P, R, numBytes);
-    Multiply(size, A, P, W);
-    Real alpha = rho0/Dot(size, P, W);
-    UpdateX(size, X, alpha, P);
-    UpdateR(size, R, alpha, W);
-    Real rho1 = Dot(size, R, R);
+    Real bound = ZeroTolerance*Math<Real>::Sqrt(Dot(size, B, B));
+    M.Apply(R, Z);
+    memcpy(P, Z, numBytes);
+    Real rho = Dot(size, R, Z);
 
-    // The remaining iterations.
-    const int imax = 1024;
     int i;
-    for (i = 1; i < imax; ++i)
+    for (i = 0; i < MaxIterations; ++i)
     {
-        Real root0 = Math<Real>::Sqrt(rho1);
-        Real norm = Dot(size, B, B);
-        Real root1 = Math<Real>::Sqrt(norm);
-        if (root0 <= ZeroTolerance*root1)
+        if (Math<Real>::Sqrt(Dot(size, R, R)) <= bound)
         {
             break;
         }
 
-        Real beta = rho1/rho0;
-        UpdateP(size, P, beta, R);
-        Multiply(size, A, P, W);
-        alpha = rho1/Dot(size, P, W);
+        A.Multiply(P, W, Pool);
+        Real alpha = rho/Dot(size, P, W);
         UpdateX(size, X, alpha, P);
         UpdateR(size, R, alpha, W);
-        rho0 = rho1;
-        rho1 = Dot(size, R, R);
+        M.Apply(R, Z);
+        Real rhoNext = Dot(size, R, Z);
+        UpdateP(size, P, rhoNext/rho, Z);
+        rho = rhoNext;
     }
 
     delete1(W);
     delete1(P);
+    delete1(Z);
+    delete1(R);
+
+    return i < MaxIterations;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+bool LinearSystem<Real>::SolveBiCGSTAB (const CSRMatrix<Real>& A,
+    const Real* B, Real* X, int preconditioner)
+{
+    // The preconditioned algorithm in "Templates for the Solution of Linear
+    // Systems" by Barrett et al.  The residual R is also used for the
+    // intermediate residual S, and Y for the preconditioned S.
+    assertion(A.GetNumRows() == A.GetNumColumns(), "Matrix must be square\n");
+    int size = A.GetNumRows();
+    Preconditioner M(A, preconditioner, false);
+    Real* R = new1<Real>(size);
+    Real* RTilde = new1<Real>(size);
+    Real* P = new1<Real>(size);
+    Real* V = new1<Real>(size);
+    Real* Y = new1<Real>(size);
+    Real* T = new1<Real>(size);
+
+    size_t numBytes = size*sizeof(Real);
+    memset(X, 0, numBytes);
+    memcpy(R, B, numBytes);
+    memcpy(RTilde, B, numBytes);
+    memset(P, 0, numBytes);
+    memset(V, 0, numBytes);
+    Real bound = ZeroTolerance*Math<Real>::Sqrt(Dot(size, B, B));
+    Real rho = (Real)1, alpha = (Real)1, omega = (Real)1;
+
+    bool converged = false;
+    for (int i = 0; i < MaxIterations; ++i)
+    {
+        if (Math<Real>::Sqrt(Dot(size, R, R)) <= bound)
+        {
+            converged = true;
+            break;
+        }
+
+        Real rhoNext = Dot(size, RTilde, R);
+        if (rhoNext == (Real)0)
+        {
+            break;
+        }
+
+        Real beta = (rhoNext/rho)*(alpha/omega);
+        for (int j = 0; j < size; ++j)
+        {
+            P[j] = R[j] + beta*(P[j] - omega*V[j]);
+        }
+        M.Apply(P, Y);
+        A.Multiply(Y, V, Pool);
+        Real denom = Dot(size, RTilde, V);
+        if (denom == (Real)0)
+        {
+            break;
+        }
+
+        alpha = rhoNext/denom;
+        UpdateX(size, X, alpha, Y);
+        UpdateR(size, R, alpha, V);
+        if (Math<Real>::Sqrt(Dot(size, R, R)) <= bound)
+        {
+            converged = true;
+            break;
+        }
+
+        M.Apply(R, Y);
+        A.Multiply(Y, T, Pool);
+        Real sqrLength = Dot(size, T, T);
+        if (sqrLength == (Real)0)
+        {
+            break;
+        }
+
+        omega = Dot(size, T, R)/sqrLength;
+        UpdateX(size, X, omega, Y);
+        UpdateR(size, R, omega, T);
+        if (omega == (Real)0)
+        {
+            break;
+        }
+        rho = rhoNext;
+    }
+
+    delete1(T);
+    delete1(Y);
+    delete1(V);
+    delete1(P);
+    delete1(RTilde);
     delete1(R);
 
-    return i < imax;
+    return converged;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+LinearSystem<Real>::Preconditioner::Preconditioner (
+    const CSRMatrix<Real>& A, int type, bool symmetric)
+    :
+    Matrix(&A),
+    Type(type),
+    Data(0)
+{
+    const int size = A.GetNumRows();
+    const Real* values = A.GetValues();
+    int i;
+
+    if (Type == PRECONDITION_INCOMPLETE)
+    {
+        Data = new1<Real>(A.GetNumNonzeros());
+        bool success = A.FactorIncomplete(Data);
+        if (success && symmetric)
+        {
+            // The conjugate gradient method requires a positive definite
+            // preconditioner, L*D*L^T with the pivots D positive.
+            for (i = 0; i < size; ++i)
+            {
+                if (Data[A.GetDiagonalIndex(i)] <= (Real)0)
+                {
+                    success = false;
+                    break;
+                }
+            }
+        }
+
+        if (!success)
+        {
+            delete1(Data);
+            Data = 0;
+            Type = PRECONDITION_JACOBI;
+        }
+    }
+
+    if (Type == PRECONDITION_JACOBI)
+    {
+        Data = new1<Real>(size);
+        for (i = 0; i < size; ++i)
+        {
+            int index = A.GetDiagonalIndex(i);
+            Real diagonal = (index >= 0 ? values[index] : (Real)0);
+            if (symmetric ? diagonal > (Real)0 : diagonal != (Real)0)
+            {
+                Data[i] = ((Real)1)/diagonal;
+            }
+            else
+            {
+                Data[i] = (Real)1;
+            }
+        }
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+LinearSystem<Real>::Preconditioner::~Preconditioner ()
+{
+    delete1(Data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void LinearSystem<Real>::Preconditioner::Apply (const Real* R, Real* Z)
+    const
+{
+    const int size = Matrix->GetNumRows();
+    int i;
+
+    switch (Type)
+    {
+    case PRECONDITION_JACOBI:
+        for (i = 0; i < size; ++i)
+        {
+            Z[i] = Data[i]*R[i];
+        }
+        break;
+    case PRECONDITION_INCOMPLETE:
+        Matrix->SolveIncomplete(Data, R, Z);
+        break;
+    default:
+        memcpy(Z, R, size*sizeof(Real));
+        break;
+    }
 }
 //----------------------------------------------------------------------------
 
@@ -4,14 +4,16 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5LINEARSYSTEM_H
 #define WM5LINEARSYSTEM_H
 
 #include "Wm5MathematicsLIB.h"
 #include "Wm5BandedMatrix.h"
+#include "Wm5CSRMatrix.h"
 #include "Wm5GMatrix.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -33,6 +35,9 @@ public:
     // Output:
     //     return value is TRUE if successful, FALSE if pivoting failed
     //     InvA[iSize][iSize], inverse matrix
+    // The inverse is computed by LUDecomposition.  To apply the inverse to
+    // vectors, use LUDecomposition::Solve instead, which is faster and more
+    // accurate than the product with the inverse.
     bool Inverse (const GMatrix<Real>& A, GMatrix<Real>& invA);
 
     // Input:
@@ -41,8 +46,21 @@ public:
     // Output:
     //     return value is TRUE if successful, FALSE if pivoting failed
     //     X[iSize] is solution X to AX = B
+    // The system is solved by LUDecomposition.  For several right-hand
+    // sides with the same matrix, use LUDecomposition directly.
     bool Solve (const GMatrix<Real>& A, const Real* B, Real* X);
 
+    // Input:
+    //     A[iSize][iSize] symmetric positive definite matrix, for example
+    //     the matrix of the normal equations of a least-squares fit
+    //     B[iSize] vector, entries are B[row]
+    // Output:
+    //     return value is TRUE if successful, FALSE if A is singular
+    //     X[iSize] is solution X to AX = B
+    // The system is solved by CholeskyDecomposition, at half the cost of
+    // Solve.  If A is not numerically positive definite, Solve is used.
+    bool SolveSymmetric (const GMatrix<Real>& A, const Real* B, Real* X);
+
     // Input:
     //     Matrix is tridiagonal.
     //     Lower diagonal A[iSize-1]
@@ -84,10 +102,43 @@ public:
     //    an array of contiguous values.
     // Output:
     //    X[iSize] is the solution x to Ax = B
+    // The map is converted to a CSRMatrix and the system is solved without
+    // a preconditioner.  New code should build the CSRMatrix directly.
     typedef std::map<std::pair<int,int>,Real> SparseMatrix;
     bool SolveSymmetricCG (int size, const SparseMatrix& A, const Real* B,
         Real* X);
 
+    // Preconditioners for the sparse iterative solvers.  The incomplete
+    // factorization is CSRMatrix::FactorIncomplete, which is IC(0) for a
+    // symmetric matrix and ILU(0) otherwise.  When it fails, the Jacobi
+    // preconditioner is used instead.
+    enum
+    {
+        PRECONDITION_NONE,
+        PRECONDITION_JACOBI,
+        PRECONDITION_INCOMPLETE
+    };
+
+    // Preconditioned conjugate gradient method for sparse, symmetric
+    // matrices.
+    // Input:
+    //    A[iSize][iSize] symmetric positive (semi)definite matrix with both
+    //    triangles stored; for a semidefinite matrix, B must be in its range
+    //    B[iSize] vector, entries are B[row]
+    // Output:
+    //    return value is TRUE if the residual norm drops below
+    //    ZeroTolerance times the norm of B within MaxIterations iterations
+    //    X[iSize] is the solution x to Ax = B
+    bool SolveSymmetricCG (const CSRMatrix<Real>& A, const Real* B,
+        Real* X, int preconditioner = PRECONDITION_INCOMPLETE);
+
+    // Preconditioned biconjugate gradient stabilized method (BiCGSTAB) for
+    // sparse, square matrices that are not symmetric.  The input, output,
+    // and convergence test are those of the sparse SolveSymmetricCG.  The
+    // return value is also FALSE when the iteration breaks down.
+    bool SolveBiCGSTAB (const CSRMatrix<Real>& A, const Real* B, Real* X,
+        int preconditioner = PRECONDITION_INCOMPLETE);
+
     // Solve banded matrix systems.
     // Input:
     //     A, a banded matrix
@@ -108,6 +159,14 @@ public:
     // Tolerance for linear system solving.
     Real ZeroTolerance;  // default = Math<Real>::ZERO_TOLERANCE
 
+    // Maximum number of iterations of the conjugate gradient methods.
+    int MaxIterations;  // default = 1024
+
+    // Optional threads for the factorizations of Inverse, Solve, and
+    // SolveSymmetric and for the matrix-vector products of the sparse
+    // iterative solvers.
+    ThreadPool* Pool;  // default = 0
+
 private:
     // Support for the conjugate gradient method for standard arrays.
     Real Dot (int size, const Real* U, const Real* V);
@@ -116,9 +175,20 @@ private:
     void UpdateR (int size, Real* R, Real alpha, const Real* W);
     void UpdateP (int size, Real* P, Real beta, const Real* R);
 
-    // Support for the conjugate gradient method for sparse arrays.
-    void Multiply (int size, const SparseMatrix& A, const Real* X,
-        Real* Prod);
+    // Support for the sparse iterative solvers.  The preconditioner
+    // computes Z = Inverse(M)*R.
+    class Preconditioner
+    {
+    public:
+        Preconditioner (const CSRMatrix<Real>& A, int type,
+            bool symmetric);
+        ~Preconditioner ();
+        void Apply (const Real* R, Real* Z) const;
+
+        const CSRMatrix<Real>* Matrix;
+        int Type;
+        Real* Data;
+    };
 
     // Support for banded matrices.
     bool ForwardEliminate (int reduceRow, BandedMatrix<Real>& A, Real* B);
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/03/09)
+// File Version: 5.0.3 (2026/10/19)
 
 #include "Wm5MathematicsPCH.h"
 #include "Wm5MinimizeN.h"
@@ -20,6 +20,8 @@ MinimizeN<Real>::MinimizeN (int dimensions, Function function,
     :
     mDimensions(dimensions),
     mFunction(function),
+    mMaxLevel(maxLevel),
+    mMaxBracket(maxBracket),
     mMaxIterations(maxIterations),
     mUserData(userData),
     mMinimizer(LineFunction, maxLevel, maxBracket)
@@ -62,10 +64,17 @@ void MinimizeN<Real>::GetMinimum (const Real* t0, const Real* t1,
     memcpy(mTSave, tInitial, numBytes);
     memcpy(mTCurr, tInitial, numBytes);
 
-    // Initialize the direction set to the standard Euclidean basis.
+    // Initialize the direction set to the standard Euclidean basis.  The
+    // iterations cycle the pointers, so they are reset for each call, which
+    // makes the result independent of the previous calls.
     size_t numBasisBytes = numBytes*(mDimensions + 1);
     memset(mDirectionStorage, 0, numBasisBytes);
     int i;
+    for (i = 0; i <= mDimensions; ++i)
+    {
+        mDirection[i] = &mDirectionStorage[i*mDimensions];
+    }
+    mDConj = mDirection[mDimensions];
     for (i = 0; i < mDimensions; ++i)
     {
         mDirection[i][i] = (Real)1;
@@ -134,6 +143,54 @@ void MinimizeN<Real>::GetMinimum (const Real* t0, const Real* t1,
 }
 //----------------------------------------------------------------------------
 template <typename Real>
+int MinimizeN<Real>::GetMinimum (const Real* t0, const Real* t1,
+    int numSeeds, const Real* seeds, Real* tMin, Real& fMin,
+    ThreadPool* pool)
+{
+    assertion(numSeeds >= 1 && seeds, "Invalid inputs\n");
+
+    // The minimizers keep their state in member data, so each worker needs
+    // its own object.
+    const int numWorkers = ThreadPool::GetNumWorkers(pool);
+    MultiStartTaskData data;
+    data.Minimizers = new1<MinimizeN*>(numWorkers);
+    data.Minimizers[0] = this;
+    int i;
+    for (i = 1; i < numWorkers; ++i)
+    {
+        data.Minimizers[i] = new0 MinimizeN(mDimensions, mFunction,
+            mMaxLevel, mMaxBracket, mMaxIterations, mUserData);
+    }
+    data.T0 = t0;
+    data.T1 = t1;
+    data.Seeds = seeds;
+    data.TMins = new1<Real>(numSeeds*mDimensions);
+    data.FMins = new1<Real>(numSeeds);
+
+    ThreadPool::ParallelFor(pool, numSeeds, 1, MultiStartTask, &data);
+
+    int best = 0;
+    for (i = 1; i < numSeeds; ++i)
+    {
+        if (data.FMins[i] < data.FMins[best])
+        {
+            best = i;
+        }
+    }
+    memcpy(tMin, &data.TMins[best*mDimensions], mDimensions*sizeof(Real));
+    fMin = data.FMins[best];
+
+    for (i = 1; i < numWorkers; ++i)
+    {
+        delete0(data.Minimizers[i]);
+    }
+    delete1(data.Minimizers);
+    delete1(data.TMins);
+    delete1(data.FMins);
+    return best;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
 void MinimizeN<Real>::ComputeDomain (const Real* t0, const Real* t1,
     Real& ell0, Real& ell1)
 {
@@ -202,6 +259,21 @@ Real MinimizeN<Real>::LineFunction (Real t, void* userData)
     return result;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void MinimizeN<Real>::MultiStartTask (int begin, int end, int worker,
+    void* userData)
+{
+    const MultiStartTaskData& data = *(const MultiStartTaskData*)userData;
+    MinimizeN& minimizer = *data.Minimizers[worker];
+    const int dimensions = minimizer.mDimensions;
+
+    for (int i = begin; i < end; ++i)
+    {
+        minimizer.GetMinimum(data.T0, data.T1, &data.Seeds[i*dimensions],
+            &data.TMins[i*dimensions], data.FMins[i]);
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2011/03/09)
+// File Version: 5.0.3 (2026/10/19)
 
 #ifndef WM5MINIMIZEN_H
 #define WM5MINIMIZEN_H
 
 #include "Wm5MathematicsLIB.h"
 #include "Wm5Minimize1.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -52,6 +53,17 @@ public:
     void GetMinimum (const Real* t0, const Real* t1, const Real* tInitial,
         Real* tMin, Real& fMin);
 
+    // Find the minimum as above from each of 'numSeeds' initial guesses,
+    // stored consecutively in seeds[0..numSeeds*d-1], and return the best
+    // result in tMin[0..d-1] and 'fMin'.  The return value is the index of
+    // the seed that led to the best result; ties are resolved by the
+    // smaller index, so the result does not depend on the number of
+    // threads.  When 'pool' is not null, the seeds are distributed to its
+    // workers, each with its own MinimizeN object, in which case 'function'
+    // must be safe to call concurrently with the same userData.
+    int GetMinimum (const Real* t0, const Real* t1, int numSeeds,
+        const Real* seeds, Real* tMin, Real& fMin, ThreadPool* pool = 0);
+
 private:
     // The current estimate of the minimum location is mTCurr[0..d-1].  The
     // direction of the current line to search is mDCurr[0..d-1].  This line
@@ -65,8 +77,26 @@ private:
     // 1-dimensionsal search (along the line mTCurr+s*mDCurr).
     static Real LineFunction (Real t, void* userData);
 
+    // Support for the parallel multiple-start minimization.  The task items
+    // are the seeds.  Minimizers stores one object per worker; the first is
+    // the caller.
+    class MultiStartTaskData
+    {
+    public:
+        MinimizeN** Minimizers;
+        const Real* T0;
+        const Real* T1;
+        const Real* Seeds;
+        Real* TMins;
+        Real* FMins;
+    };
+
+    static void MultiStartTask (int begin, int end, int worker,
+        void* userData);
+
     int mDimensions;
     Function mFunction;
+    int mMaxLevel, mMaxBracket;
     int mMaxIterations;
     void* mUserData;
     Minimize1<Real> mMinimizer;
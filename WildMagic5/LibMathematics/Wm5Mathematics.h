@@ -100,6 +100,7 @@
 #include "Wm5ContSphere3.h"
 
 // CurvesSurfacesVolumes
+#include "Wm5ArcLengthTable.h"
 #include "Wm5BSplineBasis.h"
 #include "Wm5BSplineCurveFit.h"
 #include "Wm5BSplineFitBasis.h"
@@ -315,6 +316,7 @@
 #include "Wm5EdgeKey.h"
 #include "Wm5ETManifoldMesh.h"
 #include "Wm5ETNonmanifoldMesh.h"
+#include "Wm5HalfEdgeMesh.h"
 #include "Wm5MeshCurvature.h"
 #include "Wm5MeshSmoother.h"
 #include "Wm5PlanarGraph.h"
@@ -335,8 +337,11 @@
 #include "Wm5Bisect2.h"
 #include "Wm5Bisect3.h"
 #include "Wm5BrentsMethod.h"
+#include "Wm5CSRMatrix.h"
+#include "Wm5CholeskyDecomposition.h"
 #include "Wm5EigenDecomposition.h"
 #include "Wm5Integrate1.h"
+#include "Wm5LUDecomposition.h"
 #include "Wm5LinearSystem.h"
 #include "Wm5Minimize1.h"
 #include "Wm5MinimizeN.h"
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "Wm5PhysicsPCH.h"
 #include "Wm5ExtremalQuery3.h"
@@ -51,6 +51,42 @@ const Vector3<Real>* ExtremalQuery3<Real>::GetFaceNormals () const
     return mFaceNormals;
 }
 //----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3<Real>::GetExtremeVerticesBatch (int numDirections,
+    const Vector3<Real>* directions, int* positiveDirection,
+    int* negativeDirection)
+{
+    for (int i = 0; i < numDirections; ++i)
+    {
+        GetExtremeVertices(directions[i], positiveDirection[i],
+            negativeDirection[i]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3<Real>::GetExtremeVerticesMulti (int numQueries,
+    ExtremalQuery3* const* queries, const Vector3<Real>& direction,
+    int* positiveDirection, int* negativeDirection, ThreadPool* pool)
+{
+    MultiData data;
+    data.Queries = queries;
+    data.Direction = &direction;
+    data.PositiveDirection = positiveDirection;
+    data.NegativeDirection = negativeDirection;
+    ThreadPool::ParallelFor(pool, numQueries, 0, MultiTask, &data);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3<Real>::MultiTask (int begin, int end, int, void* userData)
+{
+    const MultiData& data = *(const MultiData*)userData;
+    for (int i = begin; i < end; ++i)
+    {
+        data.Queries[i]->GetExtremeVertices(*data.Direction,
+            data.PositiveDirection[i], data.NegativeDirection[i]);
+    }
+}
+//----------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------
 // Explicit instantiation.
@@ -4,13 +4,14 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5EXTREMALQUERY3_H
 #define WM5EXTREMALQUERY3_H
 
 #include "Wm5PhysicsLIB.h"
 #include "Wm5ConvexPolyhedron3.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -31,11 +32,39 @@ public:
     virtual void GetExtremeVertices (const Vector3<Real>& direction,
         int& positiveDirection, int& negativeDirection) = 0;
 
+    // Compute the extreme vertices for each of the specified directions.
+    // The output arrays must have 'numDirections' elements.  The default
+    // implementation calls GetExtremeVertices for each direction.
+    virtual void GetExtremeVerticesBatch (int numDirections,
+        const Vector3<Real>* directions, int* positiveDirection,
+        int* negativeDirection);
+
+    // Compute the extreme vertices of each of the polyhedra of 'queries'
+    // in the specified direction.  The output arrays must have 'numQueries'
+    // elements.  The queries must be distinct objects.  If 'pool' is not
+    // null, the queries are processed concurrently.
+    static void GetExtremeVerticesMulti (int numQueries,
+        ExtremalQuery3* const* queries, const Vector3<Real>& direction,
+        int* positiveDirection, int* negativeDirection,
+        ThreadPool* pool = 0);
+
 protected:
     ExtremalQuery3 (const ConvexPolyhedron3<Real>* polytope);
 
     const ConvexPolyhedron3<Real>* mPolytope;
     Vector3<Real>* mFaceNormals;
+
+private:
+    class MultiData
+    {
+    public:
+        ExtremalQuery3* const* Queries;
+        const Vector3<Real>* Direction;
+        int* PositiveDirection;
+        int* NegativeDirection;
+    };
+
+    static void MultiTask (int begin, int end, int worker, void* userData);
 };
 
 typedef ExtremalQuery3<float> ExtremalQuery3f;
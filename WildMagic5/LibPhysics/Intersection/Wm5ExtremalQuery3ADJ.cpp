@@ -0,0 +1,204 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5PhysicsPCH.h"
+#include "Wm5ExtremalQuery3ADJ.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+const int ExtremalQuery3ADJ<Real>::msMaxScanVertices = 64;
+//----------------------------------------------------------------------------
+template <typename Real>
+ExtremalQuery3ADJ<Real>::ExtremalQuery3ADJ (
+    const ConvexPolyhedron3<Real>* polytope)
+    :
+    ExtremalQuery3<Real>(polytope),
+    mPositiveStart(0),
+    mNegativeStart(0)
+{
+    mNumVertices = mPolytope->GetNumVertices();
+    mX = new1<Real>(mNumVertices);
+    mY = new1<Real>(mNumVertices);
+    mZ = new1<Real>(mNumVertices);
+    UpdateVertices();
+
+    // Collect the directed edges of the triangles, both orientations, and
+    // remove the duplicates.  The sorted edges are grouped by their first
+    // vertex, which gives the adjacency lists directly.
+    const int numTriangles = mPolytope->GetNumTriangles();
+    const int* indices = mPolytope->GetIndices();
+    std::vector<std::pair<int,int> > edges(6*numTriangles);
+    int i, j;
+    for (i = 0, j = 0; i < numTriangles; ++i, indices += 3)
+    {
+        for (int k0 = 2, k1 = 0; k1 < 3; k0 = k1++)
+        {
+            edges[j++] = std::make_pair(indices[k0], indices[k1]);
+            edges[j++] = std::make_pair(indices[k1], indices[k0]);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    const int numEdges = (int)edges.size();
+    mAdjacentStart = new1<int>(mNumVertices + 1);
+    mAdjacent = new1<int>(numEdges);
+    memset(mAdjacentStart, 0, (mNumVertices + 1)*sizeof(int));
+    for (j = 0; j < numEdges; ++j)
+    {
+        ++mAdjacentStart[edges[j].first + 1];
+        mAdjacent[j] = edges[j].second;
+    }
+    for (i = 0; i < mNumVertices; ++i)
+    {
+        mAdjacentStart[i + 1] += mAdjacentStart[i];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+ExtremalQuery3ADJ<Real>::~ExtremalQuery3ADJ ()
+{
+    delete1(mX);
+    delete1(mY);
+    delete1(mZ);
+    delete1(mAdjacentStart);
+    delete1(mAdjacent);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3ADJ<Real>::UpdateVertices ()
+{
+    const Vector3<Real>* vertices = mPolytope->GetVertices();
+    for (int i = 0; i < mNumVertices; ++i)
+    {
+        mX[i] = vertices[i][0];
+        mY[i] = vertices[i][1];
+        mZ[i] = vertices[i][2];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3ADJ<Real>::SetStart (int positiveDirection,
+    int negativeDirection)
+{
+    assertion(0 <= positiveDirection && positiveDirection < mNumVertices
+        && 0 <= negativeDirection && negativeDirection < mNumVertices,
+        "Invalid starting vertex\n");
+
+    mPositiveStart = positiveDirection;
+    mNegativeStart = negativeDirection;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3ADJ<Real>::GetExtremeVertices (
+    const Vector3<Real>& direction, int& positiveDirection,
+    int& negativeDirection)
+{
+    positiveDirection = ClimbMaximum(direction[0], direction[1],
+        direction[2], mPositiveStart);
+    negativeDirection = ClimbMaximum(-direction[0], -direction[1],
+        -direction[2], mNegativeStart);
+
+    mPositiveStart = positiveDirection;
+    mNegativeStart = negativeDirection;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void ExtremalQuery3ADJ<Real>::GetExtremeVerticesBatch (int numDirections,
+    const Vector3<Real>* directions, int* positiveDirection,
+    int* negativeDirection)
+{
+    int d;
+    if (mNumVertices > msMaxScanVertices)
+    {
+        // Each climb starts at the answer for the previous direction.
+        for (d = 0; d < numDirections; ++d)
+        {
+            GetExtremeVertices(directions[d], positiveDirection[d],
+                negativeDirection[d]);
+        }
+        return;
+    }
+
+    const Real* x = mX;
+    const Real* y = mY;
+    const Real* z = mZ;
+
+    for (d = 0; d < numDirections; ++d)
+    {
+        const Real dx = directions[d][0];
+        const Real dy = directions[d][1];
+        const Real dz = directions[d][2];
+        Real minValue = dx*x[0] + dy*y[0] + dz*z[0];
+        Real maxValue = minValue;
+        int minIndex = 0, maxIndex = 0;
+
+        for (int i = 1; i < mNumVertices; ++i)
+        {
+            Real dot = dx*x[i] + dy*y[i] + dz*z[i];
+            if (dot < minValue)
+            {
+                minValue = dot;
+                minIndex = i;
+            }
+            else if (dot > maxValue)
+            {
+                maxValue = dot;
+                maxIndex = i;
+            }
+        }
+
+        positiveDirection[d] = maxIndex;
+        negativeDirection[d] = minIndex;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int ExtremalQuery3ADJ<Real>::ClimbMaximum (Real dx, Real dy, Real dz,
+    int current) const
+{
+    Real currentValue = dx*mX[current] + dy*mY[current] + dz*mZ[current];
+    for (;;)
+    {
+        // Move to the neighbor with the largest value (steepest ascent).
+        int next = current;
+        Real nextValue = currentValue;
+        const int jmax = mAdjacentStart[current + 1];
+        for (int j = mAdjacentStart[current]; j < jmax; ++j)
+        {
+            int a = mAdjacent[j];
+            Real value = dx*mX[a] + dy*mY[a] + dz*mZ[a];
+            if (value > nextValue)
+            {
+                next = a;
+                nextValue = value;
+            }
+        }
+
+        if (next == current)
+        {
+            return current;
+        }
+        current = next;
+        currentValue = nextValue;
+    }
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_PHYSICS_ITEM
+class ExtremalQuery3ADJ<float>;
+
+template WM5_PHYSICS_ITEM
+class ExtremalQuery3ADJ<double>;
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,82 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5EXTREMALQUERY3ADJ_H
+#define WM5EXTREMALQUERY3ADJ_H
+
+#include "Wm5PhysicsLIB.h"
+#include "Wm5ExtremalQuery3.h"
+
+namespace Wm5
+{
+
+template <typename Real>
+class WM5_PHYSICS_ITEM ExtremalQuery3ADJ : public ExtremalQuery3<Real>
+{
+public:
+    // The single-direction query is a hill climb on the vertex adjacency
+    // graph.  A vertex of a convex polyhedron that is not extreme in a
+    // direction has a neighbor that is farther in that direction, so the
+    // climb ends at an extreme vertex.  Each climb starts at the answer of
+    // the previous query, which makes temporally coherent queries (slowly
+    // rotating directions) nearly constant time.
+    //
+    // For polyhedra with at most 64 vertices, the batched query scans all
+    // the vertices for each direction, which is faster than the hill climb
+    // for small polyhedra.  The vertices are stored as separate x, y and z
+    // arrays so that the dot products are computed by a simple loop over
+    // contiguous memory.  For larger polyhedra, the batched query climbs
+    // from the answer for the previous direction, so it benefits from
+    // ordering the directions coherently.
+    ExtremalQuery3ADJ (const ConvexPolyhedron3<Real>* polytope);
+    virtual ~ExtremalQuery3ADJ ();
+
+    // Compute the extreme vertices in the specified direction and return the
+    // indices of the vertices in the polyhedron vertex array.
+    virtual void GetExtremeVertices (const Vector3<Real>& direction,
+        int& positiveDirection, int& negativeDirection);
+
+    virtual void GetExtremeVerticesBatch (int numDirections,
+        const Vector3<Real>* directions, int* positiveDirection,
+        int* negativeDirection);
+
+    // The vertices are copied on construction.  Call this after modifying
+    // the vertices of the polyhedron.  The connectivity must not change.
+    void UpdateVertices ();
+
+    // Set the starting vertices of the next hill climb.
+    void SetStart (int positiveDirection, int negativeDirection);
+
+private:
+    using ExtremalQuery3<Real>::mPolytope;
+
+    int ClimbMaximum (Real dx, Real dy, Real dz, int current) const;
+
+    int mNumVertices;
+    Real* mX;
+    Real* mY;
+    Real* mZ;
+
+    // The neighbors of vertex i are mAdjacent[mAdjacentStart[i]] through
+    // mAdjacent[mAdjacentStart[i+1]-1].
+    int* mAdjacentStart;
+    int* mAdjacent;
+
+    // The answer of the previous single-direction query.
+    int mPositiveStart, mNegativeStart;
+
+    // The largest polyhedron for which the batched query scans.
+    static const int msMaxScanVertices;
+};
+
+typedef ExtremalQuery3ADJ<float> ExtremalQuery3ADJf;
+typedef ExtremalQuery3ADJ<double> ExtremalQuery3ADJd;
+
+}
+
+#endif
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.2 (2012/08/02)
+// File Version: 5.0.3 (2026/10/19)
 
 #include "Wm5PhysicsPCH.h"
 #include "Wm5LCPPolyDist.h"
@@ -137,6 +137,37 @@ LCPPolyDist<Dimension,FVector,DVector>::LCPPolyDist (int numFaces1,
 }
 //----------------------------------------------------------------------------
 template <int Dimension, typename FVector, typename DVector>
+void LCPPolyDist<Dimension,FVector,DVector>::ComputeBatch (int numQueries,
+    Query* queries, ThreadPool* pool, double verifyMinDifference,
+    double randomWidth)
+{
+    BatchData data;
+    data.Queries = queries;
+    data.VerifyMinDifference = verifyMinDifference;
+    data.RandomWidth = randomWidth;
+
+    // The cost of a query varies with the sizes of the polyhedra and the
+    // number of pivots, so the queries are handed out one at a time.
+    ThreadPool::ParallelFor(pool, numQueries, 1, BatchTask, &data);
+}
+//----------------------------------------------------------------------------
+template <int Dimension, typename FVector, typename DVector>
+void LCPPolyDist<Dimension,FVector,DVector>::BatchTask (int begin, int end,
+    int, void* userData)
+{
+    const BatchData& data = *(const BatchData*)userData;
+    for (int i = begin; i < end; ++i)
+    {
+        Query& query = data.Queries[i];
+        LCPPolyDist distance(query.NumPoints1, query.Points1,
+            query.NumFaces1, query.Faces1, query.NumPoints2, query.Points2,
+            query.NumFaces2, query.Faces2, query.StatusCode, query.Distance,
+            query.Closest, data.VerifyMinDifference, data.RandomWidth);
+        WM5_UNUSED(distance);
+    }
+}
+//----------------------------------------------------------------------------
+template <int Dimension, typename FVector, typename DVector>
 double LCPPolyDist<Dimension,FVector,DVector>::ProcessLoop (
     bool halfspaceConstructor, int& statusCode, FVector closest[2])
 {
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2010/10/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #ifndef WM5LCPPOLYDIST_H
 #define WM5LCPPOLYDIST_H
@@ -14,6 +14,7 @@
 #include "Wm5Vector2.h"
 #include "Wm5Vector3.h"
 #include "Wm5LCPSolver.h"
+#include "Wm5ThreadPool.h"
 
 namespace Wm5
 {
@@ -108,6 +109,36 @@ public:
         FVector closest[2], double verifyMinDifference = 0.00001,
         double randomWidth = 0.0);
 
+    // Batched queries for pairs of polygons or polyhedra represented by
+    // vertices and faces.  Each query has the inputs and outputs of the
+    // vertex-face constructor.  The queries are independent of each other,
+    // so when 'pool' is not null they are processed concurrently.  The
+    // caller retains ownership of the pool.  Queries may share vertex and
+    // face arrays.  The logging enabled by WM5_LCPPOLYDIST_LOG writes to a
+    // single file and must not be used with a pool.
+    class Query
+    {
+    public:
+        // Inputs.
+        int NumPoints1;
+        FVector* Points1;
+        int NumFaces1;
+        ITuple* Faces1;
+        int NumPoints2;
+        FVector* Points2;
+        int NumFaces2;
+        ITuple* Faces2;
+
+        // Outputs.
+        int StatusCode;
+        float Distance;
+        FVector Closest[2];
+    };
+
+    static void ComputeBatch (int numQueries, Query* queries,
+        ThreadPool* pool = 0, double verifyMinDifference = 0.00001,
+        double randomWidth = 0.0);
+
     // VerifyMinDifference:  Solution vectors are tested to determine if they
     // meet constraints imposed by the halfspace statement of the problem:
     // V o Z <= B. VerifyMinDifference is the amount that this dot product can
@@ -118,6 +149,16 @@ public:
     // vertex is selected from a uniform distribution of width RandomWidth. 
 
 private:
+    class BatchData
+    {
+    public:
+        Query* Queries;
+        double VerifyMinDifference;
+        double RandomWidth;
+    };
+
+    static void BatchTask (int begin, int end, int worker, void* userData);
+
     double ProcessLoop (bool halfspaceConstructor, int& statusCode,
         FVector closest[2]);
     bool BuildMatrices (double** M, double* Q);
@@ -0,0 +1,253 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5PhysicsPCH.h"
+#include "Wm5LCPSparseSolver.h"
+#include "Wm5Assert.h"
+using namespace Wm5;
+
+//----------------------------------------------------------------------------
+LCPSparseSolver::LCPSparseSolver (int numEquations)
+    :
+    MaxIterations(100),
+    Tolerance(1e-08),
+    Relaxation(1.0),
+    mNumEquations(numEquations),
+    mValidDiagonal(false),
+    mNumIterations(0),
+    mResidual(0.0)
+{
+    assertion(mNumEquations > 0, "Invalid number of equations\n");
+    mRowStart.resize(mNumEquations + 1, 0);
+    mInvDiagonal.resize(mNumEquations, 0.0);
+}
+//----------------------------------------------------------------------------
+LCPSparseSolver::~LCPSparseSolver ()
+{
+}
+//----------------------------------------------------------------------------
+void LCPSparseSolver::BeginMatrix ()
+{
+    mTriples.clear();
+}
+//----------------------------------------------------------------------------
+void LCPSparseSolver::AddEntry (int row, int col, double value)
+{
+    assertion(0 <= row && row < mNumEquations
+        && 0 <= col && col < mNumEquations, "Invalid matrix entry\n");
+
+    Triple triple;
+    triple.Row = row;
+    triple.Col = col;
+    triple.Value = value;
+    mTriples.push_back(triple);
+}
+//----------------------------------------------------------------------------
+void LCPSparseSolver::EndMatrix ()
+{
+    std::sort(mTriples.begin(), mTriples.end());
+
+    mColumns.clear();
+    mValues.clear();
+    mColumns.reserve(mTriples.size());
+    mValues.reserve(mTriples.size());
+    std::fill(mRowStart.begin(), mRowStart.end(), 0);
+    std::fill(mInvDiagonal.begin(), mInvDiagonal.end(), 0.0);
+
+    // Merge repeated entries and count the entries per row.
+    const int numTriples = (int)mTriples.size();
+    int i = 0;
+    while (i < numTriples)
+    {
+        const Triple& triple = mTriples[i];
+        double value = triple.Value;
+        int j = i + 1;
+        for (/**/; j < numTriples; ++j)
+        {
+            if (mTriples[j].Row != triple.Row
+            ||  mTriples[j].Col != triple.Col)
+            {
+                break;
+            }
+            value += mTriples[j].Value;
+        }
+
+        mColumns.push_back(triple.Col);
+        mValues.push_back(value);
+        ++mRowStart[triple.Row + 1];
+        if (triple.Row == triple.Col)
+        {
+            mInvDiagonal[triple.Row] = value;
+        }
+        i = j;
+    }
+    mTriples.clear();
+
+    for (i = 0; i < mNumEquations; ++i)
+    {
+        mRowStart[i + 1] += mRowStart[i];
+    }
+
+    mValidDiagonal = true;
+    for (i = 0; i < mNumEquations; ++i)
+    {
+        if (mInvDiagonal[i] > 0.0)
+        {
+            mInvDiagonal[i] = 1.0/mInvDiagonal[i];
+        }
+        else
+        {
+            mValidDiagonal = false;
+        }
+    }
+}
+//----------------------------------------------------------------------------
+void LCPSparseSolver::SetMatrix (double** M, double zeroTolerance)
+{
+    BeginMatrix();
+    for (int row = 0; row < mNumEquations; ++row)
+    {
+        for (int col = 0; col < mNumEquations; ++col)
+        {
+            double value = M[row][col];
+            if (fabs(value) > zeroTolerance || row == col)
+            {
+                AddEntry(row, col, value);
+            }
+        }
+    }
+    EndMatrix();
+}
+//----------------------------------------------------------------------------
+int LCPSparseSolver::Solve (const double* Q, double* Z, double* W,
+    bool warmStart)
+{
+    mNumIterations = 0;
+    mResidual = 0.0;
+    if (!mValidDiagonal)
+    {
+        return SC_INVALID_DIAGONAL;
+    }
+
+    int i, k;
+    if (warmStart)
+    {
+        for (i = 0; i < mNumEquations; ++i)
+        {
+            if (Z[i] < 0.0)
+            {
+                Z[i] = 0.0;
+            }
+        }
+    }
+    else
+    {
+        memset(Z, 0, mNumEquations*sizeof(double));
+    }
+
+    const int* rowStart = &mRowStart[0];
+    const int* columns = (mColumns.size() > 0 ? &mColumns[0] : 0);
+    const double* values = (mValues.size() > 0 ? &mValues[0] : 0);
+    const double* invDiagonal = &mInvDiagonal[0];
+
+    int status = SC_EXCEEDED_MAX_ITERATIONS;
+    for (mNumIterations = 1; mNumIterations <= MaxIterations;
+        ++mNumIterations)
+    {
+        // The residual is measured on the iterate as seen by each row
+        // before its update, which avoids a separate matrix-vector product
+        // per sweep.
+        double residual = 0.0;
+        for (i = 0; i < mNumEquations; ++i)
+        {
+            double w = Q[i];
+            const int kmax = rowStart[i + 1];
+            for (k = rowStart[i]; k < kmax; ++k)
+            {
+                w += values[k]*Z[columns[k]];
+            }
+
+            double zOld = Z[i];
+            double r = fabs(zOld < w ? zOld : w);
+            if (r > residual)
+            {
+                residual = r;
+            }
+
+            double zNew = zOld - Relaxation*w*invDiagonal[i];
+            Z[i] = (zNew > 0.0 ? zNew : 0.0);
+        }
+
+        mResidual = residual;
+        if (residual <= Tolerance)
+        {
+            status = SC_CONVERGED;
+            break;
+        }
+    }
+    if (mNumIterations > MaxIterations)
+    {
+        mNumIterations = MaxIterations;
+    }
+
+    // W = M*Z + Q for the final iterate.
+    double residual = 0.0;
+    for (i = 0; i < mNumEquations; ++i)
+    {
+        double w = Q[i];
+        const int kmax = rowStart[i + 1];
+        for (k = rowStart[i]; k < kmax; ++k)
+        {
+            w += values[k]*Z[columns[k]];
+        }
+        W[i] = w;
+
+        double r = fabs(Z[i] < w ? Z[i] : w);
+        if (r > residual)
+        {
+            residual = r;
+        }
+    }
+    mResidual = residual;
+
+    return status;
+}
+//----------------------------------------------------------------------------
+int LCPSparseSolver::GetNumEquations () const
+{
+    return mNumEquations;
+}
+//----------------------------------------------------------------------------
+int LCPSparseSolver::GetNumNonzeros () const
+{
+    return (int)mValues.size();
+}
+//----------------------------------------------------------------------------
+int LCPSparseSolver::GetNumIterations () const
+{
+    return mNumIterations;
+}
+//----------------------------------------------------------------------------
+double LCPSparseSolver::GetResidual () const
+{
+    return mResidual;
+}
+//----------------------------------------------------------------------------
+bool LCPSparseSolver::Triple::operator< (const Triple& triple) const
+{
+    if (Row < triple.Row)
+    {
+        return true;
+    }
+    if (Row > triple.Row)
+    {
+        return false;
+    }
+    return Col < triple.Col;
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5LCPSPARSESOLVER_H
+#define WM5LCPSPARSESOLVER_H
+
+#include "Wm5PhysicsLIB.h"
+
+namespace Wm5
+{
+
+class WM5_PHYSICS_ITEM LCPSparseSolver
+{
+public:
+    // A class for solving the Linear Complementarity Problem (LCP)
+    // w = Mz + q, w o z = 0, w >= 0, z >= 0, for large sparse matrices M
+    // by projected Gauss-Seidel iteration with successive over-relaxation.
+    // Each sweep updates
+    //   z[i] = max(0, z[i] - relaxation*(Mz + q)[i]/M[i][i])
+    // using the most recent values of z.  The iteration converges when M is
+    // symmetric positive semidefinite with positive diagonal entries, which
+    // is the case for the contact (Delassus) matrices of rigid body
+    // systems, and when M is strictly diagonally dominant.  It does not
+    // apply to matrices with zero diagonal entries such as the one built by
+    // LCPPolyDist; use LCPSolver (Lemke's method) for those.
+    //
+    // The matrix is stored in compressed sparse row form and may be reused
+    // for many right-hand sides.  The solution of one frame is a good
+    // initial guess for the next frame when the contact set changes little,
+    // so Solve accepts the input Z as a starting point.
+
+    enum // status codes
+    {
+        SC_CONVERGED,               // residual is below the tolerance
+        SC_EXCEEDED_MAX_ITERATIONS, // best available iterate is returned
+        SC_INVALID_DIAGONAL         // some M[i][i] <= 0, no solution
+    };
+
+    // Construction and destruction.
+    LCPSparseSolver (int numEquations);
+    ~LCPSparseSolver ();
+
+    // Matrix assembly.  The nonzero entries are passed as (row,col,value)
+    // triples in any order; repeated entries are summed.  EndMatrix
+    // compresses the triples.  SetMatrix copies the entries of a dense
+    // matrix whose magnitudes exceed 'zeroTolerance'.
+    void BeginMatrix ();
+    void AddEntry (int row, int col, double value);
+    void EndMatrix ();
+    void SetMatrix (double** M, double zeroTolerance = 0.0);
+
+    // Input:
+    //   'Q' is a vector of reals.
+    //   'Z' is the initial guess when 'warmStart' is true; negative values
+    //   are clamped to zero.  When 'warmStart' is false, the iteration
+    //   starts at z = 0.
+    // Output:
+    //   'Z' and 'W' are the solutions.
+    //   The return value is one of the status codes.
+    int Solve (const double* Q, double* Z, double* W, bool warmStart = true);
+
+    // Member access.
+    int GetNumEquations () const;
+    int GetNumNonzeros () const;
+
+    // Convergence statistics of the last call to Solve.  The residual is
+    // max_i |min(z[i],w[i])|, which is zero exactly for a solution.
+    int GetNumIterations () const;
+    double GetResidual () const;
+
+    // Iteration controls.
+    int MaxIterations;    // default = 100
+    double Tolerance;     // default = 1e-08
+    double Relaxation;    // default = 1 (Gauss-Seidel), in (0,2)
+
+private:
+    struct Triple
+    {
+        bool operator< (const Triple& triple) const;
+        int Row, Col;
+        double Value;
+    };
+
+    int mNumEquations;
+    std::vector<Triple> mTriples;
+
+    // Compressed sparse row storage.  Row i has entries
+    // mValues[mRowStart[i]] through mValues[mRowStart[i+1]-1].
+    std::vector<int> mRowStart;
+    std::vector<int> mColumns;
+    std::vector<double> mValues;
+    std::vector<double> mInvDiagonal;
+    bool mValidDiagonal;
+
+    int mNumIterations;
+    double mResidual;
+};
+
+}
+
+#endif
@@ -0,0 +1,611 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "Wm5PhysicsPCH.h"
+#include "Wm5RigidBodyWorld.h"
+#include "Wm5Memory.h"
+
+namespace Wm5
+{
+//----------------------------------------------------------------------------
+template <typename Real>
+RigidBodyWorld<Real>::RigidBodyWorld (int maxBodies, ThreadPool* pool)
+    :
+    mForce(0),
+    mTorque(0),
+    mUserData(0),
+    mMaxBodies(maxBodies > 0 ? maxBodies : 1),
+    mNumBodies(0),
+    mPool(pool),
+    mStage(0),
+    mTime((Real)0),
+    mDT((Real)0)
+{
+    int j;
+
+    mMass = new1<Real>(mMaxBodies);
+    mInvMass = new1<Real>(mMaxBodies);
+    for (j = 0; j < 9; ++j)
+    {
+        mInertia[j] = new1<Real>(mMaxBodies);
+        mInvInertia[j] = new1<Real>(mMaxBodies);
+    }
+
+    for (j = 0; j < 3; ++j)
+    {
+        AllocateArrays(mArrays[j]);
+        MakeState(mArrays[j], mStates[j]);
+    }
+
+    for (j = 0; j < 3; ++j)
+    {
+        mForceValue[j] = new1<Real>(mMaxBodies);
+        mTorqueValue[j] = new1<Real>(mMaxBodies);
+        mSumDX[j] = new1<Real>(mMaxBodies);
+        mSumDP[j] = new1<Real>(mMaxBodies);
+        mSumDL[j] = new1<Real>(mMaxBodies);
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        mSumDQ[j] = new1<Real>(mMaxBodies);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+RigidBodyWorld<Real>::~RigidBodyWorld ()
+{
+    int j;
+
+    delete1(mMass);
+    delete1(mInvMass);
+    for (j = 0; j < 9; ++j)
+    {
+        delete1(mInertia[j]);
+        delete1(mInvInertia[j]);
+    }
+
+    for (j = 0; j < 3; ++j)
+    {
+        DeallocateArrays(mArrays[j]);
+    }
+
+    for (j = 0; j < 3; ++j)
+    {
+        delete1(mForceValue[j]);
+        delete1(mTorqueValue[j]);
+        delete1(mSumDX[j]);
+        delete1(mSumDP[j]);
+        delete1(mSumDL[j]);
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        delete1(mSumDQ[j]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int RigidBodyWorld<Real>::AddBody (const RigidBody<Real>& body)
+{
+    if (mNumBodies == mMaxBodies)
+    {
+        return -1;
+    }
+
+    int i = mNumBodies++;
+    SetBody(i, body);
+    mStates[0].NumBodies = mNumBodies;
+    mStates[1].NumBodies = mNumBodies;
+    mStates[2].NumBodies = mNumBodies;
+    return i;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::GetBody (int i, RigidBody<Real>& body) const
+{
+    assertion(0 <= i && i < mNumBodies, "Invalid body index\n");
+
+    const Arrays& state = mArrays[0];
+    Matrix3<Real> inertia;
+    for (int j = 0; j < 9; ++j)
+    {
+        inertia(j/3, j%3) = mInertia[j][i];
+    }
+
+    body.SetMass((float)mMass[i]);
+    if (mInvMass[i] > (Real)0)
+    {
+        body.SetBodyInertia(inertia);
+    }
+    body.SetPosition(Vector3<Real>(state.Position[0][i],
+        state.Position[1][i], state.Position[2][i]));
+    body.SetQOrientation(Quaternion<Real>(state.QOrientation[0][i],
+        state.QOrientation[1][i], state.QOrientation[2][i],
+        state.QOrientation[3][i]));
+    body.SetLinearMomentum(Vector3<Real>(state.LinearMomentum[0][i],
+        state.LinearMomentum[1][i], state.LinearMomentum[2][i]));
+    body.SetAngularMomentum(Vector3<Real>(state.AngularMomentum[0][i],
+        state.AngularMomentum[1][i], state.AngularMomentum[2][i]));
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::SetBody (int i, const RigidBody<Real>& body)
+{
+    assertion(0 <= i && i < mNumBodies, "Invalid body index\n");
+
+    int j;
+    mMass[i] = body.GetMass();
+    mInvMass[i] = body.GetInverseMass();
+    const Matrix3<Real>& inertia = body.GetBodyInertia();
+    const Matrix3<Real>& invInertia = body.GetBodyInverseInertia();
+    for (j = 0; j < 9; ++j)
+    {
+        mInertia[j][i] = inertia(j/3, j%3);
+        mInvInertia[j][i] = invInertia(j/3, j%3);
+    }
+
+    Arrays& state = mArrays[0];
+    const Vector3<Real>& position = body.GetPosition();
+    const Quaternion<Real>& quatOrient = body.GetQOrientation();
+    const Vector3<Real>& linearMomentum = body.GetLinearMomentum();
+    const Vector3<Real>& angularMomentum = body.GetAngularMomentum();
+    for (j = 0; j < 3; ++j)
+    {
+        state.Position[j][i] = position[j];
+        state.LinearMomentum[j][i] = linearMomentum[j];
+        state.AngularMomentum[j][i] = angularMomentum[j];
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        state.QOrientation[j][i] = quatOrient[j];
+    }
+
+    ComputeDerived(state, i, i + 1);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int RigidBodyWorld<Real>::GetMaxBodies () const
+{
+    return mMaxBodies;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+int RigidBodyWorld<Real>::GetNumBodies () const
+{
+    return mNumBodies;
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Vector3<Real> RigidBodyWorld<Real>::GetPosition (int i) const
+{
+    const Arrays& state = mArrays[0];
+    return Vector3<Real>(state.Position[0][i], state.Position[1][i],
+        state.Position[2][i]);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Quaternion<Real> RigidBodyWorld<Real>::GetQOrientation (int i) const
+{
+    const Arrays& state = mArrays[0];
+    return Quaternion<Real>(state.QOrientation[0][i],
+        state.QOrientation[1][i], state.QOrientation[2][i],
+        state.QOrientation[3][i]);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Vector3<Real> RigidBodyWorld<Real>::GetLinearVelocity (int i) const
+{
+    const Arrays& state = mArrays[0];
+    return Vector3<Real>(state.LinearVelocity[0][i],
+        state.LinearVelocity[1][i], state.LinearVelocity[2][i]);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Vector3<Real> RigidBodyWorld<Real>::GetAngularVelocity (int i) const
+{
+    const Arrays& state = mArrays[0];
+    return Vector3<Real>(state.AngularVelocity[0][i],
+        state.AngularVelocity[1][i], state.AngularVelocity[2][i]);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+const typename RigidBodyWorld<Real>::State& RigidBodyWorld<Real>::GetState ()
+    const
+{
+    return mStates[0];
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+Real* RigidBodyWorld<Real>::Position (int j)
+{
+    return mArrays[0].Position[j];
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::Update (Real t, Real dt)
+{
+    mTime = t;
+    mDT = dt;
+    for (mStage = 0; mStage < 4; ++mStage)
+    {
+        ThreadPool::ParallelFor(mPool, mNumBodies, 0, &StageTask, this);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::AllocateArrays (Arrays& arrays)
+{
+    int j;
+    for (j = 0; j < 3; ++j)
+    {
+        arrays.Position[j] = new1<Real>(mMaxBodies);
+        arrays.LinearMomentum[j] = new1<Real>(mMaxBodies);
+        arrays.AngularMomentum[j] = new1<Real>(mMaxBodies);
+        arrays.LinearVelocity[j] = new1<Real>(mMaxBodies);
+        arrays.AngularVelocity[j] = new1<Real>(mMaxBodies);
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        arrays.QOrientation[j] = new1<Real>(mMaxBodies);
+    }
+    for (j = 0; j < 9; ++j)
+    {
+        arrays.ROrientation[j] = new1<Real>(mMaxBodies);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::DeallocateArrays (Arrays& arrays)
+{
+    int j;
+    for (j = 0; j < 3; ++j)
+    {
+        delete1(arrays.Position[j]);
+        delete1(arrays.LinearMomentum[j]);
+        delete1(arrays.AngularMomentum[j]);
+        delete1(arrays.LinearVelocity[j]);
+        delete1(arrays.AngularVelocity[j]);
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        delete1(arrays.QOrientation[j]);
+    }
+    for (j = 0; j < 9; ++j)
+    {
+        delete1(arrays.ROrientation[j]);
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::MakeState (const Arrays& arrays, State& state)
+    const
+{
+    int j;
+    state.NumBodies = mNumBodies;
+    state.Mass = mMass;
+    state.InvMass = mInvMass;
+    for (j = 0; j < 3; ++j)
+    {
+        state.Position[j] = arrays.Position[j];
+        state.LinearMomentum[j] = arrays.LinearMomentum[j];
+        state.AngularMomentum[j] = arrays.AngularMomentum[j];
+        state.LinearVelocity[j] = arrays.LinearVelocity[j];
+        state.AngularVelocity[j] = arrays.AngularVelocity[j];
+    }
+    for (j = 0; j < 4; ++j)
+    {
+        state.QOrientation[j] = arrays.QOrientation[j];
+    }
+    for (j = 0; j < 9; ++j)
+    {
+        state.ROrientation[j] = arrays.ROrientation[j];
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::ComputeDerived (Arrays& arrays, int begin,
+    int end) const
+{
+    const Real* qw = arrays.QOrientation[0];
+    const Real* qx = arrays.QOrientation[1];
+    const Real* qy = arrays.QOrientation[2];
+    const Real* qz = arrays.QOrientation[3];
+    Real* const* rot = arrays.ROrientation;
+    int i;
+
+    // The rotation matrix from the quaternion, the same expressions as in
+    // Quaternion<Real>::ToRotationMatrix.
+    for (i = begin; i < end; ++i)
+    {
+        Real twoX  = ((Real)2)*qx[i];
+        Real twoY  = ((Real)2)*qy[i];
+        Real twoZ  = ((Real)2)*qz[i];
+        Real twoWX = twoX*qw[i];
+        Real twoWY = twoY*qw[i];
+        Real twoWZ = twoZ*qw[i];
+        Real twoXX = twoX*qx[i];
+        Real twoXY = twoY*qx[i];
+        Real twoXZ = twoZ*qx[i];
+        Real twoYY = twoY*qy[i];
+        Real twoYZ = twoZ*qy[i];
+        Real twoZZ = twoZ*qz[i];
+
+        rot[0][i] = (Real)1 - (twoYY + twoZZ);
+        rot[1][i] = twoXY - twoWZ;
+        rot[2][i] = twoXZ + twoWY;
+        rot[3][i] = twoXY + twoWZ;
+        rot[4][i] = (Real)1 - (twoXX + twoZZ);
+        rot[5][i] = twoYZ - twoWX;
+        rot[6][i] = twoXZ - twoWY;
+        rot[7][i] = twoYZ + twoWX;
+        rot[8][i] = (Real)1 - (twoXX + twoYY);
+    }
+
+    // The linear velocity is V = P/m.
+    for (int j = 0; j < 3; ++j)
+    {
+        const Real* linMom = arrays.LinearMomentum[j];
+        Real* linVel = arrays.LinearVelocity[j];
+        for (i = begin; i < end; ++i)
+        {
+            linVel[i] = mInvMass[i]*linMom[i];
+        }
+    }
+
+    // The angular velocity is W = R*J^{-1}*R^T*L.
+    const Real* L0 = arrays.AngularMomentum[0];
+    const Real* L1 = arrays.AngularMomentum[1];
+    const Real* L2 = arrays.AngularMomentum[2];
+    Real* W0 = arrays.AngularVelocity[0];
+    Real* W1 = arrays.AngularVelocity[1];
+    Real* W2 = arrays.AngularVelocity[2];
+    Real* const* J = mInvInertia;
+    for (i = begin; i < end; ++i)
+    {
+        Real a0 = rot[0][i]*L0[i] + rot[3][i]*L1[i] + rot[6][i]*L2[i];
+        Real a1 = rot[1][i]*L0[i] + rot[4][i]*L1[i] + rot[7][i]*L2[i];
+        Real a2 = rot[2][i]*L0[i] + rot[5][i]*L1[i] + rot[8][i]*L2[i];
+        Real b0 = J[0][i]*a0 + J[1][i]*a1 + J[2][i]*a2;
+        Real b1 = J[3][i]*a0 + J[4][i]*a1 + J[5][i]*a2;
+        Real b2 = J[6][i]*a0 + J[7][i]*a1 + J[8][i]*a2;
+        W0[i] = rot[0][i]*b0 + rot[1][i]*b1 + rot[2][i]*b2;
+        W1[i] = rot[3][i]*b0 + rot[4][i]*b1 + rot[5][i]*b2;
+        W2[i] = rot[6][i]*b0 + rot[7][i]*b1 + rot[8][i]*b2;
+    }
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::StageTask (int begin, int end, int,
+    void* userData)
+{
+    ((RigidBodyWorld<Real>*)userData)->Stage(begin, end);
+}
+//----------------------------------------------------------------------------
+template <typename Real>
+void RigidBodyWorld<Real>::Stage (int begin, int end)
+{
+    // Stage k reads the solution B[k] (B[0] = S0) and writes B[k+1] (B[4] =
+    // S1).  The stages alternate between the two intermediate arrays so
+    // that the force functions may read any body of the input.
+    static const int input[4] = { 0, 1, 2, 1 };
+    static const int output[4] = { 1, 2, 1, 0 };
+    const Arrays& S0 = mArrays[0];
+    const Arrays& B = mArrays[input[mStage]];
+    Arrays& next = mArrays[output[mStage]];
+    const State& state = mStates[input[mStage]];
+
+    Real halfDT = ((Real)0.5)*mDT;
+    Real time, step, weight;
+    switch (mStage)
+    {
+    case 0:
+        time = mTime;
+        step = halfDT;
+        weight = (Real)1;
+        break;
+    case 1:
+        time = mTime + halfDT;
+        step = halfDT;
+        weight = (Real)2;
+        break;
+    case 2:
+        time = mTime + halfDT;
+        step = mDT;
+        weight = (Real)2;
+        break;
+    default:
+        time = mTime + mDT;
+        step = mDT/((Real)6);
+        weight = (Real)1;
+        break;
+    }
+
+    // dP/dt = F and dL/dt = T.
+    int i, j;
+    if (mForce)
+    {
+        mForce(time, begin, end, state, mForceValue, mUserData);
+    }
+    else
+    {
+        for (j = 0; j < 3; ++j)
+        {
+            memset(mForceValue[j] + begin, 0, (end - begin)*sizeof(Real));
+        }
+    }
+    if (mTorque)
+    {
+        mTorque(time, begin, end, state, mTorqueValue, mUserData);
+    }
+    else
+    {
+        for (j = 0; j < 3; ++j)
+        {
+            memset(mTorqueValue[j] + begin, 0, (end - begin)*sizeof(Real));
+        }
+    }
+
+    // dQ/dt = (1/2)*W*Q, where W = (0,w) is the angular velocity as a
+    // quaternion.  This is the product in Quaternion<Real>::operator*.
+    const Real* qw = B.QOrientation[0];
+    const Real* qx = B.QOrientation[1];
+    const Real* qy = B.QOrientation[2];
+    const Real* qz = B.QOrientation[3];
+    const Real* w0 = B.AngularVelocity[0];
+    const Real* w1 = B.AngularVelocity[1];
+    const Real* w2 = B.AngularVelocity[2];
+    Real* sq0 = mSumDQ[0];
+    Real* sq1 = mSumDQ[1];
+    Real* sq2 = mSumDQ[2];
+    Real* sq3 = mSumDQ[3];
+    Real half = (Real)0.5;
+    if (mStage == 0)
+    {
+        for (i = begin; i < end; ++i)
+        {
+            sq0[i] = half*(-w0[i]*qx[i] - w1[i]*qy[i] - w2[i]*qz[i]);
+            sq1[i] = half*(w0[i]*qw[i] + w1[i]*qz[i] - w2[i]*qy[i]);
+            sq2[i] = half*(w1[i]*qw[i] + w2[i]*qx[i] - w0[i]*qz[i]);
+            sq3[i] = half*(w2[i]*qw[i] + w0[i]*qy[i] - w1[i]*qx[i]);
+        }
+        for (j = 0; j < 3; ++j)
+        {
+            memcpy(mSumDX[j] + begin, B.LinearVelocity[j] + begin,
+                (end - begin)*sizeof(Real));
+            memcpy(mSumDP[j] + begin, mForceValue[j] + begin,
+                (end - begin)*sizeof(Real));
+            memcpy(mSumDL[j] + begin, mTorqueValue[j] + begin,
+                (end - begin)*sizeof(Real));
+        }
+    }
+
+    if (mStage < 3)
+    {
+        // B[k+1] = S0 + step*A[k].  The quaternion derivative of stage 0
+        // is already in the accumulator.
+        Real* nq0 = next.QOrientation[0];
+        Real* nq1 = next.QOrientation[1];
+        Real* nq2 = next.QOrientation[2];
+        Real* nq3 = next.QOrientation[3];
+        const Real* q0 = S0.QOrientation[0];
+        const Real* q1 = S0.QOrientation[1];
+        const Real* q2 = S0.QOrientation[2];
+        const Real* q3 = S0.QOrientation[3];
+        if (mStage == 0)
+        {
+            for (i = begin; i < end; ++i)
+            {
+                nq0[i] = q0[i] + step*sq0[i];
+                nq1[i] = q1[i] + step*sq1[i];
+                nq2[i] = q2[i] + step*sq2[i];
+                nq3[i] = q3[i] + step*sq3[i];
+            }
+        }
+        else
+        {
+            for (i = begin; i < end; ++i)
+            {
+                Real d0 = half*(-w0[i]*qx[i] - w1[i]*qy[i] - w2[i]*qz[i]);
+                Real d1 = half*(w0[i]*qw[i] + w1[i]*qz[i] - w2[i]*qy[i]);
+                Real d2 = half*(w1[i]*qw[i] + w2[i]*qx[i] - w0[i]*qz[i]);
+                Real d3 = half*(w2[i]*qw[i] + w0[i]*qy[i] - w1[i]*qx[i]);
+                nq0[i] = q0[i] + step*d0;
+                nq1[i] = q1[i] + step*d1;
+                nq2[i] = q2[i] + step*d2;
+                nq3[i] = q3[i] + step*d3;
+                sq0[i] += weight*d0;
+                sq1[i] += weight*d1;
+                sq2[i] += weight*d2;
+                sq3[i] += weight*d3;
+            }
+        }
+
+        for (j = 0; j < 3; ++j)
+        {
+            const Real* x0 = S0.Position[j];
+            const Real* p0 = S0.LinearMomentum[j];
+            const Real* l0 = S0.AngularMomentum[j];
+            const Real* dx = B.LinearVelocity[j];
+            const Real* dp = mForceValue[j];
+            const Real* dl = mTorqueValue[j];
+            Real* nx = next.Position[j];
+            Real* np = next.LinearMomentum[j];
+            Real* nl = next.AngularMomentum[j];
+            Real* sx = mSumDX[j];
+            Real* sp = mSumDP[j];
+            Real* sl = mSumDL[j];
+            for (i = begin; i < end; ++i)
+            {
+                nx[i] = x0[i] + step*dx[i];
+                np[i] = p0[i] + step*dp[i];
+                nl[i] = l0[i] + step*dl[i];
+            }
+            if (mStage > 0)
+            {
+                for (i = begin; i < end; ++i)
+                {
+                    sx[i] += weight*dx[i];
+                    sp[i] += weight*dp[i];
+                    sl[i] += weight*dl[i];
+                }
+            }
+        }
+    }
+    else
+    {
+        // S1 = S0 + (DT/6)*(A1 + 2*(A2 + A3) + A4).  The output arrays are
+        // the input S0, updated in place one body at a time.
+        Real* nq0 = next.QOrientation[0];
+        Real* nq1 = next.QOrientation[1];
+        Real* nq2 = next.QOrientation[2];
+        Real* nq3 = next.QOrientation[3];
+        for (i = begin; i < end; ++i)
+        {
+            Real d0 = half*(-w0[i]*qx[i] - w1[i]*qy[i] - w2[i]*qz[i]);
+            Real d1 = half*(w0[i]*qw[i] + w1[i]*qz[i] - w2[i]*qy[i]);
+            Real d2 = half*(w1[i]*qw[i] + w2[i]*qx[i] - w0[i]*qz[i]);
+            Real d3 = half*(w2[i]*qw[i] + w0[i]*qy[i] - w1[i]*qx[i]);
+            nq0[i] += step*(sq0[i] + d0);
+            nq1[i] += step*(sq1[i] + d1);
+            nq2[i] += step*(sq2[i] + d2);
+            nq3[i] += step*(sq3[i] + d3);
+        }
+
+        for (j = 0; j < 3; ++j)
+        {
+            const Real* dx = B.LinearVelocity[j];
+            const Real* dp = mForceValue[j];
+            const Real* dl = mTorqueValue[j];
+            const Real* sx = mSumDX[j];
+            const Real* sp = mSumDP[j];
+            const Real* sl = mSumDL[j];
+            Real* nx = next.Position[j];
+            Real* np = next.LinearMomentum[j];
+            Real* nl = next.AngularMomentum[j];
+            for (i = begin; i < end; ++i)
+            {
+                nx[i] += step*(sx[i] + dx[i]);
+                np[i] += step*(sp[i] + dp[i]);
+                nl[i] += step*(sl[i] + dl[i]);
+            }
+        }
+    }
+
+    ComputeDerived(next, begin, end);
+}
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Explicit instantiation.
+//----------------------------------------------------------------------------
+template WM5_PHYSICS_ITEM
+class RigidBodyWorld<float>;
+
+template WM5_PHYSICS_ITEM
+class RigidBodyWorld<double>;
+//----------------------------------------------------------------------------
+}
@@ -0,0 +1,163 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef WM5RIGIDBODYWORLD_H
+#define WM5RIGIDBODYWORLD_H
+
+#include "Wm5PhysicsLIB.h"
+#include "Wm5RigidBody.h"
+#include "Wm5ThreadPool.h"
+
+namespace Wm5
+{
+
+// A collection of rigid bodies whose state is stored in structure-of-arrays
+// form.  All bodies are advanced together by the same Runge-Kutta
+// fourth-order solver that RigidBody<Real>::Update uses, but each stage is
+// a pass over contiguous arrays rather than a sequence of per-body function
+// calls.  Forces and torques are supplied by one batch callback per stage
+// that fills the arrays for a range of bodies.  When a thread pool is
+// supplied, the ranges are processed concurrently.
+
+template <typename Real>
+class WM5_PHYSICS_ITEM RigidBodyWorld
+{
+public:
+    // A read-only view of the state of all bodies at an intermediate time
+    // of the solver.  Element i of each array belongs to body i.  The
+    // rotation matrix is stored row-major, Rot[3*r+c][i] = R(r,c).
+    class State
+    {
+    public:
+        int NumBodies;
+        const Real* Mass;
+        const Real* InvMass;
+        const Real* Position[3];
+        const Real* QOrientation[4];
+        const Real* LinearMomentum[3];
+        const Real* AngularMomentum[3];
+        const Real* ROrientation[9];
+        const Real* LinearVelocity[3];
+        const Real* AngularVelocity[3];
+    };
+
+    // Batch force/torque function format.  The function must write
+    // result[j][i] for j in {0,1,2} and begin <= i < end.  It may read the
+    // state of any body.  With a thread pool, calls for disjoint ranges
+    // occur concurrently.
+    typedef void (*Function)
+    (
+        Real,           // time of application
+        int,            // first body of the range
+        int,            // one past the last body of the range
+        const State&,   // state of all bodies
+        Real* const*,   // force or torque (output, 3 arrays)
+        void*           // user data
+    );
+
+    // Construction and destruction.  The world has storage for 'maxBodies'
+    // bodies.  If 'pool' is not null, it is used by Update; the caller
+    // retains ownership.
+    RigidBodyWorld (int maxBodies, ThreadPool* pool = 0);
+    ~RigidBodyWorld ();
+
+    // Add a body, returning its index, or -1 when the world is full.  The
+    // body's force and torque function pointers are not used; the batch
+    // callbacks apply to all bodies.
+    int AddBody (const RigidBody<Real>& body);
+
+    // Copy the state of body i to or from a RigidBody.
+    void GetBody (int i, RigidBody<Real>& body) const;
+    void SetBody (int i, const RigidBody<Real>& body);
+
+    // Member access.
+    int GetMaxBodies () const;
+    int GetNumBodies () const;
+    Vector3<Real> GetPosition (int i) const;
+    Quaternion<Real> GetQOrientation (int i) const;
+    Vector3<Real> GetLinearVelocity (int i) const;
+    Vector3<Real> GetAngularVelocity (int i) const;
+    const State& GetState () const;
+
+    // Direct access to the position array for component j in {0,1,2}, for
+    // example to apply collision responses in bulk.
+    Real* Position (int j);
+
+    // Batch force and torque functions.  A null function applies zero
+    // force or torque.  The user data is passed to both functions.
+    Function mForce;
+    Function mTorque;
+    void* mUserData;
+
+    // Runge-Kutta fourth-order differential equation solver applied to all
+    // bodies.  The results agree, up to rounding errors, with calling
+    // RigidBody::Update on each body using equivalent per-body force and
+    // torque functions.
+    void Update (Real t, Real dt);
+
+protected:
+    // The solver state at one stage.  The world state is stage 0; two more
+    // stages are used alternately for the intermediate solutions.
+    class Arrays
+    {
+    public:
+        Real* Position[3];
+        Real* QOrientation[4];
+        Real* LinearMomentum[3];
+        Real* AngularMomentum[3];
+        Real* ROrientation[9];
+        Real* LinearVelocity[3];
+        Real* AngularVelocity[3];
+    };
+
+    void AllocateArrays (Arrays& arrays);
+    void DeallocateArrays (Arrays& arrays);
+    void MakeState (const Arrays& arrays, State& state) const;
+
+    // Compute the rotation and velocities from the quaternion and momenta
+    // for bodies [begin,end).
+    void ComputeDerived (Arrays& arrays, int begin, int end) const;
+
+    // Evaluate the derivatives at stage 'mStage' for bodies [begin,end) and
+    // write the next intermediate state (or the final state).
+    static void StageTask (int begin, int end, int worker, void* userData);
+    void Stage (int begin, int end);
+
+    int mMaxBodies, mNumBodies;
+    ThreadPool* mPool;
+
+    // Constant quantities (inverse body inertia is row-major).
+    Real* mMass;
+    Real* mInvMass;
+    Real* mInertia[9];
+    Real* mInvInertia[9];
+
+    // State and intermediate stages, and the read-only views of them.
+    Arrays mArrays[3];
+    State mStates[3];
+
+    // Force, torque and the Runge-Kutta accumulator of the derivatives
+    // dX/dt, dQ/dt, dP/dt and dL/dt.
+    Real* mForceValue[3];
+    Real* mTorqueValue[3];
+    Real* mSumDX[3];
+    Real* mSumDQ[4];
+    Real* mSumDP[3];
+    Real* mSumDL[3];
+
+    // The current stage in {0,1,2,3} and its time parameters.
+    int mStage;
+    Real mTime, mDT;
+};
+
+typedef RigidBodyWorld<float> RigidBodyWorldf;
+typedef RigidBodyWorld<double> RigidBodyWorldd;
+
+}
+
+#endif
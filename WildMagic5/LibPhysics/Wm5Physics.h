@@ -23,6 +23,7 @@
 // Intersection
 #include "Wm5BoxManager.h"
 #include "Wm5ExtremalQuery3.h"
+#include "Wm5ExtremalQuery3ADJ.h"
 #include "Wm5ExtremalQuery3BSP.h"
 #include "Wm5ExtremalQuery3PRJ.h"
 #include "Wm5IntervalManager.h"
@@ -31,6 +32,7 @@
 // LCPSolver
 #include "Wm5LCPPolyDist.h"
 #include "Wm5LCPSolver.h"
+#include "Wm5LCPSparseSolver.h"
 
 // ParticleSystem
 #include "Wm5MassSpringArbitrary.h"
@@ -42,5 +44,6 @@
 // RigidBody
 #include "Wm5PolyhedralMassProperties.h"
 #include "Wm5RigidBody.h"
+#include "Wm5RigidBodyWorld.h"
 
 #endif
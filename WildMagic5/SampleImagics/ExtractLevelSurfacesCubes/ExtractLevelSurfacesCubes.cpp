@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.1 (2013/07/14)
+// File Version: 5.0.3 (2026/10/19)
 
 #include "ExtractLevelSurfacesCubes.h"
 
@@ -48,6 +48,10 @@ bool ExtractLevelSurfacesCubes::OnInitialize ()
 
     InitializeCameraMotion(5.0f, 0.1f);
     InitializeObjectMotion(mScene);
+
+#ifdef MEASURE_TIMING_OF_LAYOUTS
+    MeasureTimingOfLayouts();
+#endif
     return true;
 }
 //----------------------------------------------------------------------------
@@ -124,8 +128,7 @@ void ExtractLevelSurfacesCubes::CreateScene ()
     std::vector<Vector3f> vertices, normals;
     std::vector<TriangleKey> triangles;
 
-    esc.ExtractContour(64.5f, vertices, triangles);
-    esc.MakeUnique(vertices, triangles);
+    esc.ExtractContourIndexed(64.5f, vertices, triangles);
     esc.OrientTriangles(vertices, triangles, false);
     esc.ComputeNormals(vertices, triangles, normals);
 
@@ -174,3 +177,207 @@ void ExtractLevelSurfacesCubes::CreateScene ()
     mesh->SetEffectInstance(effect->CreateInstance(light, material));
 }
 //----------------------------------------------------------------------------
+#ifdef MEASURE_TIMING_OF_LAYOUTS
+void ExtractLevelSurfacesCubes::MeasureTimingOfLayouts ()
+{
+    const int bound = 512, brickSize = 8, numQueries = 4000000;
+    const int area = bound*bound;
+    std::ofstream outFile("timing.txt");
+    outFile << "bound = " << bound << ", brick size = " << brickSize
+        << std::endl;
+
+    // A smooth volume whose level sets are perturbed ellipsoids.
+    ImageFloat3D linear(bound, bound, bound);
+    float* data = (float*)linear.GetData();
+    int x, y, z, i;
+    for (z = 0, i = 0; z < bound; ++z)
+    {
+        float dz = (z - 0.5f*bound)/(0.4f*bound);
+        for (y = 0; y < bound; ++y)
+        {
+            float dy = (y - 0.5f*bound)/(0.3f*bound);
+            for (x = 0; x < bound; ++x, ++i)
+            {
+                float dx = (x - 0.5f*bound)/(0.45f*bound);
+                data[i] = dx*dx + dy*dy + dz*dz +
+                    0.05f*Mathf::Sin(0.2f*x)*Mathf::Sin(0.15f*y);
+            }
+        }
+    }
+
+    TiledImageFloat3D tiled(bound, bound, bound, brickSize);
+    tiled.SetLinear(linear);
+    const int numBricks = tiled.GetNumBricks();
+    const int size = brickSize + 2;
+    Efloat* block = new1<Efloat>(size*size*size);
+    const float* blockData = (const float*)block;
+
+    // One step of the Gaussian blur.  GaussianBlur3 updates the rows of its
+    // padded copy of the volume.  The tiled step visits the bricks in
+    // storage order and applies the stencil to a copy of each brick with a
+    // 1-voxel halo.  Both use Neumann boundary conditions.
+    GaussianBlur3* blur = new0 GaussianBlur3(bound, bound, bound, 1.0f,
+        1.0f, 1.0f, data, 0, Mathf::MAX_REAL, PdeFilter::ST_NONE);
+    const float timeStep = blur->GetMaximumTimeStep();
+    blur->SetTimeStep(timeStep);
+    clock_t start = clock();
+    blur->Update();
+    clock_t final = clock();
+    double time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+    outFile << "blur linear time = " << time << " seconds" << std::endl;
+    delete0(blur);
+
+    TiledImageFloat3D blurred(bound, bound, bound, brickSize);
+    start = clock();
+    for (i = 0; i < numBricks; ++i)
+    {
+        tiled.GetBrickWithHalo(i, 1, block);
+        float* dst = (float*)blurred.GetBrickData(i);
+        for (z = 1; z <= brickSize; ++z)
+        {
+            for (y = 1; y <= brickSize; ++y)
+            {
+                const float* src = blockData + size*(y + size*z);
+                for (x = 1; x <= brickSize; ++x)
+                {
+                    float u = src[x];
+                    *dst++ = u + timeStep*(src[x+1] + src[x-1] +
+                        src[x+size] + src[x-size] + src[x+size*size] +
+                        src[x-size*size] - 6.0f*u);
+                }
+            }
+        }
+    }
+    final = clock();
+    time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+    outFile << "blur tiled time = " << time << " seconds" << std::endl;
+
+    // The complete extraction, for reference, on an integer-valued copy.
+    {
+        ImageInt3D image(bound, bound, bound);
+        int* intData = (int*)image.GetData();
+        for (i = 0; i < image.GetQuantity(); ++i)
+        {
+            intData[i] = (int)(1000.0f*data[i]);
+        }
+        ExtractSurfaceCubes esc(bound, bound, bound, intData);
+        std::vector<Vector3f> vertices;
+        std::vector<TriangleKey> triangles;
+        start = clock();
+        esc.ExtractContourIndexed(1000.5f, vertices, triangles);
+        final = clock();
+        time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+        outFile << "extraction linear time = " << time << " seconds, "
+            << triangles.size() << " triangles" << std::endl;
+
+        // The streaming extraction from the tiled layout.
+        TiledImageInt3D tiledImage(bound, bound, bound, brickSize);
+        tiledImage.SetLinear(image);
+        start = clock();
+        esc.ExtractContourIndexed(1000.5f, tiledImage, vertices, triangles);
+        final = clock();
+        time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+        outFile << "extraction tiled time = " << time << " seconds, "
+            << triangles.size() << " triangles" << std::endl;
+    }
+
+    // The classification of the cubes by the signs at their corners, which
+    // is the part of the extraction that touches every voxel.  The linear
+    // version reads four rows per row of cubes, as ExtractSurfaceCubes does.
+    const float level = 1.0005f;
+    int numLinear = 0, numTiled = 0;
+    start = clock();
+    for (z = 0; z < bound - 1; ++z)
+    {
+        for (y = 0; y < bound - 1; ++y)
+        {
+            const float* r00 = data + bound*y + area*z;
+            const float* r10 = r00 + bound;
+            const float* r01 = r00 + area;
+            const float* r11 = r01 + bound;
+            for (x = 0; x < bound - 1; ++x)
+            {
+                int numPositive = (r00[x] > level) + (r00[x+1] > level) +
+                    (r10[x] > level) + (r10[x+1] > level) +
+                    (r01[x] > level) + (r01[x+1] > level) +
+                    (r11[x] > level) + (r11[x+1] > level);
+                numLinear += (numPositive != 0 && numPositive != 8);
+            }
+        }
+    }
+    final = clock();
+    time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+    outFile << "cubes linear time = " << time << " seconds, " << numLinear
+        << " cubes" << std::endl;
+
+    start = clock();
+    for (i = 0; i < numBricks; ++i)
+    {
+        int xMin, yMin, zMin;
+        tiled.GetBrickOrigin(i, xMin, yMin, zMin);
+        int xMax = std::min(brickSize, bound - 1 - xMin);
+        int yMax = std::min(brickSize, bound - 1 - yMin);
+        int zMax = std::min(brickSize, bound - 1 - zMin);
+        tiled.GetBrickWithHalo(i, 1, block);
+        for (z = 1; z <= zMax; ++z)
+        {
+            for (y = 1; y <= yMax; ++y)
+            {
+                const float* r00 = blockData + size*(y + size*z);
+                const float* r10 = r00 + size;
+                const float* r01 = r00 + size*size;
+                const float* r11 = r01 + size;
+                for (x = 1; x <= xMax; ++x)
+                {
+                    int numPositive = (r00[x] > level) +
+                        (r00[x+1] > level) + (r10[x] > level) +
+                        (r10[x+1] > level) + (r01[x] > level) +
+                        (r01[x+1] > level) + (r11[x] > level) +
+                        (r11[x+1] > level);
+                    numTiled += (numPositive != 0 && numPositive != 8);
+                }
+            }
+        }
+    }
+    final = clock();
+    time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+    outFile << "cubes tiled time = " << time << " seconds, " << numTiled
+        << " cubes" << std::endl;
+
+    // The 3x3x3 neighborhoods of random voxels.
+    int* voxels = new1<int>(3*numQueries);
+    for (i = 0; i < 3*numQueries; ++i)
+    {
+        voxels[i] = 1 + rand() % (bound - 2);
+    }
+    for (int layout = 0; layout < 2; ++layout)
+    {
+        double sum = 0.0;
+        start = clock();
+        for (i = 0; i < numQueries; ++i)
+        {
+            const int* voxel = &voxels[3*i];
+            for (z = voxel[2] - 1; z <= voxel[2] + 1; ++z)
+            {
+                for (y = voxel[1] - 1; y <= voxel[1] + 1; ++y)
+                {
+                    for (x = voxel[0] - 1; x <= voxel[0] + 1; ++x)
+                    {
+                        sum += (layout == 0 ? linear(x, y, z) :
+                            tiled(x, y, z));
+                    }
+                }
+            }
+        }
+        final = clock();
+        time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+        outFile << "neighborhoods " << (layout == 0 ? "linear" : "tiled")
+            << " time = " << time << " seconds, sum = " << sum << std::endl;
+    }
+    outFile.close();
+
+    delete1(voxels);
+    delete1(block);
+}
+//----------------------------------------------------------------------------
+#endif
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #ifndef EXTRACTLEVELSURFACESCUBES_H
 #define EXTRACTLEVELSURFACESCUBES_H
@@ -12,6 +12,14 @@
 #include "Wm5WindowApplication3.h"
 using namespace Wm5;
 
+// Uncomment this for timing information.  The linear layout of TImage3D and
+// the brick-tiled layout of TTiledImage3D are compared on a 512^3 volume
+// for a Gaussian blur step, the surface extraction, the cube
+// classification of the extraction, and 3x3x3 neighborhoods at random
+// voxels.  The results are
+// written to timing.txt.
+//#define MEASURE_TIMING_OF_LAYOUTS
+
 class ExtractLevelSurfacesCubes : public WindowApplication3
 {
     WM5_DECLARE_INITIALIZE;
@@ -28,6 +36,10 @@ public:
 protected:
     void CreateScene ();
 
+#ifdef MEASURE_TIMING_OF_LAYOUTS
+    void MeasureTimingOfLayouts ();
+#endif
+
     NodePtr mScene, mTrnNode;
     WireStatePtr mWireState;
     Culler mCuller;
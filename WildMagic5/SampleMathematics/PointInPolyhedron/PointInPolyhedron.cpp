@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #include "PointInPolyhedron.h"
 
@@ -12,6 +12,7 @@ WM5_WINDOW_APPLICATION(PointInPolyhedron);
 
 // Enable only one at a time to test the algorithm.
 //#define TRIFACES
+//#define TRIFACES1
 //#define CVXFACES0
 //#define CVXFACES1
 //#define CVXFACES2
@@ -193,7 +194,7 @@ void PointInPolyhedron::CreateQuery (TriMesh* mesh)
     const int* currentIndex = indices;
     int i;
 
-#ifdef TRIFACES
+#if defined(TRIFACES) || defined(TRIFACES1)
     mTFaces = new1<PointInPolyhedron3f::TriangleFace>(numFaces);
 
     for (i = 0; i < numFaces; ++i)
@@ -208,8 +209,13 @@ void PointInPolyhedron::CreateQuery (TriMesh* mesh)
         mTFaces[i].Plane = Plane3f(vertices[v0], vertices[v1], vertices[v2]);
     }
 
+#ifdef TRIFACES
     mQuery = new0 PointInPolyhedron3f(numVertices, vertices, numFaces,
         mTFaces, mNumRays, mRayDirections);
+#else
+    mQuery = new0 PointInPolyhedron3f(numVertices, vertices, numFaces,
+        mTFaces, Query::QT_FILTERED);
+#endif
 #endif
 
 #if defined(CVXFACES0) || defined(CVXFACES1) || defined(CVXFACES2)
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.6.1 (2012/07/07)
+// File Version: 5.6.2 (2026/10/19)
 
 #include "ThinPlateSplines.h"
 
@@ -180,10 +180,133 @@ void TestThinPlateSplines3D ()
     fclose(outFile);
 }
 //----------------------------------------------------------------------------
+#ifdef MEASURE_TIMING_OF_EVALUATION
+static double GetMaxDifference (int numSamples, const double* values,
+    const double* exact)
+{
+    double maxDiff = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double diff = Mathd::FAbs(values[i] - exact[i]);
+        if (diff > maxDiff)
+        {
+            maxDiff = diff;
+        }
+    }
+    return maxDiff;
+}
+//----------------------------------------------------------------------------
+void BenchmarkThinPlateSplines ()
+{
+    FILE* outFile = fopen("benchmark.txt", "wt");
+
+    // Random control points and evaluation points in the unit cube.  The
+    // sums over the control points are computed for each evaluation point
+    // by operator(), by the batched exact evaluation, and in 2D by the
+    // far-field approximation for several error bounds.
+    const int numPoints = 2000;
+    const int numSamples = 100000;
+    const double maxErrors[4] = { 1e-2, 1e-4, 1e-6, 1e-9 };
+    double* x = new1<double>(numPoints);
+    double* y = new1<double>(numPoints);
+    double* z = new1<double>(numPoints);
+    double* f = new1<double>(numPoints);
+    double* sx = new1<double>(numSamples);
+    double* sy = new1<double>(numSamples);
+    double* sz = new1<double>(numSamples);
+    double* exact = new1<double>(numSamples);
+    double* values = new1<double>(numSamples);
+    int i;
+    for (i = 0; i < numPoints; ++i)
+    {
+        x[i] = Mathd::UnitRandom();
+        y[i] = Mathd::UnitRandom();
+        z[i] = Mathd::UnitRandom();
+        f[i] = Mathd::Sin(5.0*x[i])*Mathd::Cos(3.0*y[i]) + z[i];
+    }
+    for (i = 0; i < numSamples; ++i)
+    {
+        sx[i] = Mathd::UnitRandom();
+        sy[i] = Mathd::UnitRandom();
+        sz[i] = Mathd::UnitRandom();
+    }
+
+    ThreadPool pool;
+    double start, elapsed;
+    fprintf(outFile, "%d control points, %d evaluations, %d threads\n\n",
+        numPoints, numSamples, pool.GetNumThreads());
+
+    IntpThinPlateSpline2d spline2(numPoints, x, y, f, 0.001, false, true,
+        &pool);
+    start = GetTimeInSeconds();
+    for (i = 0; i < numSamples; ++i)
+    {
+        exact[i] = spline2(sx[i], sy[i]);
+    }
+    fprintf(outFile, "2D operator()       %8.3lf s\n",
+        GetTimeInSeconds() - start);
+    start = GetTimeInSeconds();
+    spline2.Evaluate(numSamples, sx, sy, values);
+    elapsed = GetTimeInSeconds() - start;
+    fprintf(outFile, "2D exact            %8.3lf s, error %le\n", elapsed,
+        GetMaxDifference(numSamples, values, exact));
+    start = GetTimeInSeconds();
+    spline2.Evaluate(numSamples, sx, sy, values, 0.0, &pool);
+    elapsed = GetTimeInSeconds() - start;
+    fprintf(outFile, "2D exact, parallel  %8.3lf s, error %le\n", elapsed,
+        GetMaxDifference(numSamples, values, exact));
+    for (int k = 0; k < 4; ++k)
+    {
+        start = GetTimeInSeconds();
+        spline2.Evaluate(numSamples, sx, sy, values, maxErrors[k], &pool);
+        elapsed = GetTimeInSeconds() - start;
+        fprintf(outFile, "2D maxError %6.0le %8.3lf s, error %le\n",
+            maxErrors[k], elapsed,
+            GetMaxDifference(numSamples, values, exact));
+    }
+    fprintf(outFile, "\n");
+
+    // IntpThinPlateSpline3 has no far-field approximation.
+    IntpThinPlateSpline3d spline3(numPoints, x, y, z, f, 0.001, false, true,
+        &pool);
+    start = GetTimeInSeconds();
+    for (i = 0; i < numSamples; ++i)
+    {
+        exact[i] = spline3(sx[i], sy[i], sz[i]);
+    }
+    fprintf(outFile, "3D operator()       %8.3lf s\n",
+        GetTimeInSeconds() - start);
+    start = GetTimeInSeconds();
+    spline3.Evaluate(numSamples, sx, sy, sz, values);
+    elapsed = GetTimeInSeconds() - start;
+    fprintf(outFile, "3D exact            %8.3lf s, error %le\n", elapsed,
+        GetMaxDifference(numSamples, values, exact));
+    start = GetTimeInSeconds();
+    spline3.Evaluate(numSamples, sx, sy, sz, values, &pool);
+    elapsed = GetTimeInSeconds() - start;
+    fprintf(outFile, "3D exact, parallel  %8.3lf s, error %le\n", elapsed,
+        GetMaxDifference(numSamples, values, exact));
+
+    delete1(x);
+    delete1(y);
+    delete1(z);
+    delete1(f);
+    delete1(sx);
+    delete1(sy);
+    delete1(sz);
+    delete1(exact);
+    delete1(values);
+    fclose(outFile);
+}
+//----------------------------------------------------------------------------
+#endif
 int ThinPlateSplines::Main (int, char**)
 {
     TestThinPlateSplines2D();
     TestThinPlateSplines3D();
+#ifdef MEASURE_TIMING_OF_EVALUATION
+    BenchmarkThinPlateSplines();
+#endif
     return 0;
 }
 //----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.6.0 (2011/05/22)
+// File Version: 5.6.1 (2026/10/19)
 
 #ifndef THINPLATESPLINES_H
 #define THINPLATESPLINES_H
@@ -12,6 +12,13 @@
 #include "Wm5ConsoleApplication.h"
 using namespace Wm5;
 
+// Uncomment this for timing information.  The batched evaluation of the
+// splines is compared with operator() for 2000 random control points and
+// 100000 random evaluation points, and the 2D far-field approximation is
+// compared with the exact sum for several error bounds.  The times and the
+// largest differences from operator() are written to benchmark.txt.
+//#define MEASURE_TIMING_OF_EVALUATION
+
 class ThinPlateSplines : public ConsoleApplication
 {
     WM5_DECLARE_INITIALIZE;
@@ -0,0 +1,126 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#include "TriangulationBridges.h"
+
+WM5_CONSOLE_APPLICATION(TriangulationBridges);
+
+typedef TriangulateEC<double> Triangulator;
+
+//----------------------------------------------------------------------------
+static void AddVertex (Triangulator::Positions& positions,
+    Triangulator::Indices& polygon, double x, double y)
+{
+    polygon.push_back((int)positions.size());
+    positions.push_back(Vector2d(x, y));
+}
+//----------------------------------------------------------------------------
+static double GetArea (const Triangulator::Positions& positions,
+    const Triangulator::Indices& polygon)
+{
+    double area = 0.0;
+    const int numVertices = (int)polygon.size();
+    for (int i0 = numVertices - 1, i1 = 0; i1 < numVertices; i0 = i1++)
+    {
+        const Vector2d& p0 = positions[polygon[i0]];
+        const Vector2d& p1 = positions[polygon[i1]];
+        area += p0.X()*p1.Y() - p1.X()*p0.Y();
+    }
+    return 0.5*area;
+}
+//----------------------------------------------------------------------------
+TriangulationBridges::TriangulationBridges ()
+    :
+    ConsoleApplication("SampleMathematics/TriangulationBridges")
+{
+}
+//----------------------------------------------------------------------------
+bool TriangulationBridges::Triangulate (bool bridgeFromAbove,
+    Query::Type queryType)
+{
+    // The outer polygon is counterclockwise.  The ray from the first hole
+    // hits the interior of an edge adjacent to P = (11,2), so the first
+    // hole is bridged to P.  The second hole has its maximum x at (3,2);
+    // its ray passes through both copies of P.  When the first hole lies
+    // below the ray, the bridge is the lower boundary of the wedge facing
+    // the second hole; when it lies above, the bridge is the upper one.
+    Triangulator::Positions positions;
+    Triangulator::Indices outer, hole0, hole1;
+    AddVertex(positions, outer, -10.0, -10.0);
+    AddVertex(positions, outer, 10.0, -10.0);
+    AddVertex(positions, outer, 11.0, 2.0);
+    AddVertex(positions, outer, 10.0, 10.0);
+    AddVertex(positions, outer, -10.0, 10.0);
+
+    // The holes are clockwise.
+    double y = (bridgeFromAbove ? 4.0 : 0.0);
+    AddVertex(positions, hole0, 5.0, y);
+    AddVertex(positions, hole0, 4.5, y - 0.5);
+    AddVertex(positions, hole0, 4.0, y);
+    AddVertex(positions, hole0, 4.5, y + 0.5);
+    AddVertex(positions, hole1, 3.0, 2.0);
+    AddVertex(positions, hole1, 2.5, 1.5);
+    AddVertex(positions, hole1, 2.0, 2.0);
+    AddVertex(positions, hole1, 2.5, 2.5);
+
+    Triangulator::IndicesArray inners;
+    inners.push_back(&hole0);
+    inners.push_back(&hole1);
+    Triangulator::Indices triangles;
+    Triangulator triangulator(positions, queryType, 0.0, outer, inners,
+        triangles);
+
+    // The triangles cover the polygon exactly once when they are all
+    // counterclockwise and their areas add up to the area of the polygon.
+    // The expected number of triangles is n + 2*h - 2 for n vertices and
+    // h holes.
+    double expectedArea = GetArea(positions, outer) +
+        GetArea(positions, hole0) + GetArea(positions, hole1);
+    const int numTriangles = (int)triangles.size()/3;
+    double area = 0.0;
+    int numClockwise = 0;
+    for (int t = 0; t < numTriangles; ++t)
+    {
+        const Vector2d& p0 = positions[triangles[3*t]];
+        const Vector2d& p1 = positions[triangles[3*t + 1]];
+        const Vector2d& p2 = positions[triangles[3*t + 2]];
+        double triangleArea = 0.5*(p1 - p0).DotPerp(p2 - p0);
+        if (triangleArea < 0.0)
+        {
+            ++numClockwise;
+        }
+        area += triangleArea;
+    }
+
+    bool passed = (numTriangles == (int)positions.size() + 2
+        && numClockwise == 0 && area == expectedArea);
+    printf("bridge from %s, query %d: %d triangles, area %g of %g: %s\n",
+        (bridgeFromAbove ? "above" : "below"), (int)queryType, numTriangles,
+        area, expectedArea, (passed ? "passed" : "FAILED"));
+    return passed;
+}
+//----------------------------------------------------------------------------
+int TriangulationBridges::Main (int, char**)
+{
+    const Query::Type queryTypes[4] =
+    {
+        Query::QT_INT64,
+        Query::QT_RATIONAL,
+        Query::QT_REAL,
+        Query::QT_FILTERED
+    };
+
+    bool passed = true;
+    for (int i = 0; i < 4; ++i)
+    {
+        passed = Triangulate(false, queryTypes[i]) && passed;
+        passed = Triangulate(true, queryTypes[i]) && passed;
+    }
+    return (passed ? 0 : 1);
+}
+//----------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+// Geometric Tools, LLC
+// Copyright (c) 1998-2013
+// Distributed under the Boost Software License, Version 1.0.
+// http://www.boost.org/LICENSE_1_0.txt
+// http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+//
+// File Version: 5.0.0 (2026/10/19)
+
+#ifndef TRIANGULATIONBRIDGES_H
+#define TRIANGULATIONBRIDGES_H
+
+#include "Wm5ConsoleApplication.h"
+#include "Wm5Mathematics.h"
+using namespace Wm5;
+
+// Triangulate polygons with two holes where the ray from the second hole
+// passes through the outer vertex that the first hole is bridged to.  The
+// combined polygon then contains two copies of that vertex, and
+// TriangulateEC must bridge to the copy whose wedge faces the second hole.
+// The program returns a nonzero value when the triangles do not cover the
+// polygon exactly once.
+
+class TriangulationBridges : public ConsoleApplication
+{
+    WM5_DECLARE_INITIALIZE;
+    WM5_DECLARE_TERMINATE;
+
+public:
+    TriangulationBridges ();
+
+    virtual int Main (int numArguments, char** arguments);
+
+protected:
+    bool Triangulate (bool bridgeFromAbove, Query::Type queryType);
+};
+
+WM5_REGISTER_INITIALIZE(TriangulationBridges);
+WM5_REGISTER_TERMINATE(TriangulationBridges);
+
+#endif
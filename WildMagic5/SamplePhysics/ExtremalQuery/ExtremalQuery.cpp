@@ -4,9 +4,10 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.2 (2026/10/19)
 
 #include "ExtremalQuery.h"
+#include "Wm5ExtremalQuery3ADJ.h"
 #include "Wm5ExtremalQuery3BSP.h"
 #include "Wm5ExtremalQuery3PRJ.h"
 
@@ -182,16 +183,26 @@ void ExtremalQuery::CreateConvexPolyhedron (int numVertices)
     mConvexPolyhedron = new0 ConvexPolyhedron3f(numVertices, vertices,
         numIndices/3, indices, 0);
 
-#ifdef USE_BSP_QUERY
+#if defined(USE_BSP_QUERY)
     mExtremalQuery = new0 ExtremalQuery3BSPf(mConvexPolyhedron);
+#elif defined(USE_ADJ_QUERY)
+    mExtremalQuery = new0 ExtremalQuery3ADJf(mConvexPolyhedron);
 #else
     mExtremalQuery = new0 ExtremalQuery3PRJf(mConvexPolyhedron);
 #endif
 
 #ifdef MEASURE_TIMING_OF_QUERY
-    // For timing purposes and determination of asymptotic order.
-    const int imax = 10000000;
+    // For timing purposes and determination of asymptotic order.  Each
+    // query type is timed on one million random and one million coherent
+    // directions.  Every result is compared with the extreme values found
+    // by testing all vertices.
+    const int imax = 1000000;
     Vector3f* directions = new1<Vector3f>(imax);
+    Vector3f* coherent = new1<Vector3f>(imax);
+    float* maxDots = new1<float>(imax);
+    float* minDots = new1<float>(imax);
+    int* pos = new1<int>(imax);
+    int* neg = new1<int>(imax);
     for (i = 0; i < imax; ++i)
     {
         for (j = 0; j < 3; ++j)
@@ -199,21 +210,116 @@ void ExtremalQuery::CreateConvexPolyhedron (int numVertices)
             directions[i][j] = Mathf::SymmetricRandom();
         }
         directions[i].Normalize();
+
+        // A direction that rotates by a small angle per query, as for an
+        // object tracked over many frames.
+        float angle = 0.001f*(float)i;
+        coherent[i] = Vector3f(Mathf::Cos(angle), Mathf::Sin(angle),
+            0.5f*Mathf::Sin(0.1f*angle));
+        coherent[i].Normalize();
     }
 
-    clock_t start = clock();
-    for (i = 0; i < imax; ++i)
+    ExtremalQuery3ADJf* adjQuery = new0 ExtremalQuery3ADJf(
+        mConvexPolyhedron);
+    ExtremalQuery3f* queries[3] =
     {
-        int pos, neg;
-        mExtremalQuery->GetExtremeVertices(directions[i], pos, neg);
-    }
-    clock_t final = clock();
-    long diff = final - start;
-    double time = ((double)diff)/(double)CLOCKS_PER_SEC;
+        new0 ExtremalQuery3BSPf(mConvexPolyhedron),
+        new0 ExtremalQuery3PRJf(mConvexPolyhedron),
+        adjQuery
+    };
+    const char* names[3] = { "BSP", "PRJ", "ADJ" };
+    const Vector3f* directionSets[2] = { directions, coherent };
+    const char* setNames[2] = { "random", "coherent" };
+
     std::ofstream outFile("timing.txt");
-    outFile << "time = " << time << " seconds" << std::endl;
+    outFile << "vertices = " << numVertices << std::endl;
+    for (int s = 0; s < 2; ++s)
+    {
+        const Vector3f* dirs = directionSets[s];
+        for (i = 0; i < imax; ++i)
+        {
+            maxDots[i] = dirs[i].Dot(vertices[0]);
+            minDots[i] = maxDots[i];
+            for (j = 1; j < numVertices; ++j)
+            {
+                float dot = dirs[i].Dot(vertices[j]);
+                if (dot > maxDots[i])
+                {
+                    maxDots[i] = dot;
+                }
+                else if (dot < minDots[i])
+                {
+                    minDots[i] = dot;
+                }
+            }
+        }
+
+        for (int q = 0; q <= 3; ++q)
+        {
+            // Query 3 is the batched hill climb.  The hill climbs start at
+            // vertex 0 for the first direction, and each result is the
+            // starting vertex for the next direction.
+            clock_t start = clock();
+            if (q < 2)
+            {
+                for (i = 0; i < imax; ++i)
+                {
+                    queries[q]->GetExtremeVertices(dirs[i], pos[i], neg[i]);
+                }
+            }
+            else if (q == 2)
+            {
+                adjQuery->SetStart(0, 0);
+                for (i = 0; i < imax; ++i)
+                {
+                    adjQuery->GetExtremeVertices(dirs[i], pos[i], neg[i]);
+                    adjQuery->SetStart(pos[i], neg[i]);
+                }
+            }
+            else
+            {
+                adjQuery->SetStart(0, 0);
+                adjQuery->GetExtremeVerticesBatch(imax, dirs, pos, neg);
+            }
+            clock_t final = clock();
+            double time = ((double)(final - start))/(double)CLOCKS_PER_SEC;
+
+            // A result is a mismatch when its vertex is not as far in the
+            // direction as the extreme vertex.
+            int numMismatches = 0;
+            float maxError = 0.0f;
+            for (i = 0; i < imax; ++i)
+            {
+                float posError = maxDots[i] - dirs[i].Dot(vertices[pos[i]]);
+                float negError = dirs[i].Dot(vertices[neg[i]]) - minDots[i];
+                float error = (posError > negError ? posError : negError);
+                if (error > 0.0f)
+                {
+                    ++numMismatches;
+                    if (error > maxError)
+                    {
+                        maxError = error;
+                    }
+                }
+            }
+
+            outFile << (q < 3 ? names[q] : "ADJ batch") << " "
+                << setNames[s] << " time = " << time << " seconds, "
+                << numMismatches << " mismatches, largest error = "
+                << maxError << std::endl;
+        }
+    }
     outFile.close();
 
+    for (i = 0; i < 3; ++i)
+    {
+        delete0(queries[i]);
+    }
+    delete1(neg);
+    delete1(pos);
+    delete1(minDots);
+    delete1(maxDots);
+    delete1(coherent);
     delete1(directions);
 #endif
 }
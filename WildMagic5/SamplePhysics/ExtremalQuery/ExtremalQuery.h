@@ -4,7 +4,7 @@
 // http://www.boost.org/LICENSE_1_0.txt
 // http://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
 //
-// File Version: 5.0.0 (2010/01/01)
+// File Version: 5.0.1 (2026/10/19)
 
 #ifndef EXTREMALQUERY_H
 #define EXTREMALQUERY_H
@@ -13,11 +13,16 @@
 #include "Wm5ExtremalQuery3.h"
 using namespace Wm5;
 
-// Expose this for the BSP-based query.  Comment it out for the
-// projection-based query.
+// Expose this for the BSP-based query.  Expose USE_ADJ_QUERY for the
+// hill-climbing query.  Comment out both for the projection-based query.
 //#define USE_BSP_QUERY
+//#define USE_ADJ_QUERY
 
-// Uncomment this for timing information.
+// Uncomment this for timing information.  The BSP, projection and
+// hill-climbing queries are compared for random directions and for a
+// slowly rotating direction, and the batched query is compared to the
+// single-direction queries.  The results that are not extreme vertices are
+// counted.  The results are written to timing.txt.
 //#define MEASURE_TIMING_OF_QUERY
 
 class ExtremalQuery : public WindowApplication3